@@ -56,6 +56,18 @@ extern "C" {
 #define FUTEX_WAKE_OP 5
 #define FUTEX_WAIT_BITSET 9
 #define FUTEX_WAKE_BITSET 10
+#define FUTEX_WAIT_MULTIPLE 31
+
+#define FUTEX_WAIT_MULTIPLE_MAX 128
+
+/**
+ * @brief one entry of a FUTEX_WAIT_MULTIPLE request; the array is passed as
+ *        the futex address and its length as the value.
+ */
+struct futex_wait_block {
+    const int32_t* address;
+    int32_t val;
+};
 
 #define FUTEX_CLOCK_REALTIME (1 << 8)
 #define FUTEX_CMD_MASK ~(FUTEX_CLOCK_REALTIME)
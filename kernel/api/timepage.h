@@ -31,10 +31,45 @@ namespace Kernel
         return clock_id == CLOCK_REALTIME_COARSE || clock_id == CLOCK_MONOTONIC_COARSE;
     }
 
+    /**
+     * @param clock_id 
+     * @return true if the clock can be computed from the time page's counter
+     *         parameters when the page advertises a usable clock source
+     */
+    inline bool time_page_supports_high_resolution(clockid_t clock_id)
+    {
+        return clock_id == CLOCK_REALTIME || clock_id == CLOCK_MONOTONIC || clock_id == CLOCK_MONOTONIC_RAW;
+    }
+
+    enum class TimePageClockSource : u32
+    {
+        None = 0,
+        TSC,
+    }; // enum class TimePageClockSource
+
+    /**
+     * @brief written by TimeManagement::update_time_page(), which bumps update2
+     *        before changing the fields and update1 after. readers take
+     *        update1, copy what they need and retry unless update2 still
+     *        matches.
+     *
+     *        with a clock source other than None, the nanoseconds since the
+     *        last tick are ((counter - counter_base) * counter_multiplier)
+     *        >> counter_shift, to be added to monotonic_base or realtime_base.
+     *        a delta above counter_max_delta would overflow, and means the
+     *        caller has to ask the kernel instead.
+     */
     struct TimePage 
     {
         volatile u32 update1;
         struct timespec clocks[CLOCK_ID_COUNT];
+        u32 clock_source;
+        u32 counter_shift;
+        u64 counter_multiplier;
+        u64 counter_base;
+        u64 counter_max_delta;
+        struct timespec monotonic_base;
+        struct timespec realtime_base;
         volatile u32 update2;
     }; // struct TimePage
 
@@ -0,0 +1,218 @@
+/**
+ * @file futextable.cpp
+ * @author Krisna Pranav
+ * @brief futex table
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <kernel/futextable.h>
+#include <kernel/process.h>
+#include <kernel/vm/memorymanager.h>
+#include <kernel/vm/region.h>
+#include <mods/singleton.h>
+
+namespace Kernel
+{
+
+    static Mods::Singleton<FutexTable> s_the;
+
+    /**
+     * @return FutexTable&
+     */
+    FutexTable& FutexTable::the()
+    {
+        return *s_the;
+    }
+
+    /**
+     * @param count
+     * @return u32
+     */
+    u32 FutexQueue::wake(u32 count)
+    {
+        if (count == 0)
+            return 0;
+
+        ScopedSpinLock lock(m_lock);
+        m_wake_sequence++;
+
+        u32 did_wake = 0;
+        do_unblock_some([&](Thread::Blocker& b, void* data, bool& stop_iterating) {
+            ASSERT(b.blocker_type() == Thread::Blocker::Type::Futex);
+            auto& blocker = static_cast<FutexBlocker&>(b);
+            if (!blocker.unblock(data))
+                return false;
+            if (++did_wake >= count)
+                stop_iterating = true;
+            return true;
+        });
+
+        return did_wake;
+    }
+
+    /**
+     * @param data
+     * @return true
+     * @return false
+     */
+    bool FutexQueue::should_add_blocker(Thread::Blocker& b, void* data)
+    {
+        ASSERT(m_lock.is_locked());
+        ASSERT(b.blocker_type() == Thread::Blocker::Type::Futex);
+
+        auto& entry = *static_cast<FutexBlocker::Entry*>(data);
+        return entry.expected_sequence == m_wake_sequence;
+    }
+
+    /**
+     * @brief registers with every queue in turn. a queue that was woken
+     *        since the caller read its futex word refuses the blocker, and
+     *        then there is no point in sleeping at all.
+     *
+     * @param entries
+     * @param woken_index
+     */
+    FutexBlocker::FutexBlocker(Span<Entry> entries, Optional<size_t>& woken_index)
+        : m_entries(entries)
+        , m_woken_index(woken_index)
+    {
+        for (auto& entry : m_entries) {
+            if (!entry.queue->add_blocker(*this, &entry)) {
+                ScopedSpinLock lock(m_lock);
+                m_should_block = false;
+                if (!m_did_unblock) {
+                    m_did_unblock = true;
+                    m_woken_index = &entry - m_entries.data();
+                }
+                break;
+            }
+            m_registered_count++;
+        }
+    }
+
+    FutexBlocker::~FutexBlocker()
+    {
+        for (size_t i = 0; i < m_registered_count; i++)
+            m_entries[i].queue->remove_blocker(*this, &m_entries[i]);
+    }
+
+    /**
+     * @param data
+     * @return true
+     * @return false
+     */
+    bool FutexBlocker::unblock(void* data)
+    {
+        {
+            ScopedSpinLock lock(m_lock);
+            if (m_did_unblock)
+                return false;
+            m_did_unblock = true;
+            m_woken_index = static_cast<Entry*>(data) - m_entries.data();
+        }
+
+        unblock_from_blocker();
+        return true;
+    }
+
+    /**
+     * @param process
+     * @param address
+     * @return KResultOr<FutexKey>
+     */
+    KResultOr<FutexKey> FutexTable::key_for(Process& process, FlatPtr address)
+    {
+        if (address % sizeof(u32))
+            return KResult(-EINVAL);
+
+        auto* region = MM.find_region_from_vaddr(process, VirtualAddress(address));
+        if (!region)
+            return KResult(-EFAULT);
+
+        FutexKey key;
+        if (region->is_shared()) {
+            key.identity = &region->vmobject();
+            key.offset = region->offset_in_vmobject() + (address - region->vaddr().get());
+            key.vmobject = region->vmobject();
+        } else {
+            key.identity = &process;
+            key.offset = address;
+        }
+        return key;
+    }
+
+    /**
+     * @param bucket
+     * @param key
+     * @return FutexQueue*
+     */
+    FutexQueue* FutexTable::find_locked(Bucket& bucket, const FutexKey& key)
+    {
+        ASSERT(bucket.lock.is_locked());
+
+        for (auto& queue : bucket.queues) {
+            if (queue.key() == key)
+                return &queue;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @param key
+     * @return FutexQueue&
+     */
+    FutexQueue& FutexTable::acquire(FutexKey&& key)
+    {
+        auto& bucket = bucket_for(key);
+        ScopedSpinLock lock(bucket.lock);
+
+        auto* queue = find_locked(bucket, key);
+        if (!queue) {
+            queue = new FutexQueue(move(key));
+            bucket.queues.append(*queue);
+        }
+
+        queue->m_users++;
+        return *queue;
+    }
+
+    /**
+     * @param key
+     * @return FutexQueue*
+     */
+    FutexQueue* FutexTable::acquire_existing(const FutexKey& key)
+    {
+        auto& bucket = bucket_for(key);
+        ScopedSpinLock lock(bucket.lock);
+
+        auto* queue = find_locked(bucket, key);
+        if (queue)
+            queue->m_users++;
+        return queue;
+    }
+
+    /**
+     * @brief drops a use; the last one unlinks and frees the queue, so
+     *        queues of words nobody waits on do not accumulate.
+     *
+     * @param queue
+     */
+    void FutexTable::release(FutexQueue& queue)
+    {
+        auto& bucket = bucket_for(queue.key());
+        {
+            ScopedSpinLock lock(bucket.lock);
+            ASSERT(queue.m_users > 0);
+            if (--queue.m_users > 0)
+                return;
+            bucket.queues.remove(queue);
+        }
+
+        delete &queue;
+    }
+
+} // namespace Kernel
@@ -0,0 +1,238 @@
+/**
+ * @file futextable.h
+ * @author Krisna Pranav
+ * @brief futex table
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include <kernel/kresult.h>
+#include <kernel/spinlock.h>
+#include <kernel/thread.h>
+#include <kernel/vm/vmobject.h>
+#include <mods/array.h>
+#include <mods/hashfunctions.h>
+#include <mods/intrusivelist.h>
+#include <mods/optional.h>
+#include <mods/refptr.h>
+#include <mods/span.h>
+#include <mods/types.h>
+
+namespace Kernel
+{
+
+    /**
+     * @brief names a futex word. words in shared mappings are named by their
+     *        VMObject and offset, so every process that maps the object finds
+     *        the same queue; words in private mappings by process and address.
+     */
+    struct FutexKey
+    {
+        void const* identity { nullptr };
+        u64 offset { 0 };
+
+        /// @brief keeps a shared key's identity from being reused while
+        ///        somebody waits on it.
+        RefPtr<VMObject> vmobject;
+
+        bool operator==(const FutexKey& other) const
+        {
+            return identity == other.identity && offset == other.offset;
+        }
+
+        /**
+         * @return unsigned
+         */
+        unsigned hash() const
+        {
+            return pair_int_hash(ptr_hash(identity), u64_hash(offset));
+        }
+    }; // struct FutexKey
+
+    /**
+     * @brief the waiters of one futex word. exists only while somebody is
+     *        waiting on or waking the word; the last user frees it.
+     */
+    class FutexQueue final : public Thread::BlockCondition
+    {
+    public:
+        /**
+         * @param key
+         */
+        explicit FutexQueue(FutexKey&& key)
+            : m_key(move(key))
+        {
+        }
+
+        /**
+         * @return const FutexKey&
+         */
+        const FutexKey& key() const
+        {
+            return m_key;
+        }
+
+        /**
+         * @brief bumped by every wake. a waiter that saw an older value when
+         *        it checked the futex word does not go to sleep.
+         *
+         * @return u32
+         */
+        u32 wake_sequence()
+        {
+            ScopedSpinLock lock(m_lock);
+            return m_wake_sequence;
+        }
+
+        /**
+         * @param count
+         * @return u32
+         */
+        u32 wake(u32 count);
+
+    protected:
+        virtual bool should_add_blocker(Thread::Blocker&, void*) override;
+
+    private:
+        friend class FutexTable;
+
+        FutexKey m_key;
+        u32 m_wake_sequence { 0 };
+
+        /// @brief guarded by the bucket lock. waiters hold a use for as long
+        ///        as they are blocked, so an unused queue has no blockers.
+        u32 m_users { 0 };
+        IntrusiveListNode<FutexQueue> m_bucket_node;
+    }; // class FutexQueue
+
+    /**
+     * @brief blocks a thread on one or more futex queues at once and
+     *        remembers which one woke it.
+     */
+    class FutexBlocker final : public Thread::Blocker
+    {
+    public:
+        struct Entry
+        {
+            FutexQueue* queue { nullptr };
+            u32 expected_sequence { 0 };
+        }; // struct Entry
+
+        /**
+         * @param entries
+         * @param woken_index set to the entry whose queue woke the thread
+         */
+        FutexBlocker(Span<Entry> entries, Optional<size_t>& woken_index);
+        virtual ~FutexBlocker();
+
+        virtual Type blocker_type() const override
+        {
+            return Type::Futex;
+        }
+
+        virtual const char* state_string() const override
+        {
+            return "Futex";
+        }
+
+        virtual bool should_block() override
+        {
+            return m_should_block;
+        }
+
+        virtual void not_blocking(bool) override { }
+
+        /**
+         * @param data
+         * @return true
+         * @return false
+         */
+        bool unblock(void* data);
+
+    private:
+        Span<Entry> m_entries;
+        size_t m_registered_count { 0 };
+        Optional<size_t>& m_woken_index;
+        bool m_should_block { true };
+        bool m_did_unblock { false };
+    }; // class FutexBlocker
+
+    /**
+     * @brief every futex queue in the system, hashed into buckets that each
+     *        have their own lock.
+     */
+    class FutexTable
+    {
+        MOD_MAKE_NONCOPYABLE(FutexTable);
+        MOD_MAKE_NONMOVABLE(FutexTable);
+
+    public:
+        static constexpr size_t bucket_count = 256;
+
+        static FutexTable& the();
+
+        FutexTable() = default;
+
+        /**
+         * @param process
+         * @param address
+         * @return KResultOr<FutexKey>
+         */
+        static KResultOr<FutexKey> key_for(Process& process, FlatPtr address);
+
+        /**
+         * @brief the queue for key, created if nobody uses it yet. the caller
+         *        owns a use until it hands the queue to release().
+         *
+         * @param key
+         * @return FutexQueue&
+         */
+        FutexQueue& acquire(FutexKey&& key);
+
+        /**
+         * @brief the queue for key if somebody is using it.
+         *
+         * @param key
+         * @return FutexQueue*
+         */
+        FutexQueue* acquire_existing(const FutexKey& key);
+
+        /**
+         * @param queue
+         */
+        void release(FutexQueue& queue);
+
+    private:
+        using QueueList = IntrusiveList<FutexQueue, RawPtr<FutexQueue>, &FutexQueue::m_bucket_node>;
+
+        struct Bucket
+        {
+            SpinLock<u8> lock;
+            QueueList queues;
+        }; // struct Bucket
+
+        /**
+         * @param key
+         * @return Bucket&
+         */
+        Bucket& bucket_for(const FutexKey& key)
+        {
+            return m_buckets[key.hash() % bucket_count];
+        }
+
+        /**
+         * @param bucket
+         * @param key
+         * @return FutexQueue*
+         */
+        static FutexQueue* find_locked(Bucket& bucket, const FutexKey& key);
+
+        Array<Bucket, bucket_count> m_buckets;
+    }; // class FutexTable
+
+} // namespace Kernel
@@ -1566,10 +1566,6 @@ namespace Kernel
 
         Vector<UnveiledPath> m_unveiled_paths;
 
-        WaitQueue& futex_queue(Userspace<const i32*>);
-
-        HashMap<u32, OwnPtr<WaitQueue>> m_futex_queues;
-
         OwnPtr<PerformanceEventBuffer> m_perf_event_buffer;
 
         bool m_wait_for_tracer_at_next_execve { false };
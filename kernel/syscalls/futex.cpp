@@ -4,34 +4,74 @@
  * @brief futex
  * @version 6.0
  * @date 2023-08-26
- * 
+ *
  * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
- * 
+ *
  */
 
+#include <mods/scopeguard.h>
 #include <mods/time.h>
+#include <kernel/futextable.h>
 #include <kernel/process.h>
 
-namespace Kernel 
+namespace Kernel
 {
 
     /**
-     * @param userspace_address 
-     * @return WaitQueue& 
+     * @brief sleep until one of the futex words is woken. each queue is
+     *        registered before its word is read, so a FUTEX_WAKE that follows
+     *        a store we did not see bumps the queue's wake sequence and the
+     *        blocker refuses to sleep.
+     *
+     * @param process
+     * @param blocks
+     * @param timeout
+     * @return the index of the word that was woken, or a negative errno
      */
-    WaitQueue& Process::futex_queue(Userspace<const i32*> userspace_address)
+    static int futex_wait(Process& process, Span<const futex_wait_block> blocks, const Thread::BlockTimeout& timeout)
     {
-        auto& queue = m_futex_queues.ensure(userspace_address.ptr());
+        auto& table = FutexTable::the();
 
-        if (!queue)
-            queue = make<WaitQueue>();
+        Vector<FutexBlocker::Entry, 1> entries;
+        ScopeGuard release_queues([&] {
+            for (auto& entry : entries)
+                table.release(*entry.queue);
+        });
 
-        return *queue;
+        for (auto& block : blocks) {
+            auto key_or_error = FutexTable::key_for(process, (FlatPtr)block.address);
+            if (key_or_error.is_error())
+                return key_or_error.error();
+
+            auto& queue = table.acquire(key_or_error.release_value());
+            entries.append({ &queue, queue.wake_sequence() });
+        }
+
+        for (auto& block : blocks) {
+            i32 user_value;
+
+            if (!copy_from_user(&user_value, block.address))
+                return -EFAULT;
+
+            if (user_value != block.val)
+                return -EAGAIN;
+        }
+
+        Optional<size_t> woken_index;
+        auto result = Thread::current()->block<FutexBlocker>(timeout, entries.span(), woken_index);
+
+        if (result == Thread::BlockResult::InterruptedByTimeout)
+            return -ETIMEDOUT;
+
+        if (result.was_interrupted())
+            return -EINTR;
+
+        return woken_index.value_or(0);
     }
 
     /**
      * @brief futex sys process
-     * 
+     *
      */
     int Process::sys$futex(Userspace<const Syscall::SC_futex_params*> user_params)
     {
@@ -42,48 +82,55 @@ namespace Kernel
         if (!copy_from_user(&params, user_params))
             return -EFAULT;
 
-        switch (params.futex_op) {
+        Thread::BlockTimeout timeout;
 
-        case FUTEX_WAIT: {
-            i32 user_value;
+        if (params.timeout && (params.futex_op == FUTEX_WAIT || params.futex_op == FUTEX_WAIT_MULTIPLE)) {
+            timespec ts_abstimeout { 0, 0 };
 
-            if (!copy_from_user(&user_value, params.userspace_address))
+            if (!copy_from_user(&ts_abstimeout, params.timeout))
                 return -EFAULT;
 
-            if (user_value != params.val)
-                return -EAGAIN;
+            timeout = Thread::BlockTimeout(true, &ts_abstimeout);
+        }
+
+        switch (params.futex_op) {
+
+        case FUTEX_WAIT: {
+            futex_wait_block block { params.userspace_address, params.val };
+            int rc = futex_wait(*this, { &block, 1 }, timeout);
+            return rc < 0 ? rc : 0;
+        }
 
-            Thread::BlockTimeout timeout;
+        case FUTEX_WAIT_MULTIPLE: {
+            if (params.val <= 0 || params.val > FUTEX_WAIT_MULTIPLE_MAX)
+                return -EINVAL;
 
-            if (params.timeout) {
-                timespec ts_abstimeout { 0, 0 };
+            futex_wait_block blocks[FUTEX_WAIT_MULTIPLE_MAX];
+            auto* user_blocks = reinterpret_cast<const futex_wait_block*>(params.userspace_address);
 
-                if (!copy_from_user(&ts_abstimeout, params.timeout))
-                    return -EFAULT;
+            if (!copy_n_from_user(blocks, user_blocks, params.val))
+                return -EFAULT;
 
-                timeout = Thread::BlockTimeout(true, &ts_abstimeout);
-            }
+            return futex_wait(*this, { blocks, (size_t)params.val }, timeout);
+        }
 
-            WaitQueue& wait_queue = futex_queue((FlatPtr)params.userspace_address);
+        case FUTEX_WAKE: {
+            if (params.val <= 0)
+                return 0;
 
-            Thread::BlockResult result = wait_queue.wait_on(timeout, "Futex");
+            auto key_or_error = FutexTable::key_for(*this, (FlatPtr)params.userspace_address);
+            if (key_or_error.is_error())
+                return key_or_error.error();
 
-            if (result == Thread::BlockResult::InterruptedByTimeout) {
-                return -ETIMEDOUT;
-            }
+            auto& table = FutexTable::the();
+            auto* queue = table.acquire_existing(key_or_error.value());
+            if (!queue)
+                return 0;
 
-            break;
+            u32 woken = queue->wake(params.val);
+            table.release(*queue);
+            return woken;
         }
-        case FUTEX_WAKE:
-            if (params.val == 0)
-                return 0;
-                
-            if (params.val == 1) {
-                futex_queue((FlatPtr)params.userspace_address).wake_one();
-            } else {
-                futex_queue((FlatPtr)params.userspace_address).wake_n(params.val);
-            }
-            break;
         }
 
         return 0;
@@ -339,6 +339,7 @@ namespace Kernel
             {
                 Unknown = 0,
                 File,
+                Futex,
                 Plan9FS,
                 Join,
                 Queue,
@@ -23,6 +23,7 @@ namespace Kernel
     #define OPTIMAL_TICKS_PER_SECOND_RATE 1000
 
     class HardwareTimerBase;
+    struct TimePage;
 
     class TimeManagement 
     {
@@ -93,6 +94,18 @@ namespace Kernel
         /// @brief: increment_time from boot
         void increment_time_since_boot(const RegisterState&);
 
+        /**
+         * @brief publish the coarse clocks and, once the TSC is calibrated,
+         *        its conversion parameters. meant to run on the boot
+         *        processor after update_time has accounted each tick, but
+         *        nothing calls it yet: update_time is defined outside this
+         *        tree. until it does, the page keeps clock_source None and
+         *        clock_gettime() falls back to the syscall.
+         *
+         * @param page 
+         */
+        void update_time_page(TimePage& page);
+
         static bool is_hpet_periodic_mode_allowed();
 
         /**
@@ -144,6 +157,29 @@ namespace Kernel
 
         RefPtr<HardwareTimerBase> m_system_timer;
         RefPtr<HardwareTimerBase> m_time_keeper_timer;
+
+        enum class TSCState : u8
+        {
+            Unprobed,
+            Calibrating,
+            Usable,
+            Unusable,
+        };
+
+        /**
+         * @param tsc 
+         * @param monotonic 
+         * @return true while the TSC can back the time page
+         */
+        bool update_tsc_clock_source(u64 tsc, const timespec& monotonic);
+
+        TSCState m_tsc_state { TSCState::Unprobed };
+        u64 m_tsc_calibration_start { 0 };
+        timespec m_tsc_calibration_start_time { 0, 0 };
+        u64 m_tsc_nominal_multiplier { 0 };
+        u64 m_tsc_multiplier { 0 };
+        u64 m_tsc_base { 0 };
+        timespec m_tsc_monotonic_base { 0, 0 };
     }; // class TimeManagement
 
 }
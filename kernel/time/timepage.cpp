@@ -0,0 +1,181 @@
+/**
+ * @file timepage.cpp
+ * @author Krisna Pranav
+ * @brief time page
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <kernel/api/timepage.h>
+#include <kernel/arch/i386/cpu.h>
+#include <kernel/time/timemanagement.h>
+#include <mods/atomic.h>
+#include <mods/logstream.h>
+#include <mods/numericlimits.h>
+#include <mods/time.h>
+
+namespace Kernel
+{
+
+    static constexpr u32 tsc_counter_shift = 24;
+    static constexpr i64 tsc_calibration_ns = 250'000'000;
+
+    /// @brief the calibration baseline keeps growing until (elapsed << shift)
+    ///        would overflow; by then the frequency is good to a few ppm.
+    static constexpr i64 tsc_refinement_limit_ns = 1ll << (63 - tsc_counter_shift);
+
+    /// @brief the tick clock and the TSC are steered back together over this
+    ///        window, by at most a tenth of a percent.
+    static constexpr i64 tsc_steering_window_ns = 4'000'000'000;
+    static constexpr i64 tsc_max_steering_ns = tsc_steering_window_ns / 1000;
+
+    /// @brief disagreement with the tick clock beyond this means the TSC
+    ///        cannot be trusted, e.g. it stopped in a deep C-state.
+    static constexpr i64 tsc_max_error_ns = 50'000'000;
+
+    /**
+     * @param ts
+     * @return i64
+     */
+    static i64 timespec_to_ns(const timespec& ts)
+    {
+        return (i64)ts.tv_sec * 1'000'000'000 + ts.tv_nsec;
+    }
+
+    /**
+     * @param ns
+     * @return timespec
+     */
+    static timespec ns_to_timespec(i64 ns)
+    {
+        ASSERT(ns >= 0);
+        return { (time_t)(ns / 1'000'000'000), (long)(ns % 1'000'000'000) };
+    }
+
+    /**
+     * @param tsc
+     * @param monotonic
+     * @return true
+     * @return false
+     */
+    bool TimeManagement::update_tsc_clock_source(u64 tsc, const timespec& monotonic)
+    {
+        auto now_ns = timespec_to_ns(monotonic);
+
+        switch (m_tsc_state) {
+        case TSCState::Unprobed: {
+            auto& processor = Processor::current();
+            if (!processor.has_feature(CPUFeature::TSC) || !processor.has_feature(CPUFeature::CONSTANT_TSC) || !processor.has_feature(CPUFeature::NONSTOP_TSC)) {
+                klog() << "TimeManagement: TSC is not invariant, clock_gettime stays a syscall";
+                m_tsc_state = TSCState::Unusable;
+                return false;
+            }
+
+            m_tsc_calibration_start = tsc;
+            m_tsc_calibration_start_time = monotonic;
+            m_tsc_state = TSCState::Calibrating;
+            return false;
+        }
+
+        case TSCState::Calibrating: {
+            auto elapsed_ns = now_ns - timespec_to_ns(m_tsc_calibration_start_time);
+            if (elapsed_ns < tsc_calibration_ns)
+                return false;
+
+            auto elapsed_tsc = tsc - m_tsc_calibration_start;
+            if (!elapsed_tsc) {
+                klog() << "TimeManagement: TSC does not advance, clock_gettime stays a syscall";
+                m_tsc_state = TSCState::Unusable;
+                return false;
+            }
+
+            m_tsc_nominal_multiplier = ((u64)elapsed_ns << tsc_counter_shift) / elapsed_tsc;
+            m_tsc_multiplier = m_tsc_nominal_multiplier;
+            m_tsc_base = tsc;
+            m_tsc_monotonic_base = monotonic;
+            m_tsc_state = TSCState::Usable;
+
+            klog() << "TimeManagement: TSC runs at " << (elapsed_tsc * 1000) / (u64)(elapsed_ns / 1'000'000) << " Hz, clock_gettime reads it in userspace";
+            return true;
+        }
+
+        case TSCState::Usable: {
+            auto delta = tsc - m_tsc_base;
+            if (delta > NumericLimits<u64>::max() / m_tsc_multiplier) {
+                klog() << "TimeManagement: TSC went backwards, clock_gettime falls back to the syscall";
+                m_tsc_state = TSCState::Unusable;
+                return false;
+            }
+
+            auto tsc_ns = timespec_to_ns(m_tsc_monotonic_base) + (i64)((delta * m_tsc_multiplier) >> tsc_counter_shift);
+            auto error_ns = now_ns - tsc_ns;
+            if (error_ns > tsc_max_error_ns || error_ns < -tsc_max_error_ns) {
+                klog() << "TimeManagement: TSC drifted " << error_ns << " ns from the system timer, clock_gettime falls back to the syscall";
+                m_tsc_state = TSCState::Unusable;
+                return false;
+            }
+
+            m_tsc_base = tsc;
+            m_tsc_monotonic_base = ns_to_timespec(tsc_ns);
+
+            auto calibration_ns = now_ns - timespec_to_ns(m_tsc_calibration_start_time);
+            if (calibration_ns < tsc_refinement_limit_ns)
+                m_tsc_nominal_multiplier = ((u64)calibration_ns << tsc_counter_shift) / (tsc - m_tsc_calibration_start);
+
+            auto steering_ns = clamp(error_ns, -tsc_max_steering_ns, tsc_max_steering_ns);
+            m_tsc_multiplier = m_tsc_nominal_multiplier + ((i64)m_tsc_nominal_multiplier * steering_ns) / tsc_steering_window_ns;
+            return true;
+        }
+
+        case TSCState::Unusable:
+            return false;
+        }
+
+        ASSERT_NOT_REACHED();
+    }
+
+    /**
+     * @brief the base is moved forward on every tick with the multiplier
+     *        that readers were using until now, so the userspace clock
+     *        stays continuous while the multiplier is steered.
+     *
+     * @param page
+     */
+    void TimeManagement::update_time_page(TimePage& page)
+    {
+        auto monotonic = monotonic_time();
+        auto realtime = epoch_time();
+        u64 tsc = Processor::current().has_feature(CPUFeature::TSC) ? read_tsc() : 0;
+
+        bool counter_usable = update_tsc_clock_source(tsc, monotonic);
+
+        // readers load update1 first and check update2 last, so update2
+        // moves before the fields change and update1 only after
+        Mods::atomic_fetch_add(&page.update2, 1u, Mods::memory_order_acquire);
+        Mods::atomic_thread_fence(Mods::memory_order_release);
+
+        page.clocks[CLOCK_REALTIME_COARSE] = realtime;
+        page.clocks[CLOCK_MONOTONIC_COARSE] = monotonic;
+
+        if (counter_usable) {
+            timespec realtime_offset;
+            timespec_sub(realtime, monotonic, realtime_offset);
+
+            page.clock_source = (u32)TimePageClockSource::TSC;
+            page.counter_shift = tsc_counter_shift;
+            page.counter_multiplier = m_tsc_multiplier;
+            page.counter_base = m_tsc_base;
+            page.counter_max_delta = NumericLimits<u64>::max() / m_tsc_multiplier;
+            page.monotonic_base = m_tsc_monotonic_base;
+            timespec_add(m_tsc_monotonic_base, realtime_offset, page.realtime_base);
+        } else {
+            page.clock_source = (u32)TimePageClockSource::None;
+        }
+
+        Mods::atomic_fetch_add(&page.update1, 1u, Mods::memory_order_release);
+    }
+
+} // namespace Kernel
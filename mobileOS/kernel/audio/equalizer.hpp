@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <tuple>
 
@@ -102,5 +103,5 @@ enum class FilterType
     None
 };
 
-QFilterCoefficients qfilter_CalculateCofees(FilterType filter, float frequency, uint32_t samplerate, float Q, float gain);
+QFilterCoefficients qfilter_CalculateCoeffs(FilterType filter, float frequency, uint32_t samplerate, float Q, float gain);
 } // namespace audio::equalizer
@@ -0,0 +1,292 @@
+/**
+ * @file filterengine.cpp
+ * @author Krisna Pranav
+ * @brief Filter Engine
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2024, pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include "filterengine.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace audio::equalizer
+{
+namespace
+{
+constexpr QFilterCoefficients passThrough = {1.f, 0.f, 0.f, 0.f, 0.f};
+
+/**
+ * @brief a block of frames converted from 16 bits, small enough for the stack
+ *
+ */
+constexpr std::size_t conversionFrames = 128;
+
+constexpr float int16Scale = 32768.f;
+
+/**
+ * @brief advance, moves a ramping band's coefficients one frame on
+ *
+ * @param c
+ * @param step
+ */
+inline void advance(QFilterCoefficients& c, const QFilterCoefficients& step) noexcept
+{
+    c.b0 += step.b0;
+    c.b1 += step.b1;
+    c.b2 += step.b2;
+    c.a1 += step.a1;
+    c.a2 += step.a2;
+}
+
+/**
+ * @brief tick, one frame through one biquad in transposed direct form II
+ *
+ * @tparam Frame
+ * @param c
+ * @param s1
+ * @param s2
+ * @param x
+ * @return Frame
+ */
+template <typename Frame> inline Frame tick(const QFilterCoefficients& c, Frame& s1, Frame& s2, Frame x) noexcept
+{
+    const Frame y = c.b0 * x + s1;
+    s1 = c.b1 * x - c.a1 * y + s2;
+    s2 = c.b2 * x - c.a2 * y;
+    return y;
+}
+} // namespace
+
+/**
+ * @brief Construct a new Filter Engine:: Filter Engine object
+ *
+ * @param rampFrames
+ */
+FilterEngine::FilterEngine(std::size_t rampFrames) noexcept : rampFrames(rampFrames)
+{
+    for(auto& band : bandState)
+    {
+        band.current = passThrough;
+        band.target = passThrough;
+    }
+}
+
+/**
+ * @brief setCoefficients
+ *
+ * @param coefficients
+ * @param count
+ */
+void FilterEngine::setCoefficients(const QFilterCoefficients* coefficients, std::size_t count)
+{
+    count = std::min(count, maxBands);
+
+    // a band that was not running starts from pass-through with no history
+    for(std::size_t i = bandCount; i < count; ++i)
+    {
+        bandState[i].current = passThrough;
+        bandState[i].s1 = Frame{};
+        bandState[i].s2 = Frame{};
+    }
+
+    targetBandCount = count;
+    bandCount = std::max(bandCount, count);
+
+    for(std::size_t i = 0; i < bandCount; ++i)
+    {
+        auto& band = bandState[i];
+        band.target = i < count ? coefficients[i] : passThrough;
+    }
+
+    if(rampFrames == 0)
+    {
+        for(std::size_t i = 0; i < bandCount; ++i)
+        {
+            bandState[i].current = bandState[i].target;
+        }
+        bandCount = targetBandCount;
+        rampRemaining = 0;
+        return;
+    }
+
+    const float inverse = 1.f / rampFrames;
+    for(std::size_t i = 0; i < bandCount; ++i)
+    {
+        auto& band = bandState[i];
+        band.step.b0 = (band.target.b0 - band.current.b0) * inverse;
+        band.step.b1 = (band.target.b1 - band.current.b1) * inverse;
+        band.step.b2 = (band.target.b2 - band.current.b2) * inverse;
+        band.step.a1 = (band.target.a1 - band.current.a1) * inverse;
+        band.step.a2 = (band.target.a2 - band.current.a2) * inverse;
+    }
+    rampRemaining = rampFrames;
+}
+
+/**
+ * @brief reset
+ *
+ */
+void FilterEngine::reset() noexcept
+{
+    for(auto& band : bandState)
+    {
+        band.s1 = Frame{};
+        band.s2 = Frame{};
+    }
+}
+
+/**
+ * @brief processFrames, runs the block through two bands per pass. a band's
+ *        output for one frame depends on its previous frame, so a single
+ *        band is bound by latency; with two in the same loop the second
+ *        band's work on frame n overlaps the first band's on frame n + 1.
+ *
+ * @param frames
+ * @param frameCount
+ */
+void FilterEngine::processFrames(Frame* frames, std::size_t frameCount) noexcept
+{
+    const auto rampCount = std::min(frameCount, rampRemaining);
+    const bool rampEnds = rampCount == rampRemaining && rampCount != 0;
+
+    for(std::size_t i = 0; i < bandCount; i += 2)
+    {
+        auto& first = bandState[i];
+        // with an odd band count the last band runs on its own
+        auto& second = i + 1 < bandCount ? bandState[i + 1] : first;
+        const bool paired = &second != &first;
+
+        auto c0 = first.current;
+        auto c1 = second.current;
+        auto s01 = first.s1, s02 = first.s2;
+        auto s11 = second.s1, s12 = second.s2;
+
+        std::size_t n = 0;
+        for(; n < rampCount; ++n)
+        {
+            advance(c0, first.step);
+            auto y = tick(c0, s01, s02, frames[n]);
+            if(paired)
+            {
+                advance(c1, second.step);
+                y = tick(c1, s11, s12, y);
+            }
+            frames[n] = y;
+        }
+
+        if(rampEnds)
+        {
+            // land exactly on the target instead of where rounding left us
+            c0 = first.target;
+            c1 = second.target;
+        }
+
+        if(paired)
+        {
+            for(; n < frameCount; ++n)
+            {
+                frames[n] = tick(c1, s11, s12, tick(c0, s01, s02, frames[n]));
+            }
+            second.current = c1;
+            second.s1 = s11;
+            second.s2 = s12;
+        }
+        else
+        {
+            for(; n < frameCount; ++n)
+            {
+                frames[n] = tick(c0, s01, s02, frames[n]);
+            }
+        }
+
+        first.current = c0;
+        first.s1 = s01;
+        first.s2 = s02;
+    }
+
+    rampRemaining -= rampCount;
+    if(rampRemaining == 0)
+    {
+        bandCount = targetBandCount;
+    }
+}
+
+/**
+ * @brief process
+ *
+ * @param frames
+ * @param frameCount
+ */
+void FilterEngine::process(float* frames, std::size_t frameCount) noexcept
+{
+    static_assert(sizeof(Frame) == channels * sizeof(float));
+
+    if(bandCount == 0)
+    {
+        return;
+    }
+
+    // the vector type wants 8-byte alignment, which a float buffer need not have
+    if(reinterpret_cast<std::uintptr_t>(frames) % alignof(Frame) == 0)
+    {
+        processFrames(reinterpret_cast<Frame*>(frames), frameCount);
+        return;
+    }
+
+    Frame block[conversionFrames];
+    while(frameCount > 0)
+    {
+        const auto count = std::min(frameCount, conversionFrames);
+        std::memcpy(block, frames, count * sizeof(Frame));
+        processFrames(block, count);
+        std::memcpy(frames, block, count * sizeof(Frame));
+        frames += count * channels;
+        frameCount -= count;
+    }
+}
+
+/**
+ * @brief process
+ *
+ * @param frames
+ * @param frameCount
+ */
+void FilterEngine::process(std::int16_t* frames, std::size_t frameCount) noexcept
+{
+    if(bandCount == 0)
+    {
+        return;
+    }
+
+    Frame block[conversionFrames];
+    while(frameCount > 0)
+    {
+        const auto count = std::min(frameCount, conversionFrames);
+
+        for(std::size_t n = 0; n < count; ++n)
+        {
+            block[n] = Frame{frames[2 * n] / int16Scale, frames[2 * n + 1] / int16Scale};
+        }
+
+        processFrames(block, count);
+
+        for(std::size_t n = 0; n < count; ++n)
+        {
+            const auto scaled = block[n] * int16Scale;
+            for(std::size_t channel = 0; channel < channels; ++channel)
+            {
+                const auto sample = std::lrintf(std::clamp(scaled[channel], -32768.f, 32767.f));
+                frames[channels * n + channel] = static_cast<std::int16_t>(sample);
+            }
+        }
+
+        frames += count * channels;
+        frameCount -= count;
+    }
+}
+} // namespace audio::equalizer
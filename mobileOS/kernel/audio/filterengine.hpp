@@ -0,0 +1,129 @@
+/**
+ * @file filterengine.hpp
+ * @author Krisna Pranav
+ * @brief Filter Engine
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2024, pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include "equalizer.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace audio::equalizer
+{
+/**
+ * @brief runs a cascade of biquads over interleaved stereo PCM, one block at
+ *        a time. both channels go through each band together as one
+ *        two-lane vector, in transposed direct form II. new coefficients are
+ *        not applied at once but reached by a linear ramp over rampFrames
+ *        frames, so moving a band while audio plays does not click.
+ */
+class FilterEngine
+{
+  public:
+    static constexpr std::size_t maxBands = 10;
+    static constexpr std::size_t channels = 2;
+    static constexpr std::size_t defaultRampFrames = 256;
+
+    /**
+     * @brief Construct a new Filter Engine object with no bands, which
+     *        passes audio through unchanged
+     *
+     * @param rampFrames
+     */
+    explicit FilterEngine(std::size_t rampFrames = defaultRampFrames) noexcept;
+
+    /**
+     * @brief setCoefficients, starts a ramp towards the given bands. bands
+     *        added by this call ramp in from a pass-through filter, bands
+     *        removed ramp out to one.
+     *
+     * @param coefficients
+     * @param count at most maxBands
+     */
+    void setCoefficients(const QFilterCoefficients* coefficients, std::size_t count);
+
+    /**
+     * @brief setCoefficients
+     *
+     * @tparam N
+     * @param coefficients
+     */
+    template <std::size_t N> void setCoefficients(const std::array<QFilterCoefficients, N>& coefficients)
+    {
+        static_assert(N <= maxBands, "Too many equalizer bands");
+        setCoefficients(coefficients.data(), N);
+    }
+
+    /**
+     * @brief reset, clears the filter history, e.g. when a new stream starts
+     *
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief process, filters frameCount interleaved stereo frames in place
+     *
+     * @param frames
+     * @param frameCount
+     */
+    void process(float* frames, std::size_t frameCount) noexcept;
+
+    /**
+     * @brief process, filters frameCount interleaved stereo frames in place,
+     *        saturating the result to 16 bits
+     *
+     * @param frames
+     * @param frameCount
+     */
+    void process(std::int16_t* frames, std::size_t frameCount) noexcept;
+
+    /**
+     * @brief Get the Band Count object
+     *
+     * @return std::size_t
+     */
+    [[nodiscard]] std::size_t getBandCount() const noexcept
+    {
+        return bandCount;
+    }
+
+    /**
+     * @brief isRamping
+     *
+     * @return true
+     * @return false
+     */
+    [[nodiscard]] bool isRamping() const noexcept
+    {
+        return rampRemaining != 0;
+    }
+
+  private:
+    using Frame = float __attribute__((vector_size(channels * sizeof(float))));
+
+    struct Band
+    {
+        QFilterCoefficients current;
+        QFilterCoefficients target;
+        QFilterCoefficients step;
+        Frame s1;
+        Frame s2;
+    };
+
+    void processFrames(Frame* frames, std::size_t frameCount) noexcept;
+
+    std::array<Band, maxBands> bandState{};
+    std::size_t bandCount = 0;
+    std::size_t targetBandCount = 0;
+    std::size_t rampFrames;
+    std::size_t rampRemaining = 0;
+};
+} // namespace audio::equalizer
@@ -18,6 +18,10 @@
 #define SQLITE_OMIT_AUTOINIT 1
 #define SQLITE_DEFAULT_MEMSTATUS 0
 
+/* xFetch in the VFS serves pages out of its page cache */
+#define SQLITE_MAX_MMAP_SIZE 0x7fff0000
+#define SQLITE_DEFAULT_MMAP_SIZE (64 * 1024 * 1024)
+
 #pragma GCC diagnostic ignored "-Wunused-variable"
 #pragma GCC diagnostic ignored "-Wsign-compare"
 #pragma GCC diagnostic ignored "-Wunused-but-set-variable"
@@ -0,0 +1,222 @@
+/**
+ * @file cursor.cpp
+ * @author Krisna Pranav
+ * @brief Cursor
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2024, pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include "cursor.hpp"
+#include <log/log.hpp>
+#include <utility>
+
+/**
+ * @brief Construct a new Cursor:: Cursor object
+ *
+ * @param cache
+ * @param statement
+ */
+Cursor::Cursor(StatementCache* cache, std::unique_ptr<Statement> statement)
+    : cache(cache), statement(std::move(statement))
+{
+}
+
+/**
+ * @brief Destroy the Cursor:: Cursor object
+ *
+ */
+Cursor::~Cursor()
+{
+    release();
+}
+
+/**
+ * @brief Construct a new Cursor:: Cursor object
+ *
+ * @param other
+ */
+Cursor::Cursor(Cursor&& other) noexcept
+    : cache(other.cache), statement(std::move(other.statement)), failed(other.failed)
+{
+}
+
+/**
+ * @brief operator=
+ *
+ * @param other
+ * @return Cursor&
+ */
+Cursor& Cursor::operator=(Cursor&& other) noexcept
+{
+    if(this != &other)
+    {
+        release();
+        cache = other.cache;
+        statement = std::move(other.statement);
+        failed = other.failed;
+    }
+    return *this;
+}
+
+/**
+ * @brief release
+ *
+ */
+void Cursor::release()
+{
+    if(!statement)
+    {
+        return;
+    }
+
+    if(cache != nullptr)
+    {
+        cache->release(std::move(statement));
+    }
+    statement.reset();
+}
+
+/**
+ * @brief next
+ *
+ * @return true
+ * @return false
+ */
+bool Cursor::next()
+{
+    if(!statement)
+    {
+        return false;
+    }
+
+    switch(const auto rc = statement->step(); rc)
+    {
+    case SQLITE_ROW:
+        return true;
+    case SQLITE_DONE:
+        return false;
+    default:
+        LOG_ERROR("Stepping statement failed with %d", rc);
+        failed = true;
+        return false;
+    }
+}
+
+/**
+ * @brief Get the Column Count object
+ *
+ * @return int
+ */
+int Cursor::getColumnCount() const
+{
+    return statement ? sqlite3_data_count(statement->getHandle()) : 0;
+}
+
+/**
+ * @brief isNull
+ *
+ * @param column
+ * @return true
+ * @return false
+ */
+bool Cursor::isNull(int column) const
+{
+    return sqlite3_column_type(statement->getHandle(), column) == SQLITE_NULL;
+}
+
+/**
+ * @brief Get the Bool object
+ *
+ * @param column
+ * @return true
+ * @return false
+ */
+bool Cursor::getBool(int column) const
+{
+    return sqlite3_column_int(statement->getHandle(), column) != 0;
+}
+
+/**
+ * @brief Get the Int32 object
+ *
+ * @param column
+ * @return std::int32_t
+ */
+std::int32_t Cursor::getInt32(int column) const
+{
+    return sqlite3_column_int(statement->getHandle(), column);
+}
+
+/**
+ * @brief Get the UInt32 object
+ *
+ * @param column
+ * @return std::uint32_t
+ */
+std::uint32_t Cursor::getUInt32(int column) const
+{
+    return static_cast<std::uint32_t>(sqlite3_column_int64(statement->getHandle(), column));
+}
+
+/**
+ * @brief Get the Int64 object
+ *
+ * @param column
+ * @return std::int64_t
+ */
+std::int64_t Cursor::getInt64(int column) const
+{
+    return sqlite3_column_int64(statement->getHandle(), column);
+}
+
+/**
+ * @brief Get the UInt64 object
+ *
+ * @param column
+ * @return std::uint64_t
+ */
+std::uint64_t Cursor::getUInt64(int column) const
+{
+    return static_cast<std::uint64_t>(sqlite3_column_int64(statement->getHandle(), column));
+}
+
+/**
+ * @brief Get the Double object
+ *
+ * @param column
+ * @return double
+ */
+double Cursor::getDouble(int column) const
+{
+    return sqlite3_column_double(statement->getHandle(), column);
+}
+
+/**
+ * @brief Get the String View object
+ *
+ * @param column
+ * @return std::string_view
+ */
+std::string_view Cursor::getStringView(int column) const
+{
+    const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(statement->getHandle(), column));
+    if(text == nullptr)
+    {
+        return {};
+    }
+    return {text, static_cast<std::size_t>(sqlite3_column_bytes(statement->getHandle(), column))};
+}
+
+/**
+ * @brief Get the String object
+ *
+ * @param column
+ * @return std::string
+ */
+std::string Cursor::getString(int column) const
+{
+    return std::string{getStringView(column)};
+}
@@ -0,0 +1,132 @@
+/**
+ * @file cursor.hpp
+ * @author Krisna Pranav
+ * @brief Cursor
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2024, pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include "statement.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief a forward-only cursor over a prepared statement. rows are read
+ *        straight from sqlite as they are stepped, nothing is copied into
+ *        Field objects. the statement goes back to its cache when the cursor
+ *        is destroyed, so a cursor must not outlive its Database;
+ *        ~Database asserts that no cursor is still open.
+ */
+class Cursor
+{
+  public:
+    /**
+     * @brief Construct a new Cursor object with no statement; next()
+     *        returns false at once.
+     *
+     */
+    Cursor() = default;
+
+    /**
+     * @brief Construct a new Cursor object
+     *
+     * @param cache
+     * @param statement
+     */
+    Cursor(StatementCache* cache, std::unique_ptr<Statement> statement);
+
+    /**
+     * @brief Destroy the Cursor object
+     *
+     */
+    ~Cursor();
+
+    Cursor(Cursor&& other) noexcept;
+    Cursor& operator=(Cursor&& other) noexcept;
+
+    Cursor(const Cursor&) = delete;
+    Cursor& operator=(const Cursor&) = delete;
+
+    /**
+     * @brief isValid
+     *
+     * @return true
+     * @return false
+     */
+    [[nodiscard]] bool isValid() const noexcept
+    {
+        return statement != nullptr;
+    }
+
+    /**
+     * @brief next, steps to the next row
+     *
+     * @return true if there is a row to read
+     * @return false at the end of the result or on an error
+     */
+    bool next();
+
+    /**
+     * @brief hasFailed, whether next() stopped because of an error
+     *
+     * @return true
+     * @return false
+     */
+    [[nodiscard]] bool hasFailed() const noexcept
+    {
+        return failed;
+    }
+
+    /**
+     * @brief Get the Column Count object
+     *
+     * @return int
+     */
+    [[nodiscard]] int getColumnCount() const;
+
+    /**
+     * @brief isNull
+     *
+     * @param column
+     * @return true
+     * @return false
+     */
+    [[nodiscard]] bool isNull(int column) const;
+
+    [[nodiscard]] bool getBool(int column) const;
+    [[nodiscard]] std::int32_t getInt32(int column) const;
+    [[nodiscard]] std::uint32_t getUInt32(int column) const;
+    [[nodiscard]] std::int64_t getInt64(int column) const;
+    [[nodiscard]] std::uint64_t getUInt64(int column) const;
+    [[nodiscard]] double getDouble(int column) const;
+
+    /**
+     * @brief Get the String View object, valid until the next call to next()
+     *
+     * @param column
+     * @return std::string_view
+     */
+    [[nodiscard]] std::string_view getStringView(int column) const;
+
+    /**
+     * @brief Get the String object
+     *
+     * @param column
+     * @return std::string
+     */
+    [[nodiscard]] std::string getString(int column) const;
+
+  private:
+    void release();
+
+    StatementCache* cache = nullptr;
+    std::unique_ptr<Statement> statement;
+    bool failed = false;
+};
@@ -10,6 +10,7 @@
  */
 
 #include "database.hpp"
+#include <cassert>
 #include <cstring>
 #include <gsl/util>
 #include <log/log.hpp>
@@ -92,6 +93,7 @@ Database::Database(const char* name, bool readOnly)
         throw DatabaseInitialisationError{"Failed to initialize the sqlite db"};
     }
     sqlite3_extended_result_codes(dbConnection, enabled);
+    statementCache = std::make_unique<StatementCache>(dbConnection);
     initQueryStatementBuffer();
     pragmaQuery("PRAGMA integrity_check;");
     pragmaQuery("PRAGMA locking_mode=EXCLUSIVE");
@@ -145,7 +147,10 @@ void Database::clearQueryStatementBuffer()
  */
 Database::~Database()
 {
+    // a live Cursor still owns a statement on this connection and points at statementCache
+    assert(statementCache == nullptr || statementCache->getOutstanding() == 0);
     sqlite3_free(queryStatementBuffer);
+    statementCache.reset();
     sqlite3_close(dbConnection);
 }
 
@@ -209,6 +214,45 @@ bool Database::execute(const char* format, ...)
     return true;
 }
 
+/**
+ * @brief reportBindFailure
+ *
+ * @param statement
+ */
+void Database::reportBindFailure(const Statement& statement)
+{
+    LOG_ERROR("Binding arguments failed, errcode: %d, extended errcode: %d, parameters: %d",
+              sqlite3_errcode(dbConnection),
+              sqlite3_extended_errcode(dbConnection),
+              sqlite3_bind_parameter_count(statement.getHandle()));
+}
+
+/**
+ * @brief runToCompletion
+ *
+ * @param statement
+ * @return true
+ * @return false
+ */
+bool Database::runToCompletion(std::unique_ptr<Statement> statement)
+{
+    int result = SQLITE_ROW;
+    while(result == SQLITE_ROW)
+    {
+        result = statement->step();
+    }
+
+    if(result != SQLITE_DONE)
+    {
+        LOG_ERROR("Execution of prepared statement failed with %d, extended errcode: %d",
+                  result,
+                  sqlite3_extended_errcode(dbConnection));
+    }
+
+    statementCache->release(std::move(statement));
+    return result == SQLITE_DONE;
+}
+
 /**
  * @brief query
  *
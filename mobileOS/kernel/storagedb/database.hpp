@@ -11,11 +11,14 @@
 
 #pragma once
 
+#include "cursor.hpp"
 #include "queryresult.hpp"
 #include "sqlite3.h"
+#include "statement.hpp"
 #include <filesystem>
 #include <memory>
 #include <stdexcept>
+#include <string_view>
 
 class DatabaseInitialisationError : public std::runtime_error
 {
@@ -51,6 +54,53 @@ class Database
      */
     bool execute(const char* format, ...);
 
+    /**
+     * @brief queryPrepared, runs sql with args bound to its ? parameters.
+     *        the compiled statement comes from the connection's statement
+     *        cache, and rows are read lazily through the cursor.
+     *
+     * @tparam Args
+     * @param sql
+     * @param args
+     * @return Cursor an invalid cursor if sql does not compile or an
+     *         argument cannot be bound
+     */
+    template <typename... Args> Cursor queryPrepared(std::string_view sql, const Args&... args)
+    {
+        auto statement = prepareWithArguments(sql, args...);
+        if(!statement)
+        {
+            return Cursor{};
+        }
+        return Cursor{statementCache.get(), std::move(statement)};
+    }
+
+    /**
+     * @brief executePrepared, like queryPrepared() but steps the statement
+     *        to completion and discards any rows
+     *
+     * @tparam Args
+     * @param sql
+     * @param args
+     * @return true
+     * @return false
+     */
+    template <typename... Args> bool executePrepared(std::string_view sql, const Args&... args)
+    {
+        auto statement = prepareWithArguments(sql, args...);
+        return statement && runToCompletion(std::move(statement));
+    }
+
+    /**
+     * @brief Get the Statement Cache Statistics object
+     *
+     * @return const StatementCache::Statistics&
+     */
+    [[nodiscard]] const StatementCache::Statistics& getStatementCacheStatistics() const noexcept
+    {
+        return statementCache->getStatistics();
+    }
+
     /**
      * @brief initialize
      *
@@ -133,6 +183,42 @@ class Database
 
     void populateDbAppId();
 
+    /**
+     * @brief prepareWithArguments
+     *
+     * @tparam Args
+     * @param sql
+     * @param args
+     * @return std::unique_ptr<Statement>
+     */
+    template <typename... Args> std::unique_ptr<Statement> prepareWithArguments(std::string_view sql, const Args&... args)
+    {
+        auto statement = statementCache->acquire(sql);
+        if(statement && !statement->bindAll(args...))
+        {
+            reportBindFailure(*statement);
+            statementCache->release(std::move(statement));
+            return nullptr;
+        }
+        return statement;
+    }
+
+    /**
+     * @brief reportBindFailure
+     *
+     * @param statement
+     */
+    void reportBindFailure(const Statement& statement);
+
+    /**
+     * @brief runToCompletion
+     *
+     * @param statement
+     * @return true
+     * @return false
+     */
+    bool runToCompletion(std::unique_ptr<Statement> statement);
+
     /**
      * @brief queryCallback
      *
@@ -148,5 +234,6 @@ class Database
     sqlite3* dbConnection;
     std::string dbName;
     char* queryStatementBuffer;
+    std::unique_ptr<StatementCache> statementCache;
     bool isInitialized_;
 };
\ No newline at end of file
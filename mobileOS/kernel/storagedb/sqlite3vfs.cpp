@@ -7,9 +7,15 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <errno.h>
+#include <algorithm>
+#include <atomic>
+#include <list>
 #include <memory>
 #include <cstring>
 #include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "free_rtos.h"
 #include "task.h"
 #include "config.h"
@@ -20,10 +26,193 @@
 #define SQLITE_ECOPHONEVFS_BUFFERSZ 8192
 #endif
 
+#ifndef SQLITE_ECOPHONEVFS_PAGESZ
+#define SQLITE_ECOPHONEVFS_PAGESZ 4096
+#endif
+
+#ifndef SQLITE_ECOPHONEVFS_CACHEPAGES
+#define SQLITE_ECOPHONEVFS_CACHEPAGES 64
+#endif
+
+#ifndef SQLITE_ECOPHONEVFS_READAHEAD
+#define SQLITE_ECOPHONEVFS_READAHEAD 16
+#endif
+
 #define MAXPATHNAME 512
 
 #define UNUSED(x) ((void)(x))
 
+/**
+ * @brief an LRU cache of fixed-size pages of one file. a page holds the
+ *        first `valid` bytes of the file from index * PAGESZ on; pages
+ *        pinned by xFetch are never evicted.
+ */
+class EcophonePageCache {
+  public:
+    struct Page {
+        sqlite3_int64 index;
+        int valid;
+        int pins;
+        std::unique_ptr<char[]> data;
+    };
+
+    /**
+     * @param capacity 
+     */
+    explicit EcophonePageCache(std::size_t capacity) : capacity(capacity) {
+    }
+
+    /**
+     * @brief looks a page up and makes it the most recently used
+     * 
+     * @param index 
+     * @return Page* 
+     */
+    Page *find(sqlite3_int64 index) {
+        auto it = pages.find(index);
+        if (it == pages.end())
+            return nullptr;
+        lru.splice(lru.begin(), lru, it->second);
+        return &*it->second;
+    }
+
+    /**
+     * @param index 
+     * @return Page* 
+     */
+    Page *peek(sqlite3_int64 index) {
+        auto it = pages.find(index);
+        return it == pages.end() ? nullptr : &*it->second;
+    }
+
+    /**
+     * @brief adds an empty page, reusing the least recently used unpinned
+     *        one when the cache is full
+     * 
+     * @param index 
+     * @return Page* nullptr if every page is pinned
+     */
+    Page *insert(sqlite3_int64 index) {
+        if (lru.size() >= capacity) {
+            auto victim = std::find_if(lru.rbegin(), lru.rend(), [](const Page &page) { return page.pins == 0; });
+            if (victim == lru.rend())
+                return nullptr;
+            pages.erase(victim->index);
+            lru.splice(lru.begin(), lru, std::next(victim).base());
+            lru.front().index = index;
+            lru.front().valid = 0;
+        }
+        else {
+            lru.push_front(Page{index, 0, 0, std::make_unique<char[]>(SQLITE_ECOPHONEVFS_PAGESZ)});
+        }
+        pages[index] = lru.begin();
+        return &lru.front();
+    }
+
+    /**
+     * @param index 
+     */
+    void erase(sqlite3_int64 index) {
+        auto it = pages.find(index);
+        if (it == pages.end() || it->second->pins)
+            return;
+        lru.erase(it->second);
+        pages.erase(it);
+    }
+
+    /**
+     * @brief copies a write that went to the file into the cached pages it
+     *        overlaps. a page the write does not reach contiguously from its
+     *        valid bytes is dropped instead, as the gap is unknown.
+     * 
+     * @param data 
+     * @param amount 
+     * @param offset 
+     */
+    void update(const char *data, int amount, sqlite3_int64 offset) {
+        while (amount > 0) {
+            const auto index  = offset / SQLITE_ECOPHONEVFS_PAGESZ;
+            const int inPage  = offset % SQLITE_ECOPHONEVFS_PAGESZ;
+            const int chunk   = std::min(amount, SQLITE_ECOPHONEVFS_PAGESZ - inPage);
+
+            if (auto *page = peek(index)) {
+                if (inPage > page->valid) {
+                    erase(index);
+                }
+                else {
+                    memcpy(page->data.get() + inPage, data, chunk);
+                    page->valid = std::max(page->valid, inPage + chunk);
+                }
+            }
+
+            data += chunk;
+            offset += chunk;
+            amount -= chunk;
+        }
+    }
+
+  private:
+    std::size_t capacity;
+    std::list<Page> lru;
+    std::unordered_map<sqlite3_int64, std::list<Page>::iterator> pages;
+};
+
+/**
+ * @brief what every connection to one path shares: the page cache, the
+ *        database file locks and, in WAL mode, the shared-memory regions and
+ *        their locks. sqlite is built with SQLITE_THREADSAFE=0, so this is
+ *        only touched from one task at a time and needs no lock of its own.
+ */
+struct EcophoneSharedFile {
+    std::string path;
+    int refs = 0;
+    EcophonePageCache cache{SQLITE_ECOPHONEVFS_CACHEPAGES};
+
+    int sharedLocks         = 0;       /* connections holding SHARED or more */
+    const void *reserved    = nullptr; /* the connection holding RESERVED */
+    const void *pending     = nullptr; /* the connection holding PENDING */
+    const void *exclusive   = nullptr; /* the connection holding EXCLUSIVE */
+
+    std::vector<std::unique_ptr<char[]>> shmRegions;
+    int shmRegionSize = 0;
+    int shmRefs       = 0;
+    int shmShared[SQLITE_SHM_NLOCK]          = {};
+    const void *shmExclusive[SQLITE_SHM_NLOCK] = {};
+};
+
+/**
+ * @return std::list<EcophoneSharedFile>& 
+ */
+static std::list<EcophoneSharedFile> &ecophoneSharedFiles() {
+    static std::list<EcophoneSharedFile> sharedFiles;
+    return sharedFiles;
+}
+
+/**
+ * @param path 
+ * @return EcophoneSharedFile* 
+ */
+static EcophoneSharedFile *ecophoneAcquireSharedFile(const char *path) {
+    auto &sharedFiles = ecophoneSharedFiles();
+    auto it = std::find_if(sharedFiles.begin(), sharedFiles.end(), [&](const EcophoneSharedFile &file) { return file.path == path; });
+    if (it == sharedFiles.end()) {
+        sharedFiles.emplace_front();
+        it       = sharedFiles.begin();
+        it->path = path;
+    }
+    ++it->refs;
+    return &*it;
+}
+
+/**
+ * @param shared 
+ */
+static void ecophoneReleaseSharedFile(EcophoneSharedFile *shared) {
+    if (shared == nullptr || --shared->refs > 0)
+        return;
+    ecophoneSharedFiles().remove_if([&](const EcophoneSharedFile &file) { return &file == shared; });
+}
+
 typedef struct EcophoneFile EcophoneFile;
 struct EcophoneFile {
     sqlite3_file base; 
@@ -35,6 +224,15 @@ struct EcophoneFile {
     sqlite3_int64 iBufferOfst; 
     long _pos  = -1;
 
+    EcophoneSharedFile *shared;         /* main database and WAL only */
+    int lockLevel;                      /* SQLITE_LOCK_*, held on shared */
+    sqlite3_int64 mmapSize;             /* xFetch limit, from SQLITE_FCNTL_MMAP_SIZE */
+    sqlite3_int64 nextSequentialOfst;
+    int readAheadPages;
+    int shmMapped;
+    int shmSharedMask;
+    int shmExclusiveMask;
+
     /**
      * @return std::size_t 
      */
@@ -199,6 +397,117 @@ static int ecophoneFlushBuffer(EcophoneFile *p) {
     return rc;
 }
 
+/**
+ * @brief reads up to count pages from first on into the cache with one seek,
+ *        stopping early at end of file or at a page that is already cached
+ * 
+ * @param p 
+ * @param first 
+ * @param count 
+ * @return int 
+ */
+static int ecophoneLoadPages(EcophoneFile *p, sqlite3_int64 first, int count) {
+    auto &cache = p->shared->cache;
+
+    /* another connection may have written through its own handle; make
+       seek() really seek so that stale stdio buffers are dropped */
+    p->_pos = -1;
+    if (p->seek(first * SQLITE_ECOPHONEVFS_PAGESZ, SEEK_SET) != 0) {
+        return SQLITE_IOERR_READ;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (i > 0 && cache.peek(first + i)) {
+            break;
+        }
+
+        auto *page = cache.insert(first + i);
+        if (page == nullptr) {
+            break;
+        }
+
+        const auto nRead = p->read(page->data.get(), SQLITE_ECOPHONEVFS_PAGESZ);
+        if (nRead < 0) {
+            cache.erase(first + i);
+            return SQLITE_IOERR_READ;
+        }
+
+        page->valid = nRead;
+        if (nRead < SQLITE_ECOPHONEVFS_PAGESZ) {
+            break;
+        }
+    }
+    return SQLITE_OK;
+}
+
+/**
+ * @brief reads through the page cache. a read that starts where the last one
+ *        ended doubles the read-ahead window, anything else resets it.
+ * 
+ * @param p 
+ * @param zBuf 
+ * @param iAmt 
+ * @param iOfst 
+ * @return int 
+ */
+static int ecophoneCachedRead(EcophoneFile *p, void *zBuf, int iAmt, sqlite_int64 iOfst) {
+    static constexpr int maxReadAhead = std::min(SQLITE_ECOPHONEVFS_READAHEAD, SQLITE_ECOPHONEVFS_CACHEPAGES / 4);
+
+    if (iOfst == p->nextSequentialOfst) {
+        p->readAheadPages = std::min(std::max(p->readAheadPages * 2, 1), maxReadAhead);
+    }
+    else {
+        p->readAheadPages = 0;
+    }
+    p->nextSequentialOfst = iOfst + iAmt;
+
+    auto &cache = p->shared->cache;
+    char *out   = (char *)zBuf;
+
+    while (iAmt > 0) {
+        const auto index = iOfst / SQLITE_ECOPHONEVFS_PAGESZ;
+        const int inPage = iOfst % SQLITE_ECOPHONEVFS_PAGESZ;
+        const int chunk  = std::min(iAmt, SQLITE_ECOPHONEVFS_PAGESZ - inPage);
+
+        auto *page = cache.find(index);
+        if (page == nullptr) {
+            if (const auto rc = ecophoneLoadPages(p, index, 1 + p->readAheadPages); rc != SQLITE_OK) {
+                return rc;
+            }
+            page = cache.find(index);
+        }
+
+        /* every page is pinned by xFetch; read the rest past the cache */
+        if (page == nullptr) {
+            p->seekOrEnd(iOfst);
+            const auto nRead = p->read(out, iAmt);
+            if (nRead < 0) {
+                return SQLITE_IOERR_READ;
+            }
+            if (nRead < iAmt) {
+                memset(out + nRead, 0, iAmt - nRead);
+                return SQLITE_IOERR_SHORT_READ;
+            }
+            return SQLITE_OK;
+        }
+
+        const int available = std::max(0, std::min(chunk, page->valid - inPage));
+        memcpy(out, page->data.get() + inPage, available);
+        if (available < chunk) {
+            memset(out + available, 0, iAmt - available);
+            return SQLITE_IOERR_SHORT_READ;
+        }
+
+        out += chunk;
+        iOfst += chunk;
+        iAmt -= chunk;
+    }
+    return SQLITE_OK;
+}
+
+static int ecophoneShmUnmap(sqlite3_file *pFile, int deleteFlag);
+static int ecophoneUnlock(sqlite3_file *pFile, int eLock);
+
 /**
  * @param pFile 
  * @return int 
@@ -210,6 +519,11 @@ static int ecophoneClose(sqlite3_file *pFile) {
     sqlite3_free(p->aBuffer);
     p->streamBuffer.reset();
 
+    ecophoneShmUnmap(pFile, 0);
+    ecophoneUnlock(pFile, SQLITE_LOCK_NONE);
+    ecophoneReleaseSharedFile(p->shared);
+    p->shared = nullptr;
+
     std::fclose(p->fd);
     return rc;
 }
@@ -230,6 +544,11 @@ static int ecophoneRead(sqlite3_file *pFile, void *zBuf, int iAmt, sqlite_int64
     if (rc != SQLITE_OK) {
         return rc;
     }
+
+    if (p->shared) {
+        return ecophoneCachedRead(p, zBuf, iAmt, iOfst);
+    }
+
     p->seekOrEnd(iOfst);
 
     nRead = p->read(zBuf, iAmt);
@@ -238,12 +557,14 @@ static int ecophoneRead(sqlite3_file *pFile, void *zBuf, int iAmt, sqlite_int64
         return SQLITE_OK;
     }
     else if (nRead >= 0) {
+        memset((char *)zBuf + nRead, 0, iAmt - nRead);
         return SQLITE_IOERR_SHORT_READ;
     }
 
     return SQLITE_IOERR_READ;
 }
 
+
 /**
  * @param pFile 
  * @param zBuf 
@@ -282,7 +603,11 @@ static int ecophoneWrite(sqlite3_file *pFile, const void *zBuf, int iAmt, sqlite
         }
     }
     else {
-        return ecophoneDirectWrite(p, zBuf, iAmt, iOfst);
+        const auto rc = ecophoneDirectWrite(p, zBuf, iAmt, iOfst);
+        if (rc == SQLITE_OK && p->shared) {
+            p->shared->cache.update((const char *)zBuf, iAmt, iOfst);
+        }
+        return rc;
     }
 
     return SQLITE_OK;
@@ -345,13 +670,54 @@ static int ecophoneFileSize(sqlite3_file *pFile, sqlite_int64 *pSize) {
 }
 
 /**
+ * @brief the locks of every connection to a path are kept on its shared
+ *        file, following the unix VFS: any number of SHARED holders, one
+ *        RESERVED, and EXCLUSIVE only once every other SHARED is gone. a
+ *        failed EXCLUSIVE keeps PENDING so no new reader gets in meanwhile.
+ *        without this a closing WAL connection would checkpoint and delete
+ *        the -wal while another connection is still appending to it.
+ *
  * @param pFile 
  * @param eLock 
  * @return int 
  */
 static int ecophoneLock(sqlite3_file *pFile, int eLock) {
-    UNUSED(pFile);
-    UNUSED(eLock);
+    EcophoneFile *p = (EcophoneFile *)pFile;
+    if (p->shared == nullptr || p->lockLevel >= eLock) {
+        return SQLITE_OK;
+    }
+    auto &shared = *p->shared;
+
+    if (eLock == SQLITE_LOCK_SHARED) {
+        if ((shared.pending != nullptr && shared.pending != p) || (shared.exclusive != nullptr && shared.exclusive != p)) {
+            return SQLITE_BUSY;
+        }
+        ++shared.sharedLocks;
+        p->lockLevel = SQLITE_LOCK_SHARED;
+        return SQLITE_OK;
+    }
+
+    assert(p->lockLevel >= SQLITE_LOCK_SHARED);
+    if (eLock == SQLITE_LOCK_RESERVED) {
+        if (shared.reserved != nullptr && shared.reserved != p) {
+            return SQLITE_BUSY;
+        }
+        shared.reserved = p;
+        p->lockLevel    = SQLITE_LOCK_RESERVED;
+        return SQLITE_OK;
+    }
+
+    assert(eLock == SQLITE_LOCK_EXCLUSIVE);
+    if (shared.pending != nullptr && shared.pending != p) {
+        return SQLITE_BUSY;
+    }
+    shared.pending = p;
+    p->lockLevel   = SQLITE_LOCK_PENDING;
+    if (shared.sharedLocks > 1) {
+        return SQLITE_BUSY;
+    }
+    shared.exclusive = p;
+    p->lockLevel     = SQLITE_LOCK_EXCLUSIVE;
     return SQLITE_OK;
 }
 
@@ -361,8 +727,25 @@ static int ecophoneLock(sqlite3_file *pFile, int eLock) {
  * @return int 
  */
 static int ecophoneUnlock(sqlite3_file *pFile, int eLock) {
-    UNUSED(pFile);
-    UNUSED(eLock);
+    EcophoneFile *p = (EcophoneFile *)pFile;
+    if (p->shared == nullptr || p->lockLevel <= eLock) {
+        return SQLITE_OK;
+    }
+    auto &shared = *p->shared;
+
+    if (shared.exclusive == p) {
+        shared.exclusive = nullptr;
+    }
+    if (shared.pending == p) {
+        shared.pending = nullptr;
+    }
+    if (shared.reserved == p) {
+        shared.reserved = nullptr;
+    }
+    if (eLock == SQLITE_LOCK_NONE) {
+        --shared.sharedLocks;
+    }
+    p->lockLevel = eLock;
     return SQLITE_OK;
 }
 
@@ -372,8 +755,12 @@ static int ecophoneUnlock(sqlite3_file *pFile, int eLock) {
  * @return int 
  */
 static int ecophoneCheckReservedLock(sqlite3_file *pFile, int *pResOut) {
-    UNUSED(pFile);
-    *pResOut = 0;
+    EcophoneFile *p = (EcophoneFile *)pFile;
+    *pResOut        = 0;
+    if (p->shared != nullptr) {
+        const auto &shared = *p->shared;
+        *pResOut = shared.reserved != nullptr || shared.pending != nullptr || shared.exclusive != nullptr;
+    }
     return SQLITE_OK;
 }
 
@@ -384,9 +771,220 @@ static int ecophoneCheckReservedLock(sqlite3_file *pFile, int *pResOut) {
  * @return int 
  */
 static int ecophoneFileControl(sqlite3_file *pFile, int op, void *pArg) {
+    EcophoneFile *p = (EcophoneFile *)pFile;
+
+    switch (op) {
+    case SQLITE_FCNTL_MMAP_SIZE: {
+        auto *size          = (sqlite3_int64 *)pArg;
+        const auto newLimit = *size;
+        *size               = p->mmapSize;
+        if (newLimit >= 0) {
+            p->mmapSize = newLimit;
+        }
+        return SQLITE_OK;
+    }
+    default:
+        return SQLITE_NOTFOUND;
+    }
+}
+
+/**
+ * @brief "maps" a page by handing out a pointer into the page cache. the page
+ *        stays pinned until xUnfetch, and writes go into it like they would
+ *        into a shared mapping. *pp stays null, and sqlite falls back to
+ *        xRead, when the range is past the mmap limit, spans two cache pages
+ *        or cannot be cached.
+ * 
+ * @param pFile 
+ * @param iOfst 
+ * @param iAmt 
+ * @param pp 
+ * @return int 
+ */
+static int ecophoneFetch(sqlite3_file *pFile, sqlite3_int64 iOfst, int iAmt, void **pp) {
+    EcophoneFile *p = (EcophoneFile *)pFile;
+    *pp             = nullptr;
+
+    if (p->shared == nullptr || iOfst + iAmt > p->mmapSize) {
+        return SQLITE_OK;
+    }
+
+    const auto index = iOfst / SQLITE_ECOPHONEVFS_PAGESZ;
+    const int inPage = iOfst % SQLITE_ECOPHONEVFS_PAGESZ;
+    if (inPage + iAmt > SQLITE_ECOPHONEVFS_PAGESZ) {
+        return SQLITE_OK;
+    }
+
+    auto *page = p->shared->cache.find(index);
+    if (page == nullptr) {
+        if (const auto rc = ecophoneLoadPages(p, index, 1); rc != SQLITE_OK) {
+            return rc;
+        }
+        page = p->shared->cache.find(index);
+    }
+
+    if (page == nullptr || page->valid < inPage + iAmt) {
+        return SQLITE_OK;
+    }
+
+    ++page->pins;
+    *pp = page->data.get() + inPage;
+    return SQLITE_OK;
+}
+
+/**
+ * @param pFile 
+ * @param iOfst 
+ * @param pPage null when sqlite asks for the whole mapping to go, which
+ *        needs nothing here as pages are unpinned one by one
+ * @return int 
+ */
+static int ecophoneUnfetch(sqlite3_file *pFile, sqlite3_int64 iOfst, void *pPage) {
+    EcophoneFile *p = (EcophoneFile *)pFile;
+
+    if (pPage == nullptr) {
+        return SQLITE_OK;
+    }
+
+    auto *page = p->shared->cache.peek(iOfst / SQLITE_ECOPHONEVFS_PAGESZ);
+    assert(page != nullptr && page->pins > 0);
+    --page->pins;
+    return SQLITE_OK;
+}
+
+/**
+ * @brief WAL-index regions live on the heap, shared by every connection to
+ *        the same database in this process
+ * 
+ * @param pFile 
+ * @param iRegion 
+ * @param szRegion 
+ * @param bExtend 
+ * @param pp 
+ * @return int 
+ */
+static int ecophoneShmMap(sqlite3_file *pFile, int iRegion, int szRegion, int bExtend, void volatile **pp) {
+    EcophoneFile *p = (EcophoneFile *)pFile;
+    *pp             = nullptr;
+
+    if (p->shared == nullptr) {
+        return SQLITE_IOERR_SHMMAP;
+    }
+
+    auto &shared = *p->shared;
+    if (!p->shmMapped) {
+        p->shmMapped = 1;
+        ++shared.shmRefs;
+    }
+
+    if (shared.shmRegionSize == 0) {
+        shared.shmRegionSize = szRegion;
+    }
+    assert(shared.shmRegionSize == szRegion);
+
+    while (iRegion >= (int)shared.shmRegions.size()) {
+        if (!bExtend) {
+            return SQLITE_OK;
+        }
+        shared.shmRegions.push_back(std::make_unique<char[]>(szRegion));
+    }
+
+    *pp = shared.shmRegions[iRegion].get();
+    return SQLITE_OK;
+}
+
+/**
+ * @brief the same rules as the unix VFS: any number of shared holders or one
+ *        exclusive holder per slot, SQLITE_BUSY on conflict
+ * 
+ * @param pFile 
+ * @param ofst 
+ * @param n 
+ * @param flags 
+ * @return int 
+ */
+static int ecophoneShmLock(sqlite3_file *pFile, int ofst, int n, int flags) {
+    EcophoneFile *p = (EcophoneFile *)pFile;
+    auto &shared    = *p->shared;
+    const int mask  = (1 << (ofst + n)) - (1 << ofst);
+
+    assert(ofst >= 0 && ofst + n <= SQLITE_SHM_NLOCK);
+
+    if (flags & SQLITE_SHM_UNLOCK) {
+        for (int i = ofst; i < ofst + n; i++) {
+            if (p->shmExclusiveMask & (1 << i)) {
+                shared.shmExclusive[i] = nullptr;
+            }
+            if (p->shmSharedMask & (1 << i)) {
+                --shared.shmShared[i];
+            }
+        }
+        p->shmExclusiveMask &= ~mask;
+        p->shmSharedMask &= ~mask;
+        return SQLITE_OK;
+    }
+
+    if (flags & SQLITE_SHM_SHARED) {
+        if ((p->shmSharedMask & mask) == mask) {
+            return SQLITE_OK;
+        }
+        for (int i = ofst; i < ofst + n; i++) {
+            if (shared.shmExclusive[i] != nullptr && shared.shmExclusive[i] != p) {
+                return SQLITE_BUSY;
+            }
+        }
+        for (int i = ofst; i < ofst + n; i++) {
+            if (!(p->shmSharedMask & (1 << i))) {
+                ++shared.shmShared[i];
+            }
+        }
+        p->shmSharedMask |= mask;
+        return SQLITE_OK;
+    }
+
+    for (int i = ofst; i < ofst + n; i++) {
+        const int ownShared = (p->shmSharedMask & (1 << i)) ? 1 : 0;
+        if ((shared.shmExclusive[i] != nullptr && shared.shmExclusive[i] != p) || shared.shmShared[i] > ownShared) {
+            return SQLITE_BUSY;
+        }
+    }
+    for (int i = ofst; i < ofst + n; i++) {
+        shared.shmExclusive[i] = p;
+    }
+    p->shmExclusiveMask |= mask;
+    return SQLITE_OK;
+}
+
+/**
+ * @param pFile 
+ */
+static void ecophoneShmBarrier(sqlite3_file *pFile) {
     UNUSED(pFile);
-    UNUSED(pArg);
-    return SQLITE_NOTFOUND;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+/**
+ * @param pFile 
+ * @param deleteFlag nothing is persisted, so there is nothing more to delete
+ * @return int 
+ */
+static int ecophoneShmUnmap(sqlite3_file *pFile, int deleteFlag) {
+    EcophoneFile *p = (EcophoneFile *)pFile;
+    UNUSED(deleteFlag);
+
+    if (!p->shmMapped) {
+        return SQLITE_OK;
+    }
+
+    ecophoneShmLock(pFile, 0, SQLITE_SHM_NLOCK, SQLITE_SHM_UNLOCK);
+    p->shmMapped = 0;
+
+    auto &shared = *p->shared;
+    if (--shared.shmRefs == 0) {
+        shared.shmRegions.clear();
+        shared.shmRegionSize = 0;
+    }
+    return SQLITE_OK;
 }
 
 /**
@@ -446,7 +1044,7 @@ static int ecophoneOpen(sqlite3_vfs *pVfs,const char *zName, sqlite3_file *pFile
     UNUSED(pVfs);
 
     static const sqlite3_io_methods ecophoneio = {
-        1,                            
+        3,                            
         ecophoneClose,                
         ecophoneRead,                 
         ecophoneWrite,                
@@ -458,7 +1056,13 @@ static int ecophoneOpen(sqlite3_vfs *pVfs,const char *zName, sqlite3_file *pFile
         ecophoneCheckReservedLock,    
         ecophoneFileControl,          
         ecophoneSectorSize,           
-        ecophoneDeviceCharacteristics 
+        ecophoneDeviceCharacteristics,
+        ecophoneShmMap,               
+        ecophoneShmLock,              
+        ecophoneShmBarrier,           
+        ecophoneShmUnmap,             
+        ecophoneFetch,                
+        ecophoneUnfetch               
     };
 
     EcophoneFile *p = (EcophoneFile *)pFile; 
@@ -507,6 +1111,11 @@ static int ecophoneOpen(sqlite3_vfs *pVfs,const char *zName, sqlite3_file *pFile
     setvbuf(p->fd, p->streamBuffer.get(), _IOFBF, streamBufferSize);
     p->aBuffer = aBuf;
 
+    if (flags & (SQLITE_OPEN_MAIN_DB | SQLITE_OPEN_WAL)) {
+        p->shared = ecophoneAcquireSharedFile(zName);
+    }
+    p->nextSequentialOfst = -1;
+
     if (pOutFlags) {
         *pOutFlags = flags;
     }
@@ -0,0 +1,288 @@
+/**
+ * @file statement.cpp
+ * @author Krisna Pranav
+ * @brief Statement
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2024, pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include "statement.hpp"
+#include <log/log.hpp>
+
+/**
+ * @brief Construct a new Statement:: Statement object
+ *
+ * @param connection
+ * @param sql
+ * @param persistent
+ */
+Statement::Statement(sqlite3* connection, std::string_view sql, bool persistent)
+    : stmt(nullptr), sql(sql)
+{
+    const unsigned int flags = persistent ? SQLITE_PREPARE_PERSISTENT : 0;
+    if(const auto rc = sqlite3_prepare_v3(connection, this->sql.data(), this->sql.size(), flags, &stmt, nullptr);
+       rc != SQLITE_OK)
+    {
+        LOG_ERROR("Preparing statement failed with %d, extended errcode: %d",
+                  rc,
+                  sqlite3_extended_errcode(connection));
+        sqlite3_finalize(stmt);
+        stmt = nullptr;
+    }
+}
+
+/**
+ * @brief Destroy the Statement:: Statement object
+ *
+ */
+Statement::~Statement()
+{
+    sqlite3_finalize(stmt);
+}
+
+/**
+ * @brief bind
+ *
+ * @param index
+ * @return true
+ * @return false
+ */
+bool Statement::bind(int index, std::nullptr_t)
+{
+    return sqlite3_bind_null(stmt, index) == SQLITE_OK;
+}
+
+/**
+ * @brief bind
+ *
+ * @param index
+ * @param value
+ * @return true
+ * @return false
+ */
+bool Statement::bind(int index, bool value)
+{
+    return sqlite3_bind_int(stmt, index, value ? 1 : 0) == SQLITE_OK;
+}
+
+/**
+ * @brief bind
+ *
+ * @param index
+ * @param value
+ * @return true
+ * @return false
+ */
+bool Statement::bind(int index, std::int32_t value)
+{
+    return sqlite3_bind_int(stmt, index, value) == SQLITE_OK;
+}
+
+/**
+ * @brief bind
+ *
+ * @param index
+ * @param value
+ * @return true
+ * @return false
+ */
+bool Statement::bind(int index, std::uint32_t value)
+{
+    return sqlite3_bind_int64(stmt, index, value) == SQLITE_OK;
+}
+
+/**
+ * @brief bind
+ *
+ * @param index
+ * @param value
+ * @return true
+ * @return false
+ */
+bool Statement::bind(int index, std::int64_t value)
+{
+    return sqlite3_bind_int64(stmt, index, value) == SQLITE_OK;
+}
+
+/**
+ * @brief bind, stored with the same bits as a signed 64-bit integer
+ *
+ * @param index
+ * @param value
+ * @return true
+ * @return false
+ */
+bool Statement::bind(int index, std::uint64_t value)
+{
+    return sqlite3_bind_int64(stmt, index, static_cast<sqlite3_int64>(value)) == SQLITE_OK;
+}
+
+/**
+ * @brief bind
+ *
+ * @param index
+ * @param value
+ * @return true
+ * @return false
+ */
+bool Statement::bind(int index, double value)
+{
+    return sqlite3_bind_double(stmt, index, value) == SQLITE_OK;
+}
+
+/**
+ * @brief bind, nullptr binds NULL
+ *
+ * @param index
+ * @param value
+ * @return true
+ * @return false
+ */
+bool Statement::bind(int index, const char* value)
+{
+    if(value == nullptr)
+    {
+        return bind(index, nullptr);
+    }
+    return sqlite3_bind_text(stmt, index, value, -1, SQLITE_TRANSIENT) == SQLITE_OK;
+}
+
+/**
+ * @brief bind, the text is copied, so value need not outlive the cursor
+ *
+ * @param index
+ * @param value
+ * @return true
+ * @return false
+ */
+bool Statement::bind(int index, std::string_view value)
+{
+    return sqlite3_bind_text(stmt, index, value.data(), value.size(), SQLITE_TRANSIENT) == SQLITE_OK;
+}
+
+/**
+ * @brief bind
+ *
+ * @param index
+ * @param value
+ * @return true
+ * @return false
+ */
+bool Statement::bind(int index, const std::string& value)
+{
+    return bind(index, std::string_view{value});
+}
+
+/**
+ * @brief step
+ *
+ * @return int
+ */
+int Statement::step()
+{
+    return sqlite3_step(stmt);
+}
+
+/**
+ * @brief reset
+ *
+ */
+void Statement::reset()
+{
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+}
+
+/**
+ * @brief Construct a new Statement Cache:: Statement Cache object
+ *
+ * @param connection
+ * @param capacity
+ */
+StatementCache::StatementCache(sqlite3* connection, std::size_t capacity)
+    : connection(connection), capacity(capacity)
+{
+}
+
+/**
+ * @brief Destroy the Statement Cache:: Statement Cache object
+ *
+ */
+StatementCache::~StatementCache()
+{
+    clear();
+}
+
+/**
+ * @brief acquire
+ *
+ * @param sql
+ * @return std::unique_ptr<Statement>
+ */
+std::unique_ptr<Statement> StatementCache::acquire(std::string_view sql)
+{
+    if(const auto it = index.find(sql); it != index.end())
+    {
+        auto lruIt = it->second;
+        auto statement = std::move(*lruIt);
+        index.erase(it);
+        lru.erase(lruIt);
+        ++statistics.hits;
+        ++outstanding;
+        return statement;
+    }
+
+    ++statistics.misses;
+    auto statement = std::make_unique<Statement>(connection, sql, true);
+    if(!statement->isValid())
+    {
+        return nullptr;
+    }
+    ++outstanding;
+    return statement;
+}
+
+/**
+ * @brief release
+ *
+ * @param statement
+ */
+void StatementCache::release(std::unique_ptr<Statement> statement)
+{
+    if(!statement)
+    {
+        return;
+    }
+
+    --outstanding;
+    statement->reset();
+
+    // a second copy compiled while this one was out; keep the cached one
+    if(index.find(statement->getSql()) != index.end() || capacity == 0)
+    {
+        return;
+    }
+
+    lru.push_front(std::move(statement));
+    index.emplace(lru.front()->getSql(), lru.begin());
+
+    if(lru.size() > capacity)
+    {
+        index.erase(lru.back()->getSql());
+        lru.pop_back();
+        ++statistics.evictions;
+    }
+}
+
+/**
+ * @brief clear
+ *
+ */
+void StatementCache::clear()
+{
+    index.clear();
+    lru.clear();
+}
@@ -0,0 +1,227 @@
+/**
+ * @file statement.hpp
+ * @author Krisna Pranav
+ * @brief Statement
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2024, pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include "sqlite3.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class Statement
+{
+  public:
+    /**
+     * @brief Construct a new Statement object. isValid() is false if the
+     *        SQL does not compile.
+     *
+     * @param connection
+     * @param sql
+     * @param persistent hint to sqlite that the statement will be reused
+     */
+    Statement(sqlite3* connection, std::string_view sql, bool persistent);
+
+    /**
+     * @brief Destroy the Statement object
+     *
+     */
+    ~Statement();
+
+    Statement(const Statement&) = delete;
+    Statement& operator=(const Statement&) = delete;
+
+    /**
+     * @brief isValid
+     *
+     * @return true
+     * @return false
+     */
+    [[nodiscard]] bool isValid() const noexcept
+    {
+        return stmt != nullptr;
+    }
+
+    /**
+     * @brief bind, parameter indices start at 1
+     *
+     * @param index
+     * @param value
+     * @return true
+     * @return false
+     */
+    bool bind(int index, std::nullptr_t value);
+    bool bind(int index, bool value);
+    bool bind(int index, std::int32_t value);
+    bool bind(int index, std::uint32_t value);
+    bool bind(int index, std::int64_t value);
+    bool bind(int index, std::uint64_t value);
+    bool bind(int index, double value);
+    bool bind(int index, const char* value);
+    bool bind(int index, std::string_view value);
+    bool bind(int index, const std::string& value);
+
+    /**
+     * @brief bindAll, binds args to parameters 1..N in order
+     *
+     * @tparam Args
+     * @param args
+     * @return true
+     * @return false
+     */
+    template <typename... Args> bool bindAll(const Args&... args)
+    {
+        int index = 1;
+        return (bind(index++, args) && ...);
+    }
+
+    /**
+     * @brief step
+     *
+     * @return int SQLITE_ROW, SQLITE_DONE or an error code
+     */
+    int step();
+
+    /**
+     * @brief reset, rewinds the statement and clears its bindings
+     *
+     */
+    void reset();
+
+    /**
+     * @brief Get the Handle object
+     *
+     * @return sqlite3_stmt*
+     */
+    [[nodiscard]] sqlite3_stmt* getHandle() const noexcept
+    {
+        return stmt;
+    }
+
+    /**
+     * @brief Get the Sql object
+     *
+     * @return const std::string&
+     */
+    [[nodiscard]] const std::string& getSql() const noexcept
+    {
+        return sql;
+    }
+
+  private:
+    sqlite3_stmt* stmt;
+    std::string sql;
+};
+
+class StatementCache
+{
+  public:
+    /**
+     * @brief defaultCapacity
+     *
+     */
+    static constexpr std::size_t defaultCapacity = 32;
+
+    struct Statistics
+    {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t evictions = 0;
+    };
+
+    /**
+     * @brief Construct a new Statement Cache object
+     *
+     * @param connection
+     * @param capacity
+     */
+    explicit StatementCache(sqlite3* connection, std::size_t capacity = defaultCapacity);
+
+    /**
+     * @brief Destroy the Statement Cache object, finalizes every cached
+     *        statement. it must go before the connection is closed.
+     *
+     */
+    ~StatementCache();
+
+    StatementCache(const StatementCache&) = delete;
+    StatementCache& operator=(const StatementCache&) = delete;
+
+    /**
+     * @brief acquire, takes the compiled statement for sql out of the cache,
+     *        or compiles a new one. while a statement is out, a second
+     *        acquire of the same sql compiles another, so nested cursors
+     *        over the same query work.
+     *
+     * @param sql
+     * @return std::unique_ptr<Statement> nullptr if sql does not compile
+     */
+    std::unique_ptr<Statement> acquire(std::string_view sql);
+
+    /**
+     * @brief release, resets the statement and puts it back as the most
+     *        recently used, finalizing the least recently used one if the
+     *        cache is over capacity.
+     *
+     * @param statement
+     */
+    void release(std::unique_ptr<Statement> statement);
+
+    /**
+     * @brief clear
+     *
+     */
+    void clear();
+
+    /**
+     * @brief Get the Size object
+     *
+     * @return std::size_t
+     */
+    [[nodiscard]] std::size_t getSize() const noexcept
+    {
+        return lru.size();
+    }
+
+    /**
+     * @brief Get the Outstanding object, the number of statements handed out
+     *        by acquire() and not yet released
+     *
+     * @return std::size_t
+     */
+    [[nodiscard]] std::size_t getOutstanding() const noexcept
+    {
+        return outstanding;
+    }
+
+    /**
+     * @brief Get the Statistics object
+     *
+     * @return const Statistics&
+     */
+    [[nodiscard]] const Statistics& getStatistics() const noexcept
+    {
+        return statistics;
+    }
+
+  private:
+    using LruList = std::list<std::unique_ptr<Statement>>;
+
+    sqlite3* connection;
+    std::size_t capacity;
+    LruList lru;
+    std::unordered_map<std::string_view, LruList::iterator> index;
+    Statistics statistics;
+    std::size_t outstanding = 0;
+};
@@ -0,0 +1,185 @@
+/**
+ * @file benchmarkvfs.cpp
+ * @author Krisna Pranav
+ * @brief host benchmark for the ecophone VFS: a mixed read/write workload on
+ *        a file-backed database through two connections. built against the
+ *        system sqlite3 with small stand-ins for free_rtos.h, task.h,
+ *        config.h and utils.hpp:
+ *
+ *        g++ -std=c++17 -O2 -Ishim -o benchmarkvfs benchmarkvfs.cpp ../sqlite3vfs.cpp -lsqlite3
+ *        ./benchmarkvfs delete /tmp/bench.db
+ *        ./benchmarkvfs wal /tmp/bench.db
+ *
+ *        the check and total values must match between modes and between VFS
+ *        revisions; only the time may differ.
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2024, pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <sqlite3.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+extern sqlite3_vfs* sqlite3_ecophonevfs(void);
+
+static constexpr int rows       = 20000;
+static constexpr int rounds     = 200;
+static constexpr int updates    = 10;
+static constexpr int pointReads = 200;
+static constexpr int scanEvery  = 20;
+
+/**
+ * @param db
+ * @param sql
+ */
+static void execute(sqlite3* db, const char* sql)
+{
+    char* err = nullptr;
+    if (sqlite3_exec(db, sql, nullptr, nullptr, &err) != SQLITE_OK) {
+        std::fprintf(stderr, "%s: %s\n", sql, err);
+        std::exit(1);
+    }
+}
+
+/**
+ * @param db
+ * @param sql
+ * @return sqlite3_stmt*
+ */
+static sqlite3_stmt* prepare(sqlite3* db, const char* sql)
+{
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        std::fprintf(stderr, "%s: %s\n", sql, sqlite3_errmsg(db));
+        std::exit(1);
+    }
+    return stmt;
+}
+
+/**
+ * @param seed
+ * @return int, a row id in [1, rows]
+ */
+static int nextRow(unsigned& seed)
+{
+    seed = seed * 1103515245 + 12345;
+    return 1 + (seed >> 8) % rows;
+}
+
+/**
+ * @param db
+ * @return true
+ * @return false
+ */
+static bool integrityOk(sqlite3* db)
+{
+    auto stmt = prepare(db, "PRAGMA integrity_check");
+    bool ok   = sqlite3_step(stmt) == SQLITE_ROW &&
+              std::strcmp(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)), "ok") == 0;
+    sqlite3_finalize(stmt);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || (std::strcmp(argv[1], "wal") != 0 && std::strcmp(argv[1], "delete") != 0)) {
+        std::fprintf(stderr, "usage: %s wal|delete [database path]\n", argv[0]);
+        return 2;
+    }
+    const bool wal         = std::strcmp(argv[1], "wal") == 0;
+    const std::string path = argc > 2 ? argv[2] : "/tmp/benchmarkvfs.db";
+    unlink(path.c_str());
+    unlink((path + "-wal").c_str());
+    unlink((path + "-journal").c_str());
+
+    sqlite3_vfs_register(sqlite3_ecophonevfs(), 1);
+
+    /* a small sqlite cache so that reads reach the VFS */
+    sqlite3* writer = nullptr;
+    if (sqlite3_open(path.c_str(), &writer) != SQLITE_OK) {
+        return 1;
+    }
+    execute(writer, "PRAGMA cache_size=16; PRAGMA mmap_size=67108864; PRAGMA journal_mode=DELETE;");
+    if (wal) {
+        execute(writer, "PRAGMA journal_mode=WAL; PRAGMA wal_autocheckpoint=0;");
+    }
+    execute(writer, "CREATE TABLE t(id INTEGER PRIMARY KEY, v INTEGER, s TEXT)");
+
+    execute(writer, "BEGIN");
+    auto insert = prepare(writer, "INSERT INTO t(v, s) VALUES(?, ?)");
+    for (int i = 0; i < rows; i++) {
+        sqlite3_bind_int(insert, 1, i);
+        sqlite3_bind_text(insert, 2, "payload-payload-payload-payload", -1, SQLITE_STATIC);
+        sqlite3_step(insert);
+        sqlite3_reset(insert);
+    }
+    execute(writer, "COMMIT");
+
+    sqlite3* reader = nullptr;
+    if (sqlite3_open(path.c_str(), &reader) != SQLITE_OK) {
+        return 1;
+    }
+    execute(reader, "PRAGMA cache_size=16; PRAGMA mmap_size=67108864;");
+
+    auto update = prepare(writer, "UPDATE t SET v = v + 1 WHERE id = ?");
+    auto select = prepare(reader, "SELECT v FROM t WHERE id = ?");
+    auto scan   = prepare(reader, "SELECT sum(v) FROM t");
+
+    unsigned seed   = 1;
+    long long check = 0;
+    auto start      = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        execute(writer, "BEGIN");
+        for (int k = 0; k < updates; k++) {
+            sqlite3_bind_int(update, 1, nextRow(seed));
+            sqlite3_step(update);
+            sqlite3_reset(update);
+        }
+        execute(writer, "COMMIT");
+
+        for (int k = 0; k < pointReads; k++) {
+            sqlite3_bind_int(select, 1, nextRow(seed));
+            if (sqlite3_step(select) == SQLITE_ROW) {
+                check += sqlite3_column_int(select, 0);
+            }
+            sqlite3_reset(select);
+        }
+
+        if (round % scanEvery == 0) {
+            if (sqlite3_step(scan) == SQLITE_ROW) {
+                check += sqlite3_column_int64(scan, 0);
+            }
+            sqlite3_reset(scan);
+        }
+    }
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (sqlite3_step(scan) != SQLITE_ROW) {
+        return 1;
+    }
+    long long total = sqlite3_column_int64(scan, 0);
+    sqlite3_reset(scan);
+    const bool ok = integrityOk(reader);
+
+    std::printf("%s: %.1f ms, check=%lld total=%lld integrity=%s\n",
+                wal ? "wal" : "delete",
+                elapsed,
+                check,
+                total,
+                ok ? "ok" : "FAILED");
+
+    sqlite3_finalize(insert);
+    sqlite3_finalize(update);
+    sqlite3_finalize(select);
+    sqlite3_finalize(scan);
+    sqlite3_close(reader);
+    sqlite3_close(writer);
+    return ok ? 0 : 1;
+}
@@ -44,7 +44,10 @@ namespace purefs::blkdev
         sector_count,
         sector_size,
         erase_block,
-        start_sector
+        start_sector,
+        cache_hits,
+        cache_misses,
+        merged_requests
     }; // enum class info_type
 
     enum class pm_state
@@ -0,0 +1,487 @@
+/**
+ * @file disk_cache.cpp
+ * @author Krisna Pranav
+ * @brief disk cache
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021 - 2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include "disk_cache.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex.hpp>
+
+namespace purefs::blkdev
+{
+    /**
+     * @param backing
+     * @param cache_sectors
+     */
+    disk_cache::disk_cache(std::shared_ptr<disk> backing, std::size_t cache_sectors)
+        : m_backing(std::move(backing)), m_capacity(std::max<std::size_t>(cache_sectors, 2)),
+          m_max_dirty(m_capacity / 2), m_lock(std::make_unique<cpp_freertos::MutexRecursive>())
+    {
+    }
+
+    disk_cache::~disk_cache()
+    {
+        flush();
+    }
+
+    /**
+     * @param flags
+     * @return int
+     */
+    auto disk_cache::probe(unsigned flags) -> int
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        return m_backing->probe(flags);
+    }
+
+    /**
+     * @return int
+     */
+    auto disk_cache::cleanup() -> int
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        if (const auto err = flush(); err) {
+            return err;
+        }
+        return m_backing->cleanup();
+    }
+
+    /**
+     * @param hwpart
+     * @return scount_t
+     */
+    auto disk_cache::sector_size(hwpart_t hwpart) -> scount_t
+    {
+        if (const auto it = m_sector_sizes.find(hwpart); it != m_sector_sizes.end()) {
+            return it->second;
+        }
+        const auto size = m_backing->get_info(info_type::sector_size, hwpart);
+        if (size <= 0) {
+            return size ? size : -EIO;
+        }
+        m_sector_sizes.emplace(hwpart, size);
+        return size;
+    }
+
+    /**
+     * @param hwpart
+     * @param lba
+     * @return disk_cache::entry*
+     */
+    auto disk_cache::peek(hwpart_t hwpart, sector_t lba) -> entry*
+    {
+        const auto it = m_index.find(key(hwpart, lba));
+        return it == m_index.end() ? nullptr : &*it->second;
+    }
+
+    /**
+     * @param hwpart
+     * @param lba
+     * @return disk_cache::entry*
+     */
+    auto disk_cache::find(hwpart_t hwpart, sector_t lba) -> entry*
+    {
+        const auto it = m_index.find(key(hwpart, lba));
+        if (it == m_index.end()) {
+            return nullptr;
+        }
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return &*it->second;
+    }
+
+    /**
+     * @param hwpart
+     * @param lba
+     * @param err
+     * @return disk_cache::entry*
+     */
+    auto disk_cache::insert(hwpart_t hwpart, sector_t lba, int& err) -> entry*
+    {
+        const auto size = sector_size(hwpart);
+        if (size < 0) {
+            err = size;
+            return nullptr;
+        }
+        err = 0;
+
+        if (m_lru.size() >= m_capacity) {
+            if (m_lru.back().dirty) {
+                if ((err = submit_writes())) {
+                    return nullptr;
+                }
+            }
+            auto victim = std::prev(m_lru.end());
+            m_index.erase(key(victim->hwpart, victim->lba));
+            m_lru.splice(m_lru.begin(), m_lru, victim);
+        }
+        else {
+            m_lru.emplace_front();
+        }
+
+        auto& front  = m_lru.front();
+        front.hwpart = hwpart;
+        front.lba    = lba;
+        front.dirty  = false;
+        front.data.resize(size);
+        m_index.emplace(key(hwpart, lba), m_lru.begin());
+        return &front;
+    }
+
+    /**
+     * @param buf
+     * @param lba
+     * @param count
+     * @param hwpart
+     * @return int
+     */
+    auto disk_cache::write(const void* buf, sector_t lba, std::size_t count, hwpart_t hwpart) -> int
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        const auto size = sector_size(hwpart);
+        if (size < 0) {
+            return size;
+        }
+        const auto* in = static_cast<const std::uint8_t*>(buf);
+
+        if (count >= m_capacity / 2) {
+            if (erase_pending(hwpart, lba, count)) {
+                if (const auto err = submit_erases(); err) {
+                    return err;
+                }
+            }
+            if (const auto err = m_backing->write(buf, lba, count, hwpart); err) {
+                return err;
+            }
+            ++m_stats.submitted_requests;
+            for (std::size_t i = 0; i < count; ++i) {
+                if (auto cached = peek(hwpart, lba + i)) {
+                    std::memcpy(cached->data.data(), in + i * size, size);
+                    if (cached->dirty) {
+                        cached->dirty = false;
+                        --m_dirty;
+                    }
+                }
+            }
+            return 0;
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            auto cached = find(hwpart, lba + i);
+            if (!cached) {
+                int err;
+                if (!(cached = insert(hwpart, lba + i, err))) {
+                    return err;
+                }
+            }
+            std::memcpy(cached->data.data(), in + i * size, size);
+            if (!cached->dirty) {
+                cached->dirty = true;
+                ++m_dirty;
+            }
+        }
+
+        return m_dirty >= m_max_dirty ? submit_writes() : 0;
+    }
+
+    /**
+     * @param buf
+     * @param lba
+     * @param count
+     * @param hwpart
+     * @return int
+     */
+    auto disk_cache::read(void* buf, sector_t lba, std::size_t count, hwpart_t hwpart) -> int
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        const auto size = sector_size(hwpart);
+        if (size < 0) {
+            return size;
+        }
+        auto* out = static_cast<std::uint8_t*>(buf);
+
+        for (std::size_t i = 0; i < count;) {
+            if (const auto cached = find(hwpart, lba + i)) {
+                std::memcpy(out + i * size, cached->data.data(), size);
+                ++m_stats.hits;
+                ++i;
+                continue;
+            }
+
+            auto end = i + 1;
+            while (end < count && !peek(hwpart, lba + end)) {
+                ++end;
+            }
+            const auto run = end - i;
+            m_stats.misses += run;
+
+            if (erase_pending(hwpart, lba + i, run)) {
+                if (const auto err = submit_erases(); err) {
+                    return err;
+                }
+            }
+            if (const auto err = m_backing->read(out + i * size, lba + i, run, hwpart); err) {
+                return err;
+            }
+
+            // a long sequential read would only push out sectors worth keeping
+            if (run < m_capacity / 2) {
+                for (auto n = i; n < end; ++n) {
+                    int err;
+                    const auto cached = insert(hwpart, lba + n, err);
+                    if (!cached) {
+                        return err;
+                    }
+                    std::memcpy(cached->data.data(), out + n * size, size);
+                }
+            }
+            i = end;
+        }
+        return 0;
+    }
+
+    /**
+     * @param lba
+     * @param count
+     * @param hwpart
+     * @return int
+     */
+    auto disk_cache::erase(sector_t lba, std::size_t count, hwpart_t hwpart) -> int
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        // whatever was cached or waiting to be written in the range is gone
+        const auto drop = [this](entry_list::iterator it) {
+            if (it->dirty) {
+                --m_dirty;
+            }
+            m_index.erase(key(it->hwpart, it->lba));
+            m_lru.erase(it);
+        };
+        if (count > m_lru.size()) {
+            for (auto it = m_lru.begin(); it != m_lru.end();) {
+                const auto next = std::next(it);
+                if (it->hwpart == hwpart && it->lba >= lba && it->lba - lba < count) {
+                    drop(it);
+                }
+                it = next;
+            }
+        }
+        else {
+            for (std::size_t i = 0; i < count; ++i) {
+                if (const auto it = m_index.find(key(hwpart, lba + i)); it != m_index.end()) {
+                    drop(it->second);
+                }
+            }
+        }
+
+        const auto before = [](const erase_request& a, const erase_request& b) {
+            return a.hwpart != b.hwpart ? a.hwpart < b.hwpart : a.lba < b.lba;
+        };
+        const erase_request request{hwpart, lba, count};
+        auto it = m_erases.insert(std::upper_bound(m_erases.begin(), m_erases.end(), request, before), request);
+
+        // fold into the previous range, then swallow the ranges this one reaches
+        if (it != m_erases.begin()) {
+            auto prev = std::prev(it);
+            if (prev->hwpart == hwpart && prev->lba + prev->count >= lba) {
+                prev->count = std::max(prev->lba + prev->count, lba + count) - prev->lba;
+                it          = std::prev(m_erases.erase(it));
+                ++m_stats.merged_requests;
+            }
+        }
+        auto next = std::next(it);
+        while (next != m_erases.end() && next->hwpart == hwpart && it->lba + it->count >= next->lba) {
+            it->count = std::max(it->lba + it->count, next->lba + next->count) - it->lba;
+            next      = m_erases.erase(next);
+            it        = std::prev(next);
+            ++m_stats.merged_requests;
+        }
+
+        return m_erases.size() >= max_pending_erases ? submit_erases() : 0;
+    }
+
+    /**
+     * @param hwpart
+     * @param lba
+     * @param count
+     * @return true
+     * @return false
+     */
+    auto disk_cache::erase_pending(hwpart_t hwpart, sector_t lba, std::size_t count) const -> bool
+    {
+        return std::any_of(m_erases.begin(), m_erases.end(), [&](const erase_request& request) {
+            return request.hwpart == hwpart && request.lba < lba + count && lba < request.lba + request.count;
+        });
+    }
+
+    /**
+     * @return int
+     */
+    auto disk_cache::submit_erases() -> int
+    {
+        auto it = m_erases.begin();
+        for (; it != m_erases.end(); ++it) {
+            if (const auto err = m_backing->erase(it->lba, it->count, it->hwpart); err) {
+                m_erases.erase(m_erases.begin(), it);
+                return err;
+            }
+            ++m_stats.submitted_requests;
+        }
+        m_erases.clear();
+        return 0;
+    }
+
+    /**
+     * @brief erases go first: a sector written after an erase was queued
+     *        must not be wiped by it
+     *
+     * @return int
+     */
+    auto disk_cache::submit_writes() -> int
+    {
+        if (const auto err = submit_erases(); err) {
+            return err;
+        }
+        if (m_dirty == 0) {
+            return 0;
+        }
+
+        std::vector<entry*> dirty;
+        dirty.reserve(m_dirty);
+        for (auto& cached : m_lru) {
+            if (cached.dirty) {
+                dirty.push_back(&cached);
+            }
+        }
+        std::sort(dirty.begin(), dirty.end(), [](const entry* a, const entry* b) {
+            return key(a->hwpart, a->lba) < key(b->hwpart, b->lba);
+        });
+
+        std::vector<std::uint8_t> staging;
+        for (std::size_t first = 0; first < dirty.size();) {
+            const auto hwpart = dirty[first]->hwpart;
+            const auto lba    = dirty[first]->lba;
+            auto last         = first + 1;
+            while (last < dirty.size() && dirty[last]->hwpart == hwpart && dirty[last]->lba == lba + (last - first)) {
+                ++last;
+            }
+            const auto run  = last - first;
+            const auto size = sector_size(hwpart);
+
+            int err;
+            if (run == 1) {
+                err = m_backing->write(dirty[first]->data.data(), lba, 1, hwpart);
+            }
+            else {
+                staging.resize(run * size);
+                for (auto n = first; n < last; ++n) {
+                    std::memcpy(&staging[(n - first) * size], dirty[n]->data.data(), size);
+                }
+                err = m_backing->write(staging.data(), lba, run, hwpart);
+            }
+            if (err) {
+                return err;
+            }
+
+            for (auto n = first; n < last; ++n) {
+                dirty[n]->dirty = false;
+            }
+            m_dirty -= run;
+            m_stats.merged_requests += run - 1;
+            ++m_stats.submitted_requests;
+            first = last;
+        }
+        return 0;
+    }
+
+    /**
+     * @return int
+     */
+    auto disk_cache::flush() -> int
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        return submit_writes();
+    }
+
+    /**
+     * @return int
+     */
+    auto disk_cache::sync() -> int
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        if (const auto err = flush(); err) {
+            return err;
+        }
+        return m_backing->sync();
+    }
+
+    /**
+     * @param target_state
+     * @return int
+     */
+    auto disk_cache::pm_control(pm_state target_state) -> int
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        if (target_state != pm_state::active) {
+            if (const auto err = sync(); err) {
+                return err;
+            }
+        }
+        return m_backing->pm_control(target_state);
+    }
+
+    /**
+     * @param current_state
+     * @return int
+     */
+    auto disk_cache::pm_read(pm_state& current_state) -> int
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        return m_backing->pm_read(current_state);
+    }
+
+    /**
+     * @return disk_cache::statistics
+     */
+    auto disk_cache::stats() const -> statistics
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        return m_stats;
+    }
+
+    /**
+     * @return media_status
+     */
+    auto disk_cache::status() const -> media_status
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        return m_backing->status();
+    }
+
+    /**
+     * @param what
+     * @param hwpart
+     * @return scount_t
+     */
+    auto disk_cache::get_info(info_type what, hwpart_t hwpart) const -> scount_t
+    {
+        cpp_freertos::LockGuard _lck(*m_lock);
+        switch (what) {
+        case info_type::cache_hits:
+            return m_stats.hits;
+        case info_type::cache_misses:
+            return m_stats.misses;
+        case info_type::merged_requests:
+            return m_stats.merged_requests;
+        default:
+            return m_backing->get_info(what, hwpart);
+        }
+    }
+} // namespace purefs::blkdev
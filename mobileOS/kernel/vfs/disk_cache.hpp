@@ -0,0 +1,247 @@
+/**
+ * @file disk_cache.hpp
+ * @author Krisna Pranav
+ * @brief disk cache
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021 - 2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include "disk.hpp"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace cpp_freertos
+{
+    class MutexRecursive;
+} // namespace cpp_freertos
+
+namespace purefs::blkdev
+{
+    /**
+     * @brief a write-back sector cache in front of another disk. writes stay
+     *        in the cache until sync(), a power state change or too many
+     *        dirty sectors; then they go out sorted by LBA, with adjacent
+     *        sectors merged into one request. erases are queued the same way,
+     *        adjacent and overlapping ranges merged into one call. register
+     *        it with disk_manager in place of the disk it wraps. every
+     *        public call takes the cache's own recursive lock, so it is
+     *        also safe to use without disk_manager.
+     */
+    class disk_cache final : public disk
+    {
+      public:
+        static constexpr std::size_t default_cache_sectors = 256;
+        static constexpr std::size_t max_pending_erases = 16;
+
+        struct statistics
+        {
+            std::size_t hits{};
+            std::size_t misses{};
+            std::size_t merged_requests{};
+            std::size_t submitted_requests{};
+        }; // struct statistics
+
+        /**
+         * @param backing
+         * @param cache_sectors
+         */
+        explicit disk_cache(std::shared_ptr<disk> backing, std::size_t cache_sectors = default_cache_sectors);
+
+        /**
+         * @brief Destroy the disk cache object, writing back what is still dirty
+         *
+         */
+        ~disk_cache() override;
+
+        /**
+         * @param flags
+         * @return int
+         */
+        auto probe(unsigned flags) -> int override;
+
+        /**
+         * @return int
+         */
+        auto cleanup() -> int override;
+
+        /**
+         * @brief writes of half the cache or more skip it and go straight
+         *        to the disk
+         *
+         * @param buf
+         * @param lba
+         * @param count
+         * @param hwpart
+         * @return int
+         */
+        auto write(const void* buf, sector_t lba, std::size_t count, hwpart_t hwpart) -> int override;
+
+        /**
+         * @brief each run of missing sectors is one read from the disk
+         *
+         * @param buf
+         * @param lba
+         * @param count
+         * @param hwpart
+         * @return int
+         */
+        auto read(void* buf, sector_t lba, std::size_t count, hwpart_t hwpart) -> int override;
+
+        /**
+         * @param lba
+         * @param count
+         * @param hwpart
+         * @return int
+         */
+        auto erase(sector_t lba, std::size_t count, hwpart_t hwpart) -> int override;
+
+        /**
+         * @return int
+         */
+        auto sync() -> int override;
+
+        /**
+         * @brief leaving the active state writes everything back and syncs
+         *        the disk first
+         *
+         * @param target_state
+         * @return int
+         */
+        auto pm_control(pm_state target_state) -> int override;
+
+        /**
+         * @param current_state
+         * @return int
+         */
+        auto pm_read(pm_state& current_state) -> int override;
+
+        /**
+         * @return media_status
+         */
+        [[nodiscard]] auto status() const -> media_status override;
+
+        /**
+         * @brief also answers info_type::cache_hits, cache_misses and
+         *        merged_requests
+         *
+         * @param what
+         * @param hwpart
+         * @return scount_t
+         */
+        [[nodiscard]] auto get_info(info_type what, hwpart_t hwpart) const -> scount_t override;
+
+        /**
+         * @brief sends queued erases and dirty sectors to the disk without
+         *        syncing it
+         *
+         * @return int
+         */
+        auto flush() -> int;
+
+        /**
+         * @return statistics
+         */
+        [[nodiscard]] auto stats() const -> statistics;
+
+      private:
+        struct entry
+        {
+            hwpart_t hwpart;
+            sector_t lba;
+            bool dirty;
+            std::vector<std::uint8_t> data;
+        }; // struct entry
+
+        struct erase_request
+        {
+            hwpart_t hwpart;
+            sector_t lba;
+            std::size_t count;
+        }; // struct erase_request
+
+        using entry_list = std::list<entry>;
+
+        /**
+         * @param hwpart
+         * @param lba
+         * @return std::uint64_t
+         */
+        static auto key(hwpart_t hwpart, sector_t lba) noexcept -> std::uint64_t
+        {
+            return (std::uint64_t(hwpart) << 56) | lba;
+        }
+
+        /**
+         * @param hwpart
+         * @return scount_t
+         */
+        auto sector_size(hwpart_t hwpart) -> scount_t;
+
+        /**
+         * @param hwpart
+         * @param lba
+         * @return entry*
+         */
+        auto peek(hwpart_t hwpart, sector_t lba) -> entry*;
+
+        /**
+         * @brief looks a sector up and makes it the most recently used
+         *
+         * @param hwpart
+         * @param lba
+         * @return entry*
+         */
+        auto find(hwpart_t hwpart, sector_t lba) -> entry*;
+
+        /**
+         * @brief adds a clean sector, evicting the least recently used one
+         *        when the cache is full; a dirty victim writes back every
+         *        dirty sector first
+         *
+         * @param hwpart
+         * @param lba
+         * @param err
+         * @return entry*
+         */
+        auto insert(hwpart_t hwpart, sector_t lba, int& err) -> entry*;
+
+        /**
+         * @param hwpart
+         * @param lba
+         * @param count
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] auto erase_pending(hwpart_t hwpart, sector_t lba, std::size_t count) const -> bool;
+
+        /**
+         * @return int
+         */
+        auto submit_erases() -> int;
+
+        /**
+         * @return int
+         */
+        auto submit_writes() -> int;
+
+      private:
+        std::shared_ptr<disk> m_backing;
+        std::size_t m_capacity;
+        std::size_t m_max_dirty;
+        std::size_t m_dirty{};
+        entry_list m_lru;
+        std::unordered_map<std::uint64_t, entry_list::iterator> m_index;
+        std::vector<erase_request> m_erases;
+        std::unordered_map<hwpart_t, scount_t> m_sector_sizes;
+        statistics m_stats;
+        std::unique_ptr<cpp_freertos::MutexRecursive> m_lock;
+    }; // class disk_cache
+} // namespace purefs::blkdev
@@ -0,0 +1,140 @@
+/**
+ * @file disk_ram.cpp
+ * @author Krisna Pranav
+ * @brief disk ram
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021 - 2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include "disk_ram.hpp"
+#include <cerrno>
+#include <cstring>
+
+namespace purefs::blkdev
+{
+    /**
+     * @param sector_size
+     * @param sector_count
+     */
+    disk_ram::disk_ram(std::size_t sector_size, std::size_t sector_count)
+        : m_sector_size(sector_size), m_sector_count(sector_count), m_data(sector_size * sector_count, 0xff)
+    {
+    }
+
+    /**
+     * @param flags
+     * @return int
+     */
+    auto disk_ram::probe(unsigned flags) -> int
+    {
+        static_cast<void>(flags);
+        return 0;
+    }
+
+    /**
+     * @param lba
+     * @param count
+     * @param hwpart
+     * @return int
+     */
+    auto disk_ram::check_range(sector_t lba, std::size_t count, hwpart_t hwpart) const -> int
+    {
+        if (hwpart != default_hw_partition) {
+            return -ERANGE;
+        }
+        if (lba > m_sector_count || count > m_sector_count - lba) {
+            return -ERANGE;
+        }
+        return 0;
+    }
+
+    /**
+     * @param buf
+     * @param lba
+     * @param count
+     * @param hwpart
+     * @return int
+     */
+    auto disk_ram::write(const void* buf, sector_t lba, std::size_t count, hwpart_t hwpart) -> int
+    {
+        if (const auto err = check_range(lba, count, hwpart); err) {
+            return err;
+        }
+        std::memcpy(&m_data[lba * m_sector_size], buf, count * m_sector_size);
+        return 0;
+    }
+
+    /**
+     * @param buf
+     * @param lba
+     * @param count
+     * @param hwpart
+     * @return int
+     */
+    auto disk_ram::read(void* buf, sector_t lba, std::size_t count, hwpart_t hwpart) -> int
+    {
+        if (const auto err = check_range(lba, count, hwpart); err) {
+            return err;
+        }
+        std::memcpy(buf, &m_data[lba * m_sector_size], count * m_sector_size);
+        return 0;
+    }
+
+    /**
+     * @param lba
+     * @param count
+     * @param hwpart
+     * @return int
+     */
+    auto disk_ram::erase(sector_t lba, std::size_t count, hwpart_t hwpart) -> int
+    {
+        if (const auto err = check_range(lba, count, hwpart); err) {
+            return err;
+        }
+        std::memset(&m_data[lba * m_sector_size], 0xff, count * m_sector_size);
+        return 0;
+    }
+
+    /**
+     * @return int
+     */
+    auto disk_ram::sync() -> int
+    {
+        return 0;
+    }
+
+    /**
+     * @return media_status
+     */
+    auto disk_ram::status() const -> media_status
+    {
+        return media_status::healthy;
+    }
+
+    /**
+     * @param what
+     * @param hwpart
+     * @return scount_t
+     */
+    auto disk_ram::get_info(info_type what, hwpart_t hwpart) const -> scount_t
+    {
+        if (hwpart != default_hw_partition) {
+            return -ERANGE;
+        }
+        switch (what) {
+        case info_type::sector_count:
+            return m_sector_count;
+        case info_type::sector_size:
+            return m_sector_size;
+        case info_type::erase_block:
+            return 1;
+        case info_type::start_sector:
+            return 0;
+        default:
+            return -ENOTSUP;
+        }
+    }
+} // namespace purefs::blkdev
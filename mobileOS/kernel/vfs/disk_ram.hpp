@@ -0,0 +1,96 @@
+/**
+ * @file disk_ram.hpp
+ * @author Krisna Pranav
+ * @brief disk ram
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021 - 2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include "disk.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace purefs::blkdev
+{
+    /**
+     * @brief a disk held in memory, with one hardware partition. erased
+     *        sectors read back as 0xff, like flash.
+     */
+    class disk_ram final : public disk
+    {
+      public:
+        /**
+         * @param sector_size
+         * @param sector_count
+         */
+        disk_ram(std::size_t sector_size, std::size_t sector_count);
+
+        /**
+         * @param flags
+         * @return int
+         */
+        auto probe(unsigned flags) -> int override;
+
+        /**
+         * @param buf
+         * @param lba
+         * @param count
+         * @param hwpart
+         * @return int
+         */
+        auto write(const void* buf, sector_t lba, std::size_t count, hwpart_t hwpart) -> int override;
+
+        /**
+         * @param buf
+         * @param lba
+         * @param count
+         * @param hwpart
+         * @return int
+         */
+        auto read(void* buf, sector_t lba, std::size_t count, hwpart_t hwpart) -> int override;
+
+        /**
+         * @param lba
+         * @param count
+         * @param hwpart
+         * @return int
+         */
+        auto erase(sector_t lba, std::size_t count, hwpart_t hwpart) -> int override;
+
+        /**
+         * @return int
+         */
+        auto sync() -> int override;
+
+        /**
+         * @return media_status
+         */
+        [[nodiscard]] auto status() const -> media_status override;
+
+        /**
+         * @param what
+         * @param hwpart
+         * @return scount_t
+         */
+        [[nodiscard]] auto get_info(info_type what, hwpart_t hwpart) const -> scount_t override;
+
+      private:
+        /**
+         * @param lba
+         * @param count
+         * @param hwpart
+         * @return int
+         */
+        auto check_range(sector_t lba, std::size_t count, hwpart_t hwpart) const -> int;
+
+      private:
+        std::size_t m_sector_size;
+        std::size_t m_sector_count;
+        std::vector<std::uint8_t> m_data;
+    }; // class disk_ram
+} // namespace purefs::blkdev
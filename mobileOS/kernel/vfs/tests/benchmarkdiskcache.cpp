@@ -0,0 +1,316 @@
+/**
+ * @file benchmarkdiskcache.cpp
+ * @author Krisna Pranav
+ * @brief host model check and benchmark for disk_cache:
+ *
+ *        - 50 seeds x 5000 random reads, writes, erases and syncs through a
+ *          disk_cache over a disk_ram, each read compared with an uncached
+ *          disk_ram given the same operations, and the backing store
+ *          compared with it after the final sync;
+ *        - four threads on disjoint ranges of one cache, checked the same
+ *          way, for the cache's lock;
+ *        - a FAT-like workload (hot metadata sectors, sequential appends,
+ *          trims) with 20 us charged per disk command, uncached and cached.
+ *
+ *        g++ -std=c++17 -O2 -Ishim -I.. -o benchmarkdiskcache benchmarkdiskcache.cpp ../disk_cache.cpp ../disk_ram.cpp -lpthread
+ *        ./benchmarkdiskcache
+ *
+ *        exits non-zero if the cache ever disagrees with the model.
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021 - 2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include "disk_cache.hpp"
+#include "disk_ram.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+
+using namespace purefs::blkdev;
+
+// the defaults disk.cpp provides on the target
+auto disk::cleanup() -> int
+{
+    return 0;
+}
+
+auto disk::erase(sector_t, std::size_t, hwpart_t) -> int
+{
+    return -ENOTSUP;
+}
+
+auto disk::sync() -> int
+{
+    return 0;
+}
+
+auto disk::pm_control(pm_state) -> int
+{
+    return 0;
+}
+
+auto disk::pm_read(pm_state&) -> int
+{
+    return 0;
+}
+
+namespace
+{
+    constexpr std::size_t sectorSize  = 512;
+    constexpr std::size_t sectorCount = 4096;
+    constexpr int seeds               = 50;
+    constexpr int operations          = 5000;
+
+    /**
+     * @brief a disk_ram that counts requests and charges a fixed latency per
+     *        request, like an eMMC command
+     */
+    class counting_disk final : public disk
+    {
+      public:
+        counting_disk(std::size_t sector_size, std::size_t sector_count) : m_ram(sector_size, sector_count)
+        {
+        }
+
+        auto probe(unsigned) -> int override
+        {
+            return 0;
+        }
+
+        [[nodiscard]] auto status() const -> media_status override
+        {
+            return media_status::healthy;
+        }
+
+        [[nodiscard]] auto get_info(info_type what, hwpart_t hwpart) const -> scount_t override
+        {
+            return m_ram.get_info(what, hwpart);
+        }
+
+        auto write(const void* buf, sector_t lba, std::size_t count, hwpart_t hwpart) -> int override
+        {
+            ++writes;
+            charge();
+            return m_ram.write(buf, lba, count, hwpart);
+        }
+
+        auto read(void* buf, sector_t lba, std::size_t count, hwpart_t hwpart) -> int override
+        {
+            ++reads;
+            charge();
+            return m_ram.read(buf, lba, count, hwpart);
+        }
+
+        auto erase(sector_t lba, std::size_t count, hwpart_t hwpart) -> int override
+        {
+            ++erases;
+            charge();
+            return m_ram.erase(lba, count, hwpart);
+        }
+
+        std::size_t reads{};
+        std::size_t writes{};
+        std::size_t erases{};
+
+      private:
+        static void charge()
+        {
+            const auto start = std::chrono::steady_clock::now();
+            while (std::chrono::steady_clock::now() - start < std::chrono::microseconds(20)) {}
+        }
+
+        disk_ram m_ram;
+    }; // class counting_disk
+
+    /**
+     * @param a
+     * @param b
+     * @param first
+     * @param count
+     * @return true if both disks hold the same sectors
+     */
+    bool same_contents(disk& a, disk& b, sector_t first, std::size_t count)
+    {
+        std::vector<std::uint8_t> x(sectorSize * count), y(sectorSize * count);
+        return !a.read(x.data(), first, count, 0) && !b.read(y.data(), first, count, 0) && x == y;
+    }
+
+    /**
+     * @brief random operations on [first, first + span) of cache and model
+     *
+     * @param rng
+     * @param cache
+     * @param model
+     * @param first
+     * @param span
+     * @param count
+     * @return true if every operation succeeded and every read matched
+     */
+    bool run_operations(std::mt19937& rng, disk& cache, disk& model, sector_t first, std::size_t span, int count)
+    {
+        std::vector<std::uint8_t> buf(sectorSize * 64), got(sectorSize * 64), expected(sectorSize * 64);
+        for (int op = 0; op < count; ++op) {
+            const sector_t lba     = first + rng() % (span - 64);
+            const std::size_t sectors = 1 + rng() % (rng() % 4 ? 4 : 40);
+            switch (rng() % 10) {
+            case 0:
+            case 1:
+            case 2:
+            case 3:
+                for (auto& byte : buf) {
+                    byte = rng();
+                }
+                if (cache.write(buf.data(), lba, sectors, 0) || model.write(buf.data(), lba, sectors, 0)) {
+                    return false;
+                }
+                break;
+            case 4:
+                if (cache.erase(lba, sectors, 0) || model.erase(lba, sectors, 0)) {
+                    return false;
+                }
+                break;
+            case 5:
+                if (rng() % 20 == 0 && cache.sync()) {
+                    return false;
+                }
+                break;
+            default:
+                if (cache.read(got.data(), lba, sectors, 0) || model.read(expected.data(), lba, sectors, 0)) {
+                    return false;
+                }
+                if (std::memcmp(got.data(), expected.data(), sectors * sectorSize) != 0) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @return true
+     * @return false
+     */
+    bool model_check()
+    {
+        for (int seed = 0; seed < seeds; ++seed) {
+            auto backing = std::make_shared<disk_ram>(sectorSize, sectorCount);
+            disk_ram model(sectorSize, sectorCount);
+            disk_cache cache(backing, 32 + seed);
+            std::mt19937 rng(seed);
+
+            if (!run_operations(rng, cache, model, 0, sectorCount, operations)) {
+                std::printf("model check: seed %d read back wrong data or failed\n", seed);
+                return false;
+            }
+            if (cache.sync() || !same_contents(*backing, model, 0, sectorCount)) {
+                std::printf("model check: seed %d backing store differs after sync\n", seed);
+                return false;
+            }
+        }
+        std::printf("model check: %d seeds x %d operations ok\n", seeds, operations);
+        return true;
+    }
+
+    /**
+     * @return true
+     * @return false
+     */
+    bool thread_check()
+    {
+        constexpr int threads  = 4;
+        constexpr auto span    = sectorCount / threads;
+        auto backing           = std::make_shared<disk_ram>(sectorSize, sectorCount);
+        disk_cache cache(backing, 64);
+        std::vector<std::unique_ptr<disk_ram>> models;
+        std::vector<std::thread> workers;
+        bool ok[threads]{};
+
+        for (int t = 0; t < threads; ++t) {
+            models.push_back(std::make_unique<disk_ram>(sectorSize, sectorCount));
+        }
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::mt19937 rng(1000 + t);
+                ok[t] = run_operations(rng, cache, *models[t], t * span, span, operations);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        bool all = cache.sync() == 0;
+        for (int t = 0; t < threads; ++t) {
+            all = all && ok[t] && same_contents(*backing, *models[t], t * span, span);
+        }
+        std::printf("thread check: %d threads x %d operations %s\n", threads, operations, all ? "ok" : "FAILED");
+        return all;
+    }
+
+    void benchmark()
+    {
+        for (bool cached : {false, true}) {
+            auto backing = std::make_shared<counting_disk>(sectorSize, 1 << 16);
+            std::shared_ptr<disk> target = backing;
+            std::shared_ptr<disk_cache> cache;
+            if (cached) {
+                target = cache = std::make_shared<disk_cache>(backing);
+            }
+
+            std::mt19937 rng(1);
+            std::vector<std::uint8_t> buf(sectorSize * 8);
+            sector_t next = 1024;
+            const auto start = std::chrono::steady_clock::now();
+            for (int op = 0; op < 20000; ++op) {
+                const auto kind = rng() % 10;
+                if (kind < 4) {
+                    // FAT and directory sectors
+                    target->read(buf.data(), rng() % 64, 1, 0);
+                }
+                else if (kind < 6) {
+                    target->write(buf.data(), rng() % 64, 1, 0);
+                }
+                else if (kind < 9) {
+                    // a file growing one sector at a time
+                    target->write(buf.data(), next, 1, 0);
+                    next = next + 1 < 60000 ? next + 1 : 1024;
+                }
+                else {
+                    // freed clusters, trimmed
+                    target->erase(1024 + (rng() % 1000) * 4, 4, 0);
+                }
+                if (op % 2000 == 1999) {
+                    target->sync();
+                }
+            }
+            target->sync();
+            const auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            std::printf("%s: %.1f ms, disk reads %zu writes %zu erases %zu",
+                        cached ? "cached  " : "uncached",
+                        ms,
+                        backing->reads,
+                        backing->writes,
+                        backing->erases);
+            if (cache) {
+                const auto stats = cache->stats();
+                std::printf(", hits %zu misses %zu merged %zu", stats.hits, stats.misses, stats.merged_requests);
+            }
+            std::printf("\n");
+        }
+    }
+} // namespace
+
+int main()
+{
+    if (!model_check() || !thread_check()) {
+        return 1;
+    }
+    benchmark();
+    return 0;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file mutex.hpp
+ * @author Krisna Pranav
+ * @brief host stand-in for the FreeRTOS C++ wrapper's mutex.hpp, for the
+ *        vfs host tests only
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021 - 2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include <mutex>
+
+namespace cpp_freertos
+{
+    class Mutex
+    {
+      public:
+        virtual ~Mutex() = default;
+
+        /**
+         * @return true
+         * @return false
+         */
+        virtual bool Lock() = 0;
+
+        /**
+         * @return true
+         * @return false
+         */
+        virtual bool Unlock() = 0;
+    }; // class Mutex
+
+    class MutexRecursive : public Mutex
+    {
+      public:
+        bool Lock() override
+        {
+            m_mutex.lock();
+            return true;
+        }
+
+        bool Unlock() override
+        {
+            m_mutex.unlock();
+            return true;
+        }
+
+      private:
+        std::recursive_mutex m_mutex;
+    }; // class MutexRecursive
+
+    class LockGuard
+    {
+      public:
+        /**
+         * @param m
+         */
+        explicit LockGuard(Mutex& m) : m_mutex(m)
+        {
+            m_mutex.Lock();
+        }
+
+        ~LockGuard()
+        {
+            m_mutex.Unlock();
+        }
+
+        LockGuard(const LockGuard&) = delete;
+        LockGuard& operator=(const LockGuard&) = delete;
+
+      private:
+        Mutex& m_mutex;
+    }; // class LockGuard
+} // namespace cpp_freertos
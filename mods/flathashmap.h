@@ -0,0 +1,362 @@
+/**
+ * @file flathashmap.h
+ * @author Krisna Pranav
+ * @brief Flat Hash Map
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include <mods/flathashtable.h>
+#include <mods/optional.h>
+#include <mods/vector.h>
+#include <initializer_list>
+
+namespace Mods
+{
+    /**
+     * @brief HashMap's interface on top of FlatHashTable. Iterators and
+     *        references are invalidated by any insertion that grows the table,
+     *        exactly as with HashMap.
+     *
+     * @tparam K
+     * @tparam V
+     * @tparam KeyTraits
+     */
+    template <typename K, typename V, typename KeyTraits>
+    class FlatHashMap
+    {
+    private:
+        struct Entry
+        {
+            K key;
+            V value;
+        }; // struct Entry
+
+        struct EntryTraits
+        {
+            static unsigned hash(Entry const& entry)
+            {
+                return KeyTraits::hash(entry.key);
+            }
+
+            static bool equals(Entry const& a, Entry const& b)
+            {
+                return KeyTraits::equals(a.key, b.key);
+            }
+        }; // struct EntryTraits
+
+    public:
+        using KeyType = K;
+        using ValueType = V;
+
+        FlatHashMap() = default;
+
+        /**
+         * @brief Construct a new FlatHashMap object
+         *
+         * @param list
+         */
+        FlatHashMap(std::initializer_list<Entry> list)
+        {
+            ensure_capacity(list.size());
+            for(auto& item : list)
+                set(item.key, item.value);
+        }
+
+        [[nodiscard]] bool is_empty() const
+        {
+            return m_table.is_empty();
+        }
+
+        [[nodiscard]] size_t size() const
+        {
+            return m_table.size();
+        }
+
+        [[nodiscard]] size_t capacity() const
+        {
+            return m_table.capacity();
+        }
+
+        void clear()
+        {
+            m_table.clear();
+        }
+
+        void clear_with_capacity()
+        {
+            m_table.clear_with_capacity();
+        }
+
+        /**
+         * @param key
+         * @param value
+         * @return HashSetResult
+         */
+        HashSetResult set(const K& key, const V& value)
+        {
+            return m_table.set({key, value});
+        }
+
+        HashSetResult set(const K& key, V&& value)
+        {
+            return m_table.set({key, move(value)});
+        }
+
+        HashSetResult set(K&& key, V&& value)
+        {
+            return m_table.set({move(key), move(value)});
+        }
+
+        /**
+         * @param key
+         * @param value
+         * @return ErrorOr<HashSetResult>
+         */
+        ErrorOr<HashSetResult> try_set(const K& key, const V& value)
+        {
+            return m_table.try_set({key, value});
+        }
+
+        ErrorOr<HashSetResult> try_set(const K& key, V&& value)
+        {
+            return m_table.try_set({key, move(value)});
+        }
+
+        ErrorOr<HashSetResult> try_set(K&& key, V&& value)
+        {
+            return m_table.try_set({move(key), move(value)});
+        }
+
+        /**
+         * @param key
+         * @return true
+         * @return false
+         */
+        bool remove(const K& key)
+        {
+            auto it = find(key);
+            if(it != end())
+            {
+                m_table.remove(it);
+                return true;
+            }
+            return false;
+        }
+
+        template <Concepts::HashCompatible<K> Key>
+            requires(IsSame<KeyTraits, Traits<K>>)
+        bool remove(Key const& key)
+        {
+            auto it = find(key);
+            if(it != end())
+            {
+                m_table.remove(it);
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * @tparam TUnaryPredicate
+         * @param predicate
+         * @return true
+         * @return false
+         */
+        template <typename TUnaryPredicate>
+        bool remove_all_matching(TUnaryPredicate predicate)
+        {
+            return m_table.template remove_all_matching([&](auto& entry)
+                                                        { return predicate(entry.key, entry.value); });
+        }
+
+        using FlatHashTableType = FlatHashTable<Entry, EntryTraits>;
+        using IteratorType = typename FlatHashTableType::Iterator;
+        using ConstIteratorType = typename FlatHashTableType::ConstIterator;
+
+        [[nodiscard]] IteratorType begin()
+        {
+            return m_table.begin();
+        }
+
+        [[nodiscard]] IteratorType end()
+        {
+            return m_table.end();
+        }
+
+        [[nodiscard]] IteratorType find(const K& key)
+        {
+            return m_table.find(KeyTraits::hash(key), [&](auto& entry)
+                                { return KeyTraits::equals(key, entry.key); });
+        }
+
+        template <typename TUnaryPredicate>
+        [[nodiscard]] IteratorType find(unsigned hash, TUnaryPredicate predicate)
+        {
+            return m_table.find(hash, predicate);
+        }
+
+        [[nodiscard]] ConstIteratorType begin() const
+        {
+            return m_table.begin();
+        }
+
+        [[nodiscard]] ConstIteratorType end() const
+        {
+            return m_table.end();
+        }
+
+        [[nodiscard]] ConstIteratorType find(const K& key) const
+        {
+            return m_table.find(KeyTraits::hash(key), [&](auto& entry)
+                                { return KeyTraits::equals(key, entry.key); });
+        }
+
+        template <typename TUnaryPredicate>
+        [[nodiscard]] ConstIteratorType find(unsigned hash, TUnaryPredicate predicate) const
+        {
+            return m_table.find(hash, predicate);
+        }
+
+        template <Concepts::HashCompatible<K> Key>
+            requires(IsSame<KeyTraits, Traits<K>>)
+        [[nodiscard]] IteratorType find(Key const& key)
+        {
+            return m_table.find(Traits<Key>::hash(key), [&](auto& entry)
+                                { return Traits<K>::equals(key, entry.key); });
+        }
+
+        template <Concepts::HashCompatible<K> Key>
+            requires(IsSame<KeyTraits, Traits<K>>)
+        [[nodiscard]] ConstIteratorType find(Key const& key) const
+        {
+            return m_table.find(Traits<Key>::hash(key), [&](auto& entry)
+                                { return Traits<K>::equals(key, entry.key); });
+        }
+
+        /**
+         * @param capacity
+         */
+        void ensure_capacity(size_t capacity)
+        {
+            m_table.ensure_capacity(capacity);
+        }
+
+        ErrorOr<void> try_ensure_capacity(size_t capacity)
+        {
+            return m_table.try_ensure_capacity(capacity);
+        }
+
+        /**
+         * @param key
+         * @return Optional<typename Traits<V>::ConstPeekType>
+         */
+        Optional<typename Traits<V>::ConstPeekType> get(const K& key) const
+        {
+            auto it = find(key);
+            if(it == end())
+                return {};
+            return (*it).value;
+        }
+
+        Optional<typename Traits<V>::PeekType> get(const K& key)
+            requires(!IsConst<typename Traits<V>::PeekType>)
+        {
+            auto it = find(key);
+            if(it == end())
+                return {};
+            return (*it).value;
+        }
+
+        template <Concepts::HashCompatible<K> Key>
+            requires(IsSame<KeyTraits, Traits<K>>)
+        Optional<typename Traits<V>::ConstPeekType> get(Key const& key) const
+        {
+            auto it = find(key);
+            if(it == end())
+                return {};
+            return (*it).value;
+        }
+
+        /**
+         * @param key
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool contains(const K& key) const
+        {
+            return find(key) != end();
+        }
+
+        template <Concepts::HashCompatible<K> Key>
+            requires(IsSame<KeyTraits, Traits<K>>)
+        [[nodiscard]] bool contains(Key const& value) const
+        {
+            return find(value) != end();
+        }
+
+        /**
+         * @param it
+         */
+        void remove(IteratorType it)
+        {
+            m_table.remove(it);
+        }
+
+        /**
+         * @param key
+         * @return V&
+         */
+        V& ensure(const K& key)
+        {
+            auto it = find(key);
+            if(it != end())
+                return it->value;
+
+            auto result = set(key, V());
+            VERIFY(result == HashSetResult::InsertedNewEntry);
+            return find(key)->value;
+        }
+
+        /**
+         * @tparam Callback
+         * @param key
+         * @param initialization_callback
+         * @return V&
+         */
+        template <typename Callback>
+        V& ensure(K const& key, Callback initialization_callback)
+        {
+            auto it = find(key);
+            if(it != end())
+                return it->value;
+
+            auto result = set(key, initialization_callback());
+            VERIFY(result == HashSetResult::InsertedNewEntry);
+            return find(key)->value;
+        }
+
+        /**
+         * @return Vector<K>
+         */
+        [[nodiscard]] Vector<K> keys() const
+        {
+            Vector<K> list;
+            list.ensure_capacity(size());
+            for(auto& it : *this)
+                list.unchecked_append(it.key);
+            return list;
+        }
+
+    private:
+        FlatHashTableType m_table;
+    }; // class FlatHashMap
+
+} // namespace Mods
+
+using Mods::FlatHashMap;
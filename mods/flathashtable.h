@@ -0,0 +1,838 @@
+/**
+ * @file flathashtable.h
+ * @author Krisna Pranav
+ * @brief Flat Hash Table
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include <mods/builtinwrappers.h>
+#include <mods/concept.h>
+#include <mods/error.h>
+#include <mods/forward.h>
+#include <mods/hashtable.h>
+#include <mods/simd.h>
+#include <mods/stdlibextra.h>
+#include <mods/traits.h>
+#include <mods/types.h>
+#include <mods/kmalloc.h>
+
+namespace Mods
+{
+    namespace Detail
+    {
+        /**
+         * @brief control byte values. A full slot stores the low 7 bits of its
+         *        hash (0..127), so every special value has the sign bit set.
+         */
+        enum class FlatControl : i8
+        {
+            Empty = -128,
+            Deleted = -2,
+            Sentinel = -1,
+        }; // enum class FlatControl : i8
+
+        static constexpr size_t flat_group_width = 16;
+
+        alignas(flat_group_width) inline constexpr i8 flat_hash_empty_group[flat_group_width] = {
+            static_cast<i8>(FlatControl::Sentinel),
+            static_cast<i8>(FlatControl::Empty), static_cast<i8>(FlatControl::Empty), static_cast<i8>(FlatControl::Empty),
+            static_cast<i8>(FlatControl::Empty), static_cast<i8>(FlatControl::Empty), static_cast<i8>(FlatControl::Empty),
+            static_cast<i8>(FlatControl::Empty), static_cast<i8>(FlatControl::Empty), static_cast<i8>(FlatControl::Empty),
+            static_cast<i8>(FlatControl::Empty), static_cast<i8>(FlatControl::Empty), static_cast<i8>(FlatControl::Empty),
+            static_cast<i8>(FlatControl::Empty), static_cast<i8>(FlatControl::Empty), static_cast<i8>(FlatControl::Empty),
+        };
+
+        /**
+         * @brief sixteen control bytes loaded at once; every query returns a
+         *        bitmask with bit i set for control byte i.
+         */
+        class FlatGroup
+        {
+        public:
+            /**
+             * @param control
+             */
+            ALWAYS_INLINE explicit FlatGroup(i8 const* control)
+            {
+                __builtin_memcpy(&m_control, control, sizeof(m_control));
+            }
+
+            /**
+             * @param tag
+             * @return u32
+             */
+            ALWAYS_INLINE u32 match(i8 tag) const
+            {
+                return to_mask(m_control == splat(tag));
+            }
+
+            ALWAYS_INLINE u32 match_empty() const
+            {
+                return to_mask(m_control == splat(static_cast<i8>(FlatControl::Empty)));
+            }
+
+            ALWAYS_INLINE u32 match_empty_or_deleted() const
+            {
+                return to_mask(m_control < splat(static_cast<i8>(FlatControl::Sentinel)));
+            }
+
+            /**
+             * @return size_t number of empty or deleted slots before the first
+             *         full slot or the sentinel.
+             */
+            ALWAYS_INLINE size_t count_leading_empty_or_deleted() const
+            {
+                return count_trailing_zeroes(match_empty_or_deleted() + 1);
+            }
+
+        private:
+            /**
+             * @param value
+             * @return ALWAYS_INLINE
+             */
+            ALWAYS_INLINE static SIMD::i8x16 splat(i8 value)
+            {
+                return SIMD::i8x16{value, value, value, value, value, value, value, value,
+                                   value, value, value, value, value, value, value, value};
+            }
+
+            /**
+             * @param comparison
+             * @return ALWAYS_INLINE
+             */
+            ALWAYS_INLINE static u32 to_mask(SIMD::i8x16 comparison)
+            {
+    #if defined(__SSE2__)
+                return static_cast<u32>(__builtin_ia32_pmovmskb128(reinterpret_cast<SIMD::c8x16>(comparison)));
+    #else
+                u32 mask = 0;
+                for(size_t i = 0; i < flat_group_width; ++i)
+                    mask |= static_cast<u32>(comparison[i] & 1) << i;
+                return mask;
+    #endif
+            }
+
+            SIMD::i8x16 m_control;
+        }; // class FlatGroup
+    } // namespace Detail
+
+    /**
+     * @tparam FlatHashTableType
+     * @tparam T
+     */
+    template <typename FlatHashTableType, typename T>
+    class FlatHashTableIterator
+    {
+        friend FlatHashTableType;
+
+    public:
+        /**
+         * @param other
+         * @return true
+         * @return false
+         */
+        bool operator==(FlatHashTableIterator const& other) const
+        {
+            return m_slot == other.m_slot;
+        }
+
+        /**
+         * @param other
+         * @return true
+         * @return false
+         */
+        bool operator!=(FlatHashTableIterator const& other) const
+        {
+            return m_slot != other.m_slot;
+        }
+
+        /**
+         * @return T&
+         */
+        T& operator*()
+        {
+            return *m_slot;
+        }
+
+        /**
+         * @return T*
+         */
+        T* operator->()
+        {
+            return m_slot;
+        }
+
+        void operator++()
+        {
+            ++m_control;
+            ++m_slot;
+            skip_empty_or_deleted();
+        }
+
+    private:
+        /**
+         * @brief Construct a new FlatHashTableIterator object
+         *
+         * @param control
+         * @param slot
+         */
+        FlatHashTableIterator(i8 const* control, T* slot)
+            : m_control(control)
+            , m_slot(slot)
+        {
+        }
+
+        void skip_empty_or_deleted()
+        {
+            if(!m_control)
+                return;
+
+            while(*m_control < static_cast<i8>(Detail::FlatControl::Sentinel))
+            {
+                auto skip = Detail::FlatGroup(m_control).count_leading_empty_or_deleted();
+                m_control += skip;
+                m_slot += skip;
+            }
+
+            if(*m_control == static_cast<i8>(Detail::FlatControl::Sentinel))
+            {
+                m_control = nullptr;
+                m_slot = nullptr;
+            }
+        }
+
+        i8 const* m_control{nullptr};
+        T* m_slot{nullptr};
+    }; // class FlatHashTableIterator
+
+    /**
+     * @brief open-addressing hash table in the "Swiss table" layout: a separate
+     *        control-byte array is probed a 16-byte group at a time (SSE2 when
+     *        available), so a lookup compares 16 7-bit hash tags with one
+     *        instruction and touches the slot array only for likely matches.
+     *        Capacity is always 2^n - 1 and the table grows at 7/8 full.
+     *
+     *        Control bytes: [0, capacity) one per slot, [capacity] a sentinel,
+     *        then the first 15 bytes cloned so a group that starts near the end
+     *        can be loaded without wrapping.
+     *
+     * @tparam T
+     * @tparam TraitsForT
+     */
+    template <typename T, typename TraitsForT>
+    class FlatHashTable
+    {
+        static_assert(alignof(T) <= 16, "FlatHashTable slots are carved out of a kmalloc block");
+
+        static constexpr size_t group_width = Detail::flat_group_width;
+        static constexpr size_t cloned_bytes = group_width - 1;
+        static constexpr size_t minimum_capacity = group_width - 1;
+
+    public:
+        /**
+         * @brief Construct a new FlatHashTable object
+         *
+         */
+        FlatHashTable() = default;
+
+        /**
+         * @brief Construct a new FlatHashTable object
+         *
+         * @param capacity
+         */
+        explicit FlatHashTable(size_t capacity)
+        {
+            ensure_capacity(capacity);
+        }
+
+        /**
+         * @brief Destroy the FlatHashTable object
+         *
+         */
+        ~FlatHashTable()
+        {
+            destroy_and_deallocate();
+        }
+
+        /**
+         * @brief Construct a new FlatHashTable object
+         *
+         * @param other
+         */
+        FlatHashTable(FlatHashTable const& other)
+        {
+            ensure_capacity(other.size());
+            for(auto& it : other)
+                set(it);
+        }
+
+        /**
+         * @param other
+         * @return FlatHashTable&
+         */
+        FlatHashTable& operator=(FlatHashTable const& other)
+        {
+            FlatHashTable temporary(other);
+            swap(*this, temporary);
+            return *this;
+        }
+
+        /**
+         * @brief Construct a new FlatHashTable object
+         *
+         * @param other
+         */
+        FlatHashTable(FlatHashTable&& other) noexcept
+            : m_control(other.m_control)
+            , m_slots(other.m_slots)
+            , m_size(other.m_size)
+            , m_capacity(other.m_capacity)
+            , m_growth_left(other.m_growth_left)
+        {
+            other.reset_to_empty();
+        }
+
+        /**
+         * @param other
+         * @return FlatHashTable&
+         */
+        FlatHashTable& operator=(FlatHashTable&& other) noexcept
+        {
+            FlatHashTable temporary{move(other)};
+            swap(*this, temporary);
+            return *this;
+        }
+
+        /**
+         * @param a
+         * @param b
+         */
+        friend void swap(FlatHashTable& a, FlatHashTable& b) noexcept
+        {
+            swap(a.m_control, b.m_control);
+            swap(a.m_slots, b.m_slots);
+            swap(a.m_size, b.m_size);
+            swap(a.m_capacity, b.m_capacity);
+            swap(a.m_growth_left, b.m_growth_left);
+        }
+
+        [[nodiscard]] bool is_empty() const
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] size_t size() const
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] size_t capacity() const
+        {
+            return m_capacity;
+        }
+
+        /**
+         * @param capacity
+         */
+        void ensure_capacity(size_t capacity)
+        {
+            MUST(try_ensure_capacity(capacity));
+        }
+
+        /**
+         * @brief makes room for capacity entries without another rehash.
+         *
+         * @param capacity
+         * @return ErrorOr<void>
+         */
+        ErrorOr<void> try_ensure_capacity(size_t capacity)
+        {
+            VERIFY(capacity >= size());
+            if(capacity <= growth_for_capacity(m_capacity))
+                return {};
+            return try_rehash(capacity_for_entries(capacity));
+        }
+
+        /**
+         * @param value
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool contains(T const& value) const
+        {
+            return find(value) != end();
+        }
+
+        /**
+         * @tparam K
+         * @param value
+         * @return true
+         * @return false
+         */
+        template <Concepts::HashCompatible<T> K>
+            requires(IsSame<TraitsForT, Traits<T>>)
+        [[nodiscard]] bool contains(K const& value) const
+        {
+            return find(value) != end();
+        }
+
+        using Iterator = FlatHashTableIterator<FlatHashTable, T>;
+        using ConstIterator = FlatHashTableIterator<const FlatHashTable, const T>;
+
+        [[nodiscard]] Iterator begin()
+        {
+            Iterator it(m_control, m_slots);
+            it.skip_empty_or_deleted();
+            return it;
+        }
+
+        [[nodiscard]] Iterator end()
+        {
+            return Iterator(nullptr, nullptr);
+        }
+
+        [[nodiscard]] ConstIterator begin() const
+        {
+            ConstIterator it(m_control, m_slots);
+            it.skip_empty_or_deleted();
+            return it;
+        }
+
+        [[nodiscard]] ConstIterator end() const
+        {
+            return ConstIterator(nullptr, nullptr);
+        }
+
+        void clear()
+        {
+            *this = FlatHashTable();
+        }
+
+        void clear_with_capacity()
+        {
+            if(!m_capacity)
+                return;
+
+            destroy_entries();
+            reset_control_bytes();
+            m_size = 0;
+            m_growth_left = growth_for_capacity(m_capacity);
+        }
+
+        /**
+         * @tparam U
+         * @param value
+         * @param existing_entry_behavior
+         * @return ErrorOr<HashSetResult>
+         */
+        template <typename U = T>
+        ErrorOr<HashSetResult> try_set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
+        {
+            auto hash = TraitsForT::hash(value);
+            if(auto* existing = lookup_with_hash(hash, [&](auto& other) { return TraitsForT::equals(value, other); }))
+            {
+                if(existing_entry_behavior == HashSetExistingEntryBehavior::Keep)
+                    return HashSetResult::KeptExistingEntry;
+                *existing = forward<U>(value);
+                return HashSetResult::ReplacedExistingEntry;
+            }
+
+            auto index = find_first_non_full(hash);
+            if(m_growth_left == 0 && m_control[index] != static_cast<i8>(Detail::FlatControl::Deleted))
+            {
+                TRY(try_grow_or_drop_deleted());
+                index = find_first_non_full(hash);
+            }
+
+            new(&m_slots[index]) T(forward<U>(value));
+            if(m_control[index] == static_cast<i8>(Detail::FlatControl::Empty))
+                --m_growth_left;
+            set_control(index, tag_for_hash(hash));
+            ++m_size;
+            return HashSetResult::InsertedNewEntry;
+        }
+
+        /**
+         * @tparam U
+         * @param value
+         * @param existing_entry_behaviour
+         * @return HashSetResult
+         */
+        template <typename U = T>
+        HashSetResult set(U&& value, HashSetExistingEntryBehavior existing_entry_behaviour = HashSetExistingEntryBehavior::Replace)
+        {
+            return MUST(try_set(forward<U>(value), existing_entry_behaviour));
+        }
+
+        /**
+         * @tparam TUnaryPredicate
+         * @param hash
+         * @param predicate
+         * @return Iterator
+         */
+        template <typename TUnaryPredicate>
+        [[nodiscard]] Iterator find(unsigned hash, TUnaryPredicate predicate)
+        {
+            return iterator_for(lookup_with_hash(hash, move(predicate)));
+        }
+
+        [[nodiscard]] Iterator find(T const& value)
+        {
+            return find(TraitsForT::hash(value), [&](auto& other)
+                        { return TraitsForT::equals(value, other); });
+        }
+
+        template <typename TUnaryPredicate>
+        [[nodiscard]] ConstIterator find(unsigned hash, TUnaryPredicate predicate) const
+        {
+            auto* slot = lookup_with_hash(hash, move(predicate));
+            if(!slot)
+                return end();
+            return ConstIterator(&m_control[slot - m_slots], slot);
+        }
+
+        [[nodiscard]] ConstIterator find(T const& value) const
+        {
+            return find(TraitsForT::hash(value), [&](auto& other)
+                        { return TraitsForT::equals(value, other); });
+        }
+
+        template <Concepts::HashCompatible<T> K>
+            requires(IsSame<TraitsForT, Traits<T>>)
+        [[nodiscard]] Iterator find(K const& value)
+        {
+            return find(Traits<K>::hash(value), [&](auto& other)
+                        { return Traits<T>::equals(other, value); });
+        }
+
+        template <Concepts::HashCompatible<T> K>
+            requires(IsSame<TraitsForT, Traits<T>>)
+        [[nodiscard]] ConstIterator find(K const& value) const
+        {
+            return find(Traits<K>::hash(value), [&](auto& other)
+                        { return Traits<T>::equals(other, value); });
+        }
+
+        /**
+         * @param value
+         * @return true
+         * @return false
+         */
+        bool remove(T const& value)
+        {
+            auto it = find(value);
+            if(it != end())
+            {
+                remove(it);
+                return true;
+            }
+            return false;
+        }
+
+        template <Concepts::HashCompatible<T> K>
+            requires(IsSame<TraitsForT, Traits<T>>)
+        bool remove(K const& value)
+        {
+            auto it = find(value);
+            if(it != end())
+            {
+                remove(it);
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief a slot only becomes a tombstone if some probe sequence could
+         *        have walked past it, i.e. its neighbourhood had no empty slot
+         *        within one group; otherwise it goes straight back to empty.
+         *
+         * @param iterator
+         */
+        void remove(Iterator iterator)
+        {
+            VERIFY(iterator.m_slot);
+            size_t index = iterator.m_slot - m_slots;
+            VERIFY(m_control[index] >= 0);
+
+            m_slots[index].~T();
+            --m_size;
+
+            size_t index_before = (index - group_width) & m_capacity;
+            auto empty_after = Detail::FlatGroup(m_control + index).match_empty();
+            auto empty_before = Detail::FlatGroup(m_control + index_before).match_empty();
+
+            bool was_never_full = empty_before && empty_after
+                && static_cast<size_t>(count_trailing_zeroes(empty_after) + count_leading_zeroes(empty_before << (32 - group_width))) < group_width;
+
+            if(was_never_full)
+            {
+                set_control(index, static_cast<i8>(Detail::FlatControl::Empty));
+                ++m_growth_left;
+            }
+            else
+            {
+                set_control(index, static_cast<i8>(Detail::FlatControl::Deleted));
+            }
+        }
+
+        /**
+         * @tparam TUnaryPredicate
+         * @param predicate
+         * @return true
+         * @return false
+         */
+        template <typename TUnaryPredicate>
+        bool remove_all_matching(TUnaryPredicate predicate)
+        {
+            size_t removed_count = 0;
+            for(auto it = begin(); it != end();)
+            {
+                auto current = it;
+                ++it;
+                if(predicate(*current))
+                {
+                    remove(current);
+                    ++removed_count;
+                }
+            }
+            return removed_count;
+        }
+
+    private:
+        /**
+         * @brief Traits hashes are only 32 bits and not always well mixed in
+         *        the low bits, which a power-of-two mask would expose; one
+         *        multiply spreads every input bit into the bits used below.
+         *
+         * @param hash
+         * @return u64
+         */
+        ALWAYS_INLINE static u64 mix(unsigned hash)
+        {
+            return static_cast<u64>(hash) * 0x9E3779B97F4A7C15ull;
+        }
+
+        ALWAYS_INLINE static size_t probe_start_for_hash(unsigned hash)
+        {
+            return static_cast<size_t>(mix(hash) >> 32);
+        }
+
+        ALWAYS_INLINE static i8 tag_for_hash(unsigned hash)
+        {
+            return static_cast<i8>((mix(hash) >> 25) & 0x7f);
+        }
+
+        /**
+         * @param capacity
+         * @return size_t entries that fit before the table is 7/8 full
+         */
+        static constexpr size_t growth_for_capacity(size_t capacity)
+        {
+            return capacity - capacity / 8;
+        }
+
+        /**
+         * @param entries
+         * @return size_t smallest 2^n - 1 capacity that holds entries
+         */
+        static constexpr size_t capacity_for_entries(size_t entries)
+        {
+            size_t capacity = minimum_capacity;
+            while(growth_for_capacity(capacity) < entries)
+                capacity = capacity * 2 + 1;
+            return capacity;
+        }
+
+        static constexpr size_t control_bytes_for_capacity(size_t capacity)
+        {
+            return (capacity + 1 + cloned_bytes + 15) & ~static_cast<size_t>(15);
+        }
+
+        static constexpr size_t allocation_size_for_capacity(size_t capacity)
+        {
+            return control_bytes_for_capacity(capacity) + capacity * sizeof(T);
+        }
+
+        /**
+         * @param slot
+         * @return Iterator
+         */
+        Iterator iterator_for(T* slot)
+        {
+            if(!slot)
+                return end();
+            return Iterator(&m_control[slot - m_slots], slot);
+        }
+
+        /**
+         * @tparam TUnaryPredicate
+         * @param hash
+         * @param predicate
+         * @return T*
+         */
+        template <typename TUnaryPredicate>
+        [[nodiscard]] T* lookup_with_hash(unsigned hash, TUnaryPredicate predicate) const
+        {
+            auto tag = tag_for_hash(hash);
+            size_t offset = probe_start_for_hash(hash) & m_capacity;
+            size_t stride = 0;
+
+            for(;;)
+            {
+                Detail::FlatGroup group(m_control + offset);
+                for(auto matches = group.match(tag); matches; matches &= matches - 1)
+                {
+                    size_t index = (offset + count_trailing_zeroes(matches)) & m_capacity;
+                    if(predicate(m_slots[index]))
+                        return &m_slots[index];
+                }
+
+                if(group.match_empty())
+                    return nullptr;
+
+                stride += group_width;
+                VERIFY(stride <= m_capacity + group_width);
+                offset = (offset + stride) & m_capacity;
+            }
+        }
+
+        /**
+         * @param hash
+         * @return size_t the first empty or deleted slot on hash's probe sequence
+         */
+        size_t find_first_non_full(unsigned hash) const
+        {
+            size_t offset = probe_start_for_hash(hash) & m_capacity;
+            size_t stride = 0;
+
+            for(;;)
+            {
+                auto available = Detail::FlatGroup(m_control + offset).match_empty_or_deleted();
+                if(available)
+                    return (offset + count_trailing_zeroes(available)) & m_capacity;
+
+                stride += group_width;
+                VERIFY(stride <= m_capacity + group_width);
+                offset = (offset + stride) & m_capacity;
+            }
+        }
+
+        /**
+         * @brief writes a control byte and its clone past the sentinel.
+         *
+         * @param index
+         * @param value
+         */
+        ALWAYS_INLINE void set_control(size_t index, i8 value)
+        {
+            m_control[index] = value;
+            m_control[((index - cloned_bytes) & m_capacity) + cloned_bytes] = value;
+        }
+
+        void reset_control_bytes()
+        {
+            __builtin_memset(m_control, static_cast<i8>(Detail::FlatControl::Empty), m_capacity + 1 + cloned_bytes);
+            m_control[m_capacity] = static_cast<i8>(Detail::FlatControl::Sentinel);
+        }
+
+        /**
+         * @brief out of room: if tombstones make up a good share of the table a
+         *        same-size rehash is enough, otherwise double.
+         *
+         * @return ErrorOr<void>
+         */
+        ErrorOr<void> try_grow_or_drop_deleted()
+        {
+            if(m_capacity > group_width && m_size * 32 <= m_capacity * 25)
+                return try_rehash(m_capacity);
+            return try_rehash(m_capacity ? m_capacity * 2 + 1 : minimum_capacity);
+        }
+
+        /**
+         * @param new_capacity
+         * @return ErrorOr<void>
+         */
+        ErrorOr<void> try_rehash(size_t new_capacity)
+        {
+            VERIFY(((new_capacity + 1) & new_capacity) == 0);
+            VERIFY(new_capacity >= minimum_capacity);
+
+            auto* block = static_cast<u8*>(kmalloc(allocation_size_for_capacity(new_capacity)));
+            if(!block)
+                return Error::from_errno(ENOMEM);
+
+            auto* old_control = m_control;
+            auto* old_slots = m_slots;
+            auto old_capacity = m_capacity;
+
+            m_control = reinterpret_cast<i8*>(block);
+            m_slots = reinterpret_cast<T*>(block + control_bytes_for_capacity(new_capacity));
+            m_capacity = new_capacity;
+            m_growth_left = growth_for_capacity(new_capacity) - m_size;
+            reset_control_bytes();
+
+            for(size_t i = 0; i < old_capacity; ++i)
+            {
+                if(old_control[i] < 0)
+                    continue;
+
+                auto hash = TraitsForT::hash(old_slots[i]);
+                auto index = find_first_non_full(hash);
+                new(&m_slots[index]) T(move(old_slots[i]));
+                set_control(index, tag_for_hash(hash));
+                old_slots[i].~T();
+            }
+
+            if(old_capacity)
+                kfree_sized(old_control, allocation_size_for_capacity(old_capacity));
+            return {};
+        }
+
+        void destroy_entries()
+        {
+            if constexpr(!Detail::IsTriviallyDestructible<T>)
+            {
+                for(size_t i = 0; i < m_capacity; ++i)
+                {
+                    if(m_control[i] >= 0)
+                        m_slots[i].~T();
+                }
+            }
+        }
+
+        void destroy_and_deallocate()
+        {
+            if(!m_capacity)
+                return;
+            destroy_entries();
+            kfree_sized(m_control, allocation_size_for_capacity(m_capacity));
+            reset_to_empty();
+        }
+
+        void reset_to_empty()
+        {
+            m_control = const_cast<i8*>(Detail::flat_hash_empty_group);
+            m_slots = nullptr;
+            m_size = 0;
+            m_capacity = 0;
+            m_growth_left = 0;
+        }
+
+        i8* m_control{const_cast<i8*>(Detail::flat_hash_empty_group)};
+        T* m_slots{nullptr};
+        size_t m_size{0};
+        size_t m_capacity{0};
+        size_t m_growth_left{0};
+    }; // class FlatHashTable
+
+} // namespace Mods
+
+using Mods::FlatHashSet;
+using Mods::FlatHashTable;
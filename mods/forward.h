@@ -158,6 +158,27 @@ namespace Mods
     template<typename K, typename V, typename KeyTraits = Traits<K>, typename ValueTraits = Traits<V>>
     using OrderedHashMap = HashMap<K, V, KeyTraits, ValueTraits, true>;
 
+    /**
+     * @tparam T
+     * @tparam TraitsForT
+     */
+    template<typename T, typename TraitsForT = Traits<T>>
+    class FlatHashTable;
+
+    /**
+     * @tparam T
+     */
+    template<typename T, typename TraitsForT = Traits<T>>
+    using FlatHashSet = FlatHashTable<T, TraitsForT>;
+
+    /**
+     * @tparam K
+     * @tparam V
+     * @tparam KeyTraits
+     */
+    template<typename K, typename V, typename KeyTraits = Traits<K>>
+    class FlatHashMap;
+
     /**
      * @tparam T
      */
@@ -279,6 +300,9 @@ using Mods::Error;
 using Mods::ErrorOr;
 using Mods::FixedArray;
 using Mods::FixedPoint;
+using Mods::FlatHashMap;
+using Mods::FlatHashSet;
+using Mods::FlatHashTable;
 using Mods::FlyString;
 using Mods::Function;
 using Mods::GenericLexer;
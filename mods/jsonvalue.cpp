@@ -274,8 +274,7 @@ namespace Mods
         else
         {
             m_type = Type::String;
-            m_value.as_string = const_cast<StringImpl*>(value.impl());
-            m_value.as_string->ref();
+            m_value.as_string = value.impl().leak_ref();
         }
     }
 
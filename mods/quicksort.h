@@ -11,206 +11,395 @@
 
 #pragma once
 
+#include <mods/builtinwrappers.h>
 #include <mods/stdlibextra.h>
 
 namespace Mods
 {
     /**
-     * @tparam Collection 
-     * @tparam LessThan 
-     * @param col 
-     * @param start 
-     * @param end 
-     * @param less_than 
+     * @brief pattern-defeating quicksort (Orson Peters' pdqsort), written purely in
+     *        terms of col[i], swap() and less_than so that proxy collections
+     *        (like LibC's qsort slices) work as well as Vector or Array.
      */
-    template <typename Collection, typename LessThan>
-    void dual_pivot_quick_sort(Collection& col, int start, int end, LessThan less_than)
+    namespace Detail
     {
-        while(start < end)
+        static constexpr size_t insertion_sort_threshold = 24;
+        static constexpr size_t ninther_threshold = 128;
+        static constexpr size_t partial_insertion_sort_limit = 8;
+
+        /**
+         * @tparam Collection
+         * @tparam LessThan
+         * @param col
+         * @param begin
+         * @param end
+         * @param less_than
+         */
+        template <typename Collection, typename LessThan>
+        void insertion_sort(Collection& col, size_t begin, size_t end, LessThan& less_than)
         {
-            int size = end - start + 1;
-            if(size > 3)
+            for(size_t i = begin + 1; i < end; ++i)
             {
-                int third = size / 3;
-                if(less_than(col[start + third], col[end - third]))
-                {
-                    swap(col[start + third], col[start]);
-                    swap(col[end - third], col[end]);
-                }
-                else
-                {
-                    swap(col[start + third], col[end]);
-                    swap(col[end - third], col[start]);
-                }
+                for(size_t j = i; j > begin && less_than(col[j], col[j - 1]); --j)
+                    swap(col[j], col[j - 1]);
             }
-            else
+        }
+
+        /**
+         * @brief insertion sort that gives up after moving too many elements; used
+         *        to finish off partitions that already look sorted.
+         *
+         * @return true if [begin, end) is now sorted
+         */
+        template <typename Collection, typename LessThan>
+        bool partial_insertion_sort(Collection& col, size_t begin, size_t end, LessThan& less_than)
+        {
+            size_t moves = 0;
+            for(size_t i = begin + 1; i < end; ++i)
             {
-                if(!less_than(col[start], col[end]))
-                {
-                    swap(col[start], col[end]);
-                }
+                size_t j = i;
+                for(; j > begin && less_than(col[j], col[j - 1]); --j)
+                    swap(col[j], col[j - 1]);
+
+                moves += i - j;
+                if(moves > partial_insertion_sort_limit)
+                    return false;
             }
+            return true;
+        }
 
-            int j = start + 1;
-            int k = start + 1;
-            int g = end - 1;
+        /**
+         * @brief orders col[a] <= col[b] <= col[c]
+         */
+        template <typename Collection, typename LessThan>
+        void sort3(Collection& col, size_t a, size_t b, size_t c, LessThan& less_than)
+        {
+            if(less_than(col[b], col[a]))
+                swap(col[a], col[b]);
+            if(less_than(col[c], col[b]))
+            {
+                swap(col[b], col[c]);
+                if(less_than(col[b], col[a]))
+                    swap(col[a], col[b]);
+            }
+        }
+
+        /**
+         * @tparam Collection
+         * @tparam LessThan
+         * @param col
+         * @param begin
+         * @param root
+         * @param size
+         * @param less_than
+         */
+        template <typename Collection, typename LessThan>
+        void sift_down(Collection& col, size_t begin, size_t root, size_t size, LessThan& less_than)
+        {
+            for(;;)
+            {
+                size_t child = 2 * root + 1;
+                if(child >= size)
+                    return;
+                if(child + 1 < size && less_than(col[begin + child], col[begin + child + 1]))
+                    ++child;
+                if(!less_than(col[begin + root], col[begin + child]))
+                    return;
+                swap(col[begin + root], col[begin + child]);
+                root = child;
+            }
+        }
 
-            auto&& left_pivot = col[start];
-            auto&& right_pivot = col[end];
+        /**
+         * @brief guarantees O(n log n) once quicksort has seen too many bad
+         *        partitions.
+         */
+        template <typename Collection, typename LessThan>
+        void heap_sort(Collection& col, size_t begin, size_t end, LessThan& less_than)
+        {
+            size_t size = end - begin;
+            for(size_t i = size / 2; i > 0; --i)
+                sift_down(col, begin, i - 1, size, less_than);
 
-            while(k <= g)
+            for(size_t i = size - 1; i > 0; --i)
             {
-                if(less_than(col[k], left_pivot))
-                {
-                    swap(col[k], col[j]);
-                    j++;
-                }
-                else if(!less_than(col[k], right_pivot))
-                {
-                    while(!less_than(col[g], right_pivot) && k < g)
-                    {
-                        g--;
-                    }
-                    swap(col[k], col[g]);
-                    g--;
-                    if(less_than(col[k], left_pivot))
-                    {
-                        swap(col[k], col[j]);
-                        j++;
-                    }
-                }
-                k++;
+                swap(col[begin], col[begin + i]);
+                sift_down(col, begin, 0, i, less_than);
             }
-            j--;
-            g++;
+        }
+
+        /**
+         * @brief partitions around the pivot at col[begin], putting elements equal
+         *        to the pivot on the right. Every scan is bounded by the other
+         *        cursor rather than by a sentinel element, so a comparator that
+         *        is not a strict weak ordering (qsort() hands us user ones) can
+         *        only produce a wrong order, never an access outside the range.
+         *
+         * @param already_partitioned set when no swaps were needed
+         * @return size_t the pivot's final position
+         */
+        template <typename Collection, typename LessThan>
+        size_t partition_right(Collection& col, size_t begin, size_t end, LessThan& less_than, bool& already_partitioned)
+        {
+            auto&& pivot = col[begin];
 
-            swap(col[start], col[j]);
-            swap(col[end], col[g]);
+            // [begin + 1, first) is less than the pivot, [last, end) is not
+            size_t first = begin + 1;
+            size_t last = end;
 
-            int left_pointer = j;
-            int right_pointer = g;
+            while(first < last && less_than(col[first], pivot))
+                ++first;
+            while(first < last && !less_than(col[last - 1], pivot))
+                --last;
 
-            int left_size = left_pointer - start;
-            int middle_size = right_pointer - (left_pointer + 1);
-            int right_size = (end + 1) - (right_pointer + 1);
+            already_partitioned = first >= last;
 
-            if(left_size >= middle_size && left_size >= right_size)
+            while(first < last)
             {
-                dual_pivot_quick_sort(col, left_pointer + 1, right_pointer - 1, less_than);
-                dual_pivot_quick_sort(col, right_pointer + 1, end, less_than);
-                end = left_pointer - 1;
+                swap(col[first++], col[--last]);
+                while(first < last && less_than(col[first], pivot))
+                    ++first;
+                while(first < last && !less_than(col[last - 1], pivot))
+                    --last;
             }
-            else if(middle_size >= right_size)
+
+            size_t pivot_position = first - 1;
+            swap(col[begin], col[pivot_position]);
+            return pivot_position;
+        }
+
+        /**
+         * @brief partitions around the pivot at col[begin], putting elements equal
+         *        to the pivot on the left. Only used when the element before begin
+         *        equals the pivot, so the whole equal range is finished in one go.
+         *        Bounded the same way as partition_right().
+         */
+        template <typename Collection, typename LessThan>
+        size_t partition_left(Collection& col, size_t begin, size_t end, LessThan& less_than)
+        {
+            auto&& pivot = col[begin];
+
+            // [begin, first] is not greater than the pivot, [last, end) is
+            size_t first = begin;
+            size_t last = end;
+
+            while(first + 1 < last && less_than(pivot, col[last - 1]))
+                --last;
+            while(first + 1 < last && !less_than(pivot, col[first + 1]))
+                ++first;
+
+            while(first + 1 < last)
             {
-                dual_pivot_quick_sort(col, start, left_pointer - 1, less_than);
-                dual_pivot_quick_sort(col, right_pointer + 1, end, less_than);
-                start = left_pointer + 1;
-                end = right_pointer - 1;
+                swap(col[++first], col[--last]);
+                while(first + 1 < last && less_than(pivot, col[last - 1]))
+                    --last;
+                while(first + 1 < last && !less_than(pivot, col[first + 1]))
+                    ++first;
             }
-            else
+
+            swap(col[begin], col[first]);
+            return first;
+        }
+
+        /**
+         * @brief swaps a few elements out of their positions to break up patterns
+         *        that produced a badly unbalanced partition.
+         */
+        template <typename Collection>
+        void break_patterns(Collection& col, size_t begin, size_t end)
+        {
+            size_t size = end - begin;
+            size_t quarter = size / 4;
+
+            swap(col[begin], col[begin + quarter]);
+            swap(col[end - 1], col[end - quarter]);
+
+            if(size > ninther_threshold)
             {
-                dual_pivot_quick_sort(col, start, left_pointer - 1, less_than);
-                dual_pivot_quick_sort(col, left_pointer + 1, right_pointer - 1, less_than);
-                start = right_pointer + 1;
+                swap(col[begin + 1], col[begin + quarter + 1]);
+                swap(col[begin + 2], col[begin + quarter + 2]);
+                swap(col[end - 2], col[end - quarter - 1]);
+                swap(col[end - 3], col[end - quarter - 2]);
             }
         }
-    }
 
-    /**
-     * @tparam Iterator 
-     * @tparam LessThan 
-     * @param start 
-     * @param end 
-     * @param less_than 
-     */
-    template <typename Iterator, typename LessThan>
-    void single_pivot_quick_sort(Iterator start, Iterator end, LessThan less_than)
-    {
-        for(;;)
+        /**
+         * @tparam Collection
+         * @tparam LessThan
+         * @param col
+         * @param begin
+         * @param end
+         * @param less_than
+         * @param bad_allowed
+         * @param leftmost
+         */
+        template <typename Collection, typename LessThan>
+        void pattern_defeating_quick_sort(Collection& col, size_t begin, size_t end, LessThan& less_than, int bad_allowed, bool leftmost)
         {
-            int size = end - start;
-            if(size <= 1)
-                return;
+            for(;;)
+            {
+                size_t size = end - begin;
+                if(size < insertion_sort_threshold)
+                {
+                    insertion_sort(col, begin, end, less_than);
+                    return;
+                }
 
-            int pivot_point = size / 2;
-            if(pivot_point)
-                swap(*(start + pivot_point), *start);
+                size_t half = size / 2;
+                if(size > ninther_threshold)
+                {
+                    sort3(col, begin, begin + half, end - 1, less_than);
+                    sort3(col, begin + 1, begin + half - 1, end - 2, less_than);
+                    sort3(col, begin + 2, begin + half + 1, end - 3, less_than);
+                    sort3(col, begin + half - 1, begin + half, begin + half + 1, less_than);
+                    swap(col[begin], col[begin + half]);
+                }
+                else
+                {
+                    sort3(col, begin + half, begin, end - 1, less_than);
+                }
 
-            auto&& pivot = *start;
+                if(!leftmost && !less_than(col[begin - 1], col[begin]))
+                {
+                    begin = partition_left(col, begin, end, less_than) + 1;
+                    continue;
+                }
 
-            int i = 1;
-            for(int j = 1; j < size; ++j)
-            {
-                if(less_than(*(start + j), pivot))
+                bool already_partitioned = false;
+                size_t pivot_position = partition_right(col, begin, end, less_than, already_partitioned);
+
+                size_t left_size = pivot_position - begin;
+                size_t right_size = end - (pivot_position + 1);
+
+                if(left_size < size / 8 || right_size < size / 8)
+                {
+                    if(--bad_allowed == 0)
+                    {
+                        heap_sort(col, begin, end, less_than);
+                        return;
+                    }
+
+                    if(left_size >= insertion_sort_threshold)
+                        break_patterns(col, begin, pivot_position);
+                    if(right_size >= insertion_sort_threshold)
+                        break_patterns(col, pivot_position + 1, end);
+                }
+                else if(already_partitioned
+                    && partial_insertion_sort(col, begin, pivot_position, less_than)
+                    && partial_insertion_sort(col, pivot_position + 1, end, less_than))
                 {
-                    swap(*(start + j), *(start + i));
-                    ++i;
+                    return;
                 }
-            }
 
-            swap(*start, *(start + i - 1));
-            
-            if(i > size / 2)
-            {
-                single_pivot_quick_sort(start + i, end, less_than);
-                end = start + i - 1;
+                if(left_size < right_size)
+                {
+                    pattern_defeating_quick_sort(col, begin, pivot_position, less_than, bad_allowed, leftmost);
+                    begin = pivot_position + 1;
+                    leftmost = false;
+                }
+                else
+                {
+                    pattern_defeating_quick_sort(col, pivot_position + 1, end, less_than, bad_allowed, false);
+                    end = pivot_position;
+                }
             }
-            else
+        }
+
+        /**
+         * @brief adapts an iterator pair to the indexed interface used above.
+         */
+        template <typename Iterator>
+        struct IteratorCollection
+        {
+            Iterator start;
+
+            decltype(auto) operator[](size_t index)
             {
-                single_pivot_quick_sort(start, start + i - 1, less_than);
-                start = start + i;
+                return *(start + index);
             }
-        }
+        }; // struct IteratorCollection
+
+    } // namespace Detail
+
+    /**
+     * @brief sorts col[start, end) with pdqsort: median-of-3 (ninther for large
+     *        ranges) pivots, insertion sort below 24 elements, a heapsort
+     *        fallback after log2(n) bad partitions, and early exit on ranges
+     *        that are already sorted.
+     *
+     * @tparam Collection
+     * @tparam LessThan
+     * @param col
+     * @param start
+     * @param end
+     * @param less_than
+     */
+    template <typename Collection, typename LessThan>
+    void pattern_defeating_quick_sort(Collection& col, size_t start, size_t end, LessThan less_than)
+    {
+        if(end - start < 2)
+            return;
+
+        int bad_allowed = static_cast<int>(count_required_bits(end - start));
+        Detail::pattern_defeating_quick_sort(col, start, end, less_than, bad_allowed, true);
     }
 
     /**
-     * @tparam Iterator 
-     * @param start 
-     * @param end 
+     * @tparam Iterator
+     * @param start
+     * @param end
      */
     template <typename Iterator>
     void quick_sort(Iterator start, Iterator end)
     {
-        single_pivot_quick_sort(start, end, [](auto& a, auto& b)
-                                { return a < b; });
+        if(end - start < 2)
+            return;
+
+        Detail::IteratorCollection<Iterator> col{start};
+        pattern_defeating_quick_sort(col, 0, end - start, [](auto& a, auto& b)
+                                     { return a < b; });
     }
 
     /**
-     * @tparam Iterator 
-     * @tparam LessThan 
-     * @param start 
-     * @param end 
-     * @param less_than 
+     * @tparam Iterator
+     * @tparam LessThan
+     * @param start
+     * @param end
+     * @param less_than
      */
     template <typename Iterator, typename LessThan>
     void quick_sort(Iterator start, Iterator end, LessThan less_than)
     {
-        single_pivot_quick_sort(start, end, move(less_than));
+        if(end - start < 2)
+            return;
+
+        Detail::IteratorCollection<Iterator> col{start};
+        pattern_defeating_quick_sort(col, 0, end - start, move(less_than));
     }
 
     /**
-     * @tparam Collection 
-     * @tparam LessThan 
-     * @param collection 
-     * @param less_than 
+     * @tparam Collection
+     * @tparam LessThan
+     * @param collection
+     * @param less_than
      */
     template <typename Collection, typename LessThan>
     void quick_sort(Collection& collection, LessThan less_than)
     {
-        dual_pivot_quick_sort(collection, 0, collection.size() - 1, move(less_than));
+        pattern_defeating_quick_sort(collection, 0, collection.size(), move(less_than));
     }
 
     /**
-     * @tparam Collection 
-     * @param collection 
+     * @tparam Collection
+     * @param collection
      */
     template <typename Collection>
     void quick_sort(Collection& collection)
     {
-        dual_pivot_quick_sort(collection, 0, collection.size() - 1, [](auto& a, auto& b)
-                            { return a < b; });
+        pattern_defeating_quick_sort(collection, 0, collection.size(), [](auto& a, auto& b)
+                                     { return a < b; });
     }
 
 } // namespace Mods
 
-using Mods::quick_sort;
\ No newline at end of file
+using Mods::quick_sort;
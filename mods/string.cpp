@@ -10,6 +10,7 @@
  */
 
 #include <mods/bytebuffer.h>
+#include <mods/charactertypes.h>
 #include <mods/flystring.h>
 #include <mods/format.h>
 #include <mods/function.h>
@@ -28,7 +29,7 @@ namespace Mods
      */
     bool String::operator==(FlyString const& fly_string) const
     {
-        return m_impl == fly_string.impl() || view() == fly_string.view();
+        return view() == fly_string.bytes_as_string_view();
     }
 
     /**
@@ -38,7 +39,9 @@ namespace Mods
      */
     bool String::operator==(String const& other) const
     {
-        return m_impl == other.impl() || view() == other.view();
+        if(!is_inline() && !other.is_inline() && m_storage.impl == other.m_storage.impl)
+            return true;
+        return view() == other.view();
     }
 
     /**
@@ -93,14 +96,16 @@ namespace Mods
      */
     String String::isolated_copy() const
     {
-        if(!m_impl)
+        if(is_null())
             return {};
-        if(!m_impl->length())
+        if(is_inline())
+            return *this;
+        if(!length())
             return empty();
 
         char* buffer;
         auto impl = StringImpl::create_uninitialized(length(), buffer);
-        memcpy(buffer, m_impl->characters(), m_impl->length());
+        memcpy(buffer, characters(), length());
         return String(move(*impl));
     }
 
@@ -114,9 +119,9 @@ namespace Mods
         if(!length)
             return String::empty();
 
-        VERIFY(m_impl);
+        VERIFY(!is_null());
         VERIFY(!Checked<size_t>::addition_would_overflow(start, length));
-        VERIFY(start + length <= m_impl->length());
+        VERIFY(start + length <= this->length());
         return {characters() + start, length};
     }
 
@@ -126,7 +131,7 @@ namespace Mods
      */
     String String::substring(size_t start) const
     {
-        VERIFY(m_impl);
+        VERIFY(!is_null());
         VERIFY(start <= length());
         return {characters() + start, length() - start};
     }
@@ -138,9 +143,9 @@ namespace Mods
      */
     StringView String::substring_view(size_t start, size_t length) const
     {
-        VERIFY(m_impl);
+        VERIFY(!is_null());
         VERIFY(!Checked<size_t>::addition_would_overflow(start, length));
-        VERIFY(start + length <= m_impl->length());
+        VERIFY(start + length <= this->length());
         return {characters() + start, length};
     }
 
@@ -150,7 +155,7 @@ namespace Mods
      */
     StringView String::substring_view(size_t start) const
     {
-        VERIFY(m_impl);
+        VERIFY(!is_null());
         VERIFY(start <= length());
         return {characters() + start, length() - start};
     }
@@ -244,7 +249,7 @@ namespace Mods
      */
     ByteBuffer String::to_byte_buffer() const
     {
-        if(!m_impl)
+        if(is_null())
             return {};
         
         return ByteBuffer::copy(bytes()).release_value_but_fixme_should_propagate_errors();
@@ -573,18 +578,66 @@ namespace Mods
      * @param string 
      */
     String::String(FlyString const& string)
-        : m_impl(string.impl())
+        : String(string.bytes_as_string_view())
     {
     }
 
+    /**
+     * @param characters 
+     * @param length 
+     * @param should_chomp 
+     */
+    void String::initialize_slow(char const* characters, size_t length, ShouldChomp should_chomp)
+    {
+        set_null();
+        if(!characters)
+            return;
+
+        if(should_chomp)
+        {
+            while(length)
+            {
+                char last_ch = characters[length - 1];
+                if(!last_ch || last_ch == '\n' || last_ch == '\r')
+                    --length;
+                else
+                    break;
+            }
+        }
+
+        if(length <= inline_capacity)
+        {
+            store_inline(characters, length);
+            return;
+        }
+
+        m_storage.impl = StringImpl::create(characters, length).leak_ref();
+    }
+
+    void String::move_to_heap()
+    {
+        VERIFY(is_inline());
+        auto length = inline_length();
+        auto impl = length ? StringImpl::create(m_storage.characters, length) : RefPtr<StringImpl>(StringImpl::the_empty_stringimpl());
+        m_storage.impl = impl.leak_ref();
+        m_storage.characters[inline_capacity] = static_cast<char>(heap_marker);
+    }
+
     /**
      * @return String 
      */
     String String::to_lowercase() const
     {
-        if(!m_impl)
+        if(is_null())
             return {};
-        return m_impl->to_lowercase();
+        if(is_inline())
+        {
+            String lowercased = *this;
+            for(size_t i = 0; i < inline_length(); ++i)
+                lowercased.m_storage.characters[i] = static_cast<char>(to_ascii_lowercase(m_storage.characters[i]));
+            return lowercased;
+        }
+        return m_storage.impl->to_lowercase();
     }
 
     /**
@@ -592,9 +645,16 @@ namespace Mods
      */
     String String::to_uppercase() const
     {
-        if(!m_impl)
+        if(is_null())
             return {};
-        return m_impl->to_uppercase();
+        if(is_inline())
+        {
+            String uppercased = *this;
+            for(size_t i = 0; i < inline_length(); ++i)
+                uppercased.m_storage.characters[i] = static_cast<char>(to_ascii_uppercase(m_storage.characters[i]));
+            return uppercased;
+        }
+        return m_storage.impl->to_uppercase();
     }
 
     /**
@@ -16,6 +16,7 @@
 #include <mods/refptr.h>
 #include <mods/stream.h>
 #include <mods/stringbuilder.h>
+#include <mods/stringhash.h>
 #include <mods/stringimpl.h>
 #include <mods/stringutils.h>
 #include <mods/traits.h>
@@ -29,13 +30,20 @@ namespace Mods
          * @brief Destroy the String object
          * 
          */
-        ~String() = default;
+        ~String()
+        {
+            if(!is_inline() && m_storage.impl)
+                m_storage.impl->unref();
+        }
 
         /**
          * @brief Construct a new String object
          * 
          */
-        String() = default;
+        String()
+        {
+            set_null();
+        }
 
         /**
          * @brief Construct a new String object
@@ -43,8 +51,8 @@ namespace Mods
          * @param view 
          */
         String(StringView view)
-            : m_impl(StringImpl::create(view.characters_without_null_termination(), view.length()))
         {
+            initialize(view.characters_without_null_termination(), view.length(), NoChomp);
         }
 
         /**
@@ -53,8 +61,10 @@ namespace Mods
          * @param other 
          */
         String(String const& other)
-            : m_impl(const_cast<String&>(other).m_impl)
         {
+            __builtin_memcpy(&m_storage, &other.m_storage, sizeof(m_storage));
+            if(!is_inline() && m_storage.impl)
+                m_storage.impl->ref();
         }
 
         /**
@@ -63,8 +73,9 @@ namespace Mods
          * @param other 
          */
         String(String&& other)
-            : m_impl(move(other.m_impl))
         {
+            __builtin_memcpy(&m_storage, &other.m_storage, sizeof(m_storage));
+            other.set_null();
         }
 
         /**
@@ -74,8 +85,8 @@ namespace Mods
          * @param shouldChomp 
          */
         String(char const* cstring, ShouldChomp shouldChomp = NoChomp)
-            : m_impl(StringImpl::create(cstring, shouldChomp))
         {
+            initialize(cstring, cstring ? __builtin_strlen(cstring) : 0, shouldChomp);
         }
 
         /**
@@ -86,8 +97,8 @@ namespace Mods
          * @param shouldChomp 
          */
         String(char const* cstring, size_t length, ShouldChomp shouldChomp = NoChomp)
-            : m_impl(StringImpl::create(cstring, length, shouldChomp))
         {
+            initialize(cstring, length, shouldChomp);
         }
 
         /**
@@ -97,8 +108,8 @@ namespace Mods
          * @param shouldChomp 
          */
         explicit String(ReadonlyBytes bytes, ShouldChomp shouldChomp = NoChomp)
-            : m_impl(StringImpl::create(bytes, shouldChomp))
         {
+            initialize(reinterpret_cast<char const*>(bytes.data()), bytes.size(), shouldChomp);
         }
 
         /**
@@ -107,8 +118,9 @@ namespace Mods
          * @param impl 
          */
         String(StringImpl const& impl)
-            : m_impl(const_cast<StringImpl&>(impl))
         {
+            impl.ref();
+            adopt_impl(&const_cast<StringImpl&>(impl));
         }
 
         /**
@@ -117,8 +129,10 @@ namespace Mods
          * @param impl 
          */
         String(StringImpl const* impl)
-            : m_impl(const_cast<StringImpl*>(impl))
         {
+            if(impl)
+                impl->ref();
+            adopt_impl(const_cast<StringImpl*>(impl));
         }
 
         /**
@@ -127,8 +141,8 @@ namespace Mods
          * @param impl 
          */
         String(RefPtr<StringImpl>&& impl)
-            : m_impl(move(impl))
         {
+            adopt_impl(impl.leak_ref());
         }
 
         /**
@@ -137,8 +151,8 @@ namespace Mods
          * @param impl 
          */
         String(NonnullRefPtr<StringImpl>&& impl)
-            : m_impl(move(impl))
         {
+            adopt_impl(&impl.leak_ref());
         }
 
         /**
@@ -384,7 +398,7 @@ namespace Mods
          */
         [[nodiscard]] bool is_null() const
         {
-            return !m_impl;
+            return !is_inline() && !m_storage.impl;
         }
 
         /**
@@ -400,7 +414,9 @@ namespace Mods
          */
         [[nodiscard]] ALWAYS_INLINE size_t length() const
         {
-            return m_impl ? m_impl->length() : 0;
+            if(is_inline())
+                return inline_length();
+            return m_storage.impl ? m_storage.impl->length() : 0;
         }
         
         /**
@@ -408,7 +424,9 @@ namespace Mods
          */
         [[nodiscard]] ALWAYS_INLINE char const* characters() const
         {
-            return m_impl ? m_impl->characters() : nullptr;
+            if(is_inline())
+                return m_storage.characters;
+            return m_storage.impl ? m_storage.impl->characters() : nullptr;
         }
 
         /**
@@ -424,11 +442,9 @@ namespace Mods
          */
         [[nodiscard]] ALWAYS_INLINE ReadonlyBytes bytes() const
         {
-            if(m_impl)
-            {
-                return m_impl->bytes();
-            }
-            return {};
+            if(is_null())
+                return {};
+            return {characters(), length()};
         }
 
         /**
@@ -438,7 +454,8 @@ namespace Mods
         [[nodiscard]] ALWAYS_INLINE char const& operator[](size_t i) const
         {
             VERIFY(!is_null());
-            return (*m_impl)[i];
+            VERIFY(i < length());
+            return characters()[i];
         }
 
         using ConstIterator = SimpleIterator<const String, char const>;
@@ -608,24 +625,45 @@ namespace Mods
          */
         [[nodiscard]] static String empty()
         {
-            return StringImpl::the_empty_stringimpl();
+            return String("", 0);
         }
 
         /**
+         * @brief strings of up to inline_capacity bytes live inside the String
+         *        itself and have no StringImpl until someone asks for one; this
+         *        moves them to the heap, so any characters() pointer taken
+         *        before the call is invalidated.
+         *
          * @return StringImpl* 
          */
         [[nodiscard]] StringImpl* impl()
         {
-            return m_impl.ptr();
+            if(is_inline())
+                move_to_heap();
+            return m_storage.impl;
         }
 
         /**
-         * @return StringImpl const* 
+         * @brief leaves the String as it is: an inline string gets a fresh
+         *        StringImpl of its own, a heap string hands out its shared one.
+         *
+         * @return RefPtr<StringImpl> 
          */
-        [[nodiscard]] StringImpl const* impl() const
+        [[nodiscard]] RefPtr<StringImpl> impl() const
         {
-            return m_impl.ptr();
-        }   
+            if(is_inline())
+                return StringImpl::create(m_storage.characters, inline_length());
+            return m_storage.impl;
+        }
+
+        /**
+         * @return true if the characters are stored inline and the string owns
+         *         no heap allocation.
+         */
+        [[nodiscard]] ALWAYS_INLINE bool is_inline() const
+        {
+            return static_cast<u8>(m_storage.characters[inline_capacity]) != heap_marker;
+        }
 
         /**
          * @param other 
@@ -634,7 +672,11 @@ namespace Mods
         String& operator=(String&& other)
         {
             if(this != &other)
-                m_impl = move(other.m_impl);
+            {
+                release();
+                __builtin_memcpy(&m_storage, &other.m_storage, sizeof(m_storage));
+                other.set_null();
+            }
             return *this;
         }   
 
@@ -645,7 +687,7 @@ namespace Mods
         String& operator=(String const& other)
         {
             if(this != &other)
-                m_impl = const_cast<String&>(other).m_impl;
+                *this = String(other);
             return *this;
         }
 
@@ -654,7 +696,8 @@ namespace Mods
          */
         String& operator=(std::nullptr_t)
         {
-            m_impl = nullptr;
+            release();
+            set_null();
             return *this;
         }
 
@@ -664,7 +707,7 @@ namespace Mods
          */
         String& operator=(ReadonlyBytes bytes)
         {
-            m_impl = StringImpl::create(bytes);
+            *this = String(bytes);
             return *this;
         }
 
@@ -673,9 +716,19 @@ namespace Mods
          */
         [[nodiscard]] u32 hash() const
         {
-            if(!m_impl)
+            if(is_inline())
+                return string_hash(m_storage.characters, inline_length());
+            if(!m_storage.impl)
                 return 0;
-            return m_impl->hash();
+            return m_storage.impl->hash();
+        }
+
+        /**
+         * @return u32 
+         */
+        [[nodiscard]] u32 case_insensitive_hash() const
+        {
+            return case_insensitive_string_hash(characters(), length());
         }
 
         /**
@@ -787,8 +840,82 @@ namespace Mods
                     }());
         }
 
+        /**
+         * @brief longest string stored without a heap allocation; the whole
+         *        String stays three pointers wide.
+         */
+        static constexpr size_t inline_capacity = 3 * sizeof(void*) - 1;
+
     private:
-        RefPtr<StringImpl> m_impl;
+        static constexpr u8 heap_marker = 0xff;
+
+        /**
+         * @return size_t 
+         */
+        ALWAYS_INLINE size_t inline_length() const
+        {
+            return inline_capacity - static_cast<u8>(m_storage.characters[inline_capacity]);
+        }
+
+        ALWAYS_INLINE void set_null()
+        {
+            m_storage.impl = nullptr;
+            m_storage.characters[inline_capacity] = static_cast<char>(heap_marker);
+        }
+
+        ALWAYS_INLINE void release()
+        {
+            if(!is_inline() && m_storage.impl)
+                m_storage.impl->unref();
+        }
+
+        /**
+         * @param impl an already-referenced StringImpl, or nullptr
+         */
+        ALWAYS_INLINE void adopt_impl(StringImpl* impl)
+        {
+            set_null();
+            m_storage.impl = impl;
+        }
+
+        /**
+         * @brief the last byte holds inline_capacity - length, so a full inline
+         *        string's length byte doubles as its null terminator.
+         *
+         * @param characters 
+         * @param length 
+         */
+        ALWAYS_INLINE void store_inline(char const* characters, size_t length)
+        {
+            __builtin_memcpy(m_storage.characters, characters, length);
+            m_storage.characters[length] = '\0';
+            m_storage.characters[inline_capacity] = static_cast<char>(inline_capacity - length);
+        }
+
+        /**
+         * @param characters 
+         * @param length 
+         * @param should_chomp 
+         */
+        ALWAYS_INLINE void initialize(char const* characters, size_t length, ShouldChomp should_chomp)
+        {
+            if(characters && length <= inline_capacity && should_chomp == NoChomp)
+            {
+                store_inline(characters, length);
+                return;
+            }
+            initialize_slow(characters, length, should_chomp);
+        }
+
+        void initialize_slow(char const* characters, size_t length, ShouldChomp);
+
+        void move_to_heap();
+
+        union
+        {
+            StringImpl* impl;
+            char characters[inline_capacity + 1];
+        } m_storage;
     }; // class String
 
     template <>
@@ -800,7 +927,7 @@ namespace Mods
          */
         static unsigned hash(String const& s)
         {
-            return s.impl() ? s.impl()->hash() : 0;
+            return s.hash();
         }
     }; // struct Traits<String> : public GenericTraits<String>
 
@@ -812,7 +939,7 @@ namespace Mods
          */
         static unsigned hash(String const& s)
         {
-            return s.impl() ? s.impl()->case_insensitive_hash() : 0;
+            return s.case_insensitive_hash();
         }
 
         /**
@@ -13,6 +13,7 @@
 #include <mods/charactertypes.h>
 #include <mods/debug.h>
 #include <mods/format.h>
+#include <mods/simd.h>
 #include <mods/utf8view.h>
 
 namespace Mods
@@ -136,42 +137,98 @@ namespace Mods
     }
 
     /**
-     * @param valid_bytes 
-     * @return true 
-     * @return false 
+     * @param data
+     * @param length
+     * @return size_t
      */
-    bool Utf8View::validate(size_t& valid_bytes) const
+    size_t ascii_prefix_length(u8 const* data, size_t length)
+    {
+        using u64_unaligned = u64 __attribute__((aligned(1), may_alias));
+        size_t i = 0;
+
+    #if defined(__SSE2__)
+        using u8x16_unaligned = u8 __attribute__((vector_size(16), aligned(1), may_alias));
+
+        for(; i + 32 <= length; i += 32)
+        {
+            auto low = *reinterpret_cast<u8x16_unaligned const*>(data + i);
+            auto high = *reinterpret_cast<u8x16_unaligned const*>(data + i + 16);
+            if(__builtin_ia32_pmovmskb128(reinterpret_cast<SIMD::c8x16>(low | high)) != 0)
+                break;
+        }
+    #endif
+
+        for(; i + 8 <= length; i += 8)
+        {
+            if(*reinterpret_cast<u64_unaligned const*>(data + i) & 0x8080808080808080ull)
+                break;
+        }
+
+        while(i < length && data[i] < 0x80)
+            ++i;
+
+        return i;
+    }
+
+    /**
+     * @param data
+     * @param length
+     * @param valid_bytes
+     * @return true
+     * @return false
+     */
+    bool validate_utf8(u8 const* data, size_t length, size_t& valid_bytes)
     {
+        size_t i = 0;
         valid_bytes = 0;
-        for(auto ptr = begin_ptr(); ptr < end_ptr(); ptr++)
+
+        while(i < length)
         {
+            if(data[i] < 0x80)
+            {
+                i += ascii_prefix_length(data + i, length - i);
+                valid_bytes = i;
+                continue;
+            }
+
             size_t code_point_length_in_bytes = 0;
             u32 code_point = 0;
-            bool first_byte_makes_sense = decode_first_byte(*ptr, code_point_length_in_bytes, code_point);
+            bool first_byte_makes_sense = decode_first_byte(data[i], code_point_length_in_bytes, code_point);
             if(!first_byte_makes_sense)
                 return false;
 
-            for(size_t i = 1; i < code_point_length_in_bytes; i++)
+            if(code_point_length_in_bytes > length - i)
+                return false;
+
+            for(size_t j = 1; j < code_point_length_in_bytes; j++)
             {
-                ptr++;
-                if(ptr >= end_ptr())
-                    return false;
-                if(*ptr >> 6 != 2)
+                if(data[i + j] >> 6 != 2)
                     return false;
 
                 code_point <<= 6;
-                code_point |= *ptr & 63;
+                code_point |= data[i + j] & 63;
             }
 
             if(!is_unicode(code_point))
                 return false;
 
-            valid_bytes += code_point_length_in_bytes;
+            i += code_point_length_in_bytes;
+            valid_bytes = i;
         }
 
         return true;
     }
 
+    /**
+     * @param valid_bytes 
+     * @return true 
+     * @return false 
+     */
+    bool Utf8View::validate(size_t& valid_bytes) const
+    {
+        return validate_utf8(begin_ptr(), end_ptr() - begin_ptr(), valid_bytes);
+    }
+
     /**
      * @return size_t 
      */
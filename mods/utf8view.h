@@ -321,7 +321,32 @@ namespace Mods
         mutable size_t m_length{0};
         mutable bool m_have_length{false};
     }; // class Utf8CodePointIterator
+
+    /**
+     * @brief how many bytes from the start are ASCII. looks at 32 bytes a
+     *        step with SSE2 and 8 otherwise, so long ASCII runs in mostly
+     *        non-ASCII text cost almost nothing.
+     *
+     * @param data
+     * @param length
+     * @return size_t
+     */
+    size_t ascii_prefix_length(u8 const* data, size_t length);
+
+    /**
+     * @brief the validator behind Utf8View::validate(), for callers that
+     *        only have bytes.
+     *
+     * @param data
+     * @param length
+     * @param valid_bytes length of the longest valid prefix
+     * @return true
+     * @return false
+     */
+    bool validate_utf8(u8 const* data, size_t length, size_t& valid_bytes);
 } // namespace Mods
 
 using Mods::Utf8CodePointIterator;
-using Mods::Utf8View;
\ No newline at end of file
+using Mods::Utf8View;
+using Mods::ascii_prefix_length;
+using Mods::validate_utf8;
\ No newline at end of file
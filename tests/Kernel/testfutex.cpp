@@ -0,0 +1,81 @@
+/**
+ * @file testfutex.cpp
+ * @author Krisna Pranav
+ * @brief test futex
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libtest/testcase.h>
+#include <libthreading/thread.h>
+#include <mods/atomic.h>
+#include <errno.h>
+#include <pranaos.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+TEST_CASE(wait_fails_when_value_changed)
+{
+    u32 word = 1;
+    EXPECT_EQ(futex_wait(&word, 0, nullptr, CLOCK_MONOTONIC), -1);
+    EXPECT_EQ(errno, EAGAIN);
+}
+
+TEST_CASE(wake_without_waiters_wakes_nobody)
+{
+    u32 word = 0;
+    EXPECT_EQ(futex_wake(&word, 1), 0);
+}
+
+TEST_CASE(wait_multiple_reports_woken_index)
+{
+    u32 words[3] = { 0, 0, 0 };
+    futex_wait_block blocks[3];
+    for (size_t i = 0; i < 3; ++i)
+        blocks[i] = { reinterpret_cast<int32_t const*>(&words[i]), 0 };
+
+    auto waker = Threading::Thread::construct([&] {
+        usleep(10'000);
+        Mods::atomic_store(&words[2], 1u);
+        futex_wake(&words[2], 1);
+        return (intptr_t) nullptr;
+    },
+        "FutexWaker"sv);
+    waker->start();
+
+    int rc;
+    do {
+        rc = futex_wait_multiple(blocks, 3, nullptr);
+    } while (rc >= 0 && Mods::atomic_load(&words[2]) == 0);
+    (void)waker->join();
+
+    EXPECT(rc == 2 || (rc == -1 && errno == EAGAIN));
+}
+
+TEST_CASE(shared_mapping_futex_wakes_other_process)
+{
+    auto* word = static_cast<u32*>(mmap(nullptr, sizeof(u32), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    VERIFY(word != MAP_FAILED);
+    *word = 0;
+
+    pid_t child = fork();
+    VERIFY(child >= 0);
+    if (child == 0) {
+        while (Mods::atomic_load(word) == 0)
+            futex_wait(word, 0, nullptr, CLOCK_MONOTONIC);
+        _exit(0);
+    }
+
+    usleep(10'000);
+    Mods::atomic_store(word, 1u);
+    futex_wake(word, 1);
+
+    int status = 0;
+    EXPECT_EQ(waitpid(child, &status, 0), child);
+    EXPECT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    munmap(word, sizeof(u32));
+}
@@ -0,0 +1,88 @@
+/**
+ * @file testzip.cpp
+ * @author Krisna Pranav
+ * @brief test zip
+ * @version 6.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ * 
+ */
+
+#include <mods/atomic.h>
+#include <mods/memorystream.h>
+#include <libarchive/zip.h>
+#include <libcrypto/checksum/crc32.h>
+#include <libtest/testcase.h>
+
+static ByteBuffer make_archive(size_t member_count)
+{
+    auto buffer = ByteBuffer::create_zeroed(member_count * 256 + 4096).release_value();
+    OutputMemoryStream stream { buffer };
+    Archive::ZipOutputStream zip { stream };
+
+    Vector<String> names;
+    Vector<String> contents;
+    for (size_t i = 0; i < member_count; ++i) {
+        names.append(String::formatted("dir/member-{}.txt", i));
+        contents.append(String::formatted("contents of member {}", i));
+    }
+
+    for (size_t i = 0; i < member_count; ++i) {
+        Archive::ZipMember member;
+        member.name = names[i];
+        member.compressed_data = contents[i].bytes();
+        member.compression_method = Archive::ZipCompressionMethod::Store;
+        member.uncompressed_size = contents[i].length();
+        member.crc32 = Crypto::Checksum::CRC32 { contents[i].bytes() }.digest();
+        member.is_directory = false;
+        zip.add_member(member);
+    }
+    zip.finish();
+
+    buffer.resize(stream.size());
+    return buffer;
+}
+
+TEST_CASE(find_member_uses_index)
+{
+    auto buffer = make_archive(100);
+    auto zip = Archive::Zip::try_create(buffer);
+    EXPECT(zip.has_value());
+    EXPECT_EQ(zip->member_count(), 100u);
+
+    auto const* member = zip->find_member("dir/member-42.txt"sv);
+    EXPECT(member != nullptr);
+    EXPECT_EQ(StringView { member->compressed_data }, "contents of member 42"sv);
+    EXPECT(zip->find_member("dir/missing.txt"sv) == nullptr);
+}
+
+TEST_CASE(parallel_extract_verifies_every_member)
+{
+    auto buffer = make_archive(500);
+    auto zip = Archive::Zip::try_create(buffer);
+    EXPECT(zip.has_value());
+
+    Atomic<size_t> extracted { 0 };
+    auto result = zip->parallel_extract(4, [&](Archive::ZipMember const& member, ReadonlyBytes contents) -> ErrorOr<void> {
+        EXPECT_EQ(contents.size(), member.uncompressed_size);
+        extracted.fetch_add(1);
+        return {};
+    });
+
+    EXPECT(!result.is_error());
+    EXPECT_EQ(extracted.load(), 500u);
+}
+
+TEST_CASE(crc_mismatch_is_reported)
+{
+    Archive::ZipMember member;
+    member.name = "broken";
+    member.compressed_data = "hello"sv.bytes();
+    member.compression_method = Archive::ZipCompressionMethod::Store;
+    member.uncompressed_size = 5;
+    member.crc32 = 0xdeadbeef;
+    member.is_directory = false;
+
+    EXPECT(Archive::Zip::decompress_member(member).is_error());
+}
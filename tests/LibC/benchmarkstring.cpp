@@ -0,0 +1,448 @@
+/**
+ * @file benchmarkstring.cpp
+ * @author Krisna Pranav
+ * @brief benchmark string
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <mods/array.h>
+#include <mods/bytebuffer.h>
+#include <mods/format.h>
+#include <mods/platform.h>
+#include <libcore/elapsedtimer.h>
+#include <libtest/testcase.h>
+#include <string.h>
+#include <sys/internals.h>
+
+namespace Reference
+{
+
+    /**
+     * @brief the byte-at-a-time routines string.cpp shipped before the SIMD set,
+     *        kept here so every run measures against the same baseline.
+     */
+    static NEVER_INLINE size_t strlen(char const* str)
+    {
+        size_t len = 0;
+        while (*(str++))
+            ++len;
+        return len;
+    }
+
+    static NEVER_INLINE void* memchr(void const* ptr, int c, size_t size)
+    {
+        char ch = c;
+        auto* cptr = (char const*)ptr;
+        for (size_t i = 0; i < size; ++i) {
+            if (cptr[i] == ch)
+                return const_cast<char*>(cptr + i);
+        }
+        return nullptr;
+    }
+
+    static NEVER_INLINE int memcmp(void const* v1, void const* v2, size_t n)
+    {
+        auto* s1 = (u8 const*)v1;
+        auto* s2 = (u8 const*)v2;
+        while (n-- > 0) {
+            if (*s1++ != *s2++)
+                return s1[-1] < s2[-1] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    static NEVER_INLINE void* memcpy(void* dest_ptr, void const* src_ptr, size_t n)
+    {
+        void* original_dest = dest_ptr;
+        asm volatile(
+            "rep movsb"
+            : "+D"(dest_ptr), "+S"(src_ptr), "+c"(n)::"memory");
+        return original_dest;
+    }
+
+    static NEVER_INLINE void* memset(void* dest_ptr, int c, size_t n)
+    {
+        size_t dest = (size_t)dest_ptr;
+
+        if (!(dest & 0x3) && n >= 12) {
+            size_t size_ts = n / sizeof(size_t);
+            size_t expanded_c = explode_byte((u8)c);
+#if ARCH(I386)
+            asm volatile(
+                "rep stosl\n"
+                : "=D"(dest)
+                : "D"(dest), "c"(size_ts), "a"(expanded_c)
+                : "memory");
+#else
+            asm volatile(
+                "rep stosq\n"
+                : "=D"(dest)
+                : "D"(dest), "c"(size_ts), "a"(expanded_c)
+                : "memory");
+#endif
+            n -= size_ts * sizeof(size_t);
+            if (n == 0)
+                return dest_ptr;
+        }
+        asm volatile(
+            "rep stosb\n"
+            : "=D"(dest), "=c"(n)
+            : "0"(dest), "1"(n), "a"(c)
+            : "memory");
+        return dest_ptr;
+    }
+
+    static NEVER_INLINE char* strstr(char const* haystack, char const* needle)
+    {
+        char nch;
+        char hch;
+
+        if ((nch = *needle++) != 0) {
+            size_t len = strlen(needle);
+            do {
+                do {
+                    if ((hch = *haystack++) == 0)
+                        return nullptr;
+                } while (hch != nch);
+            } while (strncmp(haystack, needle, len) != 0);
+            --haystack;
+        }
+        return const_cast<char*>(haystack);
+    }
+
+    static NEVER_INLINE void* memmove(void* dest_ptr, void const* src_ptr, size_t n)
+    {
+        auto* dest = (u8*)dest_ptr;
+        auto const* src = (u8 const*)src_ptr;
+        if (dest < src) {
+            for (size_t i = 0; i < n; ++i)
+                dest[i] = src[i];
+        } else {
+            for (size_t i = n; i > 0; --i)
+                dest[i - 1] = src[i - 1];
+        }
+        return dest_ptr;
+    }
+
+    static NEVER_INLINE void const* memmem(void const* haystack, size_t haystack_length, void const* needle, size_t needle_length)
+    {
+        if (needle_length > haystack_length)
+            return nullptr;
+        for (size_t i = 0; i + needle_length <= haystack_length; ++i) {
+            if (memcmp((u8 const*)haystack + i, needle, needle_length) == 0)
+                return (u8 const*)haystack + i;
+        }
+        return nullptr;
+    }
+
+} // namespace Reference
+
+static constexpr Array<size_t, 7> sizes = { 8, 32, 256, 4 * KiB, 64 * KiB, 1 * MiB, 8 * MiB };
+static constexpr Array<size_t, 4> alignments = { 0, 1, 7, 15 };
+
+/**
+ * @brief runs callback over roughly 256 MiB worth of bytes and reports MiB/s.
+ */
+template<typename Callback>
+static double measure(size_t size, Callback callback)
+{
+    size_t iterations = max<size_t>(1, (256 * MiB) / max<size_t>(size, 64));
+    Core::ElapsedTimer timer { true };
+    timer.start();
+    for (size_t i = 0; i < iterations; ++i)
+        callback();
+    auto elapsed_ms = max<i64>(timer.elapsed(), 1);
+    return static_cast<double>(iterations * size) / MiB / (elapsed_ms / 1000.0);
+}
+
+template<typename OldCallback, typename NewCallback>
+static void report(StringView name, OldCallback old_callback, NewCallback new_callback)
+{
+    outln("{:>8} {:>9} {:>5} {:>12} {:>12} {:>8}", name, "size", "align", "old MiB/s", "new MiB/s", "speedup");
+    for (auto size : sizes) {
+        for (auto alignment : alignments) {
+            auto old_rate = measure(size, [&] { old_callback(size, alignment); });
+            auto new_rate = measure(size, [&] { new_callback(size, alignment); });
+            outln("{:>8} {:>9} {:>5} {:>12.1} {:>12.1} {:>7.2}x", name, size, alignment, old_rate, new_rate, new_rate / old_rate);
+        }
+    }
+}
+
+static ByteBuffer make_buffer(size_t size, u8 fill)
+{
+    auto buffer = ByteBuffer::create_uninitialized(size + 64).release_value();
+    buffer.bytes().fill(fill);
+    return buffer;
+}
+
+static constexpr Array<char const*, 3> implementations = { "generic", "sse2", "avx2" };
+
+/**
+ * @brief runs callback once with every implementation set this CPU can run,
+ *        then goes back to the one __libc_init picked.
+ */
+template<typename Callback>
+static void for_each_implementation(Callback callback)
+{
+    for (auto* name : implementations) {
+        if (!__string_use_implementation(name)) {
+            outln("{} is not supported here, skipping it", name);
+            continue;
+        }
+        callback();
+    }
+    __string_init();
+}
+
+static void fill_pattern(u8* data, size_t size, u8 seed)
+{
+    for (size_t i = 0; i < size; ++i)
+        data[i] = (u8)(i * 131 + seed);
+}
+
+static bool all_bytes_are(u8 const* data, size_t size, u8 value)
+{
+    for (size_t i = 0; i < size; ++i) {
+        if (data[i] != value)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief every size class boundary of the vector routines (16, 32, 64, 128
+ *        and the 2 KiB "rep movsb" cut-over) plus one size well past them.
+ */
+static constexpr Array<size_t, 24> copy_sizes = { 0, 1, 2, 3, 4, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 2047, 2048, 2049, 64 * KiB + 3 };
+static constexpr size_t guard = 64;
+
+TEST_CASE(simd_routines_match_reference)
+{
+    auto haystack = make_buffer(4096, 'a');
+    haystack[4000] = 'b';
+    haystack[4095] = 0;
+
+    for_each_implementation([&] {
+        for (auto alignment : alignments) {
+            auto* text = (char const*)haystack.data() + alignment;
+            EXPECT_EQ(strlen(text), Reference::strlen(text));
+            EXPECT_EQ(memchr(text, 'b', 4000), Reference::memchr(text, 'b', 4000));
+            EXPECT_EQ(strchr(text, 'b'), (char*)Reference::memchr(text, 'b', 4095 - alignment));
+            EXPECT_EQ(strstr(text, "aab"), Reference::strstr(text, "aab"));
+        }
+    });
+}
+
+TEST_CASE(memcpy_matches_reference)
+{
+    auto source = make_buffer(64 * KiB + 2 * guard, 0);
+    auto destination = make_buffer(64 * KiB + 2 * guard, 0);
+    fill_pattern(source.data(), source.size(), 7);
+
+    for_each_implementation([&] {
+        for (auto size : copy_sizes) {
+            for (auto alignment : alignments) {
+                auto* target = destination.data() + guard + alignment;
+                Reference::memset(destination.data(), 0xee, destination.size());
+                EXPECT_EQ(memcpy(target, source.data() + 3, size), target);
+                EXPECT_EQ(Reference::memcmp(target, source.data() + 3, size), 0);
+                EXPECT(all_bytes_are(destination.data(), guard + alignment, 0xee));
+                EXPECT(all_bytes_are(target + size, guard, 0xee));
+            }
+        }
+    });
+}
+
+TEST_CASE(memmove_handles_overlap_in_both_directions)
+{
+    static constexpr Array<size_t, 10> shifts = { 1, 7, 8, 15, 16, 17, 31, 32, 33, 100 };
+    auto buffer = make_buffer(64 * KiB + 4 * guard, 0);
+    auto expected = make_buffer(64 * KiB + 4 * guard, 0);
+
+    for_each_implementation([&] {
+        for (auto size : copy_sizes) {
+            for (auto shift : shifts) {
+                for (bool dest_above_source : { true, false }) {
+                    size_t source_offset = dest_above_source ? guard : guard + shift;
+                    size_t dest_offset = dest_above_source ? guard + shift : guard;
+
+                    fill_pattern(buffer.data(), buffer.size(), (u8)shift);
+                    fill_pattern(expected.data(), expected.size(), (u8)shift);
+                    Reference::memmove(expected.data() + dest_offset, expected.data() + source_offset, size);
+
+                    EXPECT_EQ(memmove(buffer.data() + dest_offset, buffer.data() + source_offset, size), buffer.data() + dest_offset);
+                    EXPECT_EQ(Reference::memcmp(buffer.data(), expected.data(), buffer.size()), 0);
+                }
+            }
+        }
+    });
+}
+
+TEST_CASE(memset_matches_reference)
+{
+    static constexpr Array<size_t, 26> set_sizes = { 0, 1, 2, 3, 4, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 95, 96, 97, 127, 128, 129, 255, 256, 257 };
+    // the vector routines switch to non-temporal stores from 4 MiB up
+    static constexpr Array<size_t, 3> non_temporal_sizes = { 4 * MiB - 1, 4 * MiB, 4 * MiB + 17 };
+    auto buffer = make_buffer(4 * MiB + 17 + 2 * guard, 0);
+
+    auto check = [&](size_t size, size_t alignment) {
+        auto* target = buffer.data() + guard + alignment;
+        Reference::memset(buffer.data(), 0xee, size + 2 * guard);
+        EXPECT_EQ(memset(target, 0xa5, size), target);
+        EXPECT(all_bytes_are(target, size, 0xa5));
+        EXPECT(all_bytes_are(buffer.data(), guard + alignment, 0xee));
+        EXPECT(all_bytes_are(target + size, guard - alignment, 0xee));
+    };
+
+    for_each_implementation([&] {
+        for (auto alignment : alignments) {
+            for (auto size : set_sizes)
+                check(size, alignment);
+            for (auto size : non_temporal_sizes)
+                check(size, alignment);
+        }
+    });
+}
+
+TEST_CASE(memcmp_sign_matches_reference)
+{
+    static constexpr Array<size_t, 14> compare_sizes = { 1, 2, 7, 8, 9, 15, 16, 17, 31, 32, 33, 64, 100, 4096 };
+    // (0x7f, 0x80) catches a signed byte compare, (0x01, 0x00) a compare of whole words in the wrong byte order
+    struct BytePair {
+        u8 low;
+        u8 high;
+    };
+    static constexpr Array<BytePair, 3> pairs = { BytePair { 0x01, 0xff }, BytePair { 0x7f, 0x80 }, BytePair { 0x00, 0x01 } };
+    auto a = make_buffer(4096 + guard, 'q');
+    auto b = make_buffer(4096 + guard, 'q');
+
+    for_each_implementation([&] {
+        for (auto size : compare_sizes) {
+            for (size_t position : { (size_t)0, size / 2, size - 1 }) {
+                for (auto pair : pairs) {
+                    a[position] = pair.low;
+                    b[position] = pair.high;
+                    EXPECT(memcmp(a.data(), b.data(), size) < 0);
+                    EXPECT(memcmp(b.data(), a.data(), size) > 0);
+                    a[position] = 'q';
+                    b[position] = 'q';
+                }
+            }
+
+            // the first difference decides, even when a later one points the other way
+            if (size >= 2) {
+                a[0] = 0x10;
+                b[size - 1] = 0x10;
+                EXPECT(memcmp(a.data(), b.data(), size) < 0);
+                a[0] = 'q';
+                b[size - 1] = 'q';
+            }
+
+            a[size] = 'x';
+            EXPECT_EQ(memcmp(a.data(), b.data(), size), 0);
+            a[size] = 'q';
+        }
+    });
+}
+
+TEST_CASE(memmem_matches_reference)
+{
+    // needles longer than 32 bytes go through Two-Way, shorter ones through the vector filter
+    static constexpr Array<size_t, 9> needle_lengths = { 2, 3, 16, 31, 32, 33, 64, 100, 257 };
+    static constexpr size_t haystack_length = 8 * KiB;
+    auto haystack = make_buffer(haystack_length, 0);
+    for (size_t i = 0; i < haystack_length; ++i)
+        haystack[i] = i % 997 == 996 ? 'c' : "ab"[i % 2];
+
+    auto periodic = make_buffer(haystack_length, 'a');
+    periodic[haystack_length - 1] = 'b';
+
+    auto needle = make_buffer(512, 0);
+    auto check = [&](u8 const* text, size_t text_length, size_t needle_length) {
+        EXPECT_EQ(memmem(text, text_length, needle.data(), needle_length), Reference::memmem(text, text_length, needle.data(), needle_length));
+    };
+
+    for_each_implementation([&] {
+        for (auto length : needle_lengths) {
+            Reference::memcpy(needle.data(), haystack.data() + 5000, length);
+            check(haystack.data(), haystack_length, length);
+            needle[0] = 'z';
+            check(haystack.data(), haystack_length, length);
+
+            Reference::memcpy(needle.data(), haystack.data() + haystack_length - length, length);
+            check(haystack.data(), haystack_length, length);
+
+            for (size_t i = 0; i < length; ++i)
+                needle[i] = "ab"[i % 2];
+            needle[length - 1] = 'c';
+            check(haystack.data(), haystack_length, length);
+
+            Reference::memset(needle.data(), 'a', length);
+            check(haystack.data(), haystack_length, length);
+
+            needle[length - 1] = 'b';
+            check(periodic.data(), haystack_length, length);
+            check(periodic.data(), haystack_length - 1, length);
+        }
+    });
+}
+
+BENCHMARK_CASE(strlen_matrix)
+{
+    auto buffer = make_buffer(8 * MiB, 'x');
+    report(
+        "strlen"sv,
+        [&](size_t size, size_t alignment) { buffer[alignment + size] = 0; (void)Reference::strlen((char const*)buffer.data() + alignment); buffer[alignment + size] = 'x'; },
+        [&](size_t size, size_t alignment) { buffer[alignment + size] = 0; (void)strlen((char const*)buffer.data() + alignment); buffer[alignment + size] = 'x'; });
+}
+
+BENCHMARK_CASE(memchr_matrix)
+{
+    auto buffer = make_buffer(8 * MiB, 'x');
+    report(
+        "memchr"sv,
+        [&](size_t size, size_t alignment) { (void)Reference::memchr(buffer.data() + alignment, 'y', size); },
+        [&](size_t size, size_t alignment) { (void)memchr(buffer.data() + alignment, 'y', size); });
+}
+
+BENCHMARK_CASE(memcmp_matrix)
+{
+    auto a = make_buffer(8 * MiB, 'x');
+    auto b = make_buffer(8 * MiB, 'x');
+    report(
+        "memcmp"sv,
+        [&](size_t size, size_t alignment) { (void)Reference::memcmp(a.data() + alignment, b.data(), size); },
+        [&](size_t size, size_t alignment) { (void)memcmp(a.data() + alignment, b.data(), size); });
+}
+
+BENCHMARK_CASE(memcpy_matrix)
+{
+    auto source = make_buffer(8 * MiB, 'x');
+    auto destination = make_buffer(8 * MiB, 0);
+    report(
+        "memcpy"sv,
+        [&](size_t size, size_t alignment) { (void)Reference::memcpy(destination.data() + alignment, source.data(), size); },
+        [&](size_t size, size_t alignment) { (void)memcpy(destination.data() + alignment, source.data(), size); });
+}
+
+BENCHMARK_CASE(memset_matrix)
+{
+    auto destination = make_buffer(8 * MiB, 0);
+    report(
+        "memset"sv,
+        [&](size_t size, size_t alignment) { (void)Reference::memset(destination.data() + alignment, 'z', size); },
+        [&](size_t size, size_t alignment) { (void)memset(destination.data() + alignment, 'z', size); });
+}
+
+BENCHMARK_CASE(strstr_matrix)
+{
+    auto buffer = make_buffer(8 * MiB, 'a');
+    report(
+        "strstr"sv,
+        [&](size_t size, size_t alignment) { buffer[alignment + size] = 0; (void)Reference::strstr((char const*)buffer.data() + alignment, "aaaaaaab"); buffer[alignment + size] = 'a'; },
+        [&](size_t size, size_t alignment) { buffer[alignment + size] = 0; (void)strstr((char const*)buffer.data() + alignment, "aaaaaaab"); buffer[alignment + size] = 'a'; });
+}
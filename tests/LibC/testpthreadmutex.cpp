@@ -0,0 +1,95 @@
+/**
+ * @file testpthreadmutex.cpp
+ * @author Krisna Pranav
+ * @brief test pthread mutex
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libcore/elapsedtimer.h>
+#include <libtest/testcase.h>
+#include <libthreading/thread.h>
+#include <mods/format.h>
+#include <mods/vector.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <unistd.h>
+
+static constexpr size_t thread_count = 4;
+static constexpr size_t increments = 200'000;
+
+template<typename Lock, typename Unlock>
+static size_t hammer(Lock lock, Unlock unlock)
+{
+    size_t counter = 0;
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+
+    for (size_t t = 0; t < thread_count; ++t) {
+        auto thread = Threading::Thread::construct([&] {
+            for (size_t i = 0; i < increments; ++i) {
+                lock();
+                ++counter;
+                unlock();
+            }
+            return (intptr_t) nullptr;
+        },
+            "MutexHammer"sv);
+        thread->start();
+        threads.append(move(thread));
+    }
+
+    for (auto& thread : threads)
+        (void)thread->join();
+    return counter;
+}
+
+TEST_CASE(contended_mutex_excludes)
+{
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    auto counter = hammer([&] { pthread_mutex_lock(&mutex); }, [&] { pthread_mutex_unlock(&mutex); });
+    EXPECT_EQ(counter, thread_count * increments);
+}
+
+TEST_CASE(contended_spinlock_excludes)
+{
+    pthread_spinlock_t lock;
+    pthread_spin_init(&lock, PTHREAD_PROCESS_PRIVATE);
+    auto counter = hammer([&] { pthread_spin_lock(&lock); }, [&] { pthread_spin_unlock(&lock); });
+    EXPECT_EQ(counter, thread_count * increments);
+    EXPECT_EQ(pthread_spin_destroy(&lock), 0);
+}
+
+TEST_CASE(spinlock_relock_is_deadlock)
+{
+    pthread_spinlock_t lock;
+    pthread_spin_init(&lock, PTHREAD_PROCESS_PRIVATE);
+    EXPECT_EQ(pthread_spin_lock(&lock), 0);
+    EXPECT_EQ(pthread_spin_lock(&lock), EDEADLK);
+    EXPECT_EQ(pthread_spin_unlock(&lock), 0);
+}
+
+/**
+ * @brief contends one mutex with the profiler on and prints the report.
+ */
+BENCHMARK_CASE(mutex_contention_profile)
+{
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+
+    pthread_mutex_profiler_reset_np();
+    pthread_mutex_profiler_enable_np(1);
+
+    Core::ElapsedTimer timer { true };
+    timer.start();
+    auto counter = hammer([&] { pthread_mutex_lock(&mutex); }, [&] { pthread_mutex_unlock(&mutex); });
+    auto elapsed_ms = timer.elapsed();
+
+    pthread_mutex_profiler_enable_np(0);
+    EXPECT_EQ(counter, thread_count * increments);
+
+    outln("{} threads x {} lock/unlock in {} ms", thread_count, increments, elapsed_ms);
+    EXPECT_EQ(pthread_mutex_profiler_dump_np(STDOUT_FILENO, 10), 0);
+}
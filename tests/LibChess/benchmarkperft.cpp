@@ -0,0 +1,135 @@
+/**
+ * @file benchmarkperft.cpp
+ * @author Krisna Pranav
+ * @brief benchmark perft
+ * @version 6.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ * 
+ */
+
+#include <libtest/testcase.h>
+#include <mods/array.h>
+#include <libchess/chess.h>
+#include <libchess/ucicommand.h>
+
+TEST_CASE(perft_start_position_shallow)
+{
+    Chess::Board board;
+    EXPECT_EQ(board.perft(1), 20u);
+    EXPECT_EQ(board.perft(2), 400u);
+    EXPECT_EQ(board.perft(3), 8902u);
+}
+
+struct PerftPosition {
+    StringView fen;
+    Array<u64, 5> nodes;
+};
+
+// counts from the Chess Programming Wiki's perft results page; 0 ends a row
+static constexpr PerftPosition s_perft_positions[] = {
+    { "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"sv, { 48, 2039, 97862, 4085603, 0 } },
+    { "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"sv, { 14, 191, 2812, 43238, 674624 } },
+    { "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"sv, { 6, 264, 9467, 422333, 0 } },
+    { "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"sv, { 44, 1486, 62379, 2103487, 0 } },
+    { "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"sv, { 46, 2079, 89890, 3894594, 0 } },
+};
+
+/**
+ * @param max_depth 
+ */
+static void check_perft_positions(u32 max_depth)
+{
+    for (auto const& position : s_perft_positions) {
+        auto board = Chess::Board::from_fen(position.fen);
+        EXPECT(board.has_value());
+
+        for (u32 depth = 1; depth <= max_depth && depth <= position.nodes.size() && position.nodes[depth - 1]; ++depth)
+            EXPECT_EQ(board->perft(depth), position.nodes[depth - 1]);
+    }
+}
+
+TEST_CASE(perft_standard_positions_shallow)
+{
+    check_perft_positions(3);
+}
+
+TEST_CASE(make_unmake_restores_zobrist_key)
+{
+    Chess::Board board;
+    auto key = board.zobrist_key();
+
+    board.generate_moves([&](Chess::Move move) {
+        auto undo = board.make_move(move);
+        EXPECT_NE(board.zobrist_key(), key);
+        board.unmake_move(undo);
+        EXPECT_EQ(board.zobrist_key(), key);
+        return IterationDecision::Continue;
+    });
+}
+
+TEST_CASE(en_passant_keyed_only_when_capturable)
+{
+    auto keyed = [](StringView fen) { return Chess::Board::from_fen(fen)->zobrist_key(); };
+
+    EXPECT_EQ(keyed("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1"sv),
+        keyed("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1"sv));
+    EXPECT_NE(keyed("rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1"sv),
+        keyed("rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1"sv));
+}
+
+TEST_CASE(fen_round_trip)
+{
+    for (auto fen : {
+             "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"sv,
+             "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"sv,
+             "rnbqkbnr/pp1ppppp/8/2p5/4P3/8/PPPP1PPP/RNBQKBNR w KQkq c6 0 1"sv,
+             "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 b - - 12 1"sv,
+         }) {
+        auto board = Chess::Board::from_fen(fen);
+        EXPECT(board.has_value());
+        EXPECT_EQ(board->to_fen(), fen);
+    }
+
+    auto start = Chess::Board::from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"sv);
+    EXPECT_EQ(start->zobrist_key(), Chess::Board().zobrist_key());
+}
+
+TEST_CASE(fen_rejects_malformed_positions)
+{
+    for (auto fen : {
+             ""sv,
+             "8/8/8/8/8/8/8/8 w - - 0 1"sv,
+             "rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"sv,
+             "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1"sv,
+             "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1"sv,
+             "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkx - 0 1"sv,
+             "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e3 0 1"sv,
+         }) {
+        EXPECT(!Chess::Board::from_fen(fen).has_value());
+    }
+}
+
+TEST_CASE(uci_position_with_fen)
+{
+    auto command = Chess::UCI::PositionCommand::from_string("position fen r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1 moves e2a6 b4c3"sv);
+    EXPECT_EQ(command.fen().value(), "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    EXPECT_EQ(command.moves().size(), 2u);
+    EXPECT_EQ(Chess::UCI::PositionCommand::from_string(command.to_string().trim_whitespace()).fen(), command.fen());
+
+    auto startpos = Chess::UCI::PositionCommand::from_string("position startpos"sv);
+    EXPECT(!startpos.fen().has_value());
+    EXPECT(startpos.moves().is_empty());
+}
+
+BENCHMARK_CASE(perft_start_position_depth_5)
+{
+    Chess::Board board;
+    EXPECT_EQ(board.perft(5), 4865609u);
+}
+
+BENCHMARK_CASE(perft_standard_positions_deep)
+{
+    check_perft_positions(5);
+}
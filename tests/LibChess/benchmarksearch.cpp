@@ -0,0 +1,59 @@
+/**
+ * @file benchmarksearch.cpp
+ * @author Krisna Pranav
+ * @brief benchmark search
+ * @version 6.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ * 
+ */
+
+#include <libtest/testcase.h>
+#include <libchess/search.h>
+#include <libchess/transpositiontable.h>
+
+TEST_CASE(transposition_table_round_trip)
+{
+    Chess::TranspositionTable table { 1 };
+    Chess::Move move { "e2e4"sv };
+
+    Chess::TranspositionTable::Entry entry;
+    entry.move = Chess::encode_move(move);
+    entry.score = 42;
+    entry.depth = 7;
+    entry.bound = Chess::TranspositionTable::Bound::Exact;
+    table.store(0x1234567890abcdefULL, entry);
+
+    auto probed = table.probe(0x1234567890abcdefULL);
+    EXPECT(probed.has_value());
+    EXPECT_EQ(probed->score, 42);
+    EXPECT_EQ(probed->depth, 7);
+    EXPECT(Chess::decode_move(probed->move).value() == move);
+    EXPECT(!table.probe(0xfedcba0987654321ULL).has_value());
+}
+
+TEST_CASE(search_finds_mate_in_one)
+{
+    Chess::Board board;
+    for (auto move : { "f2f3"sv, "e7e5"sv, "g2g4"sv })
+        board.apply_move(Chess::Move(move));
+
+    Chess::TranspositionTable table { 1 };
+    Chess::Search search { table };
+
+    Chess::SearchLimits limits;
+    limits.depth = 3;
+
+    auto result = search.run(board, limits);
+    EXPECT(result.best_move.has_value());
+    EXPECT(result.best_move.value() == Chess::Move("d8h4"sv));
+    EXPECT_EQ(result.score, Chess::Search::mate_score - 1);
+}
+
+BENCHMARK_CASE(lazy_smp_scaling)
+{
+    auto results = Chess::Search::benchmark(6, 4);
+    for (auto const& result : results)
+        outln("threads {} nodes {} time {}ms nps {}", result.thread_count, result.nodes, result.elapsed_ms, result.nodes_per_second());
+}
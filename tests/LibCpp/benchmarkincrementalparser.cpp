@@ -0,0 +1,113 @@
+/**
+ * @file benchmarkincrementalparser.cpp
+ * @author Krisna Pranav
+ * @brief benchmark incremental parser
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libcore/elapsedtimer.h>
+#include <libcpp/incrementalparser.h>
+#include <libcpp/lexer.h>
+#include <libcpp/parser.h>
+#include <libtest/testcase.h>
+#include <mods/format.h>
+#include <mods/string_builder.h>
+
+static constexpr size_t function_count = 2000;
+
+/**
+ * @return String a source file of a few thousand declarations
+ */
+static String large_source()
+{
+    StringBuilder builder;
+    builder.append("#include <mods/types.h>\n\n"sv);
+    for (size_t i = 0; i < function_count; ++i) {
+        builder.appendff("struct Point{} {{\n    int x;\n    int y;\n}};\n\n", i);
+        builder.appendff("int function_{}(int a, int b)\n{{\n    // keep {} around\n    int c = a + b * {};\n    if (c > 10)\n        return c;\n    return a;\n}}\n\n", i, i, i);
+    }
+    return builder.to_string();
+}
+
+/**
+ * @brief the edits a user makes while working in the middle of the file:
+ *        typing a statement, adding lines, and deleting them again.
+ *
+ * @param text
+ * @return Vector<String>
+ */
+static Vector<String> edit_sequence(String const& text)
+{
+    Vector<String> versions;
+    auto anchor = text.find("int c = a + b * 1000;"sv).value();
+
+    String statement = "int typed = c * 2;\n    ";
+    for (size_t i = 1; i <= statement.length(); ++i)
+        versions.append(String::formatted("{}{}{}", text.substring_view(0, anchor), statement.substring_view(0, i), text.substring_view(anchor)));
+
+    auto typed = versions.last();
+    versions.append(String::formatted("int added_global;\n\n{}", typed));
+    versions.append(typed);
+    versions.append(text);
+    return versions;
+}
+
+/**
+ * @param name
+ * @param edits
+ * @param total_ms
+ * @param worst_ms
+ */
+static void report(StringView name, size_t edits, i64 total_ms, i64 worst_ms)
+{
+    outln("{:<24} {:>6} edits {:>8} ms total {:>8.3} ms per edit {:>6} ms worst", name, edits, total_ms, (double)total_ms / edits, worst_ms);
+}
+
+BENCHMARK_CASE(per_edit_latency)
+{
+    auto text = large_source();
+    auto versions = edit_sequence(text);
+
+    {
+        i64 total = 0;
+        i64 worst = 0;
+        for (auto& version : versions) {
+            Core::ElapsedTimer timer { true };
+            timer.start();
+            Cpp::Lexer lexer(version);
+            lexer.set_ignore_whitespace(true);
+            Cpp::Parser parser(lexer.lex(), "large.cpp");
+            parser.parse();
+            auto elapsed = timer.elapsed();
+            total += elapsed;
+            worst = max(worst, elapsed);
+        }
+        report("full reparse"sv, versions.size(), total, worst);
+    }
+
+    {
+        Cpp::IncrementalParser incremental("large.cpp");
+        incremental.set_text(text);
+
+        i64 total = 0;
+        i64 worst = 0;
+        size_t relexed_tokens = 0;
+        size_t parsed_declarations = 0;
+        for (auto& version : versions) {
+            Core::ElapsedTimer timer { true };
+            timer.start();
+            incremental.set_text(version);
+            auto elapsed = timer.elapsed();
+            total += elapsed;
+            worst = max(worst, elapsed);
+            relexed_tokens += incremental.statistics().relexed_tokens;
+            parsed_declarations += incremental.statistics().parsed_declarations;
+        }
+        report("incremental"sv, versions.size(), total, worst);
+        outln("{} tokens relexed and {} declarations parsed over {} edits", relexed_tokens, parsed_declarations, versions.size());
+    }
+}
@@ -0,0 +1,170 @@
+/**
+ * @file testincrementalparser.cpp
+ * @author Krisna Pranav
+ * @brief test incremental parser
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libcpp/incrementalparser.h>
+#include <libcpp/lexer.h>
+#include <libcpp/parser.h>
+#include <libcpp/preprocessor.h>
+#include <libtest/testcase.h>
+#include <mods/string_builder.h>
+
+/**
+ * @param count
+ * @return String
+ */
+static String source_with_functions(size_t count)
+{
+    StringBuilder builder;
+    builder.append("#include <mods/types.h>\n\n"sv);
+    for (size_t i = 0; i < count; ++i)
+        builder.appendff("int function_{}(int a, int b)\n{{\n    int c = a + b * {};\n    return c;\n}}\n\n", i, i);
+    return builder.to_string();
+}
+
+/**
+ * @param text
+ * @return Vector<Cpp::Token>
+ */
+static Vector<Cpp::Token> lex_all(StringView text)
+{
+    Cpp::Lexer lexer(text);
+    lexer.set_ignore_whitespace(true);
+    return lexer.lex();
+}
+
+/**
+ * @brief the incremental result has to be what parsing from scratch gives.
+ *
+ * @param incremental
+ * @param text
+ */
+static void expect_same_as_full_parse(Cpp::IncrementalParser const& incremental, String const& text)
+{
+    auto tokens = lex_all(text);
+    EXPECT_EQ(incremental.tokens().size(), tokens.size());
+    for (size_t i = 0; i < min(tokens.size(), incremental.tokens().size()); ++i) {
+        EXPECT_EQ(incremental.tokens()[i].type(), tokens[i].type());
+        EXPECT_EQ(incremental.tokens()[i].text(), tokens[i].text());
+        EXPECT(incremental.tokens()[i].start() == tokens[i].start());
+        EXPECT(incremental.tokens()[i].end() == tokens[i].end());
+    }
+
+    Cpp::Parser parser(move(tokens), "test.cpp");
+    auto unit = parser.parse();
+    auto declarations = unit->declarations();
+    auto incremental_declarations = incremental.root_node()->declarations();
+
+    EXPECT_EQ(incremental_declarations.size(), declarations.size());
+    for (size_t i = 0; i < min(declarations.size(), incremental_declarations.size()); ++i) {
+        EXPECT_EQ(incremental_declarations[i].class_name(), declarations[i].class_name());
+        EXPECT(incremental_declarations[i].start() == declarations[i].start());
+        EXPECT(incremental_declarations[i].end() == declarations[i].end());
+        EXPECT(incremental_declarations[i].parent() == incremental.root_node().ptr());
+    }
+}
+
+TEST_CASE(relex_matches_full_lex)
+{
+    String before = "int a = 1; /* comment */ char const* s = \"x\\ny\";\n#include <a.h>\nint b;\n";
+    String after = "int a = 12; /* comment */ char const* s = \"x\\ny\";\n#include <a.h>\nint b;\n";
+
+    auto previous_tokens = lex_all(before);
+    Cpp::Lexer lexer(after);
+    lexer.set_ignore_whitespace(true);
+    auto relexed = lexer.relex(before, previous_tokens, Cpp::TextEdit::between(before, after));
+
+    auto tokens = lex_all(after);
+    EXPECT_EQ(relexed.tokens.size(), tokens.size());
+    EXPECT(relexed.relexed_count < tokens.size());
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        EXPECT_EQ(relexed.tokens[i].text(), tokens[i].text());
+        EXPECT_EQ(relexed.tokens[i].text().characters_without_null_termination(), tokens[i].text().characters_without_null_termination());
+        EXPECT(relexed.tokens[i].start() == tokens[i].start());
+    }
+}
+
+TEST_CASE(edit_inside_function_reparses_only_that_function)
+{
+    Cpp::IncrementalParser incremental("test.cpp");
+    auto text = source_with_functions(50);
+    incremental.set_text(text);
+    EXPECT_EQ(incremental.statistics().parsed_declarations, 50u);
+
+    auto edited = text.replace("a + b * 25;", "a - b * 25;", false);
+    incremental.set_text(edited);
+    EXPECT_EQ(incremental.statistics().parsed_declarations, 1u);
+    EXPECT_EQ(incremental.statistics().reused_declarations, 49u);
+    expect_same_as_full_parse(incremental, edited);
+}
+
+TEST_CASE(inserted_lines_move_reused_declarations)
+{
+    Cpp::IncrementalParser incremental("test.cpp");
+    auto text = source_with_functions(20);
+    incremental.set_text(text);
+
+    auto edited = String::formatted("int global;\n\n\n{}", text);
+    incremental.set_text(edited);
+    EXPECT_EQ(incremental.statistics().reused_declarations, 20u);
+    expect_same_as_full_parse(incremental, edited);
+
+    // typing a character at a time, then deleting it again.
+    auto current = edited;
+    for (auto ch : "int added;"sv) {
+        current = String::formatted("{}{}", current, ch);
+        incremental.set_text(current);
+        expect_same_as_full_parse(incremental, current);
+    }
+    incremental.set_text(edited);
+    expect_same_as_full_parse(incremental, edited);
+}
+
+TEST_CASE(unbalanced_edit_falls_back_to_parsing)
+{
+    Cpp::IncrementalParser incremental("test.cpp");
+    auto text = source_with_functions(10);
+    incremental.set_text(text);
+
+    auto edited = text.replace("return c;\n}\n\nint function_5", "return c;\n\nint function_5", false);
+    incremental.set_text(edited);
+    expect_same_as_full_parse(incremental, edited);
+
+    incremental.set_text(text);
+    expect_same_as_full_parse(incremental, text);
+}
+
+TEST_CASE(header_cache_preprocesses_each_header_once)
+{
+    size_t reads = 0;
+    Cpp::PreprocessedHeaderCache cache([&](StringView path) -> Optional<String> {
+        ++reads;
+        if (path == "<a.h>")
+            return String("#include <b.h>\n#define A 1\n");
+        if (path == "<b.h>")
+            return String("#define B 2\n");
+        return {};
+    });
+
+    for (size_t i = 0; i < 3; ++i) {
+        Cpp::Preprocessor preprocessor("unit.cpp", "#include <a.h>\nint x = A + B;\n");
+        preprocessor.set_header_cache(&cache);
+        preprocessor.process_and_lex();
+        EXPECT(preprocessor.definitions().contains("A"));
+        EXPECT(preprocessor.definitions().contains("B"));
+    }
+
+    EXPECT_EQ(reads, 2u);
+    EXPECT_EQ(cache.miss_count(), 2u);
+
+    cache.invalidate("<b.h>");
+    EXPECT(cache.definitions_in_header("<a.h>"));
+    EXPECT_EQ(reads, 4u);
+}
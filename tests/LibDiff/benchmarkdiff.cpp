@@ -0,0 +1,64 @@
+/**
+ * @file benchmarkdiff.cpp
+ * @author Krisna Pranav
+ * @brief benchmark diff
+ * @version 6.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ * 
+ */
+
+#include <libtest/testcase.h>
+#include <libdiff/generator.h>
+#include <mods/stringbuilder.h>
+
+static constexpr size_t line_count = 50000;
+
+/**
+ * @param seed 
+ * @param edit_every 
+ * @return String 
+ */
+static String generate_text(u32 seed, size_t edit_every)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < line_count; ++i) {
+        if (edit_every && (i % edit_every) == 0)
+            builder.appendff("edited line {} {}\n", i, seed);
+        else
+            builder.appendff("    int value_{} = compute({}, {});\n", i, i % 97, i % 13);
+    }
+    return builder.to_string();
+}
+
+BENCHMARK_CASE(myers_50k_lines_sparse_edits)
+{
+    auto old_text = generate_text(1, 0);
+    auto new_text = generate_text(2, 500);
+    auto hunks = Diff::from_text(old_text, new_text);
+    EXPECT_EQ(hunks.size(), line_count / 500);
+}
+
+BENCHMARK_CASE(myers_50k_lines_dense_edits)
+{
+    auto old_text = generate_text(1, 7);
+    auto new_text = generate_text(2, 5);
+    auto hunks = Diff::from_text(old_text, new_text);
+    EXPECT(!hunks.is_empty());
+}
+
+BENCHMARK_CASE(patience_50k_lines_sparse_edits)
+{
+    auto old_text = generate_text(1, 0);
+    auto new_text = generate_text(2, 500);
+    auto hunks = Diff::from_text(old_text, new_text, Diff::Algorithm::Patience);
+    EXPECT_EQ(hunks.size(), line_count / 500);
+}
+
+BENCHMARK_CASE(identical_50k_lines)
+{
+    auto text = generate_text(1, 0);
+    auto hunks = Diff::from_text(text, text);
+    EXPECT(hunks.is_empty());
+}
@@ -0,0 +1,137 @@
+/**
+ * @file benchmarktextcodec.cpp
+ * @author Krisna Pranav
+ * @brief benchmark text codec
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libcore/elapsedtimer.h>
+#include <libtest/testcase.h>
+#include <libtextcodec/decoder.h>
+#include <mods/format.h>
+#include <mods/string_builder.h>
+#include <mods/utf8view.h>
+#include <string.h>
+
+static constexpr size_t document_size = 8 * MiB;
+
+/**
+ * @brief a document that is mostly ASCII with some non-ASCII every line,
+ *        like prose in a European language.
+ */
+static String mixed_utf8_document()
+{
+    StringBuilder builder;
+    while (builder.length() < document_size)
+        builder.append("The quick brown fox jumps over the lazy dog, na\xC3\xAFve caf\xC3\xA9 \xE2\x82\xAC 12.\n"sv);
+    return builder.to_string();
+}
+
+/**
+ * @param name
+ * @param bytes
+ * @param elapsed_ms
+ */
+static void report(StringView name, size_t bytes, i64 elapsed_ms)
+{
+    elapsed_ms = max<i64>(elapsed_ms, 1);
+    outln("{:<24} {:>8} ms {:>8} MiB/s", name, elapsed_ms, (bytes * 1000 / MiB) / elapsed_ms);
+}
+
+/**
+ * @brief the old way: a Function call per code point into a StringBuilder.
+ */
+static void time_per_code_point(StringView name, TextCodec::Decoder& decoder, StringView input)
+{
+    Core::ElapsedTimer timer { true };
+    timer.start();
+    StringBuilder builder(input.length());
+    decoder.process(input, [&](u32 code_point) { builder.append_code_point(code_point); });
+    auto output = builder.to_string();
+    report(String::formatted("{} process()", name), input.length(), timer.elapsed());
+}
+
+/**
+ * @brief the bulk path, into a reused buffer.
+ */
+static void time_bulk(StringView name, TextCodec::Decoder& decoder, StringView input)
+{
+    static u8 buffer[64 * KiB];
+
+    Core::ElapsedTimer timer { true };
+    timer.start();
+    auto remaining = input.bytes();
+    size_t produced = 0;
+    while (!remaining.is_empty()) {
+        auto result = decoder.decode_to_utf8(remaining, { buffer, sizeof(buffer) });
+        produced += result.produced;
+        remaining = remaining.slice(result.consumed);
+    }
+    VERIFY(produced > 0);
+    report(String::formatted("{} bulk", name), input.length(), timer.elapsed());
+}
+
+BENCHMARK_CASE(utf16_to_utf8_throughput)
+{
+    auto utf8 = mixed_utf8_document();
+    Vector<u8> utf16;
+    utf16.resize(utf8.length() * 2);
+
+    for (auto endianness : { TextCodec::Utf16Endianness::Little, TextCodec::Utf16Endianness::Big }) {
+        auto result = TextCodec::transcode_utf8_to_utf16(utf8.bytes(), utf16.span(), endianness);
+        StringView input { reinterpret_cast<char const*>(utf16.data()), result.produced };
+        bool is_big = endianness == TextCodec::Utf16Endianness::Big;
+
+        auto* decoder = TextCodec::decoder_for(is_big ? "utf-16be" : "utf-16le");
+        VERIFY(decoder);
+        time_per_code_point(is_big ? "utf-16be"sv : "utf-16le"sv, *decoder, input);
+        time_bulk(is_big ? "utf-16be"sv : "utf-16le"sv, *decoder, input);
+    }
+}
+
+BENCHMARK_CASE(utf8_to_utf16_throughput)
+{
+    auto utf8 = mixed_utf8_document();
+    Vector<u8> utf16;
+    utf16.resize(utf8.length() * 2);
+
+    Core::ElapsedTimer timer { true };
+    timer.start();
+    auto result = TextCodec::transcode_utf8_to_utf16(utf8.bytes(), utf16.span(), TextCodec::Utf16Endianness::Little);
+    EXPECT_EQ(result.consumed, utf8.length());
+    report("utf-8 to utf-16le"sv, utf8.length(), timer.elapsed());
+}
+
+BENCHMARK_CASE(single_byte_throughput)
+{
+    // the UTF-8 bytes of the Polish text serve as high-half bytes here.
+    StringBuilder builder;
+    while (builder.length() < document_size)
+        builder.append("Zażółć gęślą jaźń, plain ASCII for the most part of each line.\n"sv);
+    auto document = builder.to_string();
+
+    for (auto* name : { "windows-1252", "iso-8859-2", "koi8-r" }) {
+        auto* decoder = TextCodec::decoder_for(name);
+        VERIFY(decoder);
+        time_per_code_point(StringView { name, strlen(name) }, *decoder, document);
+        time_bulk(StringView { name, strlen(name) }, *decoder, document);
+    }
+}
+
+BENCHMARK_CASE(utf8_validation_throughput)
+{
+    auto document = mixed_utf8_document();
+    auto* decoder = TextCodec::decoder_for("utf-8");
+    VERIFY(decoder);
+
+    Core::ElapsedTimer timer { true };
+    timer.start();
+    EXPECT(Utf8View(document).validate());
+    report("Utf8View::validate"sv, document.length(), timer.elapsed());
+
+    time_bulk("utf-8"sv, *decoder, document);
+}
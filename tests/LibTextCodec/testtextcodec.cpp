@@ -0,0 +1,88 @@
+/**
+ * @file testtextcodec.cpp
+ * @author Krisna Pranav
+ * @brief test text codec
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libtest/testcase.h>
+#include <libtextcodec/decoder.h>
+#include <mods/string.h>
+#include <mods/utf8view.h>
+
+TEST_CASE(utf16_surrogate_pairs_decode_to_one_code_point)
+{
+    auto* decoder = TextCodec::decoder_for("utf-16le");
+    VERIFY(decoder);
+
+    u8 const input[] = { 'A', 0, 0x3D, 0xD8, 0x00, 0xDE, 0x00, 0xDC };
+    auto result = decoder->to_utf8(StringView { reinterpret_cast<char const*>(input), sizeof(input) });
+    EXPECT_EQ(result, "A\xF0\x9F\x98\x80\xEF\xBF\xBD");
+}
+
+TEST_CASE(utf16_split_surrogate_waits_for_more_input)
+{
+    u8 const input[] = { 0xD8, 0x3D, 0xDE, 0x00 };
+    u8 output[8];
+
+    auto first = TextCodec::transcode_utf16_to_utf8({ input, 2 }, { output, sizeof(output) }, TextCodec::Utf16Endianness::Big, false);
+    EXPECT_EQ(first.consumed, 0u);
+    EXPECT_EQ(first.produced, 0u);
+
+    auto whole = TextCodec::transcode_utf16_to_utf8({ input, 4 }, { output, sizeof(output) }, TextCodec::Utf16Endianness::Big, true);
+    EXPECT_EQ(whole.consumed, 4u);
+    EXPECT_EQ(whole.produced, 4u);
+}
+
+TEST_CASE(small_output_stops_on_a_character_boundary)
+{
+    auto input = "abc\xC3\xA9xyz"sv;
+    u8 output[4];
+
+    auto result = TextCodec::transcode_utf8_to_utf8(input.bytes(), { output, sizeof(output) });
+    EXPECT_EQ(result.consumed, 3u);
+    EXPECT_EQ(result.produced, 3u);
+}
+
+TEST_CASE(utf8_round_trips_through_utf16)
+{
+    auto input = "plain ascii, then \xC3\xA9t\xC3\xA9, \xE2\x82\xAC and \xF0\x9F\x98\x80"sv;
+    u8 utf16[128];
+    u8 utf8[128];
+
+    auto to_utf16 = TextCodec::transcode_utf8_to_utf16(input.bytes(), { utf16, sizeof(utf16) }, TextCodec::Utf16Endianness::Little);
+    EXPECT_EQ(to_utf16.consumed, input.length());
+
+    auto back = TextCodec::transcode_utf16_to_utf8({ utf16, to_utf16.produced }, { utf8, sizeof(utf8) }, TextCodec::Utf16Endianness::Little);
+    EXPECT_EQ(StringView(reinterpret_cast<char const*>(utf8), back.produced), input);
+}
+
+TEST_CASE(single_byte_decoders_match_process)
+{
+    for (auto* name : { "iso-8859-2", "windows-1255", "koi8-r", "x-user-defined" }) {
+        auto* decoder = TextCodec::decoder_for(name);
+        VERIFY(decoder);
+
+        char input[256];
+        for (size_t i = 0; i < 256; ++i)
+            input[i] = i;
+        StringView view { input, sizeof(input) };
+
+        StringBuilder expected;
+        decoder->process(view, [&](u32 code_point) { expected.append_code_point(code_point); });
+        EXPECT_EQ(decoder->to_utf8(view), expected.to_string());
+    }
+}
+
+TEST_CASE(validate_finds_the_valid_prefix)
+{
+    size_t valid_bytes = 0;
+    EXPECT(!Utf8View("0123456789abcdefghijklmnopqrstuvwxyz\xC3\xA9\xC3"sv).validate(valid_bytes));
+    EXPECT_EQ(valid_bytes, 38u);
+    EXPECT(Utf8View("0123456789abcdefghijklmnopqrstuvwxyz\xE2\x82\xAC"sv).validate(valid_bytes));
+    EXPECT_EQ(valid_bytes, 39u);
+}
@@ -0,0 +1,109 @@
+/**
+ * @file benchmarkthreadpool.cpp
+ * @author Krisna Pranav
+ * @brief benchmark thread pool
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libcore/elapsedtimer.h>
+#include <libtest/testcase.h>
+#include <libthreading/threadpool.h>
+#include <mods/atomic.h>
+#include <mods/format.h>
+#include <mods/vector.h>
+#include <unistd.h>
+
+static size_t online_processors()
+{
+    auto count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? count : 1;
+}
+
+/**
+ * @brief runs body on pools of 1..N workers and prints the speedup over
+ *        a single worker.
+ */
+template<typename Callback>
+static void scale(char const* name, Callback body)
+{
+    outln("{}", name);
+    outln("{:>8} {:>10} {:>8}", "workers", "ms", "speedup");
+
+    i64 single = 0;
+    for (size_t workers = 1; workers <= online_processors(); ++workers) {
+        Threading::ThreadPool pool { workers };
+        Core::ElapsedTimer timer { true };
+        timer.start();
+        body(pool);
+        i64 elapsed_ms = max<i64>(timer.elapsed(), 1);
+        if (workers == 1)
+            single = elapsed_ms;
+        outln("{:>8} {:>10} {:>8.2}", workers, elapsed_ms, (double)single / elapsed_ms);
+    }
+}
+
+/**
+ * @brief independent chunks submitted from outside the pool, like
+ *        decoding a directory full of thumbnails.
+ */
+BENCHMARK_CASE(flat_parallel_sum)
+{
+    static constexpr size_t chunk_count = 256;
+    static constexpr size_t chunk_size = 200'000;
+
+    scale("flat_parallel_sum", [](Threading::ThreadPool& pool) {
+        Atomic<u64> total { 0 };
+        {
+            Threading::TaskGroup group { pool };
+            for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+                group.spawn([&, chunk] {
+                    u64 sum = 0;
+                    for (size_t i = 0; i < chunk_size; ++i)
+                        sum += (chunk * chunk_size + i) % 7;
+                    total.fetch_add(sum, Mods::MemoryOrder::memory_order_relaxed);
+                });
+            }
+        }
+        VERIFY(total.load() > 0);
+    });
+}
+
+static u64 sum_range(Threading::ThreadPool& pool, u64 begin, u64 end)
+{
+    if (end - begin <= 50'000) {
+        u64 sum = 0;
+        for (u64 i = begin; i < end; ++i)
+            sum += i % 7;
+        return sum;
+    }
+
+    u64 middle = begin + (end - begin) / 2;
+    u64 left = 0;
+    u64 right = 0;
+    {
+        Threading::TaskGroup group { pool };
+        group.spawn([&] { left = sum_range(pool, begin, middle); });
+        right = sum_range(pool, middle, end);
+    }
+    return left + right;
+}
+
+/**
+ * @brief recursive fork/join, where all the work starts on one worker
+ *        and only spreads by stealing.
+ */
+BENCHMARK_CASE(recursive_fork_join)
+{
+    scale("recursive_fork_join", [](Threading::ThreadPool& pool) {
+        u64 total = 0;
+        {
+            Threading::TaskGroup group { pool };
+            group.spawn([&] { total = sum_range(pool, 0, 50'000'000); });
+        }
+        VERIFY(total > 0);
+    });
+}
@@ -0,0 +1,95 @@
+/**
+ * @file testthreadpool.cpp
+ * @author Krisna Pranav
+ * @brief test thread pool
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libtest/testcase.h>
+#include <libthreading/threadpool.h>
+#include <mods/atomic.h>
+
+TEST_CASE(submitted_tasks_all_run)
+{
+    Threading::ThreadPool pool { 4 };
+    Atomic<size_t> ran { 0 };
+
+    {
+        Threading::TaskGroup group { pool };
+        for (size_t i = 0; i < 1000; ++i)
+            group.spawn([&] { ran.fetch_add(1); });
+    }
+
+    EXPECT_EQ(ran.load(), 1000u);
+}
+
+TEST_CASE(cancelled_task_never_runs)
+{
+    Threading::ThreadPool pool { 1 };
+    Atomic<bool> release { false };
+    Atomic<bool> ran { false };
+
+    auto blocker = pool.submit([&] {
+        while (!release.load())
+            ;
+    });
+    auto task = pool.submit([&] { ran.store(true); });
+
+    EXPECT(task->cancel());
+    release.store(true);
+
+    while (blocker->state() != Threading::Task::State::Finished)
+        ;
+    while (pool.run_pending_task())
+        ;
+
+    EXPECT(!ran.load());
+    EXPECT_EQ(task->state(), Threading::Task::State::Cancelled);
+}
+
+TEST_CASE(high_priority_runs_first)
+{
+    Threading::ThreadPool pool { 1 };
+    Atomic<bool> release { false };
+    Vector<int> order;
+
+    pool.submit([&] {
+        while (!release.load())
+            ;
+    });
+    auto low = pool.submit([&] { order.append(2); }, Threading::TaskPriority::Low);
+    auto high = pool.submit([&] { order.append(1); }, Threading::TaskPriority::High);
+    release.store(true);
+
+    while (low->state() != Threading::Task::State::Finished)
+        ;
+
+    EXPECT_EQ(order.size(), 2u);
+    EXPECT_EQ(order[0], 1);
+    EXPECT_EQ(order[1], 2);
+}
+
+static u64 fibonacci(Threading::ThreadPool& pool, u64 n)
+{
+    if (n < 2)
+        return n;
+
+    u64 a = 0;
+    u64 b = 0;
+    {
+        Threading::TaskGroup group { pool };
+        group.spawn([&] { a = fibonacci(pool, n - 1); });
+        b = fibonacci(pool, n - 2);
+    }
+    return a + b;
+}
+
+TEST_CASE(nested_groups_do_not_deadlock)
+{
+    Threading::ThreadPool pool { 2 };
+    EXPECT_EQ(fibonacci(pool, 16), 987u);
+}
@@ -0,0 +1,89 @@
+/**
+ * @file benchmarkcasemapping.cpp
+ * @author Krisna Pranav
+ * @brief benchmark case mapping
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libcore/elapsedtimer.h>
+#include <libtest/testcase.h>
+#include <libunicode/charactertypes.h>
+#include <mods/format.h>
+#include <mods/string_builder.h>
+
+/**
+ * @brief Latin, Greek with final sigmas, Cyrillic and Turkish dotted I,
+ *        repeated up to the given size.
+ *
+ * @param size
+ * @return String
+ */
+static String mixed_script_document(size_t size)
+{
+    StringBuilder builder;
+    while (builder.length() < size)
+        builder.append("The Quick Brown Fox. ΟΔΥΣΣΕΥΣ ΚΑΙ ΠΗΝΕΛΟΠΗ. Съешь же ещё этих булок. İstanbul Iİ.\n"sv);
+    return builder.to_string();
+}
+
+/**
+ * @param name
+ * @param bytes
+ * @param elapsed_ms
+ */
+static void report(StringView name, size_t bytes, i64 elapsed_ms)
+{
+    elapsed_ms = max<i64>(elapsed_ms, 1);
+    outln("{:<32} {:>8} KiB {:>8} ms {:>8} KiB/s", name, bytes / KiB, elapsed_ms, (bytes * 1000 / KiB) / elapsed_ms);
+}
+
+BENCHMARK_CASE(case_mapping_scales_linearly)
+{
+    // throughput should stay flat as the input grows.
+    for (size_t size = 64 * KiB; size <= 8 * MiB; size *= 4) {
+        auto document = mixed_script_document(size);
+
+        Core::ElapsedTimer timer { true };
+        timer.start();
+        auto lowercase = Unicode::to_unicode_lowercase_full(document);
+        report("to_unicode_lowercase_full"sv, document.length(), timer.elapsed());
+
+        timer.start();
+        auto uppercase = Unicode::to_unicode_uppercase_full(document);
+        report("to_unicode_uppercase_full"sv, document.length(), timer.elapsed());
+
+        EXPECT(!lowercase.is_empty() && !uppercase.is_empty());
+    }
+}
+
+BENCHMARK_CASE(case_mapping_into_reused_builder)
+{
+    auto document = mixed_script_document(8 * MiB);
+    StringBuilder builder(document.length());
+
+    Core::ElapsedTimer timer { true };
+    for (auto* locale : { "en", "tr", "lt" }) {
+        builder.clear();
+        timer.start();
+        Unicode::append_unicode_lowercase_full(builder, document, StringView { locale });
+        report(String::formatted("append lowercase ({})", locale), document.length(), timer.elapsed());
+    }
+}
+
+BENCHMARK_CASE(ascii_case_mapping_throughput)
+{
+    StringBuilder source;
+    while (source.length() < 8 * MiB)
+        source.append("Plain ASCII Text With Some Capitals And digits 0123456789.\n"sv);
+    auto document = source.to_string();
+
+    StringBuilder builder(document.length());
+    Core::ElapsedTimer timer { true };
+    timer.start();
+    Unicode::append_unicode_uppercase_full(builder, document);
+    report("ascii uppercase"sv, document.length(), timer.elapsed());
+}
@@ -0,0 +1,52 @@
+/**
+ * @file testcasemapping.cpp
+ * @author Krisna Pranav
+ * @brief test case mapping
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libtest/testcase.h>
+#include <libunicode/charactertypes.h>
+#include <mods/string.h>
+#include <mods/string_builder.h>
+
+TEST_CASE(ascii_runs_map_across_vector_boundaries)
+{
+    auto input = "The Quick Brown Fox Jumps Over The Lazy Dog @[`{ 0123456789"sv;
+
+    EXPECT_EQ(Unicode::to_unicode_lowercase_full(input), "the quick brown fox jumps over the lazy dog @[`{ 0123456789");
+    EXPECT_EQ(Unicode::to_unicode_uppercase_full(input), "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG @[`{ 0123456789");
+}
+
+TEST_CASE(final_sigma_sees_context_across_ascii_runs)
+{
+    EXPECT_EQ(Unicode::to_unicode_lowercase_full("ΑΣ"sv), "ας");
+    EXPECT_EQ(Unicode::to_unicode_lowercase_full("ΑΣ A"sv), "ας a");
+    EXPECT_EQ(Unicode::to_unicode_lowercase_full("ΑΣA"sv), "ασa");
+    EXPECT_EQ(Unicode::to_unicode_lowercase_full("A.Σ"sv), "a.ς");
+    EXPECT_EQ(Unicode::to_unicode_lowercase_full(" Σ"sv), " σ");
+}
+
+TEST_CASE(locale_special_casing_bypasses_ascii_fast_path)
+{
+    EXPECT_EQ(Unicode::to_unicode_uppercase_full("istanbul"sv, "tr"sv), "İSTANBUL");
+    EXPECT_EQ(Unicode::to_unicode_lowercase_full("ISTANBUL"sv, "tr"sv), "ıstanbul");
+    EXPECT_EQ(Unicode::to_unicode_lowercase_full("I\xCC\x87"sv, "tr"sv), "i");
+}
+
+TEST_CASE(append_reuses_builder)
+{
+    StringBuilder builder;
+
+    Unicode::append_unicode_lowercase_full(builder, "HELLO "sv);
+    Unicode::append_unicode_uppercase_full(builder, "straße"sv);
+    EXPECT_EQ(builder.to_string(), "hello STRASSE");
+
+    builder.clear();
+    Unicode::append_unicode_uppercase_full(builder, "ﬁ"sv);
+    EXPECT_EQ(builder.to_string(), "FI");
+}
@@ -0,0 +1,92 @@
+/**
+ * @file benchmarkbasicblockcache.cpp
+ * @author Krisna Pranav
+ * @brief benchmark basic block cache. this tree cannot build it yet:
+ *        mods/forward.h includes the missing mods/singlylinkedlistsizepolicy.h
+ *        and libx86 has no Interpreter implementation. the figures quoted for
+ *        it so far come from an out-of-tree host build of instruction.cpp and
+ *        basicblockcache.cpp against stand-in mods, libcore and libtest
+ *        headers, and are not reproducible from this tree.
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libcore/elapsedtimer.h>
+#include <libtest/testcase.h>
+#include <libx86/basicblockcache.h>
+#include <mods/format.h>
+
+static constexpr size_t executed_instructions = 50'000'000;
+
+// mov eax, [ebx+4]; add eax, ecx; inc ecx; lea edx, [eax+ecx*4+8];
+// xor esi, esi; cmp ecx, edi; mov [ebx], eax; jne 0; ret
+static u8 const loop_code[] = {
+    0x8B, 0x43, 0x04, 0x01, 0xC8, 0x41, 0x8D, 0x54, 0x88, 0x08,
+    0x31, 0xF6, 0x39, 0xF9, 0x89, 0x03, 0x75, 0xEE, 0xC3
+};
+
+static constexpr u32 loop_branch = 16;
+
+/**
+ * @param name
+ * @param instructions
+ * @param elapsed_ms
+ */
+static void report(StringView name, size_t instructions, i64 elapsed_ms)
+{
+    elapsed_ms = max<i64>(elapsed_ms, 1);
+    outln("{:<24} {:>8} ms {:>8} M instructions/s", name, elapsed_ms, instructions / 1000 / elapsed_ms);
+}
+
+/**
+ * @brief the front end of an interpreter loop without the handlers: what
+ *        it costs to get from an eip to the next handler to call.
+ */
+BENCHMARK_CASE(decode_every_instruction)
+{
+    X86::InstructionHandler volatile last_handler = nullptr;
+
+    Core::ElapsedTimer timer { true };
+    timer.start();
+
+    u32 eip = 0;
+    for (size_t i = 0; i < executed_instructions; ++i) {
+        X86::SimpleInstructionStream stream { loop_code + eip, sizeof(loop_code) - eip };
+        auto instruction = X86::Instruction::from_stream(stream, true, true);
+        last_handler = instruction.handler();
+        eip = eip == loop_branch ? 0 : eip + stream.offset();
+    }
+
+    report("from_stream()"sv, executed_instructions, timer.elapsed());
+}
+
+BENCHMARK_CASE(decoded_block_cache)
+{
+    X86::InstructionHandler volatile last_handler = nullptr;
+    X86::BasicBlockCache cache;
+
+    Core::ElapsedTimer timer { true };
+    timer.start();
+
+    u32 eip = 0;
+    size_t executed = 0;
+    while (executed < executed_instructions) {
+        auto* block = cache.find(eip, true, true);
+        if (!block) {
+            X86::SimpleInstructionStream stream { loop_code + eip, sizeof(loop_code) - eip };
+            block = &cache.decode(eip, stream, true, true);
+        }
+
+        for (auto& decoded : block->instructions())
+            last_handler = decoded.handler;
+
+        executed += block->instructions().size();
+        eip = block->end() == loop_branch + 2 ? 0 : block->end();
+    }
+
+    report("BasicBlockCache"sv, executed, timer.elapsed());
+    EXPECT_EQ(cache.statistics().misses, 1u);
+}
@@ -0,0 +1,124 @@
+/**
+ * @file testbasicblockcache.cpp
+ * @author Krisna Pranav
+ * @brief test basic block cache
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libtest/testcase.h>
+#include <libx86/basicblockcache.h>
+#include <string.h>
+
+// mov eax, [ebx+4]; add eax, ecx; inc ecx; cmp ecx, edi; jne 0; ret
+static u8 const loop_code[] = { 0x8B, 0x43, 0x04, 0x01, 0xC8, 0x41, 0x39, 0xF9, 0x75, 0xF6, 0xC3 };
+
+/**
+ * @param cache
+ * @param code
+ * @param size
+ * @param address
+ * @return X86::DecodedBlock const&
+ */
+static X86::DecodedBlock const& decode_at(X86::BasicBlockCache& cache, u8 const* code, size_t size, u32 address)
+{
+    X86::SimpleInstructionStream stream { code + address, size - address };
+    return cache.decode(address, stream, true, true);
+}
+
+TEST_CASE(opcode_tables_are_constant_initialized)
+{
+    auto& tables = X86::s_opcode_tables;
+    EXPECT_EQ(StringView { tables.table32[0x01].mnemonic }, "ADD"sv);
+    EXPECT(tables.table32[0xFF].slashes);
+    EXPECT_EQ(StringView { tables.table32[0xFF].slashes[2].mnemonic }, "CALL"sv);
+    EXPECT(tables.slash_descriptor_count <= X86::max_slash_descriptors);
+
+    EXPECT(tables.table32[0xE8].ends_basic_block);
+    EXPECT(tables.table_0f32[0x84].ends_basic_block);
+    EXPECT(tables.table32[0xFF].slashes[4].ends_basic_block);
+    EXPECT(!tables.table32[0x80].ends_basic_block);
+    EXPECT(!tables.table32[0xFF].slashes[0].ends_basic_block);
+}
+
+TEST_CASE(block_ends_at_the_first_branch)
+{
+    X86::BasicBlockCache cache;
+    auto& block = decode_at(cache, loop_code, sizeof(loop_code), 0);
+
+    EXPECT_EQ(block.instructions().size(), 5u);
+    EXPECT_EQ(block.end(), 10u);
+    EXPECT_EQ(block.instructions()[3].address, 6u);
+    EXPECT_EQ(block.instructions().last().instruction.op(), 0x75);
+
+    for (auto& decoded : block.instructions())
+        EXPECT(decoded.handler == decoded.instruction.handler());
+
+    EXPECT_EQ(cache.find(0, true, true), &block);
+    EXPECT_EQ(cache.find(0, false, true), nullptr);
+    EXPECT_EQ(cache.find(3, true, true), nullptr);
+}
+
+TEST_CASE(writes_invalidate_only_code_pages)
+{
+    X86::BasicBlockCache cache;
+    decode_at(cache, loop_code, sizeof(loop_code), 0);
+
+    cache.did_write(X86::BasicBlockCache::page_size * 3, 4);
+    EXPECT_EQ(cache.block_count(), 1u);
+    EXPECT_EQ(cache.statistics().invalidated_blocks, 0u);
+
+    // a write at the top of the address space does not wrap to page 0
+    cache.did_write(0xFFFFFFFE, 4);
+    EXPECT_EQ(cache.block_count(), 1u);
+
+    cache.did_write(X86::BasicBlockCache::page_size - 2, 4);
+    EXPECT_EQ(cache.block_count(), 0u);
+    EXPECT_EQ(cache.find(0, true, true), nullptr);
+    EXPECT_EQ(cache.statistics().invalidated_blocks, 1u);
+}
+
+TEST_CASE(blocks_spanning_two_pages_are_dropped_from_either)
+{
+    static u8 code[3 * X86::BasicBlockCache::page_size];
+    memset(code, 0x90, sizeof(code));
+    code[X86::BasicBlockCache::page_size + 3] = 0xC3;
+
+    for (u32 written_page : { 0u, 1u }) {
+        X86::BasicBlockCache cache;
+        auto& block = decode_at(cache, code, sizeof(code), X86::BasicBlockCache::page_size - 6);
+        EXPECT_EQ(block.instructions().size(), 10u);
+        EXPECT_EQ(block.end(), X86::BasicBlockCache::page_size + 4);
+
+        cache.did_write(written_page * X86::BasicBlockCache::page_size + 100, 1);
+        EXPECT_EQ(cache.block_count(), 0u);
+
+        // the other page holds no code any more, so writing to it is free
+        cache.did_write((1 - written_page) * X86::BasicBlockCache::page_size + 100, 1);
+        EXPECT_EQ(cache.statistics().invalidated_blocks, 1u);
+    }
+}
+
+TEST_CASE(long_straight_runs_are_split)
+{
+    static u8 code[512];
+    memset(code, 0x90, sizeof(code));
+
+    X86::BasicBlockCache cache;
+    auto& block = decode_at(cache, code, sizeof(code), 0);
+    EXPECT_EQ(block.instructions().size(), X86::BasicBlockCache::max_instructions_per_block);
+}
+
+TEST_CASE(undecodable_instruction_gives_an_empty_block)
+{
+    // 0F 04 is not an instruction
+    u8 const code[] = { 0x0F, 0x04 };
+
+    X86::BasicBlockCache cache;
+    auto& block = decode_at(cache, code, sizeof(code), 0);
+    EXPECT(block.is_empty());
+    EXPECT_EQ(block.end(), 0u);
+}
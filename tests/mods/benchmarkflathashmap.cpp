@@ -0,0 +1,144 @@
+/**
+ * @file benchmarkflathashmap.cpp
+ * @author Krisna Pranav
+ * @brief benchmark flat hash map
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libtest/testcase.h>
+#include <mods/flathashmap.h>
+#include <mods/format.h>
+#include <mods/hashmap.h>
+#include <mods/random.h>
+#include <mods/vector.h>
+#include <libcore/elapsedtimer.h>
+
+static constexpr size_t sizes[] = { 1'000, 10'000, 100'000, 1'000'000, 10'000'000 };
+
+static Vector<u32> make_keys(size_t count)
+{
+    Vector<u32> keys;
+    keys.ensure_capacity(count);
+    for (size_t i = 0; i < count; ++i)
+        keys.unchecked_append(get_random<u32>());
+    return keys;
+}
+
+TEST_CASE(flat_hash_map_matches_hash_map)
+{
+    FlatHashMap<u32, u32> flat;
+    HashMap<u32, u32> reference;
+
+    for (size_t i = 0; i < 100'000; ++i) {
+        auto key = get_random_uniform(5000);
+        switch (get_random_uniform(3)) {
+        case 0:
+            EXPECT_EQ(flat.set(key, i), reference.set(key, i));
+            break;
+        case 1:
+            EXPECT_EQ(flat.remove(key), reference.remove(key));
+            break;
+        default:
+            EXPECT_EQ(flat.get(key), reference.get(key));
+            break;
+        }
+        EXPECT_EQ(flat.size(), reference.size());
+    }
+
+    size_t visited = 0;
+    for (auto& entry : flat) {
+        EXPECT_EQ(reference.get(entry.key), entry.value);
+        ++visited;
+    }
+    EXPECT_EQ(visited, reference.size());
+}
+
+TEST_CASE(flat_hash_set_basics)
+{
+    FlatHashSet<String> set;
+    EXPECT(set.is_empty());
+    EXPECT(!set.contains("missing"sv));
+
+    EXPECT_EQ(set.set("one"), HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(set.set("two"), HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(set.set("one", HashSetExistingEntryBehavior::Keep), HashSetResult::KeptExistingEntry);
+    EXPECT_EQ(set.size(), 2u);
+
+    EXPECT(set.remove("one"));
+    EXPECT(!set.contains("one"));
+    EXPECT(set.contains("two"));
+
+    set.clear_with_capacity();
+    EXPECT(set.is_empty());
+    EXPECT(set.begin() == set.end());
+}
+
+TEST_CASE(tombstones_do_not_grow_the_table)
+{
+    FlatHashMap<u32, u32> map;
+    map.ensure_capacity(1000);
+    auto capacity = map.capacity();
+
+    for (u32 round = 0; round < 100; ++round) {
+        for (u32 i = 0; i < 1000; ++i)
+            map.set(round * 1000 + i, i);
+        for (u32 i = 0; i < 1000; ++i)
+            EXPECT(map.remove(round * 1000 + i));
+    }
+
+    EXPECT(map.is_empty());
+    EXPECT_EQ(map.capacity(), capacity);
+}
+
+/**
+ * @brief times insert, successful lookup, failed lookup, iteration and erase
+ *        for one map type; both maps get the same keys.
+ */
+template<typename Map>
+static void run(StringView name, Vector<u32> const& keys, Vector<u32> const& misses)
+{
+    Map map;
+    Core::ElapsedTimer timer { true };
+
+    timer.start();
+    for (auto key : keys)
+        map.set(key, key);
+    auto insert_ms = timer.elapsed();
+
+    size_t found = 0;
+    timer.start();
+    for (auto key : keys)
+        found += map.contains(key);
+    for (auto key : misses)
+        found += map.contains(key);
+    auto lookup_ms = timer.elapsed();
+
+    u64 sum = 0;
+    timer.start();
+    for (auto& entry : map)
+        sum += entry.value;
+    auto iterate_ms = timer.elapsed();
+
+    timer.start();
+    for (auto key : keys)
+        map.remove(key);
+    auto erase_ms = timer.elapsed();
+
+    EXPECT(map.is_empty());
+    outln("{:>12} {:>9} {:>9} {:>9} {:>9} {:>9}  ({} found, sum {})", name, keys.size(), insert_ms, lookup_ms, iterate_ms, erase_ms, found, sum);
+}
+
+BENCHMARK_CASE(flat_hash_map_vs_hash_map)
+{
+    outln("{:>12} {:>9} {:>9} {:>9} {:>9} {:>9}", "map", "entries", "insert", "lookup", "iterate", "erase");
+    for (auto size : sizes) {
+        auto keys = make_keys(size);
+        auto misses = make_keys(size);
+        run<HashMap<u32, u32>>("HashMap"sv, keys, misses);
+        run<FlatHashMap<u32, u32>>("FlatHashMap"sv, keys, misses);
+    }
+}
@@ -0,0 +1,206 @@
+/**
+ * @file benchmarkquicksort.cpp
+ * @author Krisna Pranav
+ * @brief benchmark quick sort
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libtest/testcase.h>
+#include <mods/format.h>
+#include <mods/quicksort.h>
+#include <mods/random.h>
+#include <mods/vector.h>
+#include <libcore/elapsedtimer.h>
+#include <stdlib.h>
+
+enum class Pattern {
+    Random,
+    Sorted,
+    Reversed,
+    OrganPipe,
+    ManyDuplicates,
+    SortedWithNoise,
+};
+
+static constexpr Pattern patterns[] = {
+    Pattern::Random,
+    Pattern::Sorted,
+    Pattern::Reversed,
+    Pattern::OrganPipe,
+    Pattern::ManyDuplicates,
+    Pattern::SortedWithNoise,
+};
+
+static StringView pattern_name(Pattern pattern)
+{
+    switch (pattern) {
+    case Pattern::Random:
+        return "random"sv;
+    case Pattern::Sorted:
+        return "sorted"sv;
+    case Pattern::Reversed:
+        return "reversed"sv;
+    case Pattern::OrganPipe:
+        return "organ-pipe"sv;
+    case Pattern::ManyDuplicates:
+        return "duplicates"sv;
+    case Pattern::SortedWithNoise:
+        return "noisy-sorted"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static Vector<int> make_input(Pattern pattern, size_t size)
+{
+    Vector<int> values;
+    values.ensure_capacity(size);
+    for (size_t i = 0; i < size; ++i) {
+        switch (pattern) {
+        case Pattern::Random:
+            values.unchecked_append(static_cast<int>(get_random<u32>()));
+            break;
+        case Pattern::Sorted:
+            values.unchecked_append(static_cast<int>(i));
+            break;
+        case Pattern::Reversed:
+            values.unchecked_append(static_cast<int>(size - i));
+            break;
+        case Pattern::OrganPipe:
+            values.unchecked_append(static_cast<int>(i < size / 2 ? i : size - i));
+            break;
+        case Pattern::ManyDuplicates:
+            values.unchecked_append(static_cast<int>(get_random_uniform(4)));
+            break;
+        case Pattern::SortedWithNoise:
+            values.unchecked_append(i % 64 == 0 ? static_cast<int>(get_random<u32>()) : static_cast<int>(i));
+            break;
+        }
+    }
+    return values;
+}
+
+static bool is_sorted(Vector<int> const& values)
+{
+    for (size_t i = 1; i < values.size(); ++i) {
+        if (values[i] < values[i - 1])
+            return false;
+    }
+    return true;
+}
+
+static int compare_ints(void const* a, void const* b)
+{
+    auto x = *static_cast<int const*>(a);
+    auto y = *static_cast<int const*>(b);
+    return (x > y) - (x < y);
+}
+
+static int compare_randomly(void const*, void const*)
+{
+    return static_cast<int>(get_random_uniform(3)) - 1;
+}
+
+struct LargeRecord {
+    int key;
+    u8 payload[124];
+};
+
+TEST_CASE(sorts_every_pattern)
+{
+    for (auto pattern : patterns) {
+        for (size_t size : { 0, 1, 2, 23, 24, 129, 1000, 10000 }) {
+            auto values = make_input(pattern, size);
+            quick_sort(values);
+            EXPECT(is_sorted(values));
+
+            auto c_values = make_input(pattern, size);
+            qsort(c_values.data(), c_values.size(), sizeof(int), compare_ints);
+            EXPECT(is_sorted(c_values));
+        }
+    }
+}
+
+TEST_CASE(qsort_large_elements_keep_their_payload)
+{
+    Vector<LargeRecord> records;
+    for (int i = 0; i < 1000; ++i) {
+        LargeRecord record;
+        record.key = static_cast<int>(get_random_uniform(100));
+        for (auto& byte : record.payload)
+            byte = static_cast<u8>(record.key);
+        records.append(record);
+    }
+
+    qsort(records.data(), records.size(), sizeof(LargeRecord), compare_ints);
+
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (i > 0)
+            EXPECT(records[i - 1].key <= records[i].key);
+        for (auto byte : records[i].payload)
+            EXPECT_EQ(byte, static_cast<u8>(records[i].key));
+    }
+}
+
+TEST_CASE(qsort_with_inconsistent_comparator_stays_in_bounds)
+{
+    static constexpr int guard = 0x7eadbeef;
+    static constexpr size_t guard_count = 64;
+
+    for (size_t size : { 2, 24, 129, 1000, 10000 }) {
+        Vector<int> values;
+        values.resize(size + 2 * guard_count);
+        for (size_t i = 0; i < values.size(); ++i)
+            values[i] = i < guard_count || i >= guard_count + size ? guard : static_cast<int>(get_random_uniform(8));
+
+        qsort(values.data() + guard_count, size, sizeof(int), compare_randomly);
+
+        for (size_t i = 0; i < guard_count; ++i) {
+            EXPECT_EQ(values[i], guard);
+            EXPECT_EQ(values[guard_count + size + i], guard);
+        }
+        for (size_t i = guard_count; i < guard_count + size; ++i)
+            EXPECT(values[i] >= 0 && values[i] < 8);
+    }
+}
+
+BENCHMARK_CASE(quick_sort_patterns)
+{
+    static constexpr size_t size = 1'000'000;
+
+    for (auto pattern : patterns) {
+        auto values = make_input(pattern, size);
+        auto c_values = values;
+
+        Core::ElapsedTimer timer { true };
+        timer.start();
+        quick_sort(values);
+        auto mods_ms = timer.elapsed();
+
+        timer.start();
+        qsort(c_values.data(), c_values.size(), sizeof(int), compare_ints);
+        auto libc_ms = timer.elapsed();
+
+        EXPECT(is_sorted(values));
+        EXPECT(is_sorted(c_values));
+        outln("{:>13} quick_sort {:>5}ms qsort {:>5}ms", pattern_name(pattern), mods_ms, libc_ms);
+    }
+}
+
+BENCHMARK_CASE(qsort_large_elements)
+{
+    static constexpr size_t size = 200'000;
+
+    Vector<LargeRecord> records;
+    records.ensure_capacity(size);
+    for (size_t i = 0; i < size; ++i)
+        records.unchecked_append({ static_cast<int>(get_random<u32>()), {} });
+
+    Core::ElapsedTimer timer { true };
+    timer.start();
+    qsort(records.data(), records.size(), sizeof(LargeRecord), compare_ints);
+    outln("{} x {}-byte records: {}ms", size, sizeof(LargeRecord), timer.elapsed());
+}
@@ -0,0 +1,190 @@
+/**
+ * @file benchmarkstring.cpp
+ * @author Krisna Pranav
+ * @brief benchmark string
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libtest/testcase.h>
+#include <mods/format.h>
+#include <mods/random.h>
+#include <mods/string.h>
+#include <mods/stringbuilder.h>
+#include <mods/vector.h>
+#include <libcore/elapsedtimer.h>
+#include <stdlib.h>
+
+static constexpr size_t lengths[] = { 0, 1, 7, 15, String::inline_capacity, String::inline_capacity + 1, 64, 256 };
+
+static String make_string(size_t length)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < length; ++i)
+        builder.append(static_cast<char>('a' + get_random_uniform(26)));
+    return builder.to_string();
+}
+
+/**
+ * @brief identifier-ish lengths, skewed short the way most strings built at
+ *        runtime (keys, tokens, paths components) are.
+ */
+static size_t random_length()
+{
+    auto bucket = get_random_uniform(100);
+    if (bucket < 70)
+        return get_random_uniform(16);
+    if (bucket < 90)
+        return 16 + get_random_uniform(16);
+    return 32 + get_random_uniform(224);
+}
+
+TEST_CASE(short_strings_are_inline)
+{
+    for (auto length : lengths) {
+        auto string = make_string(length);
+        EXPECT_EQ(string.length(), length);
+        EXPECT_EQ(string.characters()[length], '\0');
+        EXPECT_EQ(string.is_inline(), length <= String::inline_capacity);
+        EXPECT(!string.is_null());
+    }
+
+    String null_string;
+    EXPECT(null_string.is_null());
+    EXPECT(!null_string.is_inline());
+    EXPECT(String::empty().is_inline());
+}
+
+TEST_CASE(inline_and_heap_strings_agree)
+{
+    for (auto length : lengths) {
+        auto string = make_string(length);
+        auto heap_string = String(*StringImpl::create(string.characters(), length));
+
+        EXPECT_EQ(string, heap_string);
+        EXPECT_EQ(string.hash(), heap_string.hash());
+        EXPECT_EQ(string.view(), heap_string.view());
+
+        auto copy = string;
+        auto moved = move(copy);
+        EXPECT(copy.is_null());
+        EXPECT_EQ(moved, string);
+
+        auto characters_before = string.view().to_string();
+        auto* impl = string.impl();
+        EXPECT(impl != nullptr);
+        EXPECT(!string.is_inline());
+        EXPECT_EQ(impl->length(), length);
+        EXPECT_EQ(string, characters_before);
+    }
+}
+
+TEST_CASE(case_conversion_keeps_short_strings_inline)
+{
+    String string("Hello, World");
+    auto lowercase = string.to_lowercase();
+    auto uppercase = string.to_uppercase();
+    EXPECT_EQ(lowercase, "hello, world"sv);
+    EXPECT_EQ(uppercase, "HELLO, WORLD"sv);
+    EXPECT(lowercase.is_inline());
+    EXPECT(uppercase.is_inline());
+    EXPECT_EQ(string, "Hello, World"sv);
+}
+
+TEST_CASE(chomp_can_make_a_string_inline)
+{
+    String string("short line\r\n\r\n\r\n\r\n\r\n\r\n\r\n", Chomp);
+    EXPECT_EQ(string, "short line"sv);
+    EXPECT(string.is_inline());
+}
+
+TEST_CASE(const_impl_leaves_inline_strings_alone)
+{
+    String const string("short");
+    auto* characters = string.characters();
+    auto impl = string.impl();
+    EXPECT(string.is_inline());
+    EXPECT_EQ(string.characters(), characters);
+    EXPECT_EQ(impl->length(), string.length());
+    EXPECT_EQ(String(*impl), string);
+}
+
+/**
+ * @brief counts the malloc() calls made while building the same strings as
+ *        inline-capable Strings and as plain StringImpls, which is what every
+ *        String used to be. the inputs are generated up front so only the
+ *        construction itself is measured.
+ */
+BENCHMARK_CASE(allocation_count)
+{
+    static constexpr size_t count = 100'000;
+
+    Vector<size_t> input_lengths;
+    input_lengths.ensure_capacity(count);
+    size_t total_length = 0;
+    for (size_t i = 0; i < count; ++i) {
+        input_lengths.unchecked_append(random_length());
+        total_length += input_lengths.last();
+    }
+    auto characters = make_string(total_length);
+
+    Vector<String> strings;
+    strings.ensure_capacity(count);
+    auto calls_before = pranaos_malloc_call_count();
+    for (size_t i = 0, offset = 0; i < count; offset += input_lengths[i++])
+        strings.unchecked_append(String(characters.characters() + offset, input_lengths[i]));
+    auto string_calls = pranaos_malloc_call_count() - calls_before;
+
+    Vector<RefPtr<StringImpl>> impls;
+    impls.ensure_capacity(count);
+    calls_before = pranaos_malloc_call_count();
+    for (size_t i = 0, offset = 0; i < count; offset += input_lengths[i++])
+        impls.unchecked_append(StringImpl::create(characters.characters() + offset, input_lengths[i]));
+    auto impl_calls = pranaos_malloc_call_count() - calls_before;
+
+    outln("{} strings: {} malloc() calls (was {}), {:.1}% saved",
+        count, string_calls, impl_calls, 100.0 * (impl_calls - string_calls) / impl_calls);
+}
+
+BENCHMARK_CASE(construct_and_copy)
+{
+    static constexpr size_t iterations = 2'000'000;
+
+    outln("{:>6} {:>12} {:>12} {:>12}", "length", "construct ms", "copy ms", "move ms");
+    for (auto length : lengths) {
+        auto source = make_string(length);
+        auto view = source.view();
+
+        size_t total_length = 0;
+
+        Core::ElapsedTimer timer { true };
+        timer.start();
+        for (size_t i = 0; i < iterations; ++i) {
+            String string(view);
+            total_length += string.length();
+        }
+        auto construct_ms = timer.elapsed();
+
+        timer.start();
+        for (size_t i = 0; i < iterations; ++i) {
+            String copy(source);
+            total_length += copy.length();
+        }
+        auto copy_ms = timer.elapsed();
+
+        timer.start();
+        String moving = source;
+        for (size_t i = 0; i < iterations; ++i) {
+            String moved(move(moving));
+            moving = move(moved);
+        }
+        auto move_ms = timer.elapsed();
+
+        EXPECT_EQ(total_length, 2 * iterations * length);
+        EXPECT_EQ(moving, source);
+        outln("{:>6} {:>12} {:>12} {:>12}", length, construct_ms, copy_ms, move_ms);
+    }
+}
@@ -54,9 +54,91 @@ typedef struct firewall_constraint_buf
     u8 buf[0];
 }* firewall_constraint_buf;
 
+#define FW_TRIE_STRIDE 4
+#define FW_TRIE_FANOUT (1 << FW_TRIE_STRIDE)
+#define FW_FLOW_CACHE_ORDER 10
+#define FW_FLOW_CACHE_SIZE (1 << FW_FLOW_CACHE_ORDER)
+#define FW_CLASSIFIER_MIN_RULES 8
+
+enum firewall_version_class
+{
+    FW_VERSION_4,
+    FW_VERSION_6,
+    FW_VERSION_OTHER,
+    FW_VERSION_CLASSES,
+}; // enum firewall_version_class
+
+/* a node of a multibit trie over source addresses; rules holds every rule
+ * whose prefix covers all addresses below this node */
+typedef struct firewall_trie_node
+{
+    struct firewall_trie_node* child[FW_TRIE_FANOUT];
+    u64 rules[0];
+}* firewall_trie_node;
+
+/* one cached verdict for a complete TCP or UDP packet; seq is odd while
+ * the entry is being written and 0 while it has never been */
+typedef struct firewall_flow
+{
+    u64 seq;
+    u8 src[16];
+    u8 dst[16];
+    u16 src_port;
+    u16 dest_port;
+    u8 version;
+    u8 proto;
+    u8 drop;
+}* firewall_flow;
+
+/* the rule list compiled into one rule bitset per field value: a packet
+ * matches the rules in the intersection of the bitsets its fields select,
+ * and the lowest set bit is the first matching rule */
+typedef struct firewall_classifier
+{
+    heap h;
+    u64 rule_count;
+    u64 words;
+    u8* drop;
+    u64 bitset_count;
+    u64* bitsets;
+    u64* version[FW_VERSION_CLASSES];
+    u64* no_l3;
+    u64* frag[2];
+    u64* proto_any;
+    u8 proto_index[256];
+    u64* proto_sets;
+    u64* l4_tcp;
+    u64* l4_udp;
+    u64* src_none;
+    u64* src_eq;
+    u64* src_neq;
+    firewall_trie_node src_trie[2];
+    u64* port_default;
+    u64 port_table_mask;
+    u32* port_table;
+    u64* port_sets;
+    struct firewall_flow flows[FW_FLOW_CACHE_SIZE];
+}* firewall_classifier;
+
+/* what the classifier looks at in a packet, parsed once */
+typedef struct firewall_pkt
+{
+    u8 version;
+    int version_class;
+    boolean l3_ok;
+    boolean frag;
+    boolean proto_ok;
+    u8 proto;
+    void* src;
+    void* dst;
+    void* l4_hdr;
+    unsigned int l4_len;
+}* firewall_pkt;
+
 static struct firewall
 {
     struct list rules;
+    firewall_classifier classifier;
 } firewall;
 
 /**
@@ -90,7 +172,7 @@ static boolean firewall_match_buf(void* buf, firewall_constraint c)
     u64 bit_count = c_buf->len & 7;
 
     if(!bit_count)
-        return true;
+        return c->equals;
 
     u8 bit_mask = ~MASK(8 - bit_count);
     u8 b = ((u8*)buf)[byte_count] & bit_mask;
@@ -356,22 +438,672 @@ static boolean firewall_match(struct pbuf* p, firewall_rule rule)
 }
 
 /**
- * @param pbuf
- * @param input_netif
- * @return int
+ * @param bits
+ * @param i
  */
-static int firewall_filter(struct pbuf* pbuf, struct netif* input_netif)
+static inline void firewall_bit_set(u64* bits, u64 i)
+{
+    bits[i / 64] |= 1ull << (i % 64);
+}
+
+/**
+ * @param c
+ * @param dest
+ * @param src
+ */
+static inline void firewall_bits_or(firewall_classifier c, u64* dest, u64* src)
+{
+    for(u64 i = 0; i < c->words; i++)
+        dest[i] |= src[i];
+}
+
+/**
+ * @param addr
+ * @param k
+ * @return u8 the k-th group of FW_TRIE_STRIDE bits of addr, from the top
+ */
+static inline u8 firewall_addr_chunk(const u8* addr, u64 k)
+{
+    u8 b = addr[k / 2];
+    return (k & 1) ? (b & 0xf) : (b >> 4);
+}
+
+/**
+ * @param c
+ * @return firewall_trie_node
+ */
+static firewall_trie_node firewall_trie_node_alloc(firewall_classifier c)
+{
+    u64 size = sizeof(struct firewall_trie_node) + c->words * sizeof(u64);
+    firewall_trie_node n = allocate(c->h, size);
+    assert(n != INVALID_ADDRESS);
+    zero(n, size);
+    return n;
+}
+
+/**
+ * @param c
+ * @param n
+ */
+static void firewall_trie_destroy(firewall_classifier c, firewall_trie_node n)
+{
+    if(!n)
+        return;
+    for(int i = 0; i < FW_TRIE_FANOUT; i++)
+        firewall_trie_destroy(c, n->child[i]);
+    deallocate(c->h, n, sizeof(struct firewall_trie_node) + c->words * sizeof(u64));
+}
+
+/**
+ * @param c
+ * @param n
+ * @param k
+ * @return firewall_trie_node
+ */
+static firewall_trie_node firewall_trie_child(firewall_classifier c, firewall_trie_node n, u8 k)
+{
+    if(!n->child[k])
+        n->child[k] = firewall_trie_node_alloc(c);
+    return n->child[k];
+}
+
+/**
+ * @brief a prefix that ends inside a chunk is expanded into every child it
+ *        covers
+ *
+ * @param c
+ * @param root
+ * @param addr
+ * @param len
+ * @param rule
+ */
+static void firewall_trie_insert(firewall_classifier c, firewall_trie_node root, const u8* addr, u64 len, u64 rule)
+{
+    firewall_trie_node n = root;
+    u64 full = len / FW_TRIE_STRIDE;
+    u64 rem = len % FW_TRIE_STRIDE;
+    for(u64 k = 0; k < full; k++)
+        n = firewall_trie_child(c, n, firewall_addr_chunk(addr, k));
+    if(!rem)
+    {
+        firewall_bit_set(n->rules, rule);
+        return;
+    }
+    u8 base = firewall_addr_chunk(addr, full) & ~MASK(FW_TRIE_STRIDE - rem);
+    for(u8 v = 0; v <= MASK(FW_TRIE_STRIDE - rem); v++)
+        firewall_bit_set(firewall_trie_child(c, n, base | v)->rules, rule);
+}
+
+/**
+ * @brief pushes each node's rules down to its children, so a lookup only
+ *        needs the deepest node it reaches
+ *
+ * @param c
+ * @param n
+ */
+static void firewall_trie_propagate(firewall_classifier c, firewall_trie_node n)
+{
+    for(int i = 0; i < FW_TRIE_FANOUT; i++)
+    {
+        firewall_trie_node child = n->child[i];
+        if(child)
+        {
+            firewall_bits_or(c, child->rules, n->rules);
+            firewall_trie_propagate(c, child);
+        }
+    }
+}
+
+/**
+ * @param root
+ * @param addr
+ * @param bits
+ * @return u64*
+ */
+static u64* firewall_trie_lookup(firewall_trie_node root, const u8* addr, u64 bits)
+{
+    firewall_trie_node n = root;
+    for(u64 k = 0; k < bits / FW_TRIE_STRIDE; k++)
+    {
+        firewall_trie_node child = n->child[firewall_addr_chunk(addr, k)];
+        if(!child)
+            break;
+        n = child;
+    }
+    return n->rules;
+}
+
+/**
+ * @param port
+ * @return u64
+ */
+static inline u64 firewall_port_hash(u16 port)
+{
+    return (port * 0x9e3779b1u) >> 16;
+}
+
+/**
+ * @param c
+ * @param port in network byte order
+ * @return s64 index of port in port_sets, -1 if no rule tests it
+ */
+static s64 firewall_port_find(firewall_classifier c, u16 port)
+{
+    if(!c->port_table)
+        return -1;
+    for(u64 i = firewall_port_hash(port);; i++)
+    {
+        u32 e = c->port_table[i & c->port_table_mask];
+        if(!e)
+            return -1;
+        if((e & 0xffff) == port)
+            return (e >> 16) - 1;
+    }
+}
+
+/**
+ * @param c
+ * @param port in network byte order
+ * @return u64* the rules that a packet to port can match
+ */
+static u64* firewall_port_lookup(firewall_classifier c, u16 port)
+{
+    s64 i = firewall_port_find(c, port);
+    return (i < 0) ? c->port_default : (c->port_sets + i * c->words);
+}
+
+/**
+ * @param c
+ * @param port
+ * @param count
+ * @return u64 index of port in port_sets, added if new
+ */
+static u64 firewall_port_insert(firewall_classifier c, u16 port, u64* count)
 {
+    for(u64 i = firewall_port_hash(port);; i++)
+    {
+        u32* e = &c->port_table[i & c->port_table_mask];
+        if(!*e)
+        {
+            *e = port | ((++*count) << 16);
+            return *count - 1;
+        }
+        if((*e & 0xffff) == port)
+            return (*e >> 16) - 1;
+    }
+}
+
+/**
+ * @param h
+ * @param c
+ */
+static void firewall_classifier_destroy(heap h, firewall_classifier c)
+{
+    firewall_trie_destroy(c, c->src_trie[0]);
+    firewall_trie_destroy(c, c->src_trie[1]);
+    if(c->port_table)
+        deallocate(h, c->port_table, (c->port_table_mask + 1) * sizeof(u32));
+    deallocate(h, c->bitsets, c->bitset_count * c->words * sizeof(u64));
+    deallocate(h, c->drop, c->rule_count ? c->rule_count : 1);
+    deallocate(h, c, sizeof(*c));
+}
+
+/**
+ * @brief compiles the rule list. rules are numbered in list order, so the
+ *        lowest matching number is the rule the list walk would stop at.
+ *
+ * @param h
+ * @return firewall_classifier
+ */
+static firewall_classifier firewall_classifier_build(heap h)
+{
+    firewall_classifier c = allocate(h, sizeof(*c));
+    assert(c != INVALID_ADDRESS);
+    zero(c, sizeof(*c));
+    c->h = h;
+
+    u64 dest_ports = 0;
     list_foreach(&firewall.rules, elem)
     {
         firewall_rule rule = struct_from_list(elem, firewall_rule, l);
-        if(firewall_match(pbuf, rule))
+        c->rule_count++;
+        if(rule->l4_match)
+            dest_ports += vector_length(rule->l4_match);
+    }
+    c->words = pad(c->rule_count ? c->rule_count : 1, 64) / 64;
+
+    c->drop = allocate(h, c->rule_count ? c->rule_count : 1);
+    assert(c->drop != INVALID_ADDRESS);
+
+    /* each rule tests at most one protocol, so rule_count proto sets are enough */
+    u64 fixed = FW_VERSION_CLASSES + 1 + 2 + 1 + 2 + 3 + 1;
+    c->bitset_count = fixed + c->rule_count + dest_ports;
+    u64 bytes = c->bitset_count * c->words * sizeof(u64);
+    c->bitsets = allocate(h, bytes);
+    assert(c->bitsets != INVALID_ADDRESS);
+    zero(c->bitsets, bytes);
+
+    u64* next = c->bitsets;
+#define FW_NEXT_BITSET() ({ u64 *__b = next; next += c->words; __b; })
+    for(int i = 0; i < FW_VERSION_CLASSES; i++)
+        c->version[i] = FW_NEXT_BITSET();
+    c->no_l3 = FW_NEXT_BITSET();
+    c->frag[0] = FW_NEXT_BITSET();
+    c->frag[1] = FW_NEXT_BITSET();
+    c->proto_any = FW_NEXT_BITSET();
+    c->l4_tcp = FW_NEXT_BITSET();
+    c->l4_udp = FW_NEXT_BITSET();
+    c->src_none = FW_NEXT_BITSET();
+    c->src_eq = FW_NEXT_BITSET();
+    c->src_neq = FW_NEXT_BITSET();
+    c->port_default = FW_NEXT_BITSET();
+    c->proto_sets = next;
+    c->port_sets = next + c->rule_count * c->words;
+#undef FW_NEXT_BITSET
+
+    c->src_trie[0] = firewall_trie_node_alloc(c);
+    c->src_trie[1] = firewall_trie_node_alloc(c);
+    if(dest_ports)
+    {
+        c->port_table_mask = U64_FROM_BIT(msb(dest_ports * 2) + 1) - 1;
+        c->port_table = allocate(h, (c->port_table_mask + 1) * sizeof(u32));
+        assert(c->port_table != INVALID_ADDRESS);
+        zero(c->port_table, (c->port_table_mask + 1) * sizeof(u32));
+    }
+
+    /* first pass: every field value that some rule tests gets its own set */
+    u64 protos = 0;
+    u64 ports = 0;
+    list_foreach(&firewall.rules, elem)
+    {
+        firewall_rule rule = struct_from_list(elem, firewall_rule, l);
+        firewall_constraint fc;
+        if(rule->l3_match)
         {
-            if(rule->drop)
-                goto drop_pkt;
-            break;
+            vector_foreach(rule->l3_match, fc)
+            {
+                if(fc->type == FW_L3_PROTO)
+                {
+                    u8 proto = struct_from_field(fc, firewall_constraint_val, c)->val;
+                    if(!c->proto_index[proto])
+                        c->proto_index[proto] = ++protos;
+                }
+            }
         }
+        if(rule->l4_match)
+        {
+            vector_foreach(rule->l4_match, fc)
+            {
+                if(fc->type == FW_L4_DEST)
+                    firewall_port_insert(c, struct_from_field(fc, firewall_constraint_val, c)->val, &ports);
+            }
+        }
+    }
+
+    /* second pass: put each rule in the sets of the values it matches */
+    u64 r = 0;
+    list_foreach(&firewall.rules, elem)
+    {
+        firewall_rule rule = struct_from_list(elem, firewall_rule, l);
+        c->drop[r] = rule->drop;
+        if(rule->ip_version != 6)
+            firewall_bit_set(c->version[FW_VERSION_4], r);
+        if(rule->ip_version != 4)
+            firewall_bit_set(c->version[FW_VERSION_6], r);
+        if(!rule->ip_version)
+            firewall_bit_set(c->version[FW_VERSION_OTHER], r);
+        if(!rule->l3_match)
+            firewall_bit_set(c->no_l3, r);
+
+        boolean has_frag = false, has_proto = false, has_src = false, has_dest = false;
+        firewall_constraint fc;
+        if(rule->l3_match)
+        {
+            vector_foreach(rule->l3_match, fc)
+            {
+                switch(fc->type)
+                {
+                case FW_L3_SRC:
+                {
+                    firewall_constraint_buf c_buf = struct_from_field(fc, firewall_constraint_buf, c);
+                    firewall_trie_insert(c, c->src_trie[rule->ip_version == 6], c_buf->buf, c_buf->len, r);
+                    firewall_bit_set(fc->equals ? c->src_eq : c->src_neq, r);
+                    has_src = true;
+                    break;
+                }
+                case FW_L3_FRAG:
+                {
+                    u64 val = struct_from_field(fc, firewall_constraint_val, c)->val;
+                    firewall_bit_set(c->frag[(val != 0) == fc->equals], r);
+                    has_frag = true;
+                    break;
+                }
+                case FW_L3_PROTO:
+                {
+                    u8 proto = struct_from_field(fc, firewall_constraint_val, c)->val;
+                    firewall_bit_set(c->proto_sets + (c->proto_index[proto] - 1) * c->words, r);
+                    has_proto = true;
+                    break;
+                }
+                }
+            }
+        }
+        if(!has_frag)
+        {
+            firewall_bit_set(c->frag[0], r);
+            firewall_bit_set(c->frag[1], r);
+        }
+        if(!has_proto)
+            firewall_bit_set(c->proto_any, r);
+        if(!has_src)
+            firewall_bit_set(c->src_none, r);
+
+        if(rule->l4_match)
+        {
+            firewall_bit_set(rule->l4_proto == IP_PROTO_TCP ? c->l4_tcp : c->l4_udp, r);
+            vector_foreach(rule->l4_match, fc)
+            {
+                if(fc->type != FW_L4_DEST)
+                    continue;
+                u64* own = c->port_sets + firewall_port_find(c, struct_from_field(fc, firewall_constraint_val, c)->val) * c->words;
+                if(fc->equals)
+                {
+                    firewall_bit_set(own, r);
+                }
+                else
+                {
+                    /* set on every port but its own */
+                    firewall_bit_set(c->port_default, r);
+                    for(u64 p = 0; p < ports; p++)
+                    {
+                        u64* set = c->port_sets + p * c->words;
+                        if(set != own)
+                            firewall_bit_set(set, r);
+                    }
+                }
+                has_dest = true;
+            }
+        }
+        if(!has_dest)
+        {
+            firewall_bit_set(c->port_default, r);
+            for(u64 p = 0; p < ports; p++)
+                firewall_bit_set(c->port_sets + p * c->words, r);
+        }
+        r++;
+    }
+
+    for(u64 p = 0; p < protos; p++)
+        firewall_bits_or(c, c->proto_sets + p * c->words, c->proto_any);
+    firewall_trie_propagate(c, c->src_trie[0]);
+    firewall_trie_propagate(c, c->src_trie[1]);
+    return c;
+}
+
+/**
+ * @brief makes c the classifier that packets go through. a pointer store is
+ *        atomic, so a packet sees either the old rules or the new ones,
+ *        never a mix.
+ *
+ * @param h
+ * @param c
+ */
+static void firewall_classifier_publish(heap h, firewall_classifier c)
+{
+    write_barrier();
+    firewall_classifier old = (firewall_classifier)atomic_swap_64((u64*)&firewall.classifier, u64_from_pointer(c));
+    /* rules only change at init, before any packet has been filtered; a
+     * reconfiguration at run time would have to defer this */
+    if(old)
+        firewall_classifier_destroy(h, old);
+}
+
+/**
+ * @param p
+ * @param pkt
+ */
+static void firewall_parse(struct pbuf* p, firewall_pkt pkt)
+{
+    void* buf = p->payload;
+    unsigned int len = p->len;
+    pkt->version = IP_HDR_GET_VERSION(buf);
+    pkt->l4_hdr = 0;
+    pkt->proto_ok = false;
+    if(pkt->version == 4)
+    {
+        struct ip_hdr* hdr = buf;
+        int hdr_len = IPH_HL_BYTES(hdr);
+        pkt->version_class = FW_VERSION_4;
+        pkt->l3_ok = len >= hdr_len;
+        if(!pkt->l3_ok)
+            return;
+        pkt->frag = (IPH_OFFSET(hdr) & lwip_htons(IP_OFFMASK)) != 0;
+        pkt->proto = IPH_PROTO(hdr);
+        pkt->proto_ok = true;
+        pkt->src = &hdr->src;
+        pkt->dst = &hdr->dest;
+        if(!pkt->frag)
+            pkt->l4_hdr = buf + hdr_len;
+    }
+    else
+    {
+        /* like the rule walk, anything that is not IPv4 is parsed as IPv6 */
+        struct ip6_hdr* hdr = buf;
+        pkt->version_class = (pkt->version == 6) ? FW_VERSION_6 : FW_VERSION_OTHER;
+        pkt->l3_ok = len >= IP6_HLEN;
+        if(!pkt->l3_ok)
+            return;
+        pkt->frag = firewall_ip6_is_fragment(hdr, len);
+        pkt->proto = firewall_ip6_get_hdr(buf, len, IP6_NEXTH_NONE, &pkt->l4_hdr);
+        pkt->proto_ok = pkt->l4_hdr != 0;
+        pkt->src = &hdr->src;
+        pkt->dst = &hdr->dest;
+        if(pkt->frag)
+            pkt->l4_hdr = 0;
+    }
+    if(pkt->l4_hdr)
+        pkt->l4_len = len - (pkt->l4_hdr - buf);
+}
+
+/**
+ * @brief whether the verdict for pkt depends on nothing but its addresses,
+ *        protocol and ports, so that it can be cached for the flow
+ *
+ * @param pkt
+ * @return boolean
+ */
+static boolean firewall_pkt_is_flow(firewall_pkt pkt)
+{
+    if(!pkt->l4_hdr)
+        return false;
+    switch(pkt->proto)
+    {
+    case IP_PROTO_TCP:
+        return pkt->l4_len >= sizeof(struct tcp_hdr);
+    case IP_PROTO_UDP:
+        return pkt->l4_len >= sizeof(struct udp_hdr);
+    default:
+        return false;
+    }
+}
+
+/**
+ * @param pkt
+ * @return u64
+ */
+static u64 firewall_flow_hash(firewall_pkt pkt)
+{
+    int addr_len = (pkt->version == 4) ? 4 : 16;
+    /* the ports of TCP and UDP are the first four bytes of the header */
+    u64 h = pkt->proto ^ ((u64)*(u32*)pkt->l4_hdr << 8);
+    for(int i = 0; i < addr_len; i += 4)
+    {
+        h = (h ^ *(u32*)(pkt->src + i)) * 0x100000001b3ull;
+        h = (h ^ *(u32*)(pkt->dst + i)) * 0x100000001b3ull;
+    }
+    return h ^ (h >> 29);
+}
+
+/**
+ * @param f
+ * @param pkt
+ * @return boolean
+ */
+static boolean firewall_flow_matches(firewall_flow f, firewall_pkt pkt)
+{
+    int addr_len = (pkt->version == 4) ? 4 : 16;
+    struct udp_hdr* hdr = pkt->l4_hdr;
+    return (f->version == pkt->version) && (f->proto == pkt->proto) && (f->src_port == hdr->src) &&
+           (f->dest_port == hdr->dest) && !runtime_memcmp(f->src, pkt->src, addr_len) &&
+           !runtime_memcmp(f->dst, pkt->dst, addr_len);
+}
+
+/**
+ * @brief a per-entry seqlock: the entry is read without a lock and the read
+ *        is thrown away if a writer got in meanwhile
+ *
+ * @param f
+ * @param pkt
+ * @param drop
+ * @return boolean
+ */
+static boolean firewall_flow_lookup(firewall_flow f, firewall_pkt pkt, boolean* drop)
+{
+    u64 seq = *(volatile u64*)&f->seq;
+    if(!seq || (seq & 1))
+        return false;
+    read_barrier();
+    boolean hit = firewall_flow_matches(f, pkt);
+    *drop = f->drop;
+    read_barrier();
+    return hit && (*(volatile u64*)&f->seq == seq);
+}
+
+/**
+ * @brief a writer that loses the race for the entry just does not cache
+ *
+ * @param f
+ * @param pkt
+ * @param drop
+ */
+static void firewall_flow_store(firewall_flow f, firewall_pkt pkt, boolean drop)
+{
+    u64 seq = *(volatile u64*)&f->seq;
+    if((seq & 1) || !compare_and_swap_64(&f->seq, seq, seq + 1))
+        return;
+    int addr_len = (pkt->version == 4) ? 4 : 16;
+    struct udp_hdr* hdr = pkt->l4_hdr;
+    f->version = pkt->version;
+    f->proto = pkt->proto;
+    f->src_port = hdr->src;
+    f->dest_port = hdr->dest;
+    runtime_memcpy(f->src, pkt->src, addr_len);
+    runtime_memcpy(f->dst, pkt->dst, addr_len);
+    f->drop = drop;
+    write_barrier();
+    *(volatile u64*)&f->seq = seq + 2;
+}
+
+/**
+ * @param c
+ * @param pkt
+ * @return boolean
+ */
+static boolean firewall_classify(firewall_classifier c, firewall_pkt pkt)
+{
+    u64* version = c->version[pkt->version_class];
+    u64 addr_bits = (pkt->version == 4) ? 32 : 128;
+    u64* src = 0;
+    u64* proto = 0;
+    u64* port = 0;
+    if(pkt->l3_ok)
+    {
+        src = firewall_trie_lookup(c->src_trie[pkt->version != 4], pkt->src, addr_bits);
+        u8 index = pkt->proto_ok ? c->proto_index[pkt->proto] : 0;
+        proto = index ? (c->proto_sets + (index - 1) * c->words) : c->proto_any;
+    }
+    boolean tcp_ok = pkt->l4_hdr && (pkt->l4_len >= sizeof(struct tcp_hdr));
+    boolean udp_ok = pkt->l4_hdr && (pkt->l4_len >= sizeof(struct udp_hdr));
+    /* both headers have the destination port at the same offset */
+    if(udp_ok)
+        port = firewall_port_lookup(c, ((struct udp_hdr*)pkt->l4_hdr)->dest);
+
+    for(u64 i = 0; i < c->words; i++)
+    {
+        u64 m = version[i];
+        if(!pkt->l3_ok)
+        {
+            m &= c->no_l3[i];
+        }
+        else
+        {
+            m &= c->frag[pkt->frag][i] & proto[i];
+            m &= c->src_none[i] | (c->src_eq[i] & src[i]) | (c->src_neq[i] & ~src[i]);
+            if(!tcp_ok)
+                m &= ~c->l4_tcp[i];
+            if(!udp_ok)
+                m &= ~c->l4_udp[i];
+            if(port)
+                m &= port[i];
+        }
+        if(m)
+            return c->drop[i * 64 + lsb(m)];
     }
+    return false;
+}
+
+/**
+ * @param pbuf
+ * @return boolean, whether the first rule that matches drops the packet
+ */
+static boolean firewall_walk_drops(struct pbuf* pbuf)
+{
+    list_foreach(&firewall.rules, elem)
+    {
+        firewall_rule rule = struct_from_list(elem, firewall_rule, l);
+        if(firewall_match(pbuf, rule))
+            return rule->drop;
+    }
+    return false;
+}
+
+/**
+ * @param c
+ * @param pbuf
+ * @return boolean, whether the classifier drops the packet
+ */
+static boolean firewall_classifier_drops(firewall_classifier c, struct pbuf* pbuf)
+{
+    struct firewall_pkt pkt;
+    boolean drop;
+    firewall_parse(pbuf, &pkt);
+    if(!firewall_pkt_is_flow(&pkt))
+        return firewall_classify(c, &pkt);
+    firewall_flow f = &c->flows[firewall_flow_hash(&pkt) & (FW_FLOW_CACHE_SIZE - 1)];
+    if(!firewall_flow_lookup(f, &pkt, &drop))
+    {
+        drop = firewall_classify(c, &pkt);
+        firewall_flow_store(f, &pkt, drop);
+    }
+    return drop;
+}
+
+/**
+ * @brief a few rules are walked in order, as the classifier costs about the
+ *        same whatever the rule count and below FW_CLASSIFIER_MIN_RULES the
+ *        walk is faster on new flows (see test/firewall)
+ *
+ * @param pbuf
+ * @param input_netif
+ * @return int
+ */
+static int firewall_filter(struct pbuf* pbuf, struct netif* input_netif)
+{
+    firewall_classifier c = *(firewall_classifier volatile*)&firewall.classifier;
+    boolean drop = (c->rule_count < FW_CLASSIFIER_MIN_RULES) ? firewall_walk_drops(pbuf)
+                                                             : firewall_classifier_drops(c, pbuf);
+    if(drop)
+        goto drop_pkt;
     return 1;
 drop_pkt:
     pbuf_free(pbuf);
@@ -790,7 +1522,10 @@ int init(status_handler complete)
             goto err_dealloc_rules;
     }
     if(!list_empty(&firewall.rules))
+    {
+        firewall_classifier_publish(h, firewall_classifier_build(h));
         net_ip_input_filter = firewall_filter;
+    }
     return KLIB_INIT_OK;
 err_dealloc_rules:
     list_foreach(&firewall.rules, elem)
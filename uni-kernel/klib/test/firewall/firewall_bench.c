@@ -0,0 +1,344 @@
+/**
+ * @file firewall_bench.c
+ * @author Krisna Pranav
+ * @brief host harness for klib/firewall.c: checks the verdicts of its rule
+ *        walk, its classifier and firewall_filter() against the old rule
+ *        walk (rulewalk.c) on synthetic rule sets and packets, reports how
+ *        many verdicts the negated-prefix fix changed, and measures packets
+ *        per second for the rule walk and the classifier, each with every
+ *        packet a new flow and with 256 flows sent over and over, so that
+ *        the classifier finds them cached:
+ *
+ *        cc -O2 -Wno-unused-function -Ishim -o firewall_bench firewall_bench.c
+ *        ./firewall_bench [seeds]
+ *
+ *        exits non-zero if any of them differs from the fixed rule walk, or
+ *        if a packet's verdict changes once its flow is cached.
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include "../../firewall.c"
+#include "rulewalk.c"
+
+#include <time.h>
+
+#define BENCH_PACKETS 4096
+#define BENCH_PACKET_SIZE 128
+#define BENCH_SOURCES 64
+#define BENCH_CACHED_FLOWS 256
+
+static const int bench_rule_counts[] = {1, 2, 4, 6, 8, 10, 16, 100, 500, 1000};
+
+enum bench_path
+{
+    BENCH_RULEWALK,
+    BENCH_WALK,
+    BENCH_CLASSIFIER,
+    BENCH_FILTER,
+}; // enum bench_path
+
+static u64 bench_random_state;
+static u8 bench_sources[BENCH_SOURCES][16];
+static u8 bench_packets[BENCH_PACKETS][BENCH_PACKET_SIZE];
+static u16 bench_lengths[BENCH_PACKETS];
+static struct heap_s bench_heap;
+
+/**
+ * @return u64
+ */
+static u64 bench_random(void)
+{
+    bench_random_state ^= bench_random_state << 13;
+    bench_random_state ^= bench_random_state >> 7;
+    bench_random_state ^= bench_random_state << 17;
+    return bench_random_state;
+}
+
+/**
+ * @return double
+ */
+static double bench_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * @param type
+ * @param val
+ * @param equals
+ * @return firewall_constraint_val
+ */
+static firewall_constraint_val bench_constraint_val(int type, u64 val, boolean equals)
+{
+    firewall_constraint_val c = allocate(&bench_heap, sizeof(*c));
+    c->c.type = type;
+    c->c.equals = equals;
+    c->val = val;
+    return c;
+}
+
+/**
+ * @param rule
+ * @param addr
+ * @param len prefix length in bits
+ * @param equals
+ */
+static void bench_add_source(firewall_rule rule, const u8* addr, u64 len, boolean equals)
+{
+    firewall_constraint_buf c = allocate(&bench_heap, sizeof(*c) + pad(len, 8) / 8);
+    c->c.type = FW_L3_SRC;
+    c->c.equals = equals;
+    c->len = len;
+    runtime_memcpy(c->buf, addr, pad(len, 8) / 8);
+    vector_push(rule->l3_match, c);
+}
+
+/**
+ * @brief appends a rule shaped like the ones firewall_create_rule() builds:
+ *        an optional ip/ip6 part with a source prefix, often a whole number
+ *        of bytes and sometimes negated, and a fragment test; an optional
+ *        tcp/udp part with a destination port
+ */
+static void bench_add_rule(void)
+{
+    firewall_rule r = allocate(&bench_heap, sizeof(*r));
+    zero(r, sizeof(*r));
+    list_push_back(&firewall.rules, &r->l);
+
+    u64 version = bench_random() % 50;
+    if(version < 35)
+        r->ip_version = 4;
+    else if(version < 49)
+        r->ip_version = 6;
+
+    if(r->ip_version)
+    {
+        r->l3_match = allocate_vector(&bench_heap, 2);
+        if(bench_random() % 20)
+        {
+            u8 addr[16];
+            runtime_memcpy(addr, bench_sources[bench_random() % BENCH_SOURCES], sizeof(addr));
+            u64 max = r->ip_version == 4 ? 32 : 128;
+            u64 len = max - bench_random() % (max / 3);
+            if(bench_random() % 3 == 0)
+                len = max - (bench_random() % 3) * 8;
+            addr[(len - 1) / 8] ^= bench_random() % 2;
+            bench_add_source(r, addr, len, bench_random() % 10 != 0);
+        }
+        if(bench_random() % 8 == 0)
+            vector_push(r->l3_match, bench_constraint_val(FW_L3_FRAG, bench_random() % 2, true));
+    }
+
+    u64 l4 = r->ip_version ? bench_random() % 4 : bench_random() % 3;
+    if(l4 < 3)
+    {
+        static const u16 ports[] = {22, 53, 80, 443, 8080, 5000, 123, 25};
+        u8 proto = l4 == 0 ? IP_PROTO_UDP : IP_PROTO_TCP;
+        r->l4_proto = proto;
+        if(bench_random() % 5)
+        {
+            u16 port = ports[bench_random() % 8] + (bench_random() % 4 ? 0 : bench_random() % 2000);
+            r->l4_match = allocate_vector(&bench_heap, 2);
+            vector_push(r->l4_match, bench_constraint_val(FW_L4_DEST, lwip_htons(port), bench_random() % 6 != 0));
+        }
+        if(!r->l3_match)
+            r->l3_match = allocate_vector(&bench_heap, 2);
+        vector_push(r->l3_match, bench_constraint_val(FW_L3_PROTO, proto, true));
+    }
+
+    if(r->l3_match && !vector_length(r->l3_match))
+    {
+        deallocate_vector(r->l3_match);
+        r->l3_match = 0;
+    }
+    r->drop = bench_random() % 3 != 0;
+}
+
+/**
+ * @brief a v4 or v6 tcp/udp/icmp packet from one of the known sources, now
+ *        and then a fragment, truncated, or shorter than its ip header
+ *
+ * @param i
+ */
+static void bench_make_packet(int i)
+{
+    static const u16 ports[] = {22, 53, 80, 443, 8080, 5000, 123, 25, 9999};
+    static const u8 protos[] = {IP_PROTO_TCP, IP_PROTO_TCP, IP_PROTO_TCP, IP_PROTO_UDP, IP_PROTO_UDP, 1};
+    u8* p = bench_packets[i];
+    zero(p, BENCH_PACKET_SIZE);
+    u8 proto = protos[bench_random() % 6];
+    int hdr_len;
+
+    if(bench_random() % 4)
+    {
+        struct ip_hdr* h = (void*)p;
+        h->_v_hl = 0x45;
+        h->_proto = proto;
+        runtime_memcpy(&h->src, bench_sources[bench_random() % BENCH_SOURCES], 4);
+        if(bench_random() % 3)
+            ((u8*)&h->src)[3] = bench_random();
+        h->dest = bench_random();
+        if(bench_random() % 20 == 0)
+            h->_offset = lwip_htons(bench_random() % 100);
+        hdr_len = 20;
+    }
+    else
+    {
+        struct ip6_hdr* h = (void*)p;
+        p[0] = 0x60;
+        runtime_memcpy(h->src, bench_sources[bench_random() % BENCH_SOURCES], 16);
+        if(bench_random() % 3)
+            ((u8*)h->src)[15] = bench_random();
+        h->_nexth = proto;
+        hdr_len = IP6_HLEN;
+        if(bench_random() % 10 == 0)
+        {
+            struct ip6_frag_hdr* f = (void*)(p + IP6_HLEN);
+            h->_nexth = IP6_NEXTH_FRAGMENT;
+            f->_nexth = proto;
+            f->_fragment_offset = lwip_htons((bench_random() % 4) << 3);
+            hdr_len += 8;
+        }
+    }
+
+    u16* l4 = (u16*)(p + hdr_len);
+    l4[0] = lwip_htons(1024 + bench_random() % 64);
+    l4[1] = lwip_htons(ports[bench_random() % 9] + (bench_random() % 8 ? 0 : bench_random() % 2000));
+    bench_lengths[i] = hdr_len + 20;
+    if(bench_random() % 30 == 0)
+        bench_lengths[i] = hdr_len + bench_random() % 20;
+    if(bench_random() % 50 == 0)
+        bench_lengths[i] = bench_random() % hdr_len;
+}
+
+/**
+ * @param path
+ * @param i
+ * @return boolean, whether packet i is dropped
+ */
+static boolean bench_drops(int path, int i)
+{
+    struct pbuf pb = {bench_packets[i], bench_lengths[i]};
+    switch(path)
+    {
+    case BENCH_RULEWALK:
+        return rulewalk_drops(&pb);
+    case BENCH_WALK:
+        return firewall_walk_drops(&pb);
+    case BENCH_CLASSIFIER:
+        return firewall_classifier_drops(firewall.classifier, &pb);
+    default:
+    {
+        u64 before = pbufs_freed;
+        firewall_filter(&pb, 0);
+        return pbufs_freed != before;
+    }
+    }
+}
+
+/**
+ * @param path
+ * @param rounds
+ * @param flows packets 0..flows-1 are sent over and over
+ * @return double, million packets per second
+ */
+static double bench_mpps(int path, int rounds, int flows)
+{
+    u64 sent = 0;
+    double start = bench_seconds();
+    for(int round = 0; round < rounds; round++)
+    {
+        for(int i = 0; i < BENCH_PACKETS; i++)
+        {
+            bench_drops(path, i % flows);
+            sent++;
+        }
+    }
+    return sent / (bench_seconds() - start) / 1e6;
+}
+
+/**
+ * @param rules
+ * @param seed
+ */
+static void bench_setup(int rules, int seed)
+{
+    list_foreach(&firewall.rules, elem)
+    {
+        firewall_destroy_rule(&bench_heap, struct_from_list(elem, firewall_rule, l));
+    }
+    list_init(&firewall.rules);
+
+    bench_random_state = 88172645463325252ull + seed;
+    for(int i = 0; i < BENCH_SOURCES; i++)
+    {
+        for(int j = 0; j < 16; j++)
+            bench_sources[i][j] = bench_random();
+    }
+    for(int i = 0; i < rules; i++)
+        bench_add_rule();
+    firewall_classifier_publish(&bench_heap, firewall_classifier_build(&bench_heap));
+    for(int i = 0; i < BENCH_PACKETS; i++)
+        bench_make_packet(i);
+}
+
+int main(int argc, char** argv)
+{
+    int seeds = argc > 1 ? atoi(argv[1]) : 6;
+    boolean ok = true;
+
+    list_init(&firewall.rules);
+    printf("                                        walk Mpps          classifier Mpps    firewall_filter Mpps\n");
+    printf("rules  mismatches  changed by the fix   all-miss  cached   all-miss  cached   all-miss  cached\n");
+    for(int r = 0; r < sizeof(bench_rule_counts) / sizeof(bench_rule_counts[0]); r++)
+    {
+        int rules = bench_rule_counts[r];
+        u64 mismatches = 0;
+        u64 changed = 0;
+
+        for(int seed = 1; seed <= seeds; seed++)
+        {
+            bench_setup(rules, seed);
+            for(int i = 0; i < BENCH_PACKETS; i++)
+            {
+                rulewalk_byte_prefix_negation_bug = false;
+                boolean fixed = bench_drops(BENCH_RULEWALK, i);
+                rulewalk_byte_prefix_negation_bug = true;
+                boolean old = bench_drops(BENCH_RULEWALK, i);
+                rulewalk_byte_prefix_negation_bug = false;
+
+                boolean walk = bench_drops(BENCH_WALK, i);
+                boolean first = bench_drops(BENCH_CLASSIFIER, i);
+                /* the packet's flow is cached now, if it has one */
+                boolean second = bench_drops(BENCH_CLASSIFIER, i);
+                boolean filter = bench_drops(BENCH_FILTER, i);
+
+                mismatches += walk != fixed || first != fixed || second != fixed || filter != fixed;
+                changed += old != fixed;
+            }
+        }
+
+        bench_setup(rules, 1);
+        int rounds = rules > 200 ? 100 : 400;
+        int walk_rounds = rules > 200 ? 10 : rounds;
+        printf("%5d %11llu %19llu %10.2f %7.2f %10.2f %7.2f %10.2f %7.2f\n",
+               rules,
+               (unsigned long long)mismatches,
+               (unsigned long long)changed,
+               bench_mpps(BENCH_WALK, walk_rounds, BENCH_PACKETS),
+               bench_mpps(BENCH_WALK, walk_rounds, BENCH_CACHED_FLOWS),
+               bench_mpps(BENCH_CLASSIFIER, rounds, BENCH_PACKETS),
+               bench_mpps(BENCH_CLASSIFIER, rounds, BENCH_CACHED_FLOWS),
+               bench_mpps(BENCH_FILTER, rules < FW_CLASSIFIER_MIN_RULES ? walk_rounds : rounds, BENCH_PACKETS),
+               bench_mpps(BENCH_FILTER, rules < FW_CLASSIFIER_MIN_RULES ? walk_rounds : rounds, BENCH_CACHED_FLOWS));
+        ok = ok && !mismatches;
+    }
+    printf("%d seeds x %d packets per rule count\n", seeds, BENCH_PACKETS);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+/**
+ * @file rulewalk.c
+ * @author Krisna Pranav
+ * @brief the firewall as it was before the classifier: every rule is tested
+ *        against every packet, in order. included by firewall_bench.c after
+ *        firewall.c, whose types and ipv6 header walk it shares.
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+/*
+ * the old walk matched a negated source prefix of whole bytes ("!10.0.0.0/8")
+ * against every address; set this to get that behaviour back
+ */
+static boolean rulewalk_byte_prefix_negation_bug;
+
+/**
+ * @param val
+ * @param c
+ * @return boolean
+ */
+static boolean rulewalk_match_val(u64 val, firewall_constraint c)
+{
+    firewall_constraint_val c_val = struct_from_field(c, firewall_constraint_val, c);
+    return ((val == c_val->val) == c->equals);
+}
+
+/**
+ * @param buf
+ * @param c
+ * @return boolean
+ */
+static boolean rulewalk_match_buf(void* buf, firewall_constraint c)
+{
+    firewall_constraint_buf c_buf = struct_from_field(c, firewall_constraint_buf, c);
+    u64 byte_count = c_buf->len / 8;
+
+    if(byte_count)
+    {
+        boolean match = !runtime_memcmp(buf, c_buf->buf, byte_count);
+        if(!match)
+            return c->equals ? false : true;
+    }
+
+    u64 bit_count = c_buf->len & 7;
+
+    if(!bit_count)
+        return rulewalk_byte_prefix_negation_bug ? true : c->equals;
+
+    u8 bit_mask = ~MASK(8 - bit_count);
+    u8 b = ((u8*)buf)[byte_count] & bit_mask;
+    return ((b == (c_buf->buf[byte_count] & bit_mask)) == c->equals);
+}
+
+/**
+ * @param constraints
+ * @param buf
+ * @param len
+ * @param l4_hdr
+ * @return boolean
+ */
+static boolean rulewalk_ip4_match(vector constraints, void* buf, unsigned int len, void** l4_hdr)
+{
+    struct ip_hdr* hdr = buf;
+    int hdr_len = IPH_HL_BYTES(hdr);
+
+    if(len < hdr_len)
+        return false;
+
+    firewall_constraint c;
+
+    vector_foreach(constraints, c)
+    {
+        switch(c->type)
+        {
+        case FW_L3_SRC:
+            if(!rulewalk_match_buf(&hdr->src, c))
+                return false;
+            break;
+        case FW_L3_FRAG:
+            if(!rulewalk_match_val((IPH_OFFSET(hdr) & lwip_htons(IP_OFFMASK)) != 0, c))
+                return false;
+            break;
+        case FW_L3_PROTO:
+            if(!rulewalk_match_val(IPH_PROTO(hdr), c))
+                return false;
+            break;
+        }
+    }
+    *l4_hdr = ((IPH_OFFSET(hdr) & lwip_htons(IP_OFFMASK)) == 0) ? (buf + hdr_len) : 0;
+    return true;
+}
+
+/**
+ * @param constraints
+ * @param buf
+ * @param len
+ * @param l4_hdr
+ * @return boolean
+ */
+static boolean rulewalk_ip6_match(vector constraints, void* buf, unsigned int len, void** l4_hdr)
+{
+    if(len < IP6_HLEN)
+        return false;
+
+    struct ip6_hdr* hdr = buf;
+    boolean frag_parsed = false;
+    boolean is_fragment;
+    firewall_constraint c;
+
+    vector_foreach(constraints, c)
+    {
+        switch(c->type)
+        {
+        case FW_L3_SRC:
+            if(!rulewalk_match_buf(&hdr->src, c))
+                return false;
+            break;
+        case FW_L3_FRAG:
+            if(!frag_parsed)
+                is_fragment = firewall_ip6_is_fragment(hdr, len);
+            if(!rulewalk_match_val(is_fragment, c))
+                return false;
+            break;
+        case FW_L3_PROTO:
+        {
+            u8 proto = firewall_ip6_get_hdr(buf, len, IP6_NEXTH_NONE, l4_hdr);
+            if(!*l4_hdr || !rulewalk_match_val(proto, c))
+                return false;
+            if(!frag_parsed)
+                is_fragment = firewall_ip6_is_fragment(hdr, len);
+            if(is_fragment)
+                *l4_hdr = 0;
+            break;
+        }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief tcp and udp keep the destination port at the same offset, and the
+ *        old walk checked the header length of the protocol the rule named
+ *
+ * @param constraints
+ * @param buf
+ * @param len
+ * @param header_len
+ * @return boolean
+ */
+static boolean rulewalk_l4_match(vector constraints, void* buf, unsigned int len, unsigned int header_len)
+{
+    struct udp_hdr* hdr = buf;
+
+    if(len < header_len)
+        return false;
+
+    firewall_constraint c;
+
+    vector_foreach(constraints, c)
+    {
+        switch(c->type)
+        {
+        case FW_L4_DEST:
+            if(!rulewalk_match_val(hdr->dest, c))
+                return false;
+            break;
+        }
+    }
+    return true;
+}
+
+/**
+ * @param p
+ * @param rule
+ * @return boolean
+ */
+static boolean rulewalk_match(struct pbuf* p, firewall_rule rule)
+{
+    u8 ip_version = IP_HDR_GET_VERSION(p->payload);
+    if(rule->ip_version && (rule->ip_version != ip_version))
+        return false;
+    if(!rule->l3_match)
+        return true;
+    void* l4_hdr;
+    boolean (*l3_match_func)(vector, void*, unsigned int, void**);
+    l3_match_func = (ip_version == 4) ? rulewalk_ip4_match : rulewalk_ip6_match;
+    if(!l3_match_func(rule->l3_match, p->payload, p->len, &l4_hdr))
+        return false;
+    if(!rule->l4_match)
+        return true;
+    if(!l4_hdr)
+        return false;
+    unsigned int l4_len = p->len - (l4_hdr - p->payload);
+    switch(rule->l4_proto)
+    {
+    case IP_PROTO_TCP:
+        return rulewalk_l4_match(rule->l4_match, l4_hdr, l4_len, sizeof(struct tcp_hdr));
+    case IP_PROTO_UDP:
+        return rulewalk_l4_match(rule->l4_match, l4_hdr, l4_len, sizeof(struct udp_hdr));
+    default:
+        return false;
+    }
+}
+
+/**
+ * @param pbuf
+ * @return boolean, whether the rules drop the packet
+ */
+static boolean rulewalk_drops(struct pbuf* pbuf)
+{
+    list_foreach(&firewall.rules, elem)
+    {
+        firewall_rule rule = struct_from_list(elem, firewall_rule, l);
+        if(rulewalk_match(pbuf, rule))
+            return rule->drop;
+    }
+    return false;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file kernel.h
+ * @author Krisna Pranav
+ * @brief host stand-in for the parts of <kernel.h> that firewall.c uses,
+ *        for the firewall benchmark only
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int64_t s64;
+typedef bool boolean;
+
+typedef struct heap_s
+{
+    int unused;
+}* heap;
+
+typedef void* value;
+typedef value tuple;
+typedef value string;
+typedef value buffer;
+typedef void* status_handler;
+
+typedef struct
+{
+    char* ptr;
+    u64 len;
+} sstring;
+
+#define INVALID_ADDRESS ((void*)-1ull)
+
+static inline void* allocate(heap h, u64 size)
+{
+    (void)h;
+    return malloc(size ? size : 1);
+}
+
+static inline void deallocate(heap h, void* p, u64 size)
+{
+    (void)h;
+    (void)size;
+    free(p);
+}
+
+#define zero(p, n) memset(p, 0, n)
+#define runtime_memcpy memcpy
+#define runtime_memcmp memcmp
+#define MASK(x) ((1ull << (x)) - 1)
+#define U64_FROM_BIT(x) (1ull << (x))
+#define pad(a, b) ((((a) - 1) | ((b) - 1)) + 1)
+#define u64_from_pointer(p) ((u64)(uintptr_t)(p))
+
+static inline u64 msb(u64 x)
+{
+    return x ? 63 - __builtin_clzll(x) : -1ull;
+}
+
+static inline u64 lsb(u64 x)
+{
+    return ((s64)__builtin_ffsll(x)) - 1;
+}
+
+static inline void write_barrier(void)
+{
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void read_barrier(void)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+
+static inline u64 atomic_swap_64(u64* v, u64 n)
+{
+    return __atomic_exchange_n(v, n, __ATOMIC_SEQ_CST);
+}
+
+static inline u8 compare_and_swap_64(u64* p, u64 old, u64 new)
+{
+    return __sync_bool_compare_and_swap(p, old, new);
+}
+
+#define struct_from_field(p, t, f) ((t)((char*)(p) - __builtin_offsetof(typeof(*(t)0), f)))
+
+struct list
+{
+    struct list* prev;
+    struct list* next;
+};
+
+static inline void list_init(struct list* l)
+{
+    l->prev = l->next = l;
+}
+
+static inline void list_push_back(struct list* l, struct list* e)
+{
+    e->prev = l->prev;
+    e->next = l;
+    l->prev->next = e;
+    l->prev = e;
+}
+
+static inline boolean list_empty(struct list* l)
+{
+    return l->next == l;
+}
+
+#define list_foreach(l, e) for(struct list *e = (l)->next, *__n = e->next; e != (l); e = __n, __n = e->next)
+#define struct_from_list(e, t, f) struct_from_field(e, t, f)
+
+typedef struct vector_s
+{
+    u64 len;
+    u64 cap;
+    void** d;
+}* vector;
+
+static inline vector allocate_vector(heap h, u64 n)
+{
+    (void)h;
+    vector v = calloc(1, sizeof(*v));
+    v->cap = n + 8;
+    v->d = calloc(v->cap, sizeof(void*));
+    return v;
+}
+
+static inline void vector_push(vector v, void* x)
+{
+    assert(v->len < v->cap);
+    v->d[v->len++] = x;
+}
+
+static inline u64 vector_length(vector v)
+{
+    return v->len;
+}
+
+static inline void deallocate_vector(vector v)
+{
+    free(v->d);
+    free(v);
+}
+
+#define vector_foreach(v, e) for(u64 __i = 0; __i < (v)->len && ((e = (v)->d[__i]), 1); __i++)
+
+#define msg_err(...) \
+    do               \
+    {                \
+    } while(0)
+
+enum
+{
+    KLIB_INIT_OK,
+    KLIB_INIT_FAILED
+};
+
+/* the rule parser reads the config tuple; the benchmark builds rules directly */
+#define firewall_unreachable() abort()
+static inline boolean is_string(value v) { (void)v; firewall_unreachable(); }
+static inline boolean is_tuple(value v) { (void)v; firewall_unreachable(); }
+static inline boolean is_composite(value v) { (void)v; firewall_unreachable(); }
+static inline u64 buffer_length(value v) { (void)v; firewall_unreachable(); }
+static inline char peek_char(value v) { (void)v; firewall_unreachable(); }
+static inline void buffer_consume(value v, u64 n) { (void)v; (void)n; firewall_unreachable(); }
+static inline boolean parse_int(value v, int base, u64* r) { (void)v; (void)base; (void)r; firewall_unreachable(); }
+static inline int buffer_strcmp(value v, const char* s) { (void)v; (void)s; firewall_unreachable(); }
+static inline value get(value t, value k) { (void)t; (void)k; firewall_unreachable(); }
+static inline value get_string(value t, value k) { (void)t; (void)k; firewall_unreachable(); }
+static inline value sym_(const char* s) { (void)s; return 0; }
+#define sym(x) sym_(#x)
+static inline sstring buffer_to_sstring(value v) { (void)v; firewall_unreachable(); }
+static inline char* runtime_strchr(sstring s, char c) { (void)s; (void)c; firewall_unreachable(); }
+static inline void* buffer_ref(value v, u64 offset) { (void)v; (void)offset; firewall_unreachable(); }
+static inline value alloca_wrap_sstring(sstring s) { (void)s; firewall_unreachable(); }
+static inline value integer_key(int i) { (void)i; firewall_unreachable(); }
+static inline tuple get_root_tuple(void) { firewall_unreachable(); }
+static inline heap heap_locked(void* kh) { (void)kh; return 0; }
+static inline void* get_kernel_heaps(void) { return 0; }
@@ -0,0 +1,141 @@
+/**
+ * @file lwip.h
+ * @author Krisna Pranav
+ * @brief host stand-in for the lwIP headers firewall.c uses, for the
+ *        firewall benchmark only
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include <arpa/inet.h>
+
+typedef struct
+{
+    union
+    {
+        struct
+        {
+            u32 addr;
+        } ip4;
+        struct
+        {
+            u32 addr[4];
+        } ip6;
+    } u_addr;
+} ip_addr_t;
+
+static inline int ip4addr_aton(sstring s, void* a) { (void)s; (void)a; firewall_unreachable(); }
+static inline int ip6addr_aton(sstring s, void* a) { (void)s; (void)a; firewall_unreachable(); }
+
+struct pbuf
+{
+    void* payload;
+    u16 len;
+};
+
+struct netif;
+
+/* firewall_filter() frees the packets it drops; the benchmark counts them */
+static u64 pbufs_freed;
+
+static inline void pbuf_free(struct pbuf* p)
+{
+    (void)p;
+    pbufs_freed++;
+}
+
+static int (*net_ip_input_filter)(struct pbuf*, struct netif*);
+
+#define lwip_htons htons
+#define lwip_htonl htonl
+#define PP_HTONS htons
+
+struct ip_hdr
+{
+    u8 _v_hl;
+    u8 _tos;
+    u16 _len;
+    u16 _id;
+    u16 _offset;
+    u8 _ttl;
+    u8 _proto;
+    u16 _chksum;
+    u32 src;
+    u32 dest;
+};
+
+#define IP_HDR_GET_VERSION(p) ((*(u8*)(p)) >> 4)
+#define IPH_HL_BYTES(h) (((h)->_v_hl & 0xf) * 4)
+#define IPH_OFFSET(h) ((h)->_offset)
+#define IPH_PROTO(h) ((h)->_proto)
+#define IP_OFFMASK 0x1fff
+#define IP_PROTO_TCP 6
+#define IP_PROTO_UDP 17
+
+#define IP6_HLEN 40
+
+struct ip6_hdr
+{
+    u32 _v_tc_fl;
+    u16 _plen;
+    u8 _nexth;
+    u8 _hoplim;
+    u32 src[4];
+    u32 dest[4];
+};
+
+#define IP6H_NEXTH(h) ((h)->_nexth)
+#define IP6_NEXTH_HOPBYHOP 0
+#define IP6_NEXTH_TCP 6
+#define IP6_NEXTH_UDP 17
+#define IP6_NEXTH_ROUTING 43
+#define IP6_NEXTH_FRAGMENT 44
+#define IP6_NEXTH_NONE 59
+#define IP6_NEXTH_DESTOPTS 60
+
+struct ip6_hbh_hdr
+{
+    u8 _nexth;
+    u8 _hlen;
+};
+
+struct ip6_dest_hdr
+{
+    u8 _nexth;
+    u8 _hlen;
+};
+
+struct ip6_rout_hdr
+{
+    u8 _nexth;
+    u8 _hlen;
+    u8 _routing_type;
+    u8 _segments_left;
+};
+
+struct ip6_frag_hdr
+{
+    u8 _nexth;
+    u8 reserved;
+    u16 _fragment_offset;
+    u32 _identification;
+};
+
+#define IP6_HBH_NEXTH(h) ((h)->_nexth)
+#define IP6_DEST_NEXTH(h) ((h)->_nexth)
+#define IP6_ROUT_NEXTH(h) ((h)->_nexth)
+#define IP6_FRAG_NEXTH(h) ((h)->_nexth)
+#define IP6_FRAG_OFFSET_MASK 0xfff8
+
+struct udp_hdr
+{
+    u16 src;
+    u16 dest;
+    u16 len;
+    u16 chksum;
+};
@@ -0,0 +1,24 @@
+/**
+ * @file tcp.h
+ * @author Krisna Pranav
+ * @brief host stand-in for <lwip/prot/tcp.h>, for the firewall benchmark only
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+struct tcp_hdr
+{
+    u16 src;
+    u16 dest;
+    u32 seqno;
+    u32 ackno;
+    u16 _hdrlen_rsvd_flags;
+    u16 wnd;
+    u16 chksum;
+    u16 urgp;
+};
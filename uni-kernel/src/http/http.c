@@ -16,22 +16,75 @@
 #define HTTP_MAJ(v) ((v) >> 16)
 #define HTTP_MIN(v) ((v) & MASK(16))
 
-#define STATE_INIT 0
-#define STATE_START_LINE 1
-#define STATE_HEADER 2
-#define STATE_VALUE 3
-#define STATE_BODY 4
+#define HTTP_MAX_WORDS 8
+#define HTTP_MAX_HEADERS 32
+#define HTTP_MAX_HEADER_BYTES 8192
+#define HTTP_MAX_CONTENT_LENGTH (1ull << 20)
+
+#define HTTP_CONNECTION_DEFAULT 0
+#define HTTP_CONNECTION_CLOSE 1
+#define HTTP_CONNECTION_KEEPALIVE 2
+
+/* messages whose headers parse but whose body can't be taken */
+#define HTTP_REJECT_NONE 0
+#define HTTP_REJECT_TRANSFER_ENCODING 1
+#define HTTP_REJECT_TOO_LARGE 2
+
+const sstring http_request_methods[] = {
+    [HTTP_REQUEST_METHOD_GET] = ss_static_init("GET"),
+    [HTTP_REQUEST_METHOD_HEAD] = ss_static_init("HEAD"),
+    [HTTP_REQUEST_METHOD_POST] = ss_static_init("POST"),
+    [HTTP_REQUEST_METHOD_PUT] = ss_static_init("PUT"),
+    [HTTP_REQUEST_METHOD_DELETE] = ss_static_init("DELETE"),
+    [HTTP_REQUEST_METHOD_TRACE] = ss_static_init("TRACE"),
+    [HTTP_REQUEST_METHOD_OPTIONS] = ss_static_init("OPTIONS"),
+    [HTTP_REQUEST_METHOD_CONNECT] = ss_static_init("CONNECT"),
+    [HTTP_REQUEST_METHOD_PATCH] = ss_static_init("PATCH"),
+};
+
+static const char http_not_found_body[] = "<html><head><title>404 Not Found</title></head>"
+                                          "<body><h1>Not Found</h1></body></html>\r\n";
+static const char http_bad_ver_body[] = "<html><head><title>505 HTTP Version Not Supported</title></head>"
+                                        "<body><h1>Use HTTP/1.1</h1></body></html>\r\n";
+static const char http_not_implemented_body[] = "<html><head><title>501 Not Implemented</title></head>"
+                                                "<body><h1>Transfer-Encoding is not supported</h1></body></html>\r\n";
+static const char http_too_large_body[] = "<html><head><title>413 Content Too Large</title></head>"
+                                          "<body><h1>Content Too Large</h1></body></html>\r\n";
+
+typedef struct http_header_field
+{
+    const u8* name;
+    bytes name_len;
+    struct buffer value;
+}* http_header_field;
+
+/*
+ * a message parsed in place: every buffer here wraps bytes of the receive
+ * buffer (or of the parser's pending copy) and is only good until the
+ * message handler returns
+ */
+typedef struct http_message
+{
+    struct buffer start_line[HTTP_MAX_WORDS];
+    int words;
+    struct http_header_field headers[HTTP_MAX_HEADERS];
+    int header_count;
+    struct buffer content;
+    struct buffer relative_uri;
+    int connection;
+    int reject;
+}* http_message;
+
+closure_type(http_message_handler, boolean, http_message m);
 
 typedef struct http_parser
 {
     heap h;
-    vector start_line;
-    int state;
-    buffer word;
-    symbol s;
-    tuple header;
-    value_handler each;
-    u64 content_length;
+    http_message_handler each;
+    buffer pending;
+    bytes need;
+    boolean done;
+    struct http_message m;
 }* http_parser;
 
 struct http_responder
@@ -40,6 +93,22 @@ struct http_responder
     buffer_handler out;
     u32 http_version;
     boolean keepalive;
+    boolean chunk_open;
+};
+
+typedef struct http_route
+{
+    sstring label;
+    http_request_handler each;
+    struct http_route* child;
+    struct http_route* next;
+}* http_route;
+
+struct http_listener
+{
+    heap h;
+    http_request_handler default_handler;
+    struct http_route routes;
 };
 
 closure_function(3, 2, boolean, each_header,
@@ -101,20 +170,20 @@ status http_request(heap h, buffer_handler bh, http_method method, tuple headers
 }
 
 /**
+ * @brief writes the status line and headers into one buffer; the framing
+ *        and connection headers are printed straight into it instead of
+ *        going through the tuple
+ *
  * @param out
  * @param t
+ * @param content_length, -1 for a chunked body
  * @return status
  */
-static status send_http_headers(http_responder out, tuple t)
+static status send_http_headers(http_responder out, tuple t, s64 content_length)
 {
     status s;
 
-    if(out->keepalive && out->http_version <= HTTP_VER(1, 0))
-        set(t, sym(connection), aprintf(out->h, "keep-alive"));
-    else if(!out->keepalive && out->http_version >= HTTP_VER(1, 1))
-        set(t, sym(connection), aprintf(out->h, "close"));
-
-    buffer d = allocate_buffer(transient, 128);
+    buffer d = allocate_buffer(transient, 256);
     bprintf(d, "HTTP/%d.%d ", HTTP_MAJ(out->http_version), HTTP_MIN(out->http_version));
 
     symbol ss = sym(status);
@@ -125,6 +194,16 @@ static status send_http_headers(http_responder out, tuple t)
     else
         bprintf(d, "200 OK\r\n");
 
+    if(content_length >= 0)
+        bprintf(d, "Content-Length: %ld\r\n", content_length);
+    else
+        bprintf(d, "Transfer-Encoding: chunked\r\n");
+
+    if(out->keepalive && out->http_version <= HTTP_VER(1, 0))
+        bprintf(d, "Connection: keep-alive\r\n");
+    else if(!out->keepalive && out->http_version >= HTTP_VER(1, 1))
+        bprintf(d, "Connection: close\r\n");
+
     iterate(t, stack_closure(each_header, d, ss, true));
     deallocate_value(t);
     bprintf(d, "\r\n");
@@ -140,98 +219,740 @@ static status send_http_headers(http_responder out, tuple t)
     return STATUS_OK;
 }
 
-closure_function(2, 1, void, each_http_request,
-                 http_listener, hl, struct http_responder, hr,
-                 value v)
+/**
+ * @param out
+ * @return status
+ */
+static status http_response_done(http_responder out)
 {
-    http_method method;
-    http_listener hl = bound(hl);
-    http_responder hr = &bound(hr);
-    vector vsl = get_vector(v, sym(start_line));
-    if(!vsl || vsl == INVALID_ADDRESS)
-        goto not_found;
+    if(out->keepalive)
+        return STATUS_OK;
+    status s = apply(out->out, 0);
+    if(!is_ok(s))
+        return timm_up(s, "result", "%s failed to close", func_ss);
+    return STATUS_OK;
+}
 
-    buffer ver = vector_get(vsl, 2);
+/**
+ * @brief the CRLF closing the previous chunk goes out with the size line of
+ *        the next one, so a chunk is two writes and its data is not touched
+ *
+ * @param out
+ * @param c
+ * @return status
+ */
+status send_http_chunk(http_responder out, buffer c)
+{
+    bytes len = c ? buffer_length(c) : 0;
+    buffer d = allocate_buffer(transient, 16);
+    if(out->chunk_open)
+        bprintf(d, "\r\n");
+    bprintf(d, "%lx\r\n", len);
+    if(len == 0)
+        bprintf(d, "\r\n");
+    out->chunk_open = len != 0;
 
-    if(ver)
+    status s = apply(out->out, d);
+    if(!is_ok(s))
     {
-        get_http_ver(alloca_wrap(ver), &hr->http_version);
-        if(hr->http_version > HTTP_VER(1, 1))
-            goto bad_ver;
+        deallocate_buffer(d);
+        return timm_up(s, "result", "%s failed to send", func_ss);
+    }
 
-        check_keepalive(hr, v);
+    if(len == 0)
+    {
+        if(c)
+            deallocate_buffer(c);
+        return http_response_done(out);
     }
 
-    buffer mb = vector_get(vsl, 0);
+    s = apply(out->out, c);
+    if(!is_ok(s))
+        return timm_up(s, "result", "%s failed to send", func_ss);
+    return STATUS_OK;
+}
 
-    for(method = 0; method < HTTP_REQUEST_METHODS; method++)
+/**
+ * @param out
+ * @param t
+ * @return status
+ */
+status send_http_chunked_response(http_responder out, tuple t)
+{
+    out->chunk_open = false;
+    return send_http_headers(out, t, -1);
+}
+
+/**
+ * @param out
+ * @param t
+ * @param c
+ * @return status
+ */
+status send_http_response(http_responder out, tuple t, buffer c)
+{
+    status s = send_http_headers(out, t, c ? buffer_length(c) : 0);
+    if(!is_ok(s))
+        return s;
+
+    if(c)
     {
-        if(buffer_compare(mb, alloca_wrap_sstring(http_request_methods[method])))
+        s = apply(out->out, c);
+        if(!is_ok(s))
+            return timm_up(s, "result", "%s failed to send", func_ss);
+    }
+    return http_response_done(out);
+}
+
+/**
+ * @param out
+ * @param t
+ * @param body
+ * @return status
+ */
+status send_http_response_chain(http_responder out, tuple t, vector body)
+{
+    bytes content_length = 0;
+    buffer c;
+    vector_foreach(body, c)
+        content_length += buffer_length(c);
+
+    status s = send_http_headers(out, t, content_length);
+    if(!is_ok(s))
+        return s;
+
+    vector_foreach(body, c)
+    {
+        s = apply(out->out, c);
+        if(!is_ok(s))
+            return timm_up(s, "result", "%s failed to send", func_ss);
+    }
+    return http_response_done(out);
+}
+
+/**
+ * @param b
+ * @param p
+ * @param len
+ */
+static inline void http_wrap(buffer b, const u8* p, bytes len)
+{
+    init_buffer(b, len, true, 0, (void*)p);
+    buffer_produce(b, len);
+}
+
+/**
+ * @brief case-insensitive match against a lowercase token; only letters
+ *        are folded, so no other byte can stand in for '-' or a digit
+ *
+ * @param p
+ * @param len
+ * @param lower
+ * @return boolean
+ */
+static boolean http_token_is(const u8* p, bytes len, sstring lower)
+{
+    if(len != lower.len)
+        return false;
+    for(bytes i = 0; i < len; i++)
+    {
+        u8 c = p[i];
+        if(c >= 'A' && c <= 'Z')
+            c |= 0x20;
+        if(c != (u8)lower.ptr[i])
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief tchar from RFC 9110 §5.6.2, the bytes a field name may contain
+ *
+ * @param c
+ * @return boolean
+ */
+static inline boolean http_is_tchar(u8 c)
+{
+    if((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))
+        return true;
+    switch(c)
+    {
+    case '!': case '#': case '$': case '%': case '&': case '\'': case '*':
+    case '+': case '-': case '.': case '^': case '_': case '`': case '|': case '~':
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @param p
+ * @param end
+ * @return const u8*, the newline ending the line at p, or 0
+ */
+static inline const u8* http_line_end(const u8* p, const u8* end)
+{
+    while(p < end && *p != '\n')
+        p++;
+    return p < end ? p : 0;
+}
+
+/**
+ * @brief parses one message at the start of data without copying it. no
+ *        transfer coding is implemented, so a message that has one, or a
+ *        body over HTTP_MAX_CONTENT_LENGTH, comes back as just its headers
+ *        with m->reject set; nothing after it can be framed.
+ *
+ * @param p
+ * @param data
+ * @param len
+ * @return s64, the length of the message, 0 if it is not all here yet
+ *         (with p->need set once the headers are) or -1 if it is malformed
+ */
+static s64 http_parse_message(http_parser p, const u8* data, bytes len)
+{
+    http_message m = &p->m;
+    const u8* end = data + len;
+    const u8* line = data;
+    const u8* eol;
+    u64 content_length = 0;
+    boolean have_content_length = false;
+
+    m->words = 0;
+    m->header_count = 0;
+    m->connection = HTTP_CONNECTION_DEFAULT;
+    m->reject = HTTP_REJECT_NONE;
+
+    /* a client may send empty lines between pipelined requests */
+    while(line < end && (*line == '\r' || *line == '\n'))
+        line++;
+
+    if(!(eol = http_line_end(line, end)))
+        goto incomplete;
+
+    const u8* stop = eol > line && eol[-1] == '\r' ? eol - 1 : eol;
+    for(const u8* word = line;; word++)
+    {
+        const u8* w = word;
+        /* words past the last slot stay with it */
+        while(word < stop && (*word != ' ' || m->words == HTTP_MAX_WORDS - 1))
+            word++;
+        http_wrap(&m->start_line[m->words++], w, word - w);
+        if(word == stop)
             break;
     }
 
-    if(method == HTTP_REQUEST_METHODS)
-        goto not_found;
+    for(;;)
+    {
+        line = eol + 1;
+        if(!(eol = http_line_end(line, end)))
+            goto incomplete;
+        stop = eol > line && eol[-1] == '\r' ? eol - 1 : eol;
+        if(stop == line)
+            break;
 
-    buffer uri = vector_get(vsl, 1);
+        /* obsolete line folding would continue the previous value (RFC 9112 §5.2) */
+        if(*line == ' ' || *line == '\t')
+            return -1;
 
-    if(!uri || buffer_length(uri) < 1 || *(u8*)buffer_ref(uri, 0) != '/')
-        goto not_found;
+        /* the name is a token right up to the colon; "Content-Length :"
+           must not slip past as some other header (RFC 9112 §5.1) */
+        const u8* colon = line;
+        while(colon < stop && http_is_tchar(*colon))
+            colon++;
+        if(colon == stop || *colon != ':' || colon == line || m->header_count == HTTP_MAX_HEADERS)
+            return -1;
+
+        const u8* v = colon + 1;
+        while(v < stop && (*v == ' ' || *v == '\t'))
+            v++;
+        const u8* vend = stop;
+        while(vend > v && (vend[-1] == ' ' || vend[-1] == '\t'))
+            vend--;
+
+        http_header_field f = &m->headers[m->header_count++];
+        f->name = line;
+        f->name_len = colon - line;
+        http_wrap(&f->value, v, vend - v);
+
+        if(http_token_is(f->name, f->name_len, ss("content-length")))
+        {
+            if(v == vend)
+                return -1;
+            u64 n = 0;
+            for(; v < vend; v++)
+            {
+                if(*v < '0' || *v > '9')
+                    return -1;
+                /* stop counting once over the limit so n can't overflow */
+                if(n <= HTTP_MAX_CONTENT_LENGTH)
+                    n = n * 10 + (*v - '0');
+            }
+            /* two lengths that disagree leave the body ambiguous */
+            if(have_content_length && n != content_length)
+                return -1;
+            have_content_length = true;
+            content_length = n;
+        }
+        else if(http_token_is(f->name, f->name_len, ss("transfer-encoding")))
+        {
+            m->reject = HTTP_REJECT_TRANSFER_ENCODING;
+        }
+        else if(http_token_is(f->name, f->name_len, ss("connection")))
+        {
+            if(http_token_is(v, vend - v, ss("close")))
+                m->connection = HTTP_CONNECTION_CLOSE;
+            else if(http_token_is(v, vend - v, ss("keep-alive")))
+                m->connection = HTTP_CONNECTION_KEEPALIVE;
+        }
+    }
 
-    if(buffer_length(uri) == 1)
+    bytes header_len = eol + 1 - data;
+    if(m->reject == HTTP_REJECT_NONE && content_length > HTTP_MAX_CONTENT_LENGTH)
+        m->reject = HTTP_REJECT_TOO_LARGE;
+    if(m->reject != HTTP_REJECT_NONE)
     {
-        if(!hl->default_handler)
-            goto not_found;
-        apply(hl->default_handler, method, hr, v);
-        return;
+        http_wrap(&m->content, 0, 0);
+        return header_len;
+    }
+    if(content_length > len - header_len)
+    {
+        p->need = header_len + content_length;
+        return 0;
     }
+    http_wrap(&m->content, eol + 1, content_length);
+    return header_len + content_length;
+incomplete:
+    return len > HTTP_MAX_HEADER_BYTES ? -1 : 0;
+}
 
-    buffer rel_uri = clone_buffer(hl->h, uri);
-    assert(rel_uri != INVALID_ADDRESS);
-    buffer_consume(rel_uri, 1);
-    int total_len = buffer_length(rel_uri);
-    int top_len = 0;
-    char* top = buffer_ref(rel_uri, 0);
+/**
+ * @brief the tuple handed to value handlers; it holds the message's own
+ *        buffers, so it goes away with http_message_value_release()
+ *
+ * @param h
+ * @param m
+ * @return tuple
+ */
+static tuple http_message_value(heap h, http_message m)
+{
+    tuple t = allocate_tuple();
+    if(t == INVALID_ADDRESS)
+        return t;
+
+    vector vsl = allocate_vector(h, m->words);
+    if(vsl == INVALID_ADDRESS)
+    {
+        deallocate_value(t);
+        return INVALID_ADDRESS;
+    }
+    for(int i = 0; i < m->words; i++)
+        vector_push(vsl, &m->start_line[i]);
+    set(t, sym(start_line), vsl);
 
-    for(int i = 0; i < total_len; i++)
+    struct buffer name;
+    for(int i = 0; i < m->header_count; i++)
     {
-        if(top[i] == '/')
+        http_wrap(&name, m->headers[i].name, m->headers[i].name_len);
+        set(t, intern(&name), &m->headers[i].value);
+    }
+    set(t, sym(content), &m->content);
+    return t;
+}
+
+/**
+ * @param t
+ */
+static void http_message_value_release(tuple t)
+{
+    deallocate_vector(get_vector(t, sym(start_line)));
+    deallocate_value(t);
+}
+
+/**
+ * @brief drops the consumed front of the pending buffer when the rest fits
+ *        in the space it frees, so the copy never overlaps
+ *
+ * @param b
+ */
+static void http_pending_compact(buffer b)
+{
+    bytes len = buffer_length(b);
+    if(len == 0)
+    {
+        buffer_clear(b);
+    }
+    else if(b->start >= len)
+    {
+        runtime_memcpy(b->contents, buffer_ref(b, 0), len);
+        b->start = 0;
+        b->end = len;
+    }
+}
+
+closure_function(1, 1, status, http_recv,
+                 http_parser, p,
+                 buffer b)
+{
+    http_parser p = bound(p);
+
+    if(!b)
+    {
+        deallocate_closure(p->each);
+        deallocate_buffer(p->pending);
+        deallocate(p->h, p, sizeof(struct http_parser));
+        closure_finish();
+        return STATUS_OK;
+    }
+
+    /* the last message asked for the connection to close */
+    if(p->done)
+        return STATUS_OK;
+
+    /*
+     * parse straight out of the receive buffer; only a message split across
+     * receive buffers is copied, and only until it is complete
+     */
+    buffer in = b;
+    if(buffer_length(p->pending))
+    {
+        if(!buffer_write(p->pending, buffer_ref(b, 0), buffer_length(b)))
+            return timm("result", "%s: out of memory", func_ss);
+        in = p->pending;
+        if(buffer_length(in) < p->need)
+            return STATUS_OK;
+    }
+
+    bytes offset = 0;
+    while(offset < buffer_length(in))
+    {
+        s64 n = http_parse_message(p, buffer_ref(in, offset), buffer_length(in) - offset);
+        if(n < 0)
+            return timm("result", "%s: malformed message", func_ss);
+        if(n == 0)
+            break;
+        p->need = 0;
+        offset += n;
+        boolean more = apply(p->each, &p->m);
+        if(p->m.reject != HTTP_REJECT_NONE)
         {
-            buffer_consume(rel_uri, 1);
+            /*
+             * the body of a rejected message can't be told apart from the
+             * next message; a handler that answered it returns false,
+             * anyone else gets the parse error
+             */
+            p->done = true;
+            buffer_clear(p->pending);
+            if(!more)
+                return STATUS_OK;
+            return timm("result", "%s: %s", func_ss,
+                        p->m.reject == HTTP_REJECT_TRANSFER_ENCODING ? ss("unsupported transfer encoding")
+                                                                      : ss("content too large"));
+        }
+        if(!more)
+        {
+            p->done = true;
+            buffer_clear(p->pending);
+            return STATUS_OK;
+        }
+    }
+
+    if(in == b)
+    {
+        if(offset < buffer_length(b) &&
+           !buffer_write(p->pending, buffer_ref(b, offset), buffer_length(b) - offset))
+            return timm("result", "%s: out of memory", func_ss);
+    }
+    else
+    {
+        buffer_consume(in, offset);
+        http_pending_compact(in);
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @param h
+ * @param each
+ * @return buffer_handler
+ */
+static buffer_handler http_parser_allocate(heap h, http_message_handler each)
+{
+    http_parser p = allocate(h, sizeof(struct http_parser));
+    if(p == INVALID_ADDRESS)
+        return INVALID_ADDRESS;
+
+    p->h = h;
+    p->each = each;
+    p->need = 0;
+    p->done = false;
+    p->pending = allocate_buffer(h, 0);
+    if(p->pending == INVALID_ADDRESS)
+        goto fail;
+
+    buffer_handler bh = closure(h, http_recv, p);
+    if(bh != INVALID_ADDRESS)
+        return bh;
+    deallocate_buffer(p->pending);
+fail:
+    deallocate(h, p, sizeof(struct http_parser));
+    return INVALID_ADDRESS;
+}
+
+closure_function(2, 1, boolean, http_each_value,
+                 heap, h, value_handler, each,
+                 http_message m)
+{
+    if(m->reject != HTTP_REJECT_NONE)
+        return true;
+    tuple v = http_message_value(bound(h), m);
+    if(v == INVALID_ADDRESS)
+        return false;
+    apply(bound(each), v);
+    http_message_value_release(v);
+    return true;
+}
+
+/**
+ * @param h
+ * @param each
+ * @return buffer_handler
+ */
+buffer_handler allocate_http_parser(heap h, value_handler each)
+{
+    http_message_handler mh = closure(h, http_each_value, h, each);
+    if(mh == INVALID_ADDRESS)
+        return INVALID_ADDRESS;
+    buffer_handler bh = http_parser_allocate(h, mh);
+    if(bh == INVALID_ADDRESS)
+        deallocate_closure(mh);
+    return bh;
+}
+
+/**
+ * @param b
+ * @param ver
+ * @return boolean
+ */
+static boolean http_parse_version(buffer b, u32* ver)
+{
+    const u8* p = buffer_ref(b, 0);
+    if(buffer_length(b) != 8 || runtime_memcmp(p, "HTTP/", 5) || p[6] != '.')
+        return false;
+    if(p[5] < '0' || p[5] > '9' || p[7] < '0' || p[7] > '9')
+        return false;
+    *ver = HTTP_VER(p[5] - '0', p[7] - '0');
+    return true;
+}
+
+/**
+ * @param b
+ * @return http_method, HTTP_REQUEST_METHODS if unknown
+ */
+static http_method http_parse_method(buffer b)
+{
+    http_method method;
+    for(method = 0; method < HTTP_REQUEST_METHODS; method++)
+    {
+        sstring name = http_request_methods[method];
+        if(buffer_length(b) == name.len && !runtime_memcmp(buffer_ref(b, 0), name.ptr, name.len))
             break;
+    }
+    return method;
+}
+
+/**
+ * @brief adds uri to the tree below root, splitting the edge it leaves
+ *        halfway; edge labels point into the registered strings
+ *
+ * @param h
+ * @param root
+ * @param uri
+ * @return http_route, the node for uri
+ */
+static http_route http_route_insert(heap h, http_route root, sstring uri)
+{
+    http_route node = root;
+    while(uri.len)
+    {
+        http_route c;
+        for(c = node->child; c && c->label.ptr[0] != uri.ptr[0]; c = c->next)
+            ;
+
+        if(!c)
+        {
+            c = allocate(h, sizeof(struct http_route));
+            assert(c != INVALID_ADDRESS);
+            c->label = uri;
+            c->each = 0;
+            c->child = 0;
+            c->next = node->child;
+            node->child = c;
+            return c;
+        }
+
+        bytes n = 1;
+        while(n < c->label.len && n < uri.len && c->label.ptr[n] == uri.ptr[n])
+            n++;
+
+        if(n < c->label.len)
+        {
+            http_route rest = allocate(h, sizeof(struct http_route));
+            assert(rest != INVALID_ADDRESS);
+            rest->label = isstring(c->label.ptr + n, c->label.len - n);
+            rest->each = c->each;
+            rest->child = c->child;
+            rest->next = 0;
+            c->label.len = n;
+            c->each = 0;
+            c->child = rest;
         }
-        top_len++;
+
+        uri.ptr += n;
+        uri.len -= n;
+        node = c;
     }
+    return node;
+}
+
+/**
+ * @brief finds the longest registered prefix of path that ends at a '/'
+ *        or at the end of the path
+ *
+ * @param root
+ * @param path
+ * @param len
+ * @param matched
+ * @return http_route
+ */
+static http_route http_route_lookup(http_route root, const char* path, bytes len, bytes* matched)
+{
+    http_route node = root;
+    http_route best = 0;
+    bytes offset = 0;
 
-    http_listener_registrant match = 0;
-    list_foreach(&hl->registrants, l)
+    for(;;)
     {
-        http_listener_registrant r = struct_from_list(l, http_listener_registrant, l);
-        if((top_len == r->uri.len) && !runtime_memcmp(top, r->uri.ptr, top_len))
+        if(node->each && (offset == len || path[offset] == '/'))
         {
-            match = r;
+            best = node;
+            *matched = offset;
+        }
+        if(offset == len)
+            break;
+
+        http_route c;
+        for(c = node->child; c && c->label.ptr[0] != path[offset]; c = c->next)
+            ;
+        if(!c || c->label.len > len - offset || runtime_memcmp(c->label.ptr, path + offset, c->label.len))
             break;
+        offset += c->label.len;
+        node = c;
+    }
+    return best;
+}
+
+/**
+ * @param h
+ * @param r
+ */
+static void http_route_destroy(heap h, http_route r)
+{
+    while(r)
+    {
+        http_route next = r->next;
+        http_route_destroy(h, r->child);
+        deallocate(h, r, sizeof(struct http_route));
+        r = next;
+    }
+}
+
+closure_function(2, 1, boolean, http_serve,
+                 http_listener, hl, struct http_responder, hr,
+                 http_message m)
+{
+    http_listener hl = bound(hl);
+    http_responder hr = &bound(hr);
+    http_request_handler each;
+    http_method method = HTTP_REQUEST_METHODS;
+
+    hr->http_version = HTTP_VER(1, 1);
+    if(m->words >= 3)
+    {
+        if(!http_parse_version(&m->start_line[2], &hr->http_version) || hr->http_version > HTTP_VER(1, 1))
+        {
+            hr->http_version = HTTP_VER(1, 1);
+            goto bad_ver;
         }
     }
+    hr->keepalive = m->connection == HTTP_CONNECTION_KEEPALIVE ||
+                    (m->connection == HTTP_CONNECTION_DEFAULT && hr->http_version >= HTTP_VER(1, 1));
+    if(m->reject == HTTP_REJECT_TRANSFER_ENCODING)
+        goto not_implemented;
+    if(m->reject == HTTP_REJECT_TOO_LARGE)
+        goto too_large;
+
+    if(m->words >= 2)
+        method = http_parse_method(&m->start_line[0]);
+    if(method == HTTP_REQUEST_METHODS)
+        goto not_found;
+
+    buffer uri = &m->start_line[1];
+    const char* path = buffer_ref(uri, 0);
+    bytes len = buffer_length(uri);
+
+    if(len < 1 || path[0] != '/')
+        goto not_found;
 
-    buffer_consume(rel_uri, top_len);
-    if(buffer_length(rel_uri) > 0)
-        set(v, sym(relative_uri), rel_uri);
+    path++;
+    len--;
+    if(len == 0)
+    {
+        each = hl->default_handler;
+        http_wrap(&m->relative_uri, 0, 0);
+    }
     else
-        deallocate_buffer(rel_uri);
+    {
+        bytes matched;
+        http_route r = http_route_lookup(&hl->routes, path, len, &matched);
+        if(!r)
+            goto not_found;
+        each = r->each;
+        /* the handler gets what follows the '/' after its prefix */
+        if(matched < len)
+            matched++;
+        http_wrap(&m->relative_uri, (const u8*)path + matched, len - matched);
+    }
+    if(!each)
+        goto not_found;
 
-    if(match)
-        apply(match->each, method, hr, v);
-    return;
+    tuple v = http_message_value(hl->h, m);
+    if(v == INVALID_ADDRESS)
+        return false;
+    if(buffer_length(&m->relative_uri) > 0)
+        set(v, sym(relative_uri), &m->relative_uri);
+    apply(each, method, hr, v);
+    http_message_value_release(v);
+    return hr->keepalive;
 not_found:
     send_http_response(hr, timm("status", "404 Not Found"),
-                       aprintf(hl->h, "<html><head><title>404 Not Found</title></head>"
-                                      "<body><h1>Not Found</h1></body></html>\r\n"));
-    return;
+                       wrap_buffer(hl->h, (void*)http_not_found_body, sizeof(http_not_found_body) - 1));
+    return hr->keepalive;
 bad_ver:
+    hr->keepalive = false;
     send_http_response(hr, timm("status", "505 HTTP Version Not Supported"),
-                       aprintf(hl->h, "<html><head><title>505 HTTP Version Not Supported</title></head>"
-                                      "<body><h1>Use HTTP/1.1</h1></body></html>\r\n"));
+                       wrap_buffer(hl->h, (void*)http_bad_ver_body, sizeof(http_bad_ver_body) - 1));
+    return false;
+not_implemented:
+    hr->keepalive = false;
+    send_http_response(hr, timm("status", "501 Not Implemented"),
+                       wrap_buffer(hl->h, (void*)http_not_implemented_body, sizeof(http_not_implemented_body) - 1));
+    return false;
+too_large:
+    hr->keepalive = false;
+    send_http_response(hr, timm("status", "413 Content Too Large"),
+                       wrap_buffer(hl->h, (void*)http_too_large_body, sizeof(http_too_large_body) - 1));
+    return false;
 }
 
 closure_function(1, 1, boolean, http_ibh,
@@ -247,6 +968,39 @@ closure_function(1, 1, boolean, http_ibh,
     return true;
 }
 
+closure_function(1, 1, input_buffer_handler, each_http_connection,
+                 http_listener, hl,
+                 buffer_handler out)
+{
+    http_listener hl = bound(hl);
+    struct http_responder hr = {
+        .h = hl->h,
+        .out = out,
+        .http_version = HTTP_VER(1, 1),
+        .keepalive = true,
+        .chunk_open = false,
+    };
+
+    http_message_handler serve = closure(hl->h, http_serve, hl, hr);
+    if(serve == INVALID_ADDRESS)
+        goto fail;
+
+    buffer_handler parser = http_parser_allocate(hl->h, serve);
+    if(parser == INVALID_ADDRESS)
+    {
+        deallocate_closure(serve);
+        goto fail;
+    }
+
+    input_buffer_handler ibh = closure(hl->h, http_ibh, parser);
+    if(ibh != INVALID_ADDRESS)
+        return ibh;
+    apply(parser, 0);
+fail:
+    msg_err("%s: failed to allocate connection state", func_ss);
+    return INVALID_ADDRESS;
+}
+
 /**
  * @param hl
  * @param uri
@@ -254,11 +1008,14 @@ closure_function(1, 1, boolean, http_ibh,
  */
 void http_register_uri_handler(http_listener hl, sstring uri, http_request_handler each)
 {
-    http_listener_registrant r = allocate(hl->h, sizeof(struct http_listener_registrant));
-    assert(r != INVALID_ADDRESS);
-    r->uri = uri;
-    r->each = each;
-    list_insert_before(&hl->registrants, &r->l);
+    if(uri.len && uri.ptr[0] == '/')
+    {
+        uri.ptr++;
+        uri.len--;
+    }
+    http_route r = http_route_insert(hl->h, &hl->routes, uri);
+    if(!r->each)
+        r->each = each;
 }
 
 /**
@@ -283,11 +1040,15 @@ http_listener allocate_http_listener(heap h, u16 port)
 
     hl->h = h;
     hl->default_handler = 0;
-    list_init(&hl->registrants);
+    hl->routes.label = isstring(0, 0);
+    hl->routes.each = 0;
+    hl->routes.child = 0;
+    hl->routes.next = 0;
     return hl;
 }
 
 void deallocate_http_listener(heap h, http_listener hl)
 {
+    http_route_destroy(h, hl->routes.child);
     deallocate(h, hl, sizeof(struct http_listener));
-}
\ No newline at end of file
+}
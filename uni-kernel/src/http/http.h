@@ -25,6 +25,9 @@ typedef enum
 typedef struct http_responder* http_responder;
 
 /**
+ * @brief the value given to each points into the received data and is
+ *        only valid until each returns; copy what has to outlive it
+ *
  * @param h
  * @param each
  * @return buffer_handler
@@ -63,6 +66,17 @@ status send_http_chunk(http_responder out, buffer c);
  */
 status send_http_chunked_response(http_responder out, tuple t);
 
+/**
+ * @brief sends the buffers in body one after another as a single body;
+ *        they are handed to the connection as they are, not copied
+ *
+ * @param out
+ * @param t
+ * @param body
+ * @return status
+ */
+status send_http_response_chain(http_responder out, tuple t, vector body);
+
 /**
  * @param out
  * @param t
@@ -76,7 +90,10 @@ extern const sstring http_request_methods[];
 typedef struct http_listener* http_listener;
 
 /**
- * @brief Construct a new closure type object
+ * @brief Construct a new closure type object. v points into the received
+ *        data and is only valid until the handler returns; requests that
+ *        were pipelined behind this one are handled after it returns, so
+ *        responding before then keeps the responses in order
  *
  * @param method
  * @param out
@@ -85,6 +102,10 @@ typedef struct http_listener* http_listener;
 closure_type(http_request_handler, void, http_method method, http_responder out, value v);
 
 /**
+ * @brief uri is matched as the longest registered prefix ending at a '/'
+ *        or at the end of the path; what follows that '/' is passed as
+ *        relative_uri. uri is not copied.
+ *
  * @param hl
  * @param uri
  * @param each
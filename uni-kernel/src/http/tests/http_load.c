@@ -0,0 +1,289 @@
+/**
+ * @file http_load.c
+ * @author Krisna Pranav
+ * @brief loopback load generator for the http server: keeps a number of
+ *        connections busy with pipelined GETs and reports requests per
+ *        second and latency percentiles
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#define _GNU_SOURCE
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_CONNECTIONS 1024
+#define MAX_DEPTH 256
+#define RECV_SIZE 65536
+
+struct connection
+{
+    int fd;
+    uint64_t sent_at[MAX_DEPTH];
+    int head;
+    int in_flight;
+    char* in;
+    size_t in_len;
+};
+
+static char request[1024];
+static size_t request_len;
+static uint64_t* latencies;
+static long completed;
+static long issued;
+static long total;
+
+/**
+ * @return uint64_t
+ */
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/**
+ * @param a
+ * @param b
+ * @return int
+ */
+static int compare_u64(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+/**
+ * @param c
+ * @param depth
+ * @return int
+ */
+static int fill(struct connection* c, int depth)
+{
+    char batch[sizeof(request) * MAX_DEPTH];
+    size_t len = 0;
+    uint64_t t = now_ns();
+
+    /* requests that go out together are one write, as a pipelining client would send them */
+    while(c->in_flight < depth && issued < total)
+    {
+        memcpy(batch + len, request, request_len);
+        len += request_len;
+        c->sent_at[(c->head + c->in_flight) % MAX_DEPTH] = t;
+        c->in_flight++;
+        issued++;
+    }
+
+    for(size_t off = 0; off < len;)
+    {
+        ssize_t n = write(c->fd, batch + off, len - off);
+        if(n < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            perror("write");
+            return -1;
+        }
+        off += n;
+    }
+    return 0;
+}
+
+/**
+ * @param p
+ * @param len
+ * @return long, the length of the response at p, 0 if it is not all here
+ *         yet or -1 if it cannot be framed
+ */
+static long response_length(const char* p, size_t len)
+{
+    const char* end = memmem(p, len, "\r\n\r\n", 4);
+    if(!end)
+        return 0;
+    size_t header_len = end + 4 - p;
+
+    long content_length = -1;
+    for(const char* line = memchr(p, '\n', header_len); line && line < end; line = memchr(line + 1, '\n', end - line))
+    {
+        if(!strncasecmp(line + 1, "content-length:", 15))
+            content_length = strtol(line + 16, 0, 10);
+    }
+    if(content_length < 0)
+        return -1;
+    return header_len + content_length <= len ? (long)(header_len + content_length) : 0;
+}
+
+/**
+ * @param c
+ * @return int
+ */
+static int drain(struct connection* c)
+{
+    char buf[RECV_SIZE];
+    ssize_t n = read(c->fd, buf, sizeof(buf));
+    if(n <= 0)
+    {
+        fprintf(stderr, "connection closed with %d requests outstanding\n", c->in_flight);
+        return -1;
+    }
+
+    c->in = realloc(c->in, c->in_len + n);
+    memcpy(c->in + c->in_len, buf, n);
+    c->in_len += n;
+
+    uint64_t t = now_ns();
+    size_t off = 0;
+    long r;
+    while((r = response_length(c->in + off, c->in_len - off)) > 0)
+    {
+        if(!c->in_flight)
+        {
+            fprintf(stderr, "response without a request\n");
+            return -1;
+        }
+        latencies[completed++] = t - c->sent_at[c->head];
+        c->head = (c->head + 1) % MAX_DEPTH;
+        c->in_flight--;
+        off += r;
+    }
+    if(r < 0)
+    {
+        fprintf(stderr, "response without a content-length\n");
+        return -1;
+    }
+    memmove(c->in, c->in + off, c->in_len - off);
+    c->in_len -= off;
+    return 0;
+}
+
+/**
+ * @param prog
+ */
+static void usage(const char* prog)
+{
+    fprintf(stderr,
+            "usage: %s [-c connections] [-d pipeline depth] [-n requests] [-p path] [address] [port]\n"
+            "defaults: -c 16 -d 8 -n 200000 -p / 127.0.0.1 8080\n",
+            prog);
+    exit(2);
+}
+
+int main(int argc, char** argv)
+{
+    int connections = 16;
+    int depth = 8;
+    const char* path = "/";
+    const char* address = "127.0.0.1";
+    int port = 8080;
+    int opt;
+
+    total = 200000;
+    while((opt = getopt(argc, argv, "c:d:n:p:")) != -1)
+    {
+        switch(opt)
+        {
+        case 'c':
+            connections = atoi(optarg);
+            break;
+        case 'd':
+            depth = atoi(optarg);
+            break;
+        case 'n':
+            total = atol(optarg);
+            break;
+        case 'p':
+            path = optarg;
+            break;
+        default:
+            usage(argv[0]);
+        }
+    }
+    if(optind < argc)
+        address = argv[optind++];
+    if(optind < argc)
+        port = atoi(argv[optind++]);
+    if(connections < 1 || connections > MAX_CONNECTIONS || depth < 1 || depth > MAX_DEPTH || total < 1)
+        usage(argv[0]);
+
+    request_len = snprintf(request, sizeof(request), "GET %s HTTP/1.1\r\nHost: %s\r\nUser-Agent: http_load\r\n\r\n",
+                           path, address);
+    if(request_len >= sizeof(request))
+        usage(argv[0]);
+    latencies = malloc(sizeof(uint64_t) * total);
+
+    struct sockaddr_in sin = {.sin_family = AF_INET, .sin_port = htons(port)};
+    if(inet_pton(AF_INET, address, &sin.sin_addr) != 1)
+        usage(argv[0]);
+
+    struct connection* conns = calloc(connections, sizeof(struct connection));
+    struct pollfd* fds = calloc(connections, sizeof(struct pollfd));
+    for(int i = 0; i < connections; i++)
+    {
+        int one = 1;
+        conns[i].fd = socket(AF_INET, SOCK_STREAM, 0);
+        if(conns[i].fd < 0 || connect(conns[i].fd, (struct sockaddr*)&sin, sizeof(sin)) < 0)
+        {
+            perror("connect");
+            return 1;
+        }
+        setsockopt(conns[i].fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        fds[i].fd = conns[i].fd;
+        fds[i].events = POLLIN;
+    }
+
+    uint64_t start = now_ns();
+    for(int i = 0; i < connections; i++)
+    {
+        if(fill(&conns[i], depth) < 0)
+            return 1;
+    }
+
+    while(completed < total)
+    {
+        if(poll(fds, connections, 5000) <= 0)
+        {
+            fprintf(stderr, "timed out with %ld of %ld responses\n", completed, total);
+            return 1;
+        }
+        for(int i = 0; i < connections; i++)
+        {
+            if(!(fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+            if(drain(&conns[i]) < 0 || fill(&conns[i], depth) < 0)
+                return 1;
+        }
+    }
+    double seconds = (now_ns() - start) / 1e9;
+
+    qsort(latencies, completed, sizeof(uint64_t), compare_u64);
+    printf("%ld requests over %d connections, pipeline depth %d, in %.3f s\n", completed, connections, depth, seconds);
+    printf("%.0f requests/s\n", completed / seconds);
+    printf("latency: p50 %.1f us, p99 %.1f us, max %.1f us\n", latencies[completed / 2] / 1e3,
+           latencies[completed * 99 / 100] / 1e3, latencies[completed - 1] / 1e3);
+
+    for(int i = 0; i < connections; i++)
+    {
+        close(conns[i].fd);
+        free(conns[i].in);
+    }
+    free(conns);
+    free(fds);
+    free(latencies);
+    return 0;
+}
@@ -9,7 +9,19 @@
  *
  */
 
+#include <mods/atomic.h>
+#include <mods/lexicalpath.h>
+#include <mods/quicksort.h>
+#include <mods/scopeguard.h>
 #include <libarchive/zip.h>
+#include <libcompress/deflate.h>
+#include <libcore/directory.h>
+#include <libcore/system.h>
+#include <libcrypto/checksum/crc32.h>
+#include <libthreading/mutex.h>
+#include <libthreading/thread.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace Archive
 {
@@ -66,6 +78,9 @@ namespace Archive
         if(end_of_central_directory.disk_number != 0 || end_of_central_directory.central_directory_start_disk != 0 || end_of_central_directory.disk_records_count != end_of_central_directory.total_records_count)
             return {}; 
 
+        Vector<ZipMember> members;
+        members.ensure_capacity(end_of_central_directory.total_records_count);
+
         size_t member_offset = end_of_central_directory.central_directory_offset;
         for(size_t i = 0; i < end_of_central_directory.total_records_count; i++)
         {
@@ -93,14 +108,62 @@ namespace Archive
                 return {};
             if(buffer.size() - (local_file_header.compressed_data - buffer.data()) < central_directory_record.compressed_size)
                 return {};
+
+            ZipMember member;
+            member.name = String{reinterpret_cast<char const*>(central_directory_record.name), central_directory_record.name_length};
+            member.compressed_data = {local_file_header.compressed_data, central_directory_record.compressed_size};
+            member.compression_method = central_directory_record.compression_method;
+            member.uncompressed_size = central_directory_record.uncompressed_size;
+            member.crc32 = central_directory_record.crc32;
+            member.is_directory = central_directory_record.external_attributes & zip_directory_external_attribute || member.name.ends_with('/'); // FIXME: better directory detection
+            members.unchecked_append(move(member));
+
             member_offset += central_directory_record.size();
         }
 
-        return Zip{
-            end_of_central_directory.total_records_count,
-            end_of_central_directory.central_directory_offset,
-            buffer,
-        };
+        return Zip{move(members), buffer};
+    }
+
+    /**
+     * @param path 
+     * @return ErrorOr<Zip> 
+     */
+    ErrorOr<Zip> Zip::try_open(String const& path)
+    {
+        auto mapped_file = TRY(Core::MappedFile::map(path));
+
+        auto zip = try_create(mapped_file->bytes());
+        if(!zip.has_value())
+            return Error::from_string_literal("Not a valid zip archive");
+
+        zip->m_mapped_file = move(mapped_file);
+        return zip.release_value();
+    }
+
+    /**
+     * @brief Construct a new Zip::Zip object
+     * 
+     * @param members 
+     * @param input_data 
+     */
+    Zip::Zip(Vector<ZipMember> members, ReadonlyBytes input_data)
+        : m_members(move(members)), m_input_data(input_data)
+    {
+        m_member_index.ensure_capacity(m_members.size());
+        for(size_t i = 0; i < m_members.size(); i++)
+            m_member_index.set(m_members[i].name, i);
+    }
+
+    /**
+     * @param name 
+     * @return ZipMember const* 
+     */
+    ZipMember const* Zip::find_member(StringView name) const
+    {
+        auto it = m_member_index.find(name.hash(), [&](auto& entry) { return entry.key == name; });
+        if(it == m_member_index.end())
+            return nullptr;
+        return &m_members[it->value];
     }
 
     /**
@@ -110,33 +173,153 @@ namespace Archive
      */
     bool Zip::for_each_member(Function<IterationDecision(ZipMember const&)> callback)
     {
-        size_t member_offset = m_members_start_offset;
-        for(size_t i = 0; i < m_member_count; i++)
+        for(auto const& member : m_members)
         {
-            CentralDirectoryRecord central_directory_record{};
-            VERIFY(central_directory_record.read(m_input_data.slice(member_offset)));
-            LocalFileHeader local_file_header{};
-            VERIFY(local_file_header.read(m_input_data.slice(central_directory_record.local_file_header_offset)));
-
-            ZipMember member;
-            char null_terminated_name[central_directory_record.name_length + 1];
-            memcpy(null_terminated_name, central_directory_record.name, central_directory_record.name_length);
-            null_terminated_name[central_directory_record.name_length] = 0;
-            member.name = String{null_terminated_name};
-            member.compressed_data = {local_file_header.compressed_data, central_directory_record.compressed_size};
-            member.compression_method = central_directory_record.compression_method;
-            member.uncompressed_size = central_directory_record.uncompressed_size;
-            member.crc32 = central_directory_record.crc32;
-            member.is_directory = central_directory_record.external_attributes & zip_directory_external_attribute || member.name.ends_with('/'); // FIXME: better directory detection
-
             if(callback(member) == IterationDecision::Break)
                 return false;
-
-            member_offset += central_directory_record.size();
         }
         return true;
     }
 
+    /**
+     * @param member 
+     * @return ErrorOr<ByteBuffer> 
+     */
+    ErrorOr<ByteBuffer> Zip::decompress_member(ZipMember const& member)
+    {
+        ByteBuffer contents;
+
+        switch(member.compression_method)
+        {
+        case ZipCompressionMethod::Store:
+            contents = TRY(ByteBuffer::copy(member.compressed_data));
+            break;
+        case ZipCompressionMethod::Deflate:
+        {
+            auto decompressed = Compress::DeflateDecompressor::decompress_all(member.compressed_data);
+            if(!decompressed.has_value())
+                return Error::from_string_literal("Failed to inflate zip member");
+            contents = decompressed.release_value();
+            break;
+        }
+        default:
+            return Error::from_string_literal("Unsupported zip compression method");
+        }
+
+        if(contents.size() != member.uncompressed_size)
+            return Error::from_string_literal("Zip member has the wrong uncompressed size");
+
+        if(Crypto::Checksum::CRC32{contents.bytes()}.digest() != member.crc32)
+            return Error::from_string_literal("Zip member failed CRC32 verification");
+
+        return contents;
+    }
+
+    /**
+     * @param thread_count 
+     * @param callback 
+     * @return ErrorOr<void> 
+     */
+    ErrorOr<void> Zip::parallel_extract(size_t thread_count, Function<ErrorOr<void>(ZipMember const&, ReadonlyBytes)> callback) const
+    {
+        Vector<ZipMember const*> work;
+        work.ensure_capacity(m_members.size());
+        for(auto const& member : m_members)
+        {
+            if(!member.is_directory)
+                work.unchecked_append(&member);
+        }
+
+        quick_sort(work, [](auto const* a, auto const* b) {
+            return a->compressed_data.size() > b->compressed_data.size();
+        });
+
+        if(thread_count == 0)
+            thread_count = static_cast<size_t>(max(sysconf(_SC_NPROCESSORS_ONLN), 1l));
+        thread_count = clamp(thread_count, static_cast<size_t>(1), max(work.size(), static_cast<size_t>(1)));
+
+        Atomic<size_t> next_index{0};
+        Atomic<bool> failed{false};
+        Threading::Mutex error_lock;
+        Optional<Error> first_error;
+
+        auto worker = [&]() -> intptr_t {
+            while(!failed.load(Mods::memory_order_relaxed))
+            {
+                auto index = next_index.fetch_add(1, Mods::memory_order_relaxed);
+                if(index >= work.size())
+                    break;
+
+                auto const& member = *work[index];
+                auto result = [&]() -> ErrorOr<void> {
+                    auto contents = TRY(decompress_member(member));
+                    return callback(member, contents.bytes());
+                }();
+
+                if(result.is_error())
+                {
+                    Threading::MutexLocker locker(error_lock);
+                    if(!first_error.has_value())
+                        first_error = result.release_error();
+                    failed.store(true, Mods::memory_order_relaxed);
+                }
+            }
+            return (intptr_t) nullptr;
+        };
+
+        Vector<NonnullRefPtr<Threading::Thread>> threads;
+        for(size_t i = 1; i < thread_count; i++)
+        {
+            auto thread = Threading::Thread::construct(worker, "Zip extract"sv);
+            thread->start();
+            threads.append(move(thread));
+        }
+
+        worker();
+
+        for(auto& thread : threads)
+            (void)thread->join();
+
+        if(first_error.has_value())
+            return first_error.release_value();
+        return {};
+    }
+
+    /**
+     * @param destination 
+     * @param thread_count 
+     * @return ErrorOr<void> 
+     */
+    ErrorOr<void> Zip::extract_to_directory(StringView destination, size_t thread_count) const
+    {
+        auto resolve = [&](ZipMember const& member) -> ErrorOr<LexicalPath> {
+            auto relative = LexicalPath(member.name);
+            if(relative.is_absolute() || relative.parts_view().contains_slow(".."sv))
+                return Error::from_string_literal("Zip member path escapes the destination");
+            return LexicalPath::join(destination, relative.string());
+        };
+
+        for(auto const& member : m_members)
+        {
+            auto path = TRY(resolve(member));
+            auto directory = member.is_directory ? path : path.parent();
+            TRY(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes));
+        }
+
+        return parallel_extract(thread_count, [&](ZipMember const& member, ReadonlyBytes contents) -> ErrorOr<void> {
+            auto path = TRY(resolve(member));
+            auto fd = TRY(Core::System::open(path.string(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+            ScopeGuard close_fd = [fd] { (void)Core::System::close(fd); };
+
+            while(!contents.is_empty())
+            {
+                auto nwritten = TRY(Core::System::write(fd, contents));
+                contents = contents.slice(nwritten);
+            }
+            return {};
+        });
+    }
+
     /**
      * @brief Construct a new ZipOutputStream::ZipOutputStream object
      * 
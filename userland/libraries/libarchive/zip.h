@@ -12,11 +12,15 @@
 #pragma once
 
 #include <mods/array.h>
+#include <mods/bytebuffer.h>
+#include <mods/error.h>
 #include <mods/function.h>
+#include <mods/hashmap.h>
 #include <mods/iterationdecision.h>
 #include <mods/stream.h>
 #include <mods/string.h>
 #include <mods/vector.h>
+#include <libcore/mappedfile.h>
 #include <string.h>
 
 namespace Archive
@@ -275,12 +279,61 @@ namespace Archive
          */
         static Optional<Zip> try_create(ReadonlyBytes buffer);
 
+        /**
+         * @brief maps the archive at path and indexes its central directory;
+         *        members reference the mapping directly, nothing is copied.
+         * 
+         * @param path 
+         * @return ErrorOr<Zip> 
+         */
+        static ErrorOr<Zip> try_open(String const& path);
+
         /**
          * @return true
          * @return false
          */
         bool for_each_member(Function<IterationDecision(ZipMember const&)>);
 
+        /**
+         * @param name 
+         * @return ZipMember const* 
+         */
+        ZipMember const* find_member(StringView name) const;
+
+        /**
+         * @return size_t 
+         */
+        size_t member_count() const
+        {
+            return m_members.size();
+        }
+
+        /**
+         * @brief inflates a member and verifies it against the recorded CRC32.
+         * 
+         * @param member 
+         * @return ErrorOr<ByteBuffer> 
+         */
+        static ErrorOr<ByteBuffer> decompress_member(ZipMember const& member);
+
+        /**
+         * @brief inflates every member on a pool of thread_count threads (0 picks
+         *        one per CPU) and hands the verified contents to callback, which
+         *        runs on the worker threads. Largest members are claimed first.
+         * 
+         * @param thread_count 
+         * @param callback 
+         * @return ErrorOr<void> 
+         */
+        ErrorOr<void> parallel_extract(size_t thread_count, Function<ErrorOr<void>(ZipMember const&, ReadonlyBytes)> callback) const;
+
+        /**
+         * @param destination 
+         * @param thread_count 
+         * @return ErrorOr<void> 
+         */
+        ErrorOr<void> extract_to_directory(StringView destination, size_t thread_count = 0) const;
+
     private:
         /**
          * @param offset
@@ -292,18 +345,15 @@ namespace Archive
         /**
          * @brief Construct a new Zip object
          *
-         * @param member_count
-         * @param members_start_offset
+         * @param members
          * @param input_data
          */
-        Zip(u16 member_count, size_t members_start_offset, ReadonlyBytes input_data)
-            : m_member_count{member_count}, m_members_start_offset{members_start_offset}, m_input_data{input_data}
-        {
-        }
+        Zip(Vector<ZipMember> members, ReadonlyBytes input_data);
 
-        u16 m_member_count{0};
-        size_t m_members_start_offset{0};
+        Vector<ZipMember> m_members;
+        HashMap<String, size_t> m_member_index;
         ReadonlyBytes m_input_data;
+        RefPtr<Core::MappedFile> m_mapped_file;
     }; // class Zip
 
     class ZipOutputStream
@@ -38,6 +38,17 @@ int __pthread_setspecific(pthread_key_t, void const*);
 
 int __pthread_self(void);
 
+/**
+ * @brief tells the cpu we are spinning, so a hyperthread sibling gets the
+ *        pipeline and leaving the loop does not mispredict.
+ */
+static inline void __pthread_relax(void)
+{
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#endif
+}
+
 void __pthread_key_destroy_for_current_thread(void);
 
 #define __PTHREAD_MUTEX_NORMAL 0
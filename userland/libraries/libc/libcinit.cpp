@@ -38,6 +38,7 @@ int* __errno_location()
 void __libc_init()
 {
     __auxiliary_vector_init();
+    __string_init();
     __malloc_init();
     __stdio_init();
 }
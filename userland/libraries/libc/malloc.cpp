@@ -688,6 +688,11 @@ void __malloc_init()
     new (&big_allocators()[0])(BigAllocator);
 }
 
+size_t pranaos_malloc_call_count()
+{
+    return g_malloc_stats.number_of_malloc_calls;
+}
+
 void pranaos_dump_malloc_stats()
 {
     dbgln("# malloc() calls: {}", g_malloc_stats.number_of_malloc_calls);
@@ -86,6 +86,17 @@ static ALWAYS_INLINE int futex_wake(uint32_t* userspace_address, uint32_t count)
     return futex(userspace_address, FUTEX_WAKE, count, NULL, NULL, 0);
 }
 
+/**
+ * @param blocks 
+ * @param count 
+ * @param abstime 
+ * @return the index of the futex that was woken, or -1 with errno set
+ */
+static ALWAYS_INLINE int futex_wait_multiple(struct futex_wait_block const* blocks, uint32_t count, const struct timespec* abstime)
+{
+    return futex((uint32_t*)blocks, FUTEX_WAIT_MULTIPLE, count, abstime, NULL, 0);
+}
+
 #ifdef ALWAYS_INLINE_PRANAOS_H
 #    undef ALWAYS_INLINE
 #endif
@@ -11,12 +11,16 @@
 
 #include <mods/atomic.h>
 #include <mods/neverdestroyed.h>
+#include <mods/quicksort.h>
 #include <mods/types.h>
 #include <mods/vector.h>
 #include <bits/pthread_integration.h>
 #include <errno.h>
+#include <pthread.h>
 #include <sched.h>
 #include <pranaos.h>
+#include <stdio.h>
+#include <time.h>
 #include <unistd.h>
 
 namespace 
@@ -103,6 +107,161 @@ static constexpr u32 MUTEX_UNLOCKED = 0;
 static constexpr u32 MUTEX_LOCKED_NO_NEED_TO_WAKE = 1;
 static constexpr u32 MUTEX_LOCKED_NEED_TO_WAKE = 2;
 
+// a contended lock spins for up to 2^MUTEX_SPIN_ROUNDS - 1 pauses, doubling
+// the wait between looks, before it goes to sleep in the kernel. long enough
+// to ride out a short critical section on another cpu, short enough not to
+// matter when the owner is descheduled.
+static constexpr u32 MUTEX_SPIN_ROUNDS = 8;
+
+static constexpr size_t MUTEX_PROFILE_SLOTS = 1024;
+
+namespace
+{
+
+    struct MutexProfileEntry
+    {
+        Atomic<FlatPtr> mutex { 0 };
+        Atomic<FlatPtr> last_call_site { 0 };
+        Atomic<FlatPtr> worst_call_site { 0 };
+        Atomic<u64> contentions { 0 };
+        Atomic<u64> total_wait_ns { 0 };
+        Atomic<u64> worst_wait_ns { 0 };
+    }; // struct MutexProfileEntry
+
+    struct MutexProfileSnapshot
+    {
+        FlatPtr mutex;
+        FlatPtr last_call_site;
+        FlatPtr worst_call_site;
+        u64 contentions;
+        u64 total_wait_ns;
+        u64 worst_wait_ns;
+    }; // struct MutexProfileSnapshot
+
+    static Atomic<bool> g_mutex_profiling { false };
+    static Atomic<size_t> g_mutex_profile_dropped { 0 };
+    static MutexProfileEntry g_mutex_profile[MUTEX_PROFILE_SLOTS];
+    static Atomic<int> g_spin_allowed { -1 };
+
+} // namespace
+
+/**
+ * @brief spinning only helps if the owner can run at the same time.
+ *
+ * @return true
+ * @return false
+ */
+static bool mutex_spinning_allowed()
+{
+    int allowed = g_spin_allowed.load(Mods::memory_order_relaxed);
+    if (allowed < 0) [[unlikely]] {
+        allowed = sysconf(_SC_NPROCESSORS_ONLN) > 1;
+        g_spin_allowed.store(allowed, Mods::memory_order_relaxed);
+    }
+    return allowed;
+}
+
+/**
+ * @param mutex
+ * @return true if the lock was taken while spinning
+ */
+static bool mutex_spin(pthread_mutex_t* mutex)
+{
+    if (!mutex_spinning_allowed())
+        return false;
+
+    for (u32 round = 0; round < MUTEX_SPIN_ROUNDS; ++round) {
+        for (u32 i = 0; i < (1u << round); ++i)
+            __pthread_relax();
+
+        if (Mods::atomic_load(&mutex->lock, Mods::memory_order_relaxed) != MUTEX_UNLOCKED)
+            continue;
+
+        u32 expected = MUTEX_UNLOCKED;
+        if (Mods::atomic_compare_exchange_strong(&mutex->lock, expected, MUTEX_LOCKED_NO_NEED_TO_WAKE, Mods::memory_order_acquire))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @return u64
+ */
+static u64 mutex_profile_now()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (u64)now.tv_sec * 1'000'000'000 + now.tv_nsec;
+}
+
+/**
+ * @brief finds or claims the mutex's slot. never allocates, since malloc
+ *        itself takes mutexes; once the table is full new mutexes are
+ *        only counted as dropped.
+ *
+ * @param mutex
+ * @param call_site
+ * @param wait_ns
+ */
+static void mutex_profile_record(pthread_mutex_t* mutex, FlatPtr call_site, u64 wait_ns)
+{
+    FlatPtr key = (FlatPtr)mutex;
+    size_t start = (key >> 4) % MUTEX_PROFILE_SLOTS;
+
+    for (size_t probe = 0; probe < MUTEX_PROFILE_SLOTS; ++probe) {
+        auto& entry = g_mutex_profile[(start + probe) % MUTEX_PROFILE_SLOTS];
+        FlatPtr current = entry.mutex.load(Mods::memory_order_relaxed);
+
+        if (current == 0) {
+            if (!entry.mutex.compare_exchange_strong(current, key, Mods::memory_order_relaxed) && current != key)
+                continue;
+        } else if (current != key) {
+            continue;
+        }
+
+        entry.last_call_site.store(call_site, Mods::memory_order_relaxed);
+        entry.contentions.fetch_add(1, Mods::memory_order_relaxed);
+        entry.total_wait_ns.fetch_add(wait_ns, Mods::memory_order_relaxed);
+
+        u64 worst = entry.worst_wait_ns.load(Mods::memory_order_relaxed);
+        while (wait_ns > worst) {
+            if (entry.worst_wait_ns.compare_exchange_strong(worst, wait_ns, Mods::memory_order_relaxed)) {
+                entry.worst_call_site.store(call_site, Mods::memory_order_relaxed);
+                break;
+            }
+        }
+        return;
+    }
+
+    g_mutex_profile_dropped.fetch_add(1, Mods::memory_order_relaxed);
+}
+
+/**
+ * @brief the contended part of a lock: spin, then sleep on the futex.
+ *
+ * @param mutex
+ * @param value the lock word seen by the failed fast path
+ * @param call_site
+ */
+static void mutex_lock_slow(pthread_mutex_t* mutex, u32 value, FlatPtr call_site)
+{
+    bool profiling = g_mutex_profiling.load(Mods::memory_order_relaxed);
+    u64 start = profiling ? mutex_profile_now() : 0;
+
+    if (!mutex_spin(mutex)) {
+        if (value != MUTEX_LOCKED_NEED_TO_WAKE)
+            value = Mods::atomic_exchange(&mutex->lock, MUTEX_LOCKED_NEED_TO_WAKE, Mods::memory_order_acquire);
+
+        while (value != MUTEX_UNLOCKED) {
+            futex_wait(&mutex->lock, value, nullptr, 0);
+            value = Mods::atomic_exchange(&mutex->lock, MUTEX_LOCKED_NEED_TO_WAKE, Mods::memory_order_acquire);
+        }
+    }
+
+    if (profiling)
+        mutex_profile_record(mutex, call_site, mutex_profile_now() - start);
+}
+
 /**
  * @param mutex 
  * @param attributes 
@@ -167,13 +326,7 @@ int __pthread_mutex_lock(pthread_mutex_t* mutex)
         }
     }
 
-    if (value != MUTEX_LOCKED_NEED_TO_WAKE)
-        value = Mods::atomic_exchange(&mutex->lock, MUTEX_LOCKED_NEED_TO_WAKE, Mods::memory_order_acquire);
-
-    while (value != MUTEX_UNLOCKED) {
-        futex_wait(&mutex->lock, value, nullptr, 0);
-        value = Mods::atomic_exchange(&mutex->lock, MUTEX_LOCKED_NEED_TO_WAKE, Mods::memory_order_acquire);
-    }
+    mutex_lock_slow(mutex, value, (FlatPtr)__builtin_return_address(0));
 
     if (mutex->type == __PTHREAD_MUTEX_RECURSIVE)
         Mods::atomic_store(&mutex->owner, __pthread_self(), Mods::memory_order_relaxed);
@@ -225,4 +378,88 @@ int __pthread_mutex_unlock(pthread_mutex_t* mutex)
 }
 
 int pthread_mutex_unlock(pthread_mutex_t*) __attribute__((weak, alias("__pthread_mutex_unlock")));
+
+/**
+ * @param enable
+ * @return int
+ */
+int pthread_mutex_profiler_enable_np(int enable)
+{
+    g_mutex_profiling.store(enable != 0);
+    return 0;
+}
+
+int pthread_mutex_profiler_reset_np(void)
+{
+    for (auto& entry : g_mutex_profile) {
+        entry.contentions.store(0, Mods::memory_order_relaxed);
+        entry.total_wait_ns.store(0, Mods::memory_order_relaxed);
+        entry.worst_wait_ns.store(0, Mods::memory_order_relaxed);
+        entry.last_call_site.store(0, Mods::memory_order_relaxed);
+        entry.worst_call_site.store(0, Mods::memory_order_relaxed);
+        entry.mutex.store(0, Mods::memory_order_relaxed);
+    }
+    g_mutex_profile_dropped.store(0, Mods::memory_order_relaxed);
+    return 0;
+}
+
+/**
+ * @brief writes the most contended mutexes, by total time spent waiting.
+ *        call sites are return addresses; symbolize them with addr2line
+ *        or the profiler. the table is copied first, so the sort sees fixed
+ *        keys while other threads keep recording.
+ *
+ * @param fd
+ * @param max_entries
+ * @return int
+ */
+int pthread_mutex_profiler_dump_np(int fd, size_t max_entries)
+{
+    Vector<MutexProfileSnapshot> snapshot;
+    if (snapshot.try_ensure_capacity(MUTEX_PROFILE_SLOTS).is_error())
+        return ENOMEM;
+
+    for (auto& entry : g_mutex_profile) {
+        auto contentions = entry.contentions.load(Mods::memory_order_relaxed);
+        if (contentions == 0)
+            continue;
+        snapshot.unchecked_append(MutexProfileSnapshot {
+            entry.mutex.load(Mods::memory_order_relaxed),
+            entry.last_call_site.load(Mods::memory_order_relaxed),
+            entry.worst_call_site.load(Mods::memory_order_relaxed),
+            contentions,
+            entry.total_wait_ns.load(Mods::memory_order_relaxed),
+            entry.worst_wait_ns.load(Mods::memory_order_relaxed),
+        });
+    }
+
+    Mods::quick_sort(snapshot, [](auto& a, auto& b) {
+        return a.total_wait_ns > b.total_wait_ns;
+    });
+
+    char line[160];
+    int length = snprintf(line, sizeof(line), "%-18s %10s %14s %12s %-18s %-18s\n", "mutex", "contended", "total wait us", "worst us", "worst site", "last site");
+    if (write(fd, line, length) < 0)
+        return errno;
+
+    for (size_t i = 0; i < snapshot.size() && i < max_entries; ++i) {
+        auto& entry = snapshot[i];
+        length = snprintf(line, sizeof(line), "%#-18lx %10llu %14llu %12llu %#-18lx %#-18lx\n",
+            (unsigned long)entry.mutex,
+            (unsigned long long)entry.contentions,
+            (unsigned long long)entry.total_wait_ns / 1000,
+            (unsigned long long)entry.worst_wait_ns / 1000,
+            (unsigned long)entry.worst_call_site,
+            (unsigned long)entry.last_call_site);
+        if (write(fd, line, length) < 0)
+            return errno;
+    }
+
+    if (auto dropped = g_mutex_profile_dropped.load(Mods::memory_order_relaxed)) {
+        length = snprintf(line, sizeof(line), "(%zu contentions on mutexes that did not fit the table)\n", dropped);
+        if (write(fd, line, length) < 0)
+            return errno;
+    }
+    return 0;
+}
 }
@@ -13,6 +13,8 @@
 #include <sys/types.h>
 #include <mods/assertions.h>
 #include <mods/quicksort.h>
+#include <mods/scopeguard.h>
+#include <string.h>
 
 class SizedObject {
 public:
@@ -51,6 +53,9 @@ private:
 namespace Mods {
 
     /**
+     * @brief swaps word by word, falling back to bytes only for the tail; the
+     *        element pointers qsort hands out are not necessarily aligned.
+     *
      * @tparam  
      * @param a 
      * @param b 
@@ -59,12 +64,21 @@ namespace Mods {
     inline void swap(const SizedObject& a, const SizedObject& b)
     {
         ASSERT(a.size() == b.size());
-        const size_t size = a.size();
-        const auto a_data = reinterpret_cast<char*>(a.data());
-        const auto b_data = reinterpret_cast<char*>(b.data());
-        for (auto i = 0u; i < size; ++i) {
-            swap(a_data[i], b_data[i]);
+        size_t size = a.size();
+        auto* a_data = reinterpret_cast<u8*>(a.data());
+        auto* b_data = reinterpret_cast<u8*>(b.data());
+
+        for (; size >= sizeof(size_t); size -= sizeof(size_t), a_data += sizeof(size_t), b_data += sizeof(size_t)) {
+            size_t a_word;
+            size_t b_word;
+            __builtin_memcpy(&a_word, a_data, sizeof(size_t));
+            __builtin_memcpy(&b_word, b_data, sizeof(size_t));
+            __builtin_memcpy(a_data, &b_word, sizeof(size_t));
+            __builtin_memcpy(b_data, &a_word, sizeof(size_t));
         }
+
+        for (; size; --size, ++a_data, ++b_data)
+            swap(*a_data, *b_data);
     }
 
 } // namespace Mods
@@ -96,21 +110,88 @@ private:
     size_t m_element_size;
 }; // class SizedObjectSlice
 
+/**
+ * @brief elements at least this large are sorted through an array of pointers
+ *        and moved into place once at the end, instead of being swapped at
+ *        every step of the sort.
+ */
+static constexpr size_t indirect_sort_threshold = 64;
+
 /**
  * @param bot 
  * @param nmemb 
  * @param size 
- * @param compar 
+ * @param less_than 
+ * @return true 
+ * @return false 
  */
-void qsort(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, const void*))
+template<typename LessThan>
+static bool indirect_sort(void* bot, size_t nmemb, size_t size, LessThan less_than)
 {
-    if (nmemb <= 1) {
-        return;
+    auto** pointers = static_cast<u8**>(malloc(nmemb * sizeof(u8*)));
+    auto* temporary = static_cast<u8*>(malloc(size));
+    ScopeGuard free_buffers = [&] {
+        free(pointers);
+        free(temporary);
+    };
+
+    if (!pointers || !temporary)
+        return false;
+
+    auto* base = static_cast<u8*>(bot);
+    for (size_t i = 0; i < nmemb; ++i)
+        pointers[i] = base + i * size;
+
+    Mods::pattern_defeating_quick_sort(pointers, 0, nmemb, [&](u8 const* a, u8 const* b) { return less_than(a, b); });
+
+    for (size_t i = 0; i < nmemb; ++i) {
+        if (pointers[i] == base + i * size)
+            continue;
+
+        memcpy(temporary, base + i * size, size);
+        size_t hole = i;
+        for (;;) {
+            size_t source = (pointers[hole] - base) / size;
+            pointers[hole] = base + hole * size;
+            if (source == i)
+                break;
+            memcpy(base + hole * size, base + source * size, size);
+            hole = source;
+        }
+        memcpy(base + hole * size, temporary, size);
     }
 
+    return true;
+}
+
+/**
+ * @param bot 
+ * @param nmemb 
+ * @param size 
+ * @param less_than 
+ */
+template<typename LessThan>
+static void sort_sized_objects(void* bot, size_t nmemb, size_t size, LessThan less_than)
+{
+    if (nmemb <= 1)
+        return;
+
+    if (size >= indirect_sort_threshold && indirect_sort(bot, nmemb, size, less_than))
+        return;
+
     SizedObjectSlice slice { bot, size };
+    Mods::pattern_defeating_quick_sort(slice, 0, nmemb, [&](const SizedObject& a, const SizedObject& b) { return less_than(a.data(), b.data()); });
+}
 
-    Mods::dual_pivot_quick_sort(slice, 0, nmemb - 1, [=](const SizedObject& a, const SizedObject& b) { return compar(a.data(), b.data()) < 0; });
+/**
+ * @param bot 
+ * @param nmemb 
+ * @param size 
+ * @param compar 
+ */
+void qsort(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, const void*))
+{
+    sort_sized_objects(bot, nmemb, size, [=](const void* a, const void* b) { return compar(a, b) < 0; });
 } // void qsort
 
 /**
@@ -122,11 +203,5 @@ void qsort(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, cons
  */
 void qsort_r(void* bot, size_t nmemb, size_t size, int (*compar)(const void*, const void*, void*), void* arg)
 {
-    if (nmemb <= 1) {
-        return;
-    }
-
-    SizedObjectSlice slice { bot, size };
-
-    Mods::dual_pivot_quick_sort(slice, 0, nmemb - 1, [=](const SizedObject& a, const SizedObject& b) { return compar(a.data(), b.data(), arg) < 0; });
+    sort_sized_objects(bot, nmemb, size, [=](const void* a, const void* b) { return compar(a, b, arg) < 0; });
 } // void qsort_r
@@ -10,7 +10,6 @@
  */
 
 #include <mods/format.h>
-#include <mods/memmem.h>
 #include <mods/memory.h>
 #include <mods/platform.h>
 #include <mods/stdlibextra.h>
@@ -61,18 +60,6 @@ size_t strcspn(char const* s, char const* reject)
     }
 }
 
-/**
- * @param str 
- * @return size_t 
- */
-size_t strlen(char const* str)
-{
-    size_t len = 0;
-    while (*(str++))
-        ++len;
-    return len;
-}
-
 /**
  * @param str 
  * @param maxlen 
@@ -145,23 +132,6 @@ int strncmp(char const* s1, char const* s2, size_t n)
     return 0;
 }
 
-/**
- * @param v1 
- * @param v2 
- * @param n 
- * @return int 
- */
-int memcmp(void const* v1, void const* v2, size_t n)
-{
-    auto* s1 = (uint8_t const*)v1;
-    auto* s2 = (uint8_t const*)v2;
-    while (n-- > 0) {
-        if (*s1++ != *s2++)
-            return s1[-1] < s2[-1] ? -1 : 1;
-    }
-    return 0;
-}
-
 /**
  * @param b1 
  * @param b2 
@@ -173,89 +143,6 @@ int timingsafe_memcmp(void const* b1, void const* b2, size_t len)
     return Mods::timing_safe_compare(b1, b2, len) ? 1 : 0;
 }
 
-/**
- * @param dest_ptr 
- * @param src_ptr 
- * @param n 
- * @return void* 
- */
-void* memcpy(void* dest_ptr, void const* src_ptr, size_t n)
-{
-    void* original_dest = dest_ptr;
-    asm volatile(
-        "rep movsb"
-        : "+D"(dest_ptr), "+S"(src_ptr), "+c"(n)::"memory");
-    return original_dest;
-}
-
-/**
- * @param dest_ptr 
- * @param c 
- * @param n 
- * @return void* 
- */
-void* memset(void* dest_ptr, int c, size_t n)
-{
-    size_t dest = (size_t)dest_ptr;
-
-    if (!(dest & 0x3) && n >= 12) {
-        size_t size_ts = n / sizeof(size_t);
-        size_t expanded_c = explode_byte((u8)c);
-#if ARCH(I386)
-        asm volatile(
-            "rep stosl\n"
-            : "=D"(dest)
-            : "D"(dest), "c"(size_ts), "a"(expanded_c)
-            : "memory");
-#else
-        asm volatile(
-            "rep stosq\n"
-            : "=D"(dest)
-            : "D"(dest), "c"(size_ts), "a"(expanded_c)
-            : "memory");
-#endif
-        n -= size_ts * sizeof(size_t);
-        if (n == 0)
-            return dest_ptr;
-    }
-    asm volatile(
-        "rep stosb\n"
-        : "=D"(dest), "=c"(n)
-        : "0"(dest), "1"(n), "a"(c)
-        : "memory");
-    return dest_ptr;
-}
-
-/**
- * @param dest 
- * @param src 
- * @param n 
- * @return void* 
- */
-void* memmove(void* dest, void const* src, size_t n)
-{
-    if (((FlatPtr)dest - (FlatPtr)src) >= n)
-        return memcpy(dest, src, n);
-
-    u8* pd = (u8*)dest;
-    u8 const* ps = (u8 const*)src;
-    for (pd += n, ps += n; n--;)
-        *--pd = *--ps;
-    return dest;
-}
-
-/**
- * @param haystack 
- * @param haystack_length 
- * @param needle 
- * @param needle_length 
- * @return void const* 
- */
-void const* memmem(void const* haystack, size_t haystack_length, void const* needle, size_t needle_length)
-{
-    return Mods::memmem(haystack, haystack_length, needle, needle_length);
-}
-
 /**
  * @param dest 
  * @param src 
@@ -304,22 +191,6 @@ size_t strlcpy(char* dest, char const* src, size_t n)
     return i;
 }
 
-/**
- * @param str 
- * @param c 
- * @return char* 
- */
-char* strchr(char const* str, int c)
-{
-    char ch = c;
-    for (;; ++str) {
-        if (*str == ch)
-            return const_cast<char*>(str);
-        if (!*str)
-            return nullptr;
-    }
-}
-
 /**
  * @param str 
  * @param c 
@@ -344,23 +215,6 @@ char* strchrnul(char const* str, int c)
     }
 }
 
-/**
- * @param ptr 
- * @param c 
- * @param size 
- * @return void* 
- */
-void* memchr(void const* ptr, int c, size_t size)
-{
-    char ch = c;
-    auto* cptr = (char const*)ptr;
-    for (size_t i = 0; i < size; ++i) {
-        if (cptr[i] == ch)
-            return const_cast<char*>(cptr + i);
-    }
-    return nullptr;
-}
-
 /**
  * @param str 
  * @param ch 
@@ -478,29 +332,6 @@ char* strsignal(int signum)
     return const_cast<char*>(sys_siglist[signum]);
 }
 
-/**
- * @param haystack 
- * @param needle 
- * @return char* 
- */
-char* strstr(char const* haystack, char const* needle)
-{
-    char nch;
-    char hch;
-
-    if ((nch = *needle++) != 0) {
-        size_t len = strlen(needle);
-        do {
-            do {
-                if ((hch = *haystack++) == 0)
-                    return nullptr;
-            } while (hch != nch);
-        } while (strncmp(haystack, needle, len) != 0);
-        --haystack;
-    }
-    return const_cast<char*>(haystack);
-}
-
 /**
  * @param s 
  * @param accept 
@@ -0,0 +1,1176 @@
+/**
+ * @file string_simd.cpp
+ * @author Krisna Pranav
+ * @brief string simd
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <mods/platform.h>
+#include <mods/simd.h>
+#include <mods/stdlibextra.h>
+#include <mods/types.h>
+#include <string.h>
+#include <sys/internals.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+#if !defined(__clang__)
+#    pragma GCC optimize("no-tree-loop-distribute-patterns")
+#endif
+
+namespace
+{
+
+    using namespace Mods::SIMD;
+
+    struct StringFunctions {
+        size_t (*strlen)(char const*);
+        void* (*memchr)(void const*, int, size_t);
+        char* (*strchr)(char const*, int);
+        int (*memcmp)(void const*, void const*, size_t);
+        void* (*memcpy)(void*, void const*, size_t);
+        void* (*memmove)(void*, void const*, size_t);
+        void* (*memset)(void*, int, size_t);
+        void const* (*memmem)(void const*, size_t, void const*, size_t);
+    };
+
+    using u8x16_unaligned = u8 __attribute__((vector_size(16), aligned(1), may_alias));
+    using u8x32_unaligned = u8 __attribute__((vector_size(32), aligned(1), may_alias));
+    using u8x16_aliased = u8 __attribute__((vector_size(16), may_alias));
+    using u8x32_aliased = u8 __attribute__((vector_size(32), may_alias));
+    using u64_unaligned = u64 __attribute__((aligned(1), may_alias));
+    using u32_unaligned = u32 __attribute__((aligned(1), may_alias));
+    using u16_unaligned = u16 __attribute__((aligned(1), may_alias));
+    using size_t_aliased = size_t __attribute__((may_alias));
+
+    /**
+     * @brief stores at or above this size bypass the cache; anything that large would
+     *        evict the working set on its way to memory anyway.
+     */
+    constexpr size_t non_temporal_threshold = 4 * MiB;
+
+    /**
+     * @brief "rep movsb" only beats the vector loop once the microcode fast path
+     *        (ERMS) has enough bytes to amortize its startup cost.
+     */
+    constexpr size_t rep_movsb_threshold = 2 * KiB;
+
+    bool s_has_erms = false;
+
+    /**
+     * @brief overlapping word moves for n <= 16; every load happens before the
+     *        first store, so this is also correct for overlapping ranges.
+     */
+    ALWAYS_INLINE void move_small(u8* dest, u8 const* src, size_t n)
+    {
+        if (n >= 8) {
+            u64 head = *(u64_unaligned const*)src;
+            u64 tail = *(u64_unaligned const*)(src + n - 8);
+            *(u64_unaligned*)dest = head;
+            *(u64_unaligned*)(dest + n - 8) = tail;
+        } else if (n >= 4) {
+            u32 head = *(u32_unaligned const*)src;
+            u32 tail = *(u32_unaligned const*)(src + n - 4);
+            *(u32_unaligned*)dest = head;
+            *(u32_unaligned*)(dest + n - 4) = tail;
+        } else if (n >= 2) {
+            u16 head = *(u16_unaligned const*)src;
+            u16 tail = *(u16_unaligned const*)(src + n - 2);
+            *(u16_unaligned*)dest = head;
+            *(u16_unaligned*)(dest + n - 2) = tail;
+        } else if (n == 1) {
+            *dest = *src;
+        }
+    }
+
+    /**
+     * @brief word-at-a-time fallbacks for targets without a vector unit we can
+     *        rely on (pre-SSE2 i686, and non-x86 architectures).
+     */
+    namespace Generic
+    {
+
+        constexpr size_t ones = explode_byte(0x01);
+        constexpr size_t highs = explode_byte(0x80);
+
+        ALWAYS_INLINE bool has_zero_byte(size_t word)
+        {
+            return ((word - ones) & ~word & highs) != 0;
+        }
+
+        size_t strlen(char const* str)
+        {
+            auto const* p = str;
+            while ((FlatPtr)p % sizeof(size_t)) {
+                if (!*p)
+                    return p - str;
+                ++p;
+            }
+
+            auto const* words = (size_t_aliased const*)p;
+            while (!has_zero_byte(*words))
+                ++words;
+
+            p = (char const*)words;
+            while (*p)
+                ++p;
+            return p - str;
+        }
+
+        void* memchr(void const* ptr, int c, size_t size)
+        {
+            auto const* p = (u8 const*)ptr;
+            u8 ch = c;
+            for (; size && (FlatPtr)p % sizeof(size_t); --size, ++p) {
+                if (*p == ch)
+                    return const_cast<u8*>(p);
+            }
+
+            size_t pattern = explode_byte(ch);
+            for (; size >= sizeof(size_t); size -= sizeof(size_t), p += sizeof(size_t)) {
+                if (has_zero_byte(*(size_t_aliased const*)p ^ pattern))
+                    break;
+            }
+
+            for (; size; --size, ++p) {
+                if (*p == ch)
+                    return const_cast<u8*>(p);
+            }
+            return nullptr;
+        }
+
+        char* strchr(char const* str, int c)
+        {
+            char ch = c;
+            for (;; ++str) {
+                if (*str == ch)
+                    return const_cast<char*>(str);
+                if (!*str)
+                    return nullptr;
+            }
+        }
+
+        int memcmp(void const* v1, void const* v2, size_t n)
+        {
+            auto const* s1 = (u8 const*)v1;
+            auto const* s2 = (u8 const*)v2;
+            for (; n >= 8; n -= 8, s1 += 8, s2 += 8) {
+                u64 a = *(u64_unaligned const*)s1;
+                u64 b = *(u64_unaligned const*)s2;
+                if (a != b) {
+                    a = __builtin_bswap64(a);
+                    b = __builtin_bswap64(b);
+                    return a < b ? -1 : 1;
+                }
+            }
+            for (; n; --n, ++s1, ++s2) {
+                if (*s1 != *s2)
+                    return *s1 < *s2 ? -1 : 1;
+            }
+            return 0;
+        }
+
+        void* memmove(void* dest_ptr, void const* src_ptr, size_t n)
+        {
+            auto* dest = (u8*)dest_ptr;
+            auto const* src = (u8 const*)src_ptr;
+
+            if (n <= 16) {
+                move_small(dest, src, n);
+                return dest_ptr;
+            }
+
+            if ((FlatPtr)dest - (FlatPtr)src >= n) {
+                u64 tail = *(u64_unaligned const*)(src + n - 8);
+                size_t i = 0;
+                for (; i + 8 <= n; i += 8)
+                    *(u64_unaligned*)(dest + i) = *(u64_unaligned const*)(src + i);
+                *(u64_unaligned*)(dest + n - 8) = tail;
+            } else {
+                u64 head = *(u64_unaligned const*)src;
+                size_t i = n;
+                while (i > 8) {
+                    i -= 8;
+                    *(u64_unaligned*)(dest + i) = *(u64_unaligned const*)(src + i);
+                }
+                *(u64_unaligned*)dest = head;
+            }
+            return dest_ptr;
+        }
+
+        void* memset(void* dest_ptr, int c, size_t n)
+        {
+            auto* dest = (u8*)dest_ptr;
+
+            if (n < 8) {
+                for (size_t i = 0; i < n; ++i)
+                    dest[i] = (u8)c;
+                return dest_ptr;
+            }
+
+            u64 pattern = 0x0101010101010101ull * (u8)c;
+            for (size_t i = 0; i + 8 <= n; i += 8)
+                *(u64_unaligned*)(dest + i) = pattern;
+            *(u64_unaligned*)(dest + n - 8) = pattern;
+            return dest_ptr;
+        }
+
+    } // namespace Generic
+
+    /**
+     * @brief Two-Way string matching (Crochemore-Perrin): linear time, constant
+     *        space. Used for long needles, where the vector filter below would
+     *        degrade to quadratic verification work.
+     */
+    void const* two_way_memmem(u8 const* haystack, size_t haystack_length, u8 const* needle, size_t needle_length)
+    {
+        size_t byteset[32 / sizeof(size_t)] = {};
+        size_t shift[256];
+
+        auto set_bit = [&](u8 byte) { byteset[byte / (8 * sizeof(size_t))] |= (size_t)1 << (byte % (8 * sizeof(size_t))); };
+        auto has_bit = [&](u8 byte) { return (byteset[byte / (8 * sizeof(size_t))] >> (byte % (8 * sizeof(size_t)))) & 1; };
+
+        for (size_t i = 0; i < needle_length; ++i) {
+            set_bit(needle[i]);
+            shift[needle[i]] = i + 1;
+        }
+
+        auto maximal_suffix = [&](bool reversed, size_t& period) {
+            size_t ip = (size_t)-1;
+            size_t jp = 0;
+            size_t k = 1;
+            period = 1;
+            while (jp + k < needle_length) {
+                u8 a = needle[ip + k];
+                u8 b = needle[jp + k];
+                if (a == b) {
+                    if (k == period) {
+                        jp += period;
+                        k = 1;
+                    } else {
+                        ++k;
+                    }
+                } else if (reversed ? a < b : a > b) {
+                    jp += k;
+                    k = 1;
+                    period = jp - ip;
+                } else {
+                    ip = jp++;
+                    k = period = 1;
+                }
+            }
+            return ip;
+        };
+
+        size_t period;
+        size_t reversed_period;
+        size_t critical = maximal_suffix(false, period);
+        size_t reversed_critical = maximal_suffix(true, reversed_period);
+        if (reversed_critical + 1 > critical + 1) {
+            critical = reversed_critical;
+            period = reversed_period;
+        }
+
+        size_t memory_reset;
+        if (Generic::memcmp(needle, needle + period, critical + 1) != 0) {
+            memory_reset = 0;
+            period = max(critical, needle_length - critical - 1) + 1;
+        } else {
+            memory_reset = needle_length - period;
+        }
+
+        size_t memory = 0;
+        u8 const* end = haystack + haystack_length;
+        for (u8 const* h = haystack; (size_t)(end - h) >= needle_length;) {
+            u8 last = h[needle_length - 1];
+            if (!has_bit(last)) {
+                h += needle_length;
+                memory = 0;
+                continue;
+            }
+            if (size_t k = needle_length - shift[last]; k) {
+                h += max(k, memory);
+                memory = 0;
+                continue;
+            }
+
+            size_t k = max(critical + 1, memory);
+            while (k < needle_length && needle[k] == h[k])
+                ++k;
+            if (k < needle_length) {
+                h += k - critical;
+                memory = 0;
+                continue;
+            }
+
+            k = critical + 1;
+            while (k > memory && needle[k - 1] == h[k - 1])
+                --k;
+            if (k <= memory)
+                return h;
+
+            h += period;
+            memory = memory_reset;
+        }
+        return nullptr;
+    }
+
+    namespace Generic
+    {
+
+        void const* memmem(void const* haystack, size_t haystack_length, void const* needle, size_t needle_length)
+        {
+            if (needle_length == 0)
+                return haystack;
+            if (needle_length > haystack_length)
+                return nullptr;
+            if (needle_length == 1)
+                return memchr(haystack, *(u8 const*)needle, haystack_length);
+            return two_way_memmem((u8 const*)haystack, haystack_length, (u8 const*)needle, needle_length);
+        }
+
+        void* memcpy(void* dest, void const* src, size_t n)
+        {
+            return memmove(dest, src, n);
+        }
+
+    } // namespace Generic
+
+#if ARCH(I386) || ARCH(X86_64)
+
+    /**
+     * @brief needles up to this length go through the vector first/last-byte
+     *        filter; longer ones use Two-Way.
+     */
+    constexpr size_t simd_memmem_max_needle = 32;
+
+    namespace SSE2
+    {
+
+#    define SSE2_TARGET [[gnu::target("sse2")]]
+
+        SSE2_TARGET ALWAYS_INLINE u8x16 splat(u8 c)
+        {
+            return u8x16 { c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c };
+        }
+
+        SSE2_TARGET ALWAYS_INLINE u8x16 load(void const* p)
+        {
+            return *(u8x16_unaligned const*)p;
+        }
+
+        SSE2_TARGET ALWAYS_INLINE u8x16 load_aligned(void const* p)
+        {
+            return *(u8x16_aliased const*)p;
+        }
+
+        SSE2_TARGET ALWAYS_INLINE void store(void* p, u8x16 value)
+        {
+            *(u8x16_unaligned*)p = value;
+        }
+
+        SSE2_TARGET ALWAYS_INLINE u32 mask_of(u8x16 a, u8x16 b)
+        {
+            return (u32)__builtin_ia32_pmovmskb128((c8x16)(a == b));
+        }
+
+        SSE2_TARGET size_t strlen(char const* str)
+        {
+            auto offset = (FlatPtr)str % 16;
+            auto const* p = str - offset;
+            auto zero = splat(0);
+
+            u32 mask = mask_of(load_aligned(p), zero) >> offset;
+            if (mask)
+                return __builtin_ctz(mask);
+
+            for (;;) {
+                p += 16;
+                mask = mask_of(load_aligned(p), zero);
+                if (mask)
+                    return p - str + __builtin_ctz(mask);
+            }
+        }
+
+        SSE2_TARGET void* memchr(void const* ptr, int c, size_t size)
+        {
+            if (!size)
+                return nullptr;
+
+            auto const* start = (u8 const*)ptr;
+            auto offset = (FlatPtr)start % 16;
+            auto const* p = start - offset;
+            auto needle = splat((u8)c);
+
+            u32 mask = mask_of(load_aligned(p), needle) >> offset;
+            size_t scanned = 16 - offset;
+            if (mask) {
+                size_t index = __builtin_ctz(mask);
+                return index < size ? const_cast<u8*>(start + index) : nullptr;
+            }
+
+            while (scanned < size) {
+                p += 16;
+                mask = mask_of(load_aligned(p), needle);
+                if (mask) {
+                    size_t index = scanned + __builtin_ctz(mask);
+                    return index < size ? const_cast<u8*>(start + index) : nullptr;
+                }
+                scanned += 16;
+            }
+            return nullptr;
+        }
+
+        SSE2_TARGET char* strchr(char const* str, int c)
+        {
+            auto offset = (FlatPtr)str % 16;
+            auto const* p = str - offset;
+            auto needle = splat((u8)c);
+            auto zero = splat(0);
+
+            auto block = load_aligned(p);
+            u32 mask = (mask_of(block, needle) | mask_of(block, zero)) >> offset;
+            p += offset;
+
+            while (!mask) {
+                p += 16 - ((FlatPtr)p % 16);
+                block = load_aligned(p);
+                mask = mask_of(block, needle) | mask_of(block, zero);
+            }
+
+            auto const* match = p + __builtin_ctz(mask);
+            return *match == (char)c ? const_cast<char*>(match) : nullptr;
+        }
+
+        SSE2_TARGET int memcmp(void const* v1, void const* v2, size_t n)
+        {
+            auto const* s1 = (u8 const*)v1;
+            auto const* s2 = (u8 const*)v2;
+
+            if (n < 16)
+                return Generic::memcmp(s1, s2, n);
+
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                u32 mask = mask_of(load(s1 + i), load(s2 + i)) ^ 0xffff;
+                if (mask) {
+                    size_t index = i + __builtin_ctz(mask);
+                    return s1[index] < s2[index] ? -1 : 1;
+                }
+            }
+
+            if (i < n) {
+                i = n - 16;
+                u32 mask = mask_of(load(s1 + i), load(s2 + i)) ^ 0xffff;
+                if (mask) {
+                    size_t index = i + __builtin_ctz(mask);
+                    return s1[index] < s2[index] ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+        /**
+         * @brief size classes: <= 16 bytes via overlapping words, <= 32 via two
+         *        overlapping vectors, then a vector loop with the tail preloaded so
+         *        a forward copy stays correct when dest < src.
+         */
+        SSE2_TARGET ALWAYS_INLINE void copy_forward(u8* dest, u8 const* src, size_t n)
+        {
+            auto tail = load(src + n - 16);
+            size_t i = 0;
+            for (; i + 64 <= n; i += 64) {
+                auto a = load(src + i);
+                auto b = load(src + i + 16);
+                auto c = load(src + i + 32);
+                auto d = load(src + i + 48);
+                store(dest + i, a);
+                store(dest + i + 16, b);
+                store(dest + i + 32, c);
+                store(dest + i + 48, d);
+            }
+            for (; i + 16 <= n; i += 16)
+                store(dest + i, load(src + i));
+            store(dest + n - 16, tail);
+        }
+
+        SSE2_TARGET ALWAYS_INLINE void copy_backward(u8* dest, u8 const* src, size_t n)
+        {
+            auto head = load(src);
+            size_t i = n;
+            while (i > 16) {
+                i -= 16;
+                store(dest + i, load(src + i));
+            }
+            store(dest, head);
+        }
+
+        SSE2_TARGET void* memmove(void* dest_ptr, void const* src_ptr, size_t n)
+        {
+            auto* dest = (u8*)dest_ptr;
+            auto const* src = (u8 const*)src_ptr;
+
+            if (n <= 16) {
+                move_small(dest, src, n);
+            } else if (n <= 32) {
+                auto head = load(src);
+                auto tail = load(src + n - 16);
+                store(dest, head);
+                store(dest + n - 16, tail);
+            } else if ((FlatPtr)dest <= (FlatPtr)src || (FlatPtr)dest - (FlatPtr)src >= n) {
+                copy_forward(dest, src, n);
+            } else {
+                copy_backward(dest, src, n);
+            }
+            return dest_ptr;
+        }
+
+        SSE2_TARGET void* memcpy(void* dest_ptr, void const* src_ptr, size_t n)
+        {
+            if (n >= rep_movsb_threshold && s_has_erms) {
+                void* dest = dest_ptr;
+                asm volatile(
+                    "rep movsb"
+                    : "+D"(dest), "+S"(src_ptr), "+c"(n)::"memory");
+                return dest_ptr;
+            }
+
+            auto* dest = (u8*)dest_ptr;
+            auto const* src = (u8 const*)src_ptr;
+
+            if (n <= 16) {
+                move_small(dest, src, n);
+            } else if (n <= 32) {
+                auto head = load(src);
+                auto tail = load(src + n - 16);
+                store(dest, head);
+                store(dest + n - 16, tail);
+            } else {
+                copy_forward(dest, src, n);
+            }
+            return dest_ptr;
+        }
+
+        SSE2_TARGET void* memset(void* dest_ptr, int c, size_t n)
+        {
+            auto* dest = (u8*)dest_ptr;
+
+            if (n < 16) {
+                u64 pattern = (u64)0x0101010101010101ull * (u8)c;
+                if (n >= 8) {
+                    *(u64_unaligned*)dest = pattern;
+                    *(u64_unaligned*)(dest + n - 8) = pattern;
+                } else if (n >= 4) {
+                    *(u32_unaligned*)dest = (u32)pattern;
+                    *(u32_unaligned*)(dest + n - 4) = (u32)pattern;
+                } else if (n) {
+                    dest[0] = (u8)c;
+                    dest[n / 2] = (u8)c;
+                    dest[n - 1] = (u8)c;
+                }
+                return dest_ptr;
+            }
+
+            auto value = splat((u8)c);
+            store(dest, value);
+            store(dest + n - 16, value);
+            if (n <= 32)
+                return dest_ptr;
+
+            auto* p = dest + 16 - ((FlatPtr)dest % 16);
+            auto* end = dest + n - 16;
+
+            if (n >= non_temporal_threshold) {
+                for (; p < end; p += 16)
+                    asm volatile("movntdq %1, %0"
+                                 : "=m"(*(u8x16_aliased*)p)
+                                 : "x"(value));
+                asm volatile("sfence" ::
+                                 : "memory");
+                return dest_ptr;
+            }
+
+            for (; p + 64 <= end; p += 64) {
+                *(u8x16_aliased*)p = value;
+                *(u8x16_aliased*)(p + 16) = value;
+                *(u8x16_aliased*)(p + 32) = value;
+                *(u8x16_aliased*)(p + 48) = value;
+            }
+            for (; p < end; p += 16)
+                *(u8x16_aliased*)p = value;
+            return dest_ptr;
+        }
+
+        /**
+         * @brief compares the needle's first and last byte against 16 candidate
+         *        positions at once and only verifies positions where both match.
+         */
+        SSE2_TARGET void const* memmem(void const* haystack_ptr, size_t haystack_length, void const* needle_ptr, size_t needle_length)
+        {
+            auto const* haystack = (u8 const*)haystack_ptr;
+            auto const* needle = (u8 const*)needle_ptr;
+
+            if (needle_length == 0)
+                return haystack;
+            if (needle_length > haystack_length)
+                return nullptr;
+            if (needle_length == 1)
+                return memchr(haystack, needle[0], haystack_length);
+            if (needle_length > simd_memmem_max_needle)
+                return two_way_memmem(haystack, haystack_length, needle, needle_length);
+
+            auto first = splat(needle[0]);
+            auto last = splat(needle[needle_length - 1]);
+            size_t last_position = haystack_length - needle_length;
+
+            size_t i = 0;
+            for (; i + 16 <= last_position + 1; i += 16) {
+                u32 mask = mask_of(load(haystack + i), first) & mask_of(load(haystack + i + needle_length - 1), last);
+                while (mask) {
+                    size_t candidate = i + __builtin_ctz(mask);
+                    if (Generic::memcmp(haystack + candidate + 1, needle + 1, needle_length - 2) == 0)
+                        return haystack + candidate;
+                    mask &= mask - 1;
+                }
+            }
+
+            for (; i <= last_position; ++i) {
+                if (haystack[i] == needle[0] && Generic::memcmp(haystack + i + 1, needle + 1, needle_length - 1) == 0)
+                    return haystack + i;
+            }
+            return nullptr;
+        }
+
+#    undef SSE2_TARGET
+
+    } // namespace SSE2
+
+    namespace AVX2
+    {
+
+#    define AVX2_TARGET [[gnu::target("avx2")]]
+
+        AVX2_TARGET ALWAYS_INLINE u8x32 splat(u8 c)
+        {
+            return u8x32 { c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c };
+        }
+
+        AVX2_TARGET ALWAYS_INLINE u8x32 load(void const* p)
+        {
+            return *(u8x32_unaligned const*)p;
+        }
+
+        AVX2_TARGET ALWAYS_INLINE u8x32 load_aligned(void const* p)
+        {
+            return *(u8x32_aliased const*)p;
+        }
+
+        AVX2_TARGET ALWAYS_INLINE void store(void* p, u8x32 value)
+        {
+            *(u8x32_unaligned*)p = value;
+        }
+
+        AVX2_TARGET ALWAYS_INLINE u32 mask_of(u8x32 a, u8x32 b)
+        {
+            return (u32)__builtin_ia32_pmovmskb256((c8x32)(a == b));
+        }
+
+        AVX2_TARGET size_t strlen(char const* str)
+        {
+            auto offset = (FlatPtr)str % 32;
+            auto const* p = str - offset;
+            auto zero = splat(0);
+
+            u32 mask = mask_of(load_aligned(p), zero) >> offset;
+            if (mask)
+                return __builtin_ctz(mask);
+
+            for (;;) {
+                p += 32;
+                mask = mask_of(load_aligned(p), zero);
+                if (mask)
+                    return p - str + __builtin_ctz(mask);
+            }
+        }
+
+        AVX2_TARGET void* memchr(void const* ptr, int c, size_t size)
+        {
+            if (!size)
+                return nullptr;
+
+            auto const* start = (u8 const*)ptr;
+            auto offset = (FlatPtr)start % 32;
+            auto const* p = start - offset;
+            auto needle = splat((u8)c);
+
+            u32 mask = mask_of(load_aligned(p), needle) >> offset;
+            size_t scanned = 32 - offset;
+            if (mask) {
+                size_t index = __builtin_ctz(mask);
+                return index < size ? const_cast<u8*>(start + index) : nullptr;
+            }
+
+            while (scanned < size) {
+                p += 32;
+                mask = mask_of(load_aligned(p), needle);
+                if (mask) {
+                    size_t index = scanned + __builtin_ctz(mask);
+                    return index < size ? const_cast<u8*>(start + index) : nullptr;
+                }
+                scanned += 32;
+            }
+            return nullptr;
+        }
+
+        AVX2_TARGET char* strchr(char const* str, int c)
+        {
+            auto offset = (FlatPtr)str % 32;
+            auto const* p = str - offset;
+            auto needle = splat((u8)c);
+            auto zero = splat(0);
+
+            auto block = load_aligned(p);
+            u32 mask = (mask_of(block, needle) | mask_of(block, zero)) >> offset;
+            p += offset;
+
+            while (!mask) {
+                p += 32 - ((FlatPtr)p % 32);
+                block = load_aligned(p);
+                mask = mask_of(block, needle) | mask_of(block, zero);
+            }
+
+            auto const* match = p + __builtin_ctz(mask);
+            return *match == (char)c ? const_cast<char*>(match) : nullptr;
+        }
+
+        AVX2_TARGET int memcmp(void const* v1, void const* v2, size_t n)
+        {
+            auto const* s1 = (u8 const*)v1;
+            auto const* s2 = (u8 const*)v2;
+
+            if (n < 32)
+                return SSE2::memcmp(s1, s2, n);
+
+            size_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                u32 mask = ~mask_of(load(s1 + i), load(s2 + i));
+                if (mask) {
+                    size_t index = i + __builtin_ctz(mask);
+                    return s1[index] < s2[index] ? -1 : 1;
+                }
+            }
+
+            if (i < n) {
+                i = n - 32;
+                u32 mask = ~mask_of(load(s1 + i), load(s2 + i));
+                if (mask) {
+                    size_t index = i + __builtin_ctz(mask);
+                    return s1[index] < s2[index] ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+        AVX2_TARGET ALWAYS_INLINE void copy_forward(u8* dest, u8 const* src, size_t n)
+        {
+            auto tail = load(src + n - 32);
+            size_t i = 0;
+            for (; i + 128 <= n; i += 128) {
+                auto a = load(src + i);
+                auto b = load(src + i + 32);
+                auto c = load(src + i + 64);
+                auto d = load(src + i + 96);
+                store(dest + i, a);
+                store(dest + i + 32, b);
+                store(dest + i + 64, c);
+                store(dest + i + 96, d);
+            }
+            for (; i + 32 <= n; i += 32)
+                store(dest + i, load(src + i));
+            store(dest + n - 32, tail);
+        }
+
+        AVX2_TARGET ALWAYS_INLINE void copy_backward(u8* dest, u8 const* src, size_t n)
+        {
+            auto head = load(src);
+            size_t i = n;
+            while (i > 32) {
+                i -= 32;
+                store(dest + i, load(src + i));
+            }
+            store(dest, head);
+        }
+
+        AVX2_TARGET void* memmove(void* dest_ptr, void const* src_ptr, size_t n)
+        {
+            auto* dest = (u8*)dest_ptr;
+            auto const* src = (u8 const*)src_ptr;
+
+            if (n <= 32) {
+                SSE2::memmove(dest, src, n);
+            } else if (n <= 64) {
+                auto head = load(src);
+                auto tail = load(src + n - 32);
+                store(dest, head);
+                store(dest + n - 32, tail);
+            } else if ((FlatPtr)dest <= (FlatPtr)src || (FlatPtr)dest - (FlatPtr)src >= n) {
+                copy_forward(dest, src, n);
+            } else {
+                copy_backward(dest, src, n);
+            }
+            return dest_ptr;
+        }
+
+        AVX2_TARGET void* memcpy(void* dest_ptr, void const* src_ptr, size_t n)
+        {
+            if (n <= 32)
+                return SSE2::memcpy(dest_ptr, src_ptr, n);
+
+            if (n >= rep_movsb_threshold && s_has_erms) {
+                void* dest = dest_ptr;
+                asm volatile(
+                    "rep movsb"
+                    : "+D"(dest), "+S"(src_ptr), "+c"(n)::"memory");
+                return dest_ptr;
+            }
+
+            auto* dest = (u8*)dest_ptr;
+            auto const* src = (u8 const*)src_ptr;
+            if (n <= 64) {
+                auto head = load(src);
+                auto tail = load(src + n - 32);
+                store(dest, head);
+                store(dest + n - 32, tail);
+            } else {
+                copy_forward(dest, src, n);
+            }
+            return dest_ptr;
+        }
+
+        AVX2_TARGET void* memset(void* dest_ptr, int c, size_t n)
+        {
+            if (n <= 32)
+                return SSE2::memset(dest_ptr, c, n);
+
+            auto* dest = (u8*)dest_ptr;
+            auto value = splat((u8)c);
+            store(dest, value);
+            store(dest + n - 32, value);
+            if (n <= 64)
+                return dest_ptr;
+
+            auto* p = dest + 32 - ((FlatPtr)dest % 32);
+            auto* end = dest + n - 32;
+
+            if (n >= non_temporal_threshold) {
+                for (; p < end; p += 32)
+                    asm volatile("vmovntdq %1, %0"
+                                 : "=m"(*(u8x32_aliased*)p)
+                                 : "x"(value));
+                asm volatile("sfence" ::
+                                 : "memory");
+                return dest_ptr;
+            }
+
+            for (; p + 128 <= end; p += 128) {
+                *(u8x32_aliased*)p = value;
+                *(u8x32_aliased*)(p + 32) = value;
+                *(u8x32_aliased*)(p + 64) = value;
+                *(u8x32_aliased*)(p + 96) = value;
+            }
+            for (; p < end; p += 32)
+                *(u8x32_aliased*)p = value;
+            return dest_ptr;
+        }
+
+        AVX2_TARGET void const* memmem(void const* haystack_ptr, size_t haystack_length, void const* needle_ptr, size_t needle_length)
+        {
+            auto const* haystack = (u8 const*)haystack_ptr;
+            auto const* needle = (u8 const*)needle_ptr;
+
+            if (needle_length <= 1 || needle_length > simd_memmem_max_needle || needle_length > haystack_length)
+                return SSE2::memmem(haystack, haystack_length, needle, needle_length);
+
+            auto first = splat(needle[0]);
+            auto last = splat(needle[needle_length - 1]);
+            size_t last_position = haystack_length - needle_length;
+
+            size_t i = 0;
+            for (; i + 32 <= last_position + 1; i += 32) {
+                u32 mask = mask_of(load(haystack + i), first) & mask_of(load(haystack + i + needle_length - 1), last);
+                while (mask) {
+                    size_t candidate = i + __builtin_ctz(mask);
+                    if (Generic::memcmp(haystack + candidate + 1, needle + 1, needle_length - 2) == 0)
+                        return haystack + candidate;
+                    mask &= mask - 1;
+                }
+            }
+
+            auto const* rest = SSE2::memmem(haystack + i, haystack_length - i, needle, needle_length);
+            return rest;
+        }
+
+#    undef AVX2_TARGET
+
+    } // namespace AVX2
+
+    /**
+     * @param leaf
+     * @param subleaf
+     * @param registers eax, ebx, ecx, edx
+     */
+    void cpuid(u32 leaf, u32 subleaf, u32 (&registers)[4])
+    {
+        asm volatile("cpuid"
+                     : "=a"(registers[0]), "=b"(registers[1]), "=c"(registers[2]), "=d"(registers[3])
+                     : "a"(leaf), "c"(subleaf));
+    }
+
+
+    constexpr StringFunctions sse2_functions = {
+        SSE2::strlen,
+        SSE2::memchr,
+        SSE2::strchr,
+        SSE2::memcmp,
+        SSE2::memcpy,
+        SSE2::memmove,
+        SSE2::memset,
+        SSE2::memmem,
+    };
+
+    constexpr StringFunctions avx2_functions = {
+        AVX2::strlen,
+        AVX2::memchr,
+        AVX2::strchr,
+        AVX2::memcmp,
+        AVX2::memcpy,
+        AVX2::memmove,
+        AVX2::memset,
+        AVX2::memmem,
+    };
+
+    struct CPUFeatures {
+        bool sse2 { false };
+        bool avx2 { false };
+        bool erms { false };
+    };
+
+    /**
+     * @brief AVX2 only counts when XGETBV shows the kernel saves YMM state.
+     *
+     * @return CPUFeatures
+     */
+    CPUFeatures detect_cpu_features()
+    {
+        CPUFeatures features;
+        u32 registers[4];
+        cpuid(0, 0, registers);
+        u32 max_leaf = registers[0];
+
+        cpuid(1, 0, registers);
+        features.sse2 = registers[3] & (1u << 26);
+        bool has_osxsave = registers[2] & (1u << 27);
+        bool has_avx = registers[2] & (1u << 28);
+
+        bool has_avx2 = false;
+        if (max_leaf >= 7) {
+            cpuid(7, 0, registers);
+            has_avx2 = registers[1] & (1u << 5);
+            features.erms = registers[1] & (1u << 9);
+        }
+
+        bool avx_state_enabled = false;
+        if (has_osxsave && has_avx) {
+            u32 xcr0_low;
+            u32 xcr0_high;
+            asm volatile("xgetbv"
+                         : "=a"(xcr0_low), "=d"(xcr0_high)
+                         : "c"(0));
+            avx_state_enabled = (xcr0_low & 0x6) == 0x6;
+        }
+        features.avx2 = has_avx2 && avx_state_enabled;
+        return features;
+    }
+
+#endif
+
+    constexpr StringFunctions generic_functions = {
+        Generic::strlen,
+        Generic::memchr,
+        Generic::strchr,
+        Generic::memcmp,
+        Generic::memcpy,
+        Generic::memmove,
+        Generic::memset,
+        Generic::memmem,
+    };
+
+#if ARCH(X86_64)
+    StringFunctions s_string_functions = sse2_functions;
+#else
+    StringFunctions s_string_functions = generic_functions;
+#endif
+
+} // namespace
+
+extern "C" {
+
+/**
+ * @brief picks the widest implementation this CPU and kernel support. The
+ *        table starts out with the baseline set so anything that runs before
+ *        __libc_init (the dynamic loader, static constructors) is safe.
+ */
+void __string_init()
+{
+#if ARCH(I386) || ARCH(X86_64)
+    auto features = detect_cpu_features();
+    s_has_erms = features.erms;
+    if (features.avx2)
+        s_string_functions = avx2_functions;
+    else if (features.sse2)
+        s_string_functions = sse2_functions;
+#endif
+}
+
+/**
+ * @brief switches every routine to one implementation set, so tests can run
+ *        each set on the same machine. __string_init() goes back to the
+ *        default choice.
+ *
+ * @param name "generic", "sse2" or "avx2"
+ * @return true
+ * @return false if name is unknown or this CPU cannot run that set
+ */
+bool __string_use_implementation(char const* name)
+{
+    if (!strcmp(name, "generic")) {
+        s_string_functions = generic_functions;
+        return true;
+    }
+#if ARCH(I386) || ARCH(X86_64)
+    auto features = detect_cpu_features();
+    if (!strcmp(name, "sse2") && features.sse2) {
+        s_string_functions = sse2_functions;
+        return true;
+    }
+    if (!strcmp(name, "avx2") && features.avx2) {
+        s_string_functions = avx2_functions;
+        return true;
+    }
+#endif
+    return false;
+}
+
+/**
+ * @param str
+ * @return size_t
+ */
+size_t strlen(char const* str)
+{
+    return s_string_functions.strlen(str);
+}
+
+/**
+ * @param ptr
+ * @param c
+ * @param size
+ * @return void*
+ */
+void* memchr(void const* ptr, int c, size_t size)
+{
+    return s_string_functions.memchr(ptr, c, size);
+}
+
+/**
+ * @param str
+ * @param c
+ * @return char*
+ */
+char* strchr(char const* str, int c)
+{
+    return s_string_functions.strchr(str, c);
+}
+
+/**
+ * @param v1
+ * @param v2
+ * @param n
+ * @return int
+ */
+int memcmp(void const* v1, void const* v2, size_t n)
+{
+    return s_string_functions.memcmp(v1, v2, n);
+}
+
+/**
+ * @param dest_ptr
+ * @param src_ptr
+ * @param n
+ * @return void*
+ */
+void* memcpy(void* dest_ptr, void const* src_ptr, size_t n)
+{
+    return s_string_functions.memcpy(dest_ptr, src_ptr, n);
+}
+
+/**
+ * @param dest
+ * @param src
+ * @param n
+ * @return void*
+ */
+void* memmove(void* dest, void const* src, size_t n)
+{
+    return s_string_functions.memmove(dest, src, n);
+}
+
+/**
+ * @param dest_ptr
+ * @param c
+ * @param n
+ * @return void*
+ */
+void* memset(void* dest_ptr, int c, size_t n)
+{
+    return s_string_functions.memset(dest_ptr, c, n);
+}
+
+/**
+ * @param haystack
+ * @param haystack_length
+ * @param needle
+ * @param needle_length
+ * @return void const*
+ */
+void const* memmem(void const* haystack, size_t haystack_length, void const* needle, size_t needle_length)
+{
+    return s_string_functions.memmem(haystack, haystack_length, needle, needle_length);
+}
+
+/**
+ * @param haystack
+ * @param needle
+ * @return char*
+ */
+char* strstr(char const* haystack, char const* needle)
+{
+    if (!needle[0])
+        return const_cast<char*>(haystack);
+
+    haystack = s_string_functions.strchr(haystack, needle[0]);
+    if (!haystack || !needle[1])
+        return const_cast<char*>(haystack);
+
+    size_t needle_length = s_string_functions.strlen(needle);
+    size_t haystack_length = s_string_functions.strlen(haystack);
+    return (char*)s_string_functions.memmem(haystack, haystack_length, needle, needle_length);
+}
+
+}
+
+#pragma GCC diagnostic pop
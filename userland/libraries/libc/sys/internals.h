@@ -19,6 +19,8 @@ typedef void (*AtExitFunction)(void*);
 
 extern void __libc_init(void);
 extern void __malloc_init(void);
+extern void __string_init(void);
+extern bool __string_use_implementation(char const* name);
 extern void __stdio_init(void);
 extern void __begin_atexit_locking(void);
 extern void _init(void);
@@ -500,6 +500,58 @@ static Kernel::TimePage* get_kernel_time_page()
     return s_kernel_time_page;
 }
 
+/**
+ * @brief lfence keeps rdtsc from being hoisted above the read of update1.
+ *
+ * @return u64 
+ */
+static ALWAYS_INLINE u64 read_tsc_ordered()
+{
+    u32 lsw;
+    u32 msw;
+    asm volatile("lfence\n"
+                 "rdtsc"
+                 : "=a"(lsw), "=d"(msw)::"memory");
+    return ((u64)msw << 32) | lsw;
+}
+
+/**
+ * @brief compute a precise clock from the counter parameters in the time
+ *        page. fails if the kernel has not published a usable clock source
+ *        or the counter is outside the range the parameters cover, e.g.
+ *        because this cpu's TSC lags the one the kernel sampled.
+ *
+ * @param kernel_time_page 
+ * @param clock_id 
+ * @param ts 
+ * @return true 
+ * @return false 
+ */
+static bool read_high_resolution_clock(Kernel::TimePage const& kernel_time_page, clockid_t clock_id, struct timespec& ts)
+{
+    u32 update_iteration;
+    do {
+        update_iteration = Mods::atomic_load(&kernel_time_page.update1, Mods::memory_order_acquire);
+        if (kernel_time_page.clock_source != (u32)Kernel::TimePageClockSource::TSC)
+            return false;
+
+        u64 delta = read_tsc_ordered() - kernel_time_page.counter_base;
+        if (delta > kernel_time_page.counter_max_delta)
+            return false;
+
+        u64 nanoseconds = (delta * kernel_time_page.counter_multiplier) >> kernel_time_page.counter_shift;
+        ts = clock_id == CLOCK_REALTIME ? kernel_time_page.realtime_base : kernel_time_page.monotonic_base;
+        ts.tv_sec += nanoseconds / 1'000'000'000;
+        ts.tv_nsec += nanoseconds % 1'000'000'000;
+    } while (update_iteration != Mods::atomic_load(&kernel_time_page.update2, Mods::memory_order_acquire));
+
+    if (ts.tv_nsec >= 1'000'000'000) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1'000'000'000;
+    }
+    return true;
+}
+
 /**
  * @param clock_id 
  * @param ts 
@@ -507,6 +559,18 @@ static Kernel::TimePage* get_kernel_time_page()
  */
 int clock_gettime(clockid_t clock_id, struct timespec* ts)
 {
+    if (Kernel::time_page_supports_high_resolution(clock_id)) {
+        if (!ts) {
+            errno = EFAULT;
+            return -1;
+        }
+
+        if (auto* kernel_time_page = get_kernel_time_page()) {
+            if (read_high_resolution_clock(*kernel_time_page, clock_id, *ts))
+                return 0;
+        }
+    }
+
     if (Kernel::time_page_supports(clock_id)) {
         if (!ts) {
             errno = EFAULT;
@@ -0,0 +1,226 @@
+/**
+ * @file bitboard.cpp
+ * @author Krisna Pranav
+ * @brief bitboard
+ * @version 6.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ * 
+ */
+
+#include <mods/assertions.h>
+#include <mods/vector.h>
+#include <libchess/bitboard.h>
+
+namespace Chess::Bitboards 
+{
+
+    constinit Tables Detail::s_tables {};
+
+    namespace 
+    {
+
+        class Xorshift 
+        {
+        public:
+            /**
+             * @return u64 
+             */
+            u64 next()
+            {
+                m_state ^= m_state >> 12;
+                m_state ^= m_state << 25;
+                m_state ^= m_state >> 27;
+                return m_state * 2685821657736338717ull;
+            }
+
+            /**
+             * @return u64 
+             */
+            u64 next_sparse()
+            {
+                return next() & next() & next();
+            }
+
+        private:
+            u64 m_state { 0x9e3779b97f4a7c15ull };
+        }; // class Xorshift
+
+        /**
+         * @param square 
+         * @param directions 
+         * @param occupancy 
+         * @param stop_before_edge 
+         * @return u64 
+         */
+        u64 slide(u8 square, int const (&directions)[4][2], u64 occupancy, bool stop_before_edge)
+        {
+            u64 result = 0;
+            int rank = square / 8;
+            int file = square % 8;
+
+            for (auto const& direction : directions) {
+                int r = rank + direction[0];
+                int f = file + direction[1];
+                while (r >= 0 && r < 8 && f >= 0 && f < 8) {
+                    int next_r = r + direction[0];
+                    int next_f = f + direction[1];
+                    if (stop_before_edge && (next_r < 0 || next_r >= 8 || next_f < 0 || next_f >= 8))
+                        break;
+
+                    auto bit = square_bit(r * 8 + f);
+                    result |= bit;
+                    if (occupancy & bit)
+                        break;
+
+                    r = next_r;
+                    f = next_f;
+                }
+            }
+
+            return result;
+        }
+
+        constexpr int bishop_directions[4][2] = { { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+        constexpr int rook_directions[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+
+        /**
+         * @param square 
+         * @param offsets 
+         * @return u64 
+         */
+        u64 leaper_attacks(u8 square, int const (&offsets)[8][2])
+        {
+            u64 result = 0;
+            int rank = square / 8;
+            int file = square % 8;
+
+            for (auto const& offset : offsets) {
+                int r = rank + offset[0];
+                int f = file + offset[1];
+                if (r >= 0 && r < 8 && f >= 0 && f < 8)
+                    result |= square_bit(r * 8 + f);
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief fills one slider's attack table for a square; without BMI2 this also
+         *        searches for a collision-free magic multiplier.
+         * 
+         * @param square 
+         * @param directions 
+         * @param mask 
+         * @param magic 
+         * @param shift 
+         * @param attacks 
+         * @param random 
+         */
+        void initialize_slider(u8 square, int const (&directions)[4][2], u64 mask, u64& magic, u8& shift, u64* attacks, [[maybe_unused]] Xorshift& random)
+        {
+            auto bits = popcount(mask);
+            size_t subset_count = 1ull << bits;
+            shift = static_cast<u8>(64 - bits);
+
+            Vector<u64> occupancies;
+            Vector<u64> references;
+            occupancies.ensure_capacity(subset_count);
+            references.ensure_capacity(subset_count);
+
+            u64 subset = 0;
+            do {
+                occupancies.unchecked_append(subset);
+                references.unchecked_append(slide(square, directions, subset, false));
+                subset = (subset - mask) & mask;
+            } while (subset);
+
+#if defined(__BMI2__)
+            magic = 0;
+            for (size_t i = 0; i < subset_count; ++i)
+                attacks[_pext_u64(occupancies[i], mask)] = references[i];
+#else
+            Vector<u32> epochs;
+            epochs.resize(subset_count);
+            u32 epoch = 0;
+
+            for (;;) {
+                auto candidate = random.next_sparse();
+                if (popcount((mask * candidate) & 0xff00000000000000ull) < 6)
+                    continue;
+
+                ++epoch;
+                bool collided = false;
+                for (size_t i = 0; i < subset_count && !collided; ++i) {
+                    auto index = (occupancies[i] * candidate) >> shift;
+                    if (epochs[index] != epoch) {
+                        epochs[index] = epoch;
+                        attacks[index] = references[i];
+                    } else if (attacks[index] != references[i]) {
+                        collided = true;
+                    }
+                }
+
+                if (!collided) {
+                    magic = candidate;
+                    return;
+                }
+            }
+#endif
+        }
+
+        /**
+         * @param t 
+         */
+        void initialize_tables(Tables& t)
+        {
+            Xorshift random;
+
+            constexpr int knight_offsets[8][2] = { { 2, 1 }, { 2, -1 }, { -2, 1 }, { -2, -1 }, { 1, 2 }, { 1, -2 }, { -1, 2 }, { -1, -2 } };
+            constexpr int king_offsets[8][2] = { { 1, 1 }, { 1, 0 }, { 1, -1 }, { 0, 1 }, { 0, -1 }, { -1, 1 }, { -1, 0 }, { -1, -1 } };
+
+            for (u8 square = 0; square < 64; ++square) {
+                t.knight_attacks[square] = leaper_attacks(square, knight_offsets);
+                t.king_attacks[square] = leaper_attacks(square, king_offsets);
+
+                u64 bit = square_bit(square);
+                t.pawn_attacks[0][square] = ((bit << 7) & ~0x8080808080808080ull) | ((bit << 9) & ~0x0101010101010101ull);
+                t.pawn_attacks[1][square] = ((bit >> 9) & ~0x8080808080808080ull) | ((bit >> 7) & ~0x0101010101010101ull);
+
+                t.bishop_masks[square] = slide(square, bishop_directions, 0, true);
+                t.rook_masks[square] = slide(square, rook_directions, 0, true);
+
+                initialize_slider(square, bishop_directions, t.bishop_masks[square], t.bishop_magics[square], t.bishop_shifts[square], t.bishop_attacks[square], random);
+                initialize_slider(square, rook_directions, t.rook_masks[square], t.rook_magics[square], t.rook_shifts[square], t.rook_attacks[square], random);
+            }
+
+            for (auto& color : t.zobrist_pieces) {
+                for (auto& type : color) {
+                    for (auto& key : type)
+                        key = random.next();
+                }
+            }
+
+            for (auto& key : t.zobrist_castling)
+                key = random.next();
+
+            for (auto& key : t.zobrist_en_passant)
+                key = random.next();
+
+            t.zobrist_side = random.next();
+        }
+
+        /**
+         * @brief fills s_tables when the library is loaded, so the accessors
+         *        never pay for a first-use guard.
+         * 
+         */
+        [[gnu::constructor]] void fill_tables()
+        {
+            initialize_tables(Detail::s_tables);
+        }
+
+    } // namespace
+
+} // namespace Chess::Bitboards
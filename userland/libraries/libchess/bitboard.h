@@ -0,0 +1,124 @@
+/**
+ * @file bitboard.h
+ * @author Krisna Pranav
+ * @brief bitboard
+ * @version 6.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ * 
+ */
+
+#pragma once
+
+#include <mods/builtinwrappers.h>
+#include <mods/platform.h>
+#include <mods/types.h>
+
+#if defined(__BMI2__)
+#    include <immintrin.h>
+#endif
+
+namespace Chess::Bitboards 
+{
+
+    struct Tables 
+    {
+        u64 pawn_attacks[2][64];
+        u64 knight_attacks[64];
+        u64 king_attacks[64];
+
+        u64 bishop_masks[64];
+        u64 rook_masks[64];
+        u64 bishop_magics[64];
+        u64 rook_magics[64];
+        u8 bishop_shifts[64];
+        u8 rook_shifts[64];
+
+        u64 bishop_attacks[64][512];
+        u64 rook_attacks[64][4096];
+
+        u64 zobrist_pieces[2][6][64];
+        u64 zobrist_castling[16];
+        u64 zobrist_en_passant[8];
+        u64 zobrist_side;
+    }; // struct Tables
+
+    namespace Detail 
+    {
+        extern constinit Tables s_tables;
+    } // namespace Detail
+
+    /**
+     * @brief the attack and Zobrist tables, filled in when the library is loaded.
+     * 
+     * @return Tables const& 
+     */
+    ALWAYS_INLINE Tables const& tables()
+    {
+        return Detail::s_tables;
+    }
+
+    /**
+     * @param square 
+     * @return constexpr u64 
+     */
+    constexpr u64 square_bit(u8 square)
+    {
+        return 1ull << square;
+    }
+
+    /**
+     * @brief pops the lowest set square off a bitboard.
+     * 
+     * @param bitboard 
+     * @return u8 
+     */
+    ALWAYS_INLINE u8 pop_lowest_square(u64& bitboard)
+    {
+        auto square = static_cast<u8>(count_trailing_zeroes(bitboard));
+        bitboard &= bitboard - 1;
+        return square;
+    }
+
+    /**
+     * @param square 
+     * @param occupancy 
+     * @return u64 
+     */
+    ALWAYS_INLINE u64 bishop_attacks(u8 square, u64 occupancy)
+    {
+        auto const& t = tables();
+#if defined(__BMI2__)
+        return t.bishop_attacks[square][_pext_u64(occupancy, t.bishop_masks[square])];
+#else
+        return t.bishop_attacks[square][((occupancy & t.bishop_masks[square]) * t.bishop_magics[square]) >> t.bishop_shifts[square]];
+#endif
+    }
+
+    /**
+     * @param square 
+     * @param occupancy 
+     * @return u64 
+     */
+    ALWAYS_INLINE u64 rook_attacks(u8 square, u64 occupancy)
+    {
+        auto const& t = tables();
+#if defined(__BMI2__)
+        return t.rook_attacks[square][_pext_u64(occupancy, t.rook_masks[square])];
+#else
+        return t.rook_attacks[square][((occupancy & t.rook_masks[square]) * t.rook_magics[square]) >> t.rook_shifts[square]];
+#endif
+    }
+
+    /**
+     * @param square 
+     * @param occupancy 
+     * @return u64 
+     */
+    ALWAYS_INLINE u64 queen_attacks(u8 square, u64 occupancy)
+    {
+        return bishop_attacks(square, occupancy) | rook_attacks(square, occupancy);
+    }
+
+} // namespace Chess::Bitboards
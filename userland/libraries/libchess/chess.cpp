@@ -10,6 +10,7 @@
  */
 
 #include <mods/assertions.h>
+#include <mods/numericlimits.h>
 #include <mods/string.h>
 #include <mods/stringbuilder.h>
 #include <mods/vector.h>
@@ -337,11 +338,11 @@ namespace Chess
         VERIFY(m_turn != Color::None);
         builder.append(m_turn == Color::White ? " w " : " b ");
 
-        builder.append(m_white_can_castle_kingside ? "K" : "");
-        builder.append(m_white_can_castle_queenside ? "Q" : "");
-        builder.append(m_black_can_castle_kingside ? "k" : "");
-        builder.append(m_black_can_castle_queenside ? "q" : "");
-        builder.append(" ");
+        builder.append((m_castling_rights & WhiteKingside) ? "K" : "");
+        builder.append((m_castling_rights & WhiteQueenside) ? "Q" : "");
+        builder.append((m_castling_rights & BlackKingside) ? "k" : "");
+        builder.append((m_castling_rights & BlackQueenside) ? "q" : "");
+        builder.append(m_castling_rights ? " " : "- ");
 
         if (!m_last_move.has_value())
             builder.append("-");
@@ -365,6 +366,107 @@ namespace Chess
         return builder.to_string();
     }
 
+    /**
+     * @param fen 
+     * @return Optional<Board> 
+     */
+    Optional<Board> Board::from_fen(StringView fen)
+    {
+        auto fields = fen.split_view(' ');
+        if (fields.size() < 4 || fields.size() > 6)
+            return {};
+
+        Board board;
+        Square::for_each([&](Square const& square) {
+            board.set_piece(square, EmptyPiece);
+            return IterationDecision::Continue;
+        });
+
+        auto ranks = fields[0].split_view('/', true);
+        if (ranks.size() != 8)
+            return {};
+        for (int rank = 0; rank < 8; ++rank) {
+            int file = 0;
+            for (auto c : ranks[7 - rank]) {
+                if (c >= '1' && c <= '8') {
+                    file += c - '0';
+                    continue;
+                }
+                auto type = piece_for_char_promotion(StringView(&c, 1));
+                if (type == Type::None && c != 'p' && c != 'P')
+                    return {};
+                if (type == Type::None)
+                    type = Type::Pawn;
+                if (file >= 8)
+                    return {};
+                board.set_piece({ rank, file++ }, { c >= 'a' ? Color::Black : Color::White, type });
+            }
+            if (file != 8)
+                return {};
+        }
+        if (popcount(board.pieces(Color::White, Type::King)) != 1 || popcount(board.pieces(Color::Black, Type::King)) != 1)
+            return {};
+
+        if (fields[1] == "w")
+            board.m_turn = Color::White;
+        else if (fields[1] == "b")
+            board.m_turn = Color::Black;
+        else
+            return {};
+
+        board.m_castling_rights = 0;
+        if (fields[2] != "-") {
+            for (auto c : fields[2]) {
+                switch (c) {
+                case 'K':
+                    board.m_castling_rights |= WhiteKingside;
+                    break;
+                case 'Q':
+                    board.m_castling_rights |= WhiteQueenside;
+                    break;
+                case 'k':
+                    board.m_castling_rights |= BlackKingside;
+                    break;
+                case 'q':
+                    board.m_castling_rights |= BlackQueenside;
+                    break;
+                default:
+                    return {};
+                }
+            }
+        }
+
+        // the board tracks en passant through the double push that allows it
+        if (fields[3] != "-") {
+            auto target = fields[3];
+            if (target.length() != 2 || target[0] < 'a' || target[0] > 'h' || (target[1] != '3' && target[1] != '6'))
+                return {};
+            int file = target[0] - 'a';
+            bool white_pushed = target[1] == '3';
+            if (board.m_turn != (white_pushed ? Color::Black : Color::White))
+                return {};
+            Piece pawn { white_pushed ? Color::White : Color::Black, Type::Pawn };
+            Square to { white_pushed ? 3 : 4, file };
+            if (board.get_piece(to) != pawn)
+                return {};
+            Move push({ white_pushed ? 1 : 6, file }, to);
+            push.piece = pawn;
+            board.m_last_move = push;
+        }
+
+        if (fields.size() > 4) {
+            auto halfmove = fields[4].to_uint();
+            if (!halfmove.has_value() || halfmove.value() > NumericLimits<short>::max())
+                return {};
+            board.m_moves_since_capture = halfmove.value();
+            board.m_moves_since_pawn_advance = halfmove.value();
+        }
+        if (fields.size() > 5 && !fields[5].to_uint().has_value())
+            return {};
+
+        return board;
+    }
+
     /**
      * @param square 
      * @return Piece 
@@ -383,7 +485,25 @@ namespace Chess
     Piece Board::set_piece(Square const& square, Piece const& piece)
     {
         VERIFY(square.in_bounds());
-        return m_board[square.rank][square.file] = piece;
+
+        auto const& tables = Bitboards::tables();
+        auto index = square.index();
+        auto bit = Bitboards::square_bit(index);
+
+        auto& previous = m_board[square.rank][square.file];
+        if (previous.color != Color::None && previous.type != Type::None) {
+            m_bitboards[to_underlying(previous.color)][to_underlying(previous.type)] &= ~bit;
+            m_occupancy[to_underlying(previous.color)] &= ~bit;
+            m_piece_key ^= tables.zobrist_pieces[to_underlying(previous.color)][to_underlying(previous.type)][index];
+        }
+
+        if (piece.color != Color::None && piece.type != Type::None) {
+            m_bitboards[to_underlying(piece.color)][to_underlying(piece.type)] |= bit;
+            m_occupancy[to_underlying(piece.color)] |= bit;
+            m_piece_key ^= tables.zobrist_pieces[to_underlying(piece.color)][to_underlying(piece.type)][index];
+        }
+
+        return previous = piece;
     }
 
     /**
@@ -434,36 +554,76 @@ namespace Chess
         if (!is_legal_promotion(move, color))
             return false;
 
-        Board clone = *this;
-        clone.apply_illegal_move(move, color);
-        if (clone.in_check(color))
+        if (leaves_king_in_check(move, color))
             return false;
 
-        Vector<Square> check_squares;
-        if (color == Color::White && move.from == Square("e1") && get_piece(Square("e1")) == Piece(Color::White, Type::King)) {
-            if (move.to == Square("a1") || move.to == Square("c1")) {
-                check_squares = { Square("e1"), Square("d1"), Square("c1") };
-            } else if (move.to == Square("h1") || move.to == Square("g1")) {
-                check_squares = { Square("e1"), Square("f1"), Square("g1") };
-            }
-        } else if (color == Color::Black && move.from == Square("e8") && get_piece(Square("e8")) == Piece(Color::Black, Type::King)) {
-            if (move.to == Square("a8") || move.to == Square("c8")) {
-                check_squares = { Square("e8"), Square("d8"), Square("c8") };
-            } else if (move.to == Square("h8") || move.to == Square("g8")) {
-                check_squares = { Square("e8"), Square("f8"), Square("g8") };
+        if (is_castling_move(move, color)) {
+            int step = (move.to.file < move.from.file) ? -1 : 1;
+            for (int file = move.from.file; file != move.from.file + 3 * step; file += step) {
+                if (is_square_attacked(Square(move.from.rank, file).index(), opposing_color(color)))
+                    return false;
             }
         }
-        for (auto& square : check_squares) {
-            Board clone = *this;
-            clone.set_piece(move.from, EmptyPiece);
-            clone.set_piece(square, { color, Type::King });
-            if (clone.in_check(color))
-                return false;
-        }
 
         return true;
     }
 
+    /**
+     * @param move 
+     * @param color 
+     * @return true 
+     * @return false 
+     */
+    bool Board::is_castling_move(Move const& move, Color color) const
+    {
+        int home_rank = (color == Color::White) ? 0 : 7;
+
+        if (move.from != Square(home_rank, 4) || move.to.rank != home_rank)
+            return false;
+
+        if (get_piece(move.from) != Piece(color, Type::King))
+            return false;
+
+        return move.to.file == 0 || move.to.file == 2 || move.to.file == 6 || move.to.file == 7;
+    }
+
+    /**
+     * @param move 
+     * @param color 
+     * @return true 
+     * @return false 
+     */
+    bool Board::leaves_king_in_check(Move const& move, Color color) const
+    {
+        auto king = pieces(color, Type::King);
+        if (!king)
+            return false;
+
+        auto moved = get_piece(move.from);
+        auto from_bit = Bitboards::square_bit(move.from.index());
+        auto to_bit = Bitboards::square_bit(move.to.index());
+        auto occupied = (m_occupancy[0] | m_occupancy[1]) & ~from_bit;
+        u64 captured = 0;
+
+        if (is_castling_move(move, color)) {
+            bool queenside = move.to.file < move.from.file;
+            int rank = move.from.rank;
+            to_bit = Bitboards::square_bit(Square(rank, queenside ? 2 : 6).index());
+            occupied &= ~Bitboards::square_bit(Square(rank, queenside ? 0 : 7).index());
+            occupied |= to_bit | Bitboards::square_bit(Square(rank, queenside ? 3 : 5).index());
+        } else {
+            captured = to_bit;
+            if (moved.type == Type::Pawn && move.from.file != move.to.file && get_piece(move.to).type == Type::None)
+                captured = Bitboards::square_bit(Square(move.from.rank, move.to.file).index());
+            occupied = (occupied & ~captured) | to_bit;
+        }
+
+        if (moved.type == Type::King)
+            king = to_bit;
+
+        return is_square_attacked(static_cast<u8>(count_trailing_zeroes(king)), opposing_color(color), occupied, captured);
+    }
+
     /**
      * @param move 
      * @param color 
@@ -482,15 +642,15 @@ namespace Chess
 
         if (piece.type == Type::King) {
             if (color == Color::White) {
-                if ((move.to == Square("a1") || move.to == Square("c1")) && m_white_can_castle_queenside && get_piece(Square("b1")).type == Type::None && get_piece(Square("c1")).type == Type::None && get_piece(Square("d1")).type == Type::None) {
+                if ((move.to == Square("a1") || move.to == Square("c1")) && (m_castling_rights & WhiteQueenside) && get_piece(Square("b1")).type == Type::None && get_piece(Square("c1")).type == Type::None && get_piece(Square("d1")).type == Type::None) {
                     return true;
-                } else if ((move.to == Square("h1") || move.to == Square("g1")) && m_white_can_castle_kingside && get_piece(Square("f1")).type == Type::None && get_piece(Square("g1")).type == Type::None) {
+                } else if ((move.to == Square("h1") || move.to == Square("g1")) && (m_castling_rights & WhiteKingside) && get_piece(Square("f1")).type == Type::None && get_piece(Square("g1")).type == Type::None) {
                     return true;
                 }
             } else {
-                if ((move.to == Square("a8") || move.to == Square("c8")) && m_black_can_castle_queenside && get_piece(Square("b8")).type == Type::None && get_piece(Square("c8")).type == Type::None && get_piece(Square("d8")).type == Type::None) {
+                if ((move.to == Square("a8") || move.to == Square("c8")) && (m_castling_rights & BlackQueenside) && get_piece(Square("b8")).type == Type::None && get_piece(Square("c8")).type == Type::None && get_piece(Square("d8")).type == Type::None) {
                     return true;
-                } else if ((move.to == Square("h8") || move.to == Square("g8")) && m_black_can_castle_kingside && get_piece(Square("f8")).type == Type::None && get_piece(Square("g8")).type == Type::None) {
+                } else if ((move.to == Square("h8") || move.to == Square("g8")) && (m_castling_rights & BlackKingside) && get_piece(Square("f8")).type == Type::None && get_piece(Square("g8")).type == Type::None) {
                     return true;
                 }
             }
@@ -592,25 +752,343 @@ namespace Chess
      */
     bool Board::in_check(Color color) const
     {
-        Square king_square = { 50, 50 };
-        Square::for_each([&](Square const& square) {
-            if (get_piece(square) == Piece(color, Type::King)) {
-                king_square = square;
-                return IterationDecision::Break;
+        auto king = pieces(color, Type::King);
+        if (!king)
+            return false;
+
+        return is_square_attacked(static_cast<u8>(count_trailing_zeroes(king)), opposing_color(color));
+    }
+
+    /**
+     * @param square 
+     * @param by 
+     * @return true 
+     * @return false 
+     */
+    bool Board::is_square_attacked(u8 square, Color by) const
+    {
+        return is_square_attacked(square, by, m_occupancy[0] | m_occupancy[1], 0);
+    }
+
+    /**
+     * @param square 
+     * @param by 
+     * @param occupied 
+     * @param captured 
+     * @return true 
+     * @return false 
+     */
+    bool Board::is_square_attacked(u8 square, Color by, u64 occupied, u64 captured) const
+    {
+        auto const& tables = Bitboards::tables();
+        auto defender = (by == Color::White) ? Color::Black : Color::White;
+        auto attackers = [&](Type type) { return pieces(by, type) & ~captured; };
+
+        if (tables.pawn_attacks[to_underlying(defender)][square] & attackers(Type::Pawn))
+            return true;
+        if (tables.knight_attacks[square] & attackers(Type::Knight))
+            return true;
+        if (tables.king_attacks[square] & attackers(Type::King))
+            return true;
+        if (Bitboards::bishop_attacks(square, occupied) & (attackers(Type::Bishop) | attackers(Type::Queen)))
+            return true;
+        if (Bitboards::rook_attacks(square, occupied) & (attackers(Type::Rook) | attackers(Type::Queen)))
+            return true;
+
+        return false;
+    }
+
+    /**
+     * @param moves 
+     * @param color 
+     */
+    void Board::generate_pseudo_legal_moves(Vector<Move, 256>& moves, Color color) const
+    {
+        auto const& tables = Bitboards::tables();
+        auto us = to_underlying(color);
+        auto own = m_occupancy[us];
+        auto enemy = m_occupancy[1 - us];
+        auto occupied = own | enemy;
+
+        auto add_moves = [&](u8 from, u64 targets) {
+            while (targets) {
+                auto to = Bitboards::pop_lowest_square(targets);
+                moves.append({ Square::from_index(from), Square::from_index(to) });
             }
-            return IterationDecision::Continue;
-        });
+        };
 
-        bool check = false;
-        Square::for_each([&](Square const& square) {
-            if (is_legal_no_check({ square, king_square }, opposing_color(color))) {
-                check = true;
-                return IterationDecision::Break;
+        int dir = (color == Color::White) ? 1 : -1;
+        int start_rank = (color == Color::White) ? 1 : 6;
+        int promotion_rank = (color == Color::White) ? 7 : 0;
+        int en_passant_rank = (color == Color::White) ? 4 : 3;
+
+        auto add_pawn_move = [&](Square from, Square to) {
+            if (to.rank == promotion_rank) {
+                for (auto type : { Type::Knight, Type::Bishop, Type::Rook, Type::Queen })
+                    moves.append({ from, to, type });
+            } else {
+                moves.append({ from, to });
             }
-            return IterationDecision::Continue;
-        });
+        };
+
+        Optional<int> en_passant_file;
+        if (m_last_move.has_value()) {
+            auto const& last = m_last_move.value();
+            int other_start_rank = (color == Color::White) ? 6 : 1;
+            if (last.from.rank == other_start_rank && last.to.rank == en_passant_rank && last.from.file == last.to.file
+                && get_piece(last.to) == Piece(opposing_color(color), Type::Pawn))
+                en_passant_file = last.to.file;
+        }
+
+        auto pawns = pieces(color, Type::Pawn);
+        while (pawns) {
+            auto from_index = Bitboards::pop_lowest_square(pawns);
+            auto from = Square::from_index(from_index);
+
+            Square one_step { from.rank + dir, from.file };
+            if (one_step.in_bounds() && !(occupied & Bitboards::square_bit(one_step.index()))) {
+                add_pawn_move(from, one_step);
+
+                Square two_step { from.rank + 2 * dir, from.file };
+                if (from.rank == start_rank && !(occupied & Bitboards::square_bit(two_step.index())))
+                    moves.append({ from, two_step });
+            }
+
+            auto captures = tables.pawn_attacks[us][from_index] & enemy;
+            while (captures)
+                add_pawn_move(from, Square::from_index(Bitboards::pop_lowest_square(captures)));
+
+            if (en_passant_file.has_value() && from.rank == en_passant_rank && abs(from.file - en_passant_file.value()) == 1)
+                moves.append({ from, { from.rank + dir, en_passant_file.value() } });
+        }
+
+        auto knights = pieces(color, Type::Knight);
+        while (knights) {
+            auto from = Bitboards::pop_lowest_square(knights);
+            add_moves(from, tables.knight_attacks[from] & ~own);
+        }
+
+        auto diagonal_sliders = pieces(color, Type::Bishop) | pieces(color, Type::Queen);
+        while (diagonal_sliders) {
+            auto from = Bitboards::pop_lowest_square(diagonal_sliders);
+            add_moves(from, Bitboards::bishop_attacks(from, occupied) & ~own);
+        }
+
+        auto orthogonal_sliders = pieces(color, Type::Rook) | pieces(color, Type::Queen);
+        while (orthogonal_sliders) {
+            auto from = Bitboards::pop_lowest_square(orthogonal_sliders);
+            add_moves(from, Bitboards::rook_attacks(from, occupied) & ~own);
+        }
+
+        auto kings = pieces(color, Type::King);
+        while (kings) {
+            auto from = Bitboards::pop_lowest_square(kings);
+            add_moves(from, tables.king_attacks[from] & ~own);
+
+            int home_rank = (color == Color::White) ? 0 : 7;
+            if (from != Square(home_rank, 4).index())
+                continue;
+
+            auto is_empty = [&](int file) {
+                return !(occupied & Bitboards::square_bit(Square(home_rank, file).index()));
+            };
+
+            auto kingside = (color == Color::White) ? WhiteKingside : BlackKingside;
+            auto queenside = (color == Color::White) ? WhiteQueenside : BlackQueenside;
+
+            if ((m_castling_rights & queenside) && is_empty(1) && is_empty(2) && is_empty(3))
+                moves.append({ Square(home_rank, 4), Square(home_rank, 2) });
+            if ((m_castling_rights & kingside) && is_empty(5) && is_empty(6))
+                moves.append({ Square(home_rank, 4), Square(home_rank, 6) });
+        }
+    }
+
+    /**
+     * @param moves 
+     * @param color 
+     */
+    void Board::generate_legal_moves(Vector<Move, 256>& moves, Color color) const
+    {
+        if (color == Color::None)
+            color = turn();
 
-        return check;
+        generate_pseudo_legal_moves(moves, color);
+
+        size_t legal_count = 0;
+        for (size_t i = 0; i < moves.size(); ++i) {
+            auto const& move = moves[i];
+            if (leaves_king_in_check(move, color))
+                continue;
+
+            if (is_castling_move(move, color)) {
+                int step = (move.to.file < move.from.file) ? -1 : 1;
+                bool passes_through_check = false;
+                for (int file = move.from.file; file != move.from.file + 3 * step; file += step) {
+                    if (is_square_attacked(Square(move.from.rank, file).index(), opposing_color(color))) {
+                        passes_through_check = true;
+                        break;
+                    }
+                }
+                if (passes_through_check)
+                    continue;
+            }
+
+            moves[legal_count++] = move;
+        }
+
+        moves.shrink(legal_count);
+    }
+
+    /**
+     * @param move 
+     * @return Board::UndoState 
+     */
+    Board::UndoState Board::make_move(Move const& move)
+    {
+        auto moved = get_piece(move.from);
+        auto color = moved.color;
+
+        UndoState undo {
+            move,
+            moved,
+            EmptyPiece,
+            move.to,
+            m_last_move,
+            m_castling_rights,
+            m_moves_since_capture,
+            m_moves_since_pawn_advance,
+            is_castling_move(move, color),
+        };
+
+        m_turn = opposing_color(color);
+        m_last_move = move;
+        m_last_move.value().piece = moved;
+        m_moves_since_capture++;
+        m_moves_since_pawn_advance++;
+
+        auto revoke_rights_touching = [&](Square const& square) {
+            if (square == Square(0, 0) || square == Square(0, 4))
+                m_castling_rights &= ~WhiteQueenside;
+            if (square == Square(0, 7) || square == Square(0, 4))
+                m_castling_rights &= ~WhiteKingside;
+            if (square == Square(7, 0) || square == Square(7, 4))
+                m_castling_rights &= ~BlackQueenside;
+            if (square == Square(7, 7) || square == Square(7, 4))
+                m_castling_rights &= ~BlackKingside;
+        };
+        revoke_rights_touching(move.from);
+        if (move.to.file == 0 || move.to.file == 7)
+            revoke_rights_touching(move.to);
+
+        if (undo.is_castling) {
+            bool queenside = move.to.file < move.from.file;
+            int rank = move.from.rank;
+            set_piece(move.from, EmptyPiece);
+            set_piece({ rank, queenside ? 0 : 7 }, EmptyPiece);
+            set_piece({ rank, queenside ? 2 : 6 }, { color, Type::King });
+            set_piece({ rank, queenside ? 3 : 5 }, { color, Type::Rook });
+            return undo;
+        }
+
+        if (moved.type == Type::Pawn)
+            m_moves_since_pawn_advance = 0;
+
+        if (moved.type == Type::Pawn && move.from.file != move.to.file && get_piece(move.to).type == Type::None) {
+            undo.captured_square = { move.from.rank, move.to.file };
+        }
+
+        undo.captured = get_piece(undo.captured_square);
+        if (undo.captured.color != Color::None) {
+            m_moves_since_capture = 0;
+            set_piece(undo.captured_square, EmptyPiece);
+        }
+
+        set_piece(move.from, EmptyPiece);
+
+        if (moved.type == Type::Pawn && ((color == Color::Black && move.to.rank == 0) || (color == Color::White && move.to.rank == 7)))
+            set_piece(move.to, { color, move.promote_to });
+        else
+            set_piece(move.to, moved);
+
+        return undo;
+    }
+
+    /**
+     * @param undo 
+     */
+    void Board::unmake_move(UndoState const& undo)
+    {
+        auto const& move = undo.move;
+        auto color = undo.moved.color;
+
+        if (undo.is_castling) {
+            bool queenside = move.to.file < move.from.file;
+            int rank = move.from.rank;
+            set_piece({ rank, queenside ? 2 : 6 }, EmptyPiece);
+            set_piece({ rank, queenside ? 3 : 5 }, EmptyPiece);
+            set_piece({ rank, queenside ? 0 : 7 }, { color, Type::Rook });
+        } else {
+            set_piece(move.to, EmptyPiece);
+            if (undo.captured.color != Color::None)
+                set_piece(undo.captured_square, undo.captured);
+        }
+
+        set_piece(move.from, undo.moved);
+
+        m_turn = color;
+        m_last_move = undo.last_move;
+        m_castling_rights = undo.castling_rights;
+        m_moves_since_capture = undo.moves_since_capture;
+        m_moves_since_pawn_advance = undo.moves_since_pawn_advance;
+    }
+
+    /**
+     * @param depth 
+     * @return u64 
+     */
+    u64 Board::perft(u32 depth)
+    {
+        if (depth == 0)
+            return 1;
+
+        Vector<Move, 256> moves;
+        generate_legal_moves(moves);
+
+        if (depth == 1)
+            return moves.size();
+
+        u64 nodes = 0;
+        for (auto const& move : moves) {
+            auto undo = make_move(move);
+            nodes += perft(depth - 1);
+            unmake_move(undo);
+        }
+
+        return nodes;
+    }
+
+    /**
+     * @return u64 
+     */
+    u64 Board::zobrist_key() const
+    {
+        auto const& tables = Bitboards::tables();
+        auto key = m_piece_key ^ tables.zobrist_castling[m_castling_rights];
+
+        if (m_turn == Color::Black)
+            key ^= tables.zobrist_side;
+
+        if (m_last_move.has_value()) {
+            auto const& last = m_last_move.value();
+            if (last.piece.type == Type::Pawn && abs(last.to.rank - last.from.rank) == 2) {
+                // only a capturable double push changes the position for repetition purposes
+                Square passed { (last.from.rank + last.to.rank) / 2, last.to.file };
+                if (tables.pawn_attacks[to_underlying(last.piece.color)][passed.index()] & pieces(m_turn, Type::Pawn))
+                    key ^= tables.zobrist_en_passant[last.to.file];
+            }
+        }
+
+        return key;
     }
 
     /**
@@ -640,7 +1118,7 @@ namespace Chess
      */
     bool Board::apply_illegal_move(Move const& move, Color color)
     {
-        auto state = Traits<Board>::hash(*this);
+        auto state = zobrist_key();
         auto state_count = 0;
         if (m_previous_states.contains(state))
             state_count = m_previous_states.get(state).value();
@@ -648,102 +1126,40 @@ namespace Chess
         m_previous_states.set(state, state_count + 1);
         m_moves.append(move);
 
-        m_turn = opposing_color(color);
-
-        m_last_move = move;
-        m_moves_since_capture++;
-        m_moves_since_pawn_advance++;
-
-        if (move.from == Square("a1") || move.to == Square("a1") || move.from == Square("e1"))
-            m_white_can_castle_queenside = false;
-        if (move.from == Square("h1") || move.to == Square("h1") || move.from == Square("e1"))
-            m_white_can_castle_kingside = false;
-        if (move.from == Square("a8") || move.to == Square("a8") || move.from == Square("e8"))
-            m_black_can_castle_queenside = false;
-        if (move.from == Square("h8") || move.to == Square("h8") || move.from == Square("e8"))
-            m_black_can_castle_kingside = false;
-
-        if (color == Color::White && move.from == Square("e1") && get_piece(Square("e1")) == Piece(Color::White, Type::King)) {
-            if (move.to == Square("a1") || move.to == Square("c1")) {
-                set_piece(Square("e1"), EmptyPiece);
-                set_piece(Square("a1"), EmptyPiece);
-                set_piece(Square("c1"), { Color::White, Type::King });
-                set_piece(Square("d1"), { Color::White, Type::Rook });
-                return true;
-            } else if (move.to == Square("h1") || move.to == Square("g1")) {
-                set_piece(Square("e1"), EmptyPiece);
-                set_piece(Square("h1"), EmptyPiece);
-                set_piece(Square("g1"), { Color::White, Type::King });
-                set_piece(Square("f1"), { Color::White, Type::Rook });
-                return true;
-            }
-        } else if (color == Color::Black && move.from == Square("e8") && get_piece(Square("e8")) == Piece(Color::Black, Type::King)) {
-            if (move.to == Square("a8") || move.to == Square("c8")) {
-                set_piece(Square("e8"), EmptyPiece);
-                set_piece(Square("a8"), EmptyPiece);
-                set_piece(Square("c8"), { Color::Black, Type::King });
-                set_piece(Square("d8"), { Color::Black, Type::Rook });
-                return true;
-            } else if (move.to == Square("h8") || move.to == Square("g8")) {
-                set_piece(Square("e8"), EmptyPiece);
-                set_piece(Square("h8"), EmptyPiece);
-                set_piece(Square("g8"), { Color::Black, Type::King });
-                set_piece(Square("f8"), { Color::Black, Type::Rook });
-                return true;
-            }
-        }
-
-        if (move.piece.type == Type::Pawn)
-            m_moves_since_pawn_advance = 0;
+        auto& annotated_move = const_cast<Move&>(move);
+        bool is_castling = is_castling_move(move, color);
 
-        if (get_piece(move.to).color != Color::None) {
-            const_cast<Move&>(move).is_capture = true;
-            m_moves_since_capture = 0;
-        }
+        if (!is_castling) {
+            auto piece = get_piece(move.from);
+            bool is_promotion = piece.type == Type::Pawn && ((color == Color::Black && move.to.rank == 0) || (color == Color::White && move.to.rank == 7));
+            bool is_en_passant = piece.type == Type::Pawn && move.from.file != move.to.file && get_piece(move.to).type == Type::None;
 
-        if (get_piece(move.from).type == Type::Pawn && ((color == Color::Black && move.to.rank == 0) || (color == Color::White && move.to.rank == 7))) {
-            // Pawn Promotion
-            set_piece(move.to, { color, move.promote_to });
-            set_piece(move.from, EmptyPiece);
+            if (get_piece(move.to).color != Color::None || is_en_passant)
+                annotated_move.is_capture = true;
 
-            if (in_check(m_turn))
-                const_cast<Move&>(move).is_check = true;
+            if (!is_promotion) {
+                Square::for_each([&](Square sq) {
+                    // Ambiguous Move
+                    if (sq != move.from && get_piece(sq).type == move.piece.type && get_piece(sq).color == move.piece.color) {
+                        if (is_legal(Move(sq, move.to), get_piece(sq).color)) {
+                            m_moves.last().is_ambiguous = true;
+                            m_moves.last().ambiguous = sq;
 
-            return true;
-        }
-
-        if (get_piece(move.from).type == Type::Pawn && move.from.file != move.to.file && get_piece(move.to).type == Type::None) {
-            // En passant.
-            if (color == Color::White) {
-                set_piece({ move.to.rank - 1, move.to.file }, EmptyPiece);
-            } else {
-                set_piece({ move.to.rank + 1, move.to.file }, EmptyPiece);
+                            return IterationDecision::Break;
+                        }
+                    }
+                    return IterationDecision::Continue;
+                });
             }
-            const_cast<Move&>(move).is_capture = true;
-            m_moves_since_capture = 0;
         }
 
-        Square::for_each([&](Square sq) {
-            // Ambiguous Move
-            if (sq != move.from && get_piece(sq).type == move.piece.type && get_piece(sq).color == move.piece.color) {
-                if (is_legal(Move(sq, move.to), get_piece(sq).color)) {
-                    m_moves.last().is_ambiguous = true;
-                    m_moves.last().ambiguous = sq;
-
-                    return IterationDecision::Break;
-                }
-            }
-            return IterationDecision::Continue;
-        });
+        make_move(move);
 
-        set_piece(move.to, get_piece(move.from));
-        set_piece(move.from, EmptyPiece);
-
-        if (in_check(m_turn))
-            const_cast<Move&>(move).is_check = true;
+        if (!is_castling && in_check(m_turn))
+            annotated_move.is_check = true;
 
         return true;
-    }   
+    }
 
     /**
      * @param color 
@@ -959,13 +1375,7 @@ namespace Chess
         if (!equal_squares)
             return false;
 
-        if (m_white_can_castle_queenside != other.m_white_can_castle_queenside)
-            return false;
-        if (m_white_can_castle_kingside != other.m_white_can_castle_kingside)
-            return false;
-        if (m_black_can_castle_queenside != other.m_black_can_castle_queenside)
-            return false;
-        if (m_black_can_castle_kingside != other.m_black_can_castle_kingside)
+        if (m_castling_rights != other.m_castling_rights)
             return false;
 
         return turn() == other.turn();
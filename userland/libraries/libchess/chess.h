@@ -17,6 +17,7 @@
 #include <mods/stringview.h>
 #include <mods/traits.h>
 #include <mods/vector.h>
+#include <libchess/bitboard.h>
 
 namespace Chess 
 {
@@ -153,6 +154,23 @@ namespace Chess
             return (rank % 2) != (file % 2); 
         }
 
+        /**
+         * @return u8 
+         */
+        u8 index() const 
+        { 
+            return static_cast<u8>(rank * 8 + file); 
+        }
+
+        /**
+         * @param index 
+         * @return Square 
+         */
+        static Square from_index(u8 index) 
+        { 
+            return { index / 8, index % 8 }; 
+        }
+
         /**
          * @return String 
          */
@@ -278,8 +296,97 @@ namespace Chess
             return m_last_move; 
         }
 
+        struct UndoState {
+            Move move;
+            Piece moved;
+            Piece captured;
+            Square captured_square;
+            Optional<Move> last_move;
+            u8 castling_rights;
+            short moves_since_capture;
+            short moves_since_pawn_advance;
+            bool is_castling;
+        }; // struct UndoState
+
+        /**
+         * @brief plays a move without legality checks or game history bookkeeping,
+         *        for use by search and perft. Must be paired with unmake_move().
+         * 
+         * @return UndoState 
+         */
+        UndoState make_move(Move const&);
+
+        void unmake_move(UndoState const&);
+
+        /**
+         * @brief appends every legal move for color to moves.
+         * 
+         * @param moves 
+         * @param color 
+         */
+        void generate_legal_moves(Vector<Move, 256>& moves, Color color = Color::None) const;
+
+        /**
+         * @param depth 
+         * @return u64 
+         */
+        u64 perft(u32 depth);
+
+        /**
+         * @return u64 
+         */
+        u64 zobrist_key() const;
+
+        /**
+         * @param color 
+         * @param type 
+         * @return u64 
+         */
+        u64 pieces(Color color, Type type) const 
+        { 
+            return m_bitboards[to_underlying(color)][to_underlying(type)]; 
+        }
+
+        /**
+         * @param color 
+         * @return u64 
+         */
+        u64 occupancy(Color color) const 
+        { 
+            return m_occupancy[to_underlying(color)]; 
+        }
+
+        /**
+         * @param square 
+         * @param by 
+         * @return true 
+         * @return false 
+         */
+        bool is_square_attacked(u8 square, Color by) const;
+
+        /**
+         * @param key 
+         * @return true 
+         * @return false 
+         */
+        bool has_position_occurred(u64 key) const 
+        { 
+            return m_previous_states.contains(key); 
+        }
+
         String to_fen() const;
 
+        /**
+         * @brief the position described by fen. the full move number is
+         *        accepted but not kept, since the board only counts the moves
+         *        played on it.
+         *
+         * @param fen 
+         * @return Optional<Board>, empty if fen is malformed or has no
+         *         single king per side
+         */
+        static Optional<Board> from_fen(StringView fen);
+
         enum class Result 
         {
             CheckMate,
@@ -375,7 +482,52 @@ namespace Chess
          */
         bool apply_illegal_move(Move const&, Color color);
 
+        /**
+         * @param color 
+         * @return true 
+         * @return false 
+         */
+        bool is_castling_move(Move const&, Color color) const;
+
+        /**
+         * @brief whether color's king is attacked once move is played, worked
+         *        out on the bitboards without touching the board.
+         * 
+         * @param color 
+         * @return true 
+         * @return false 
+         */
+        bool leaves_king_in_check(Move const&, Color color) const;
+
+        /**
+         * @brief is_square_attacked() on a hypothetical occupancy, ignoring the
+         *        pieces of by that stand on captured.
+         * 
+         * @param square 
+         * @param by 
+         * @param occupied 
+         * @param captured 
+         * @return true 
+         * @return false 
+         */
+        bool is_square_attacked(u8 square, Color by, u64 occupied, u64 captured) const;
+
+        /**
+         * @param moves 
+         * @param color 
+         */
+        void generate_pseudo_legal_moves(Vector<Move, 256>& moves, Color color) const;
+
+        static constexpr u8 WhiteKingside = 1 << 0;
+        static constexpr u8 WhiteQueenside = 1 << 1;
+        static constexpr u8 BlackKingside = 1 << 2;
+        static constexpr u8 BlackQueenside = 1 << 3;
+        static constexpr u8 AllCastlingRights = WhiteKingside | WhiteQueenside | BlackKingside | BlackQueenside;
+
         Piece m_board[8][8];
+        u64 m_bitboards[2][6] {};
+        u64 m_occupancy[2] {};
+        u64 m_piece_key { 0 };
         Optional<Move> m_last_move;
 
         short m_moves_since_capture { 0 };
@@ -384,14 +536,10 @@ namespace Chess
         Color m_turn : 2 { Color::White };
         Color m_resigned : 2 { Color::None };
 
-        bool m_white_can_castle_kingside : 1 { true };
-        bool m_white_can_castle_queenside : 1 { true };
-        bool m_black_can_castle_kingside : 1 { true };
-        bool m_black_can_castle_queenside : 1 { true };
+        u8 m_castling_rights { AllCastlingRights };
 
-        HashMap<unsigned, int> m_previous_states;
+        HashMap<u64, int> m_previous_states;
         Vector<Move> m_moves;
-        friend struct Traits<Board>;
     }; // class Board
 
     /**
@@ -402,95 +550,13 @@ namespace Chess
     template<typename Callback>
     void Board::generate_moves(Callback callback, Color color) const
     {
-        if (color == Color::None)
-            color = turn();
-
-        auto try_move = [&](Move m) {
-            if (is_legal(m, color)) {
-                if (callback(m) == IterationDecision::Break)
-                    return false;
-            }
-            return true;
-        };
-
-        Square::for_each([&](Square sq) {
-            auto piece = get_piece(sq);
-            if (piece.color != color)
-                return IterationDecision::Continue;
-
-            bool keep_going = true;
-            if (piece.type == Type::Pawn) {
-                for (auto& piece : Vector({ Type::None, Type::Knight, Type::Bishop, Type::Rook, Type::Queen })) {
-                    keep_going = try_move({ sq, { sq.rank + 1, sq.file }, piece })
-                        && try_move({ sq, { sq.rank + 2, sq.file }, piece })
-                        && try_move({ sq, { sq.rank - 1, sq.file }, piece })
-                        && try_move({ sq, { sq.rank - 2, sq.file }, piece })
-                        && try_move({ sq, { sq.rank + 1, sq.file + 1 }, piece })
-                        && try_move({ sq, { sq.rank + 1, sq.file - 1 }, piece })
-                        && try_move({ sq, { sq.rank - 1, sq.file + 1 }, piece })
-                        && try_move({ sq, { sq.rank - 1, sq.file - 1 }, piece });
-                }
-            } else if (piece.type == Type::Knight) {
-                keep_going = try_move({ sq, { sq.rank + 2, sq.file + 1 } })
-                    && try_move({ sq, { sq.rank + 2, sq.file - 1 } })
-                    && try_move({ sq, { sq.rank + 1, sq.file + 2 } })
-                    && try_move({ sq, { sq.rank + 1, sq.file - 2 } })
-                    && try_move({ sq, { sq.rank - 2, sq.file + 1 } })
-                    && try_move({ sq, { sq.rank - 2, sq.file - 1 } })
-                    && try_move({ sq, { sq.rank - 1, sq.file + 2 } })
-                    && try_move({ sq, { sq.rank - 1, sq.file - 2 } });
-            } else if (piece.type == Type::Bishop) {
-                for (int dr = -1; dr <= 1; dr += 2) {
-                    for (int df = -1; df <= 1; df += 2) {
-                        for (Square to = sq; to.in_bounds(); to = { to.rank + dr, to.file + df }) {
-                            if (!try_move({ sq, to }))
-                                return IterationDecision::Break;
-                        }
-                    }
-                }
-            } else if (piece.type == Type::Rook) {
-                for (int dr = -1; dr <= 1; dr++) {
-                    for (int df = -1; df <= 1; df++) {
-                        if ((dr == 0) != (df == 0)) {
-                            for (Square to = sq; to.in_bounds(); to = { to.rank + dr, to.file + df }) {
-                                if (!try_move({ sq, to }))
-                                    return IterationDecision::Break;
-                            }
-                        }
-                    }
-                }
-            } else if (piece.type == Type::Queen) {
-                for (int dr = -1; dr <= 1; dr++) {
-                    for (int df = -1; df <= 1; df++) {
-                        if (dr != 0 || df != 0) {
-                            for (Square to = sq; to.in_bounds(); to = { to.rank + dr, to.file + df }) {
-                                if (!try_move({ sq, to }))
-                                    return IterationDecision::Break;
-                            }
-                        }
-                    }
-                }
-            } else if (piece.type == Type::King) {
-                for (int dr = -1; dr <= 1; dr++) {
-                    for (int df = -1; df <= 1; df++) {
-                        if (!try_move({ sq, { sq.rank + dr, sq.file + df } }))
-                            return IterationDecision::Break;
-                    }
-                }
+        Vector<Move, 256> moves;
+        generate_legal_moves(moves, color);
 
-                if (sq == Square("e1")) {
-                    keep_going = try_move({ sq, Square("c1") }) && try_move({ sq, Square("g1") });
-                } else if (sq == Square("e8")) {
-                    keep_going = try_move({ sq, Square("c8") }) && try_move({ sq, Square("g8") });
-                }
-            }
-
-            if (keep_going) {
-                return IterationDecision::Continue;
-            } else {
-                return IterationDecision::Break;
-            }
-        });
+        for (auto& move : moves) {
+            if (callback(move) == IterationDecision::Break)
+                return;
+        }
     }
 
 } // namespace Chess
@@ -515,17 +581,6 @@ struct Mods::Traits<Chess::Board> : public GenericTraits<Chess::Board> {
      */
     static unsigned hash(Chess::Board const& chess)
     {
-        unsigned hash = 0;
-        hash = pair_int_hash(hash, static_cast<u32>(chess.m_white_can_castle_queenside));
-        hash = pair_int_hash(hash, static_cast<u32>(chess.m_white_can_castle_kingside));
-        hash = pair_int_hash(hash, static_cast<u32>(chess.m_black_can_castle_queenside));
-        hash = pair_int_hash(hash, static_cast<u32>(chess.m_black_can_castle_kingside));
-
-        Chess::Square::for_each([&](Chess::Square sq) {
-            hash = pair_int_hash(hash, Traits<Chess::Piece>::hash(chess.get_piece(sq)));
-            return IterationDecision::Continue;
-        });
-
-        return hash;
+        return u64_hash(chess.zobrist_key());
     }
 };
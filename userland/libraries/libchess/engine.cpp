@@ -0,0 +1,179 @@
+/**
+ * @file engine.cpp
+ * @author Krisna Pranav
+ * @brief engine
+ * @version 6.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ * 
+ */
+
+#include <mods/debug.h>
+#include <libchess/engine.h>
+#include <libcore/eventloop.h>
+
+namespace Chess 
+{
+
+    /**
+     * @brief Construct a new Engine::Engine object
+     * 
+     * @param in 
+     * @param out 
+     */
+    Engine::Engine(NonnullRefPtr<Core::IODevice> in, NonnullRefPtr<Core::IODevice> out)
+        : UCI::Endpoint(in, out)
+        , m_reply_target(adopt_ref(*new ReplyTarget))
+        , m_search(m_table)
+    {
+        m_reply_target->engine = this;
+    }
+
+    /**
+     * @brief Destroy the Engine::Engine object
+     * 
+     */
+    Engine::~Engine()
+    {
+        m_search.stop();
+        wait_for_search();
+        m_reply_target->engine = nullptr;
+    }
+
+    void Engine::wait_for_search()
+    {
+        if (!m_search_thread)
+            return;
+
+        (void)m_search_thread->join();
+        m_search_thread = nullptr;
+    }
+
+    void Engine::handle_uci()
+    {
+        send_command(UCI::IdCommand(UCI::IdCommand::Type::Name, "pranaOS ChessEngine"));
+        send_command(UCI::IdCommand(UCI::IdCommand::Type::Author, "pranaOS Developers"));
+        send_command(UCI::UCIOkCommand());
+    }
+
+    void Engine::handle_isready()
+    {
+        send_command(UCI::ReadyOkCommand());
+    }
+
+    /**
+     * @param command 
+     */
+    void Engine::handle_setoption(UCI::SetOptionCommand const& command)
+    {
+        if (!command.value().has_value())
+            return;
+
+        auto value = command.value().value().to_uint();
+        if (!value.has_value())
+            return;
+
+        if (command.name() == "Threads") {
+            m_search.set_thread_count(value.value());
+        } else if (command.name() == "Hash") {
+            m_search.stop();
+            wait_for_search();
+            m_table.resize(value.value());
+        }
+    }
+
+    /**
+     * @param command 
+     */
+    void Engine::handle_position(UCI::PositionCommand const& command)
+    {
+        m_search.stop();
+        wait_for_search();
+
+        auto board = Board();
+        if (command.fen().has_value()) {
+            auto fen_board = Board::from_fen(command.fen().value());
+            if (!fen_board.has_value()) {
+                dbgln("ChessEngine: ignoring position with invalid FEN '{}'", command.fen().value());
+                return;
+            }
+            board = fen_board.release_value();
+        }
+
+        for (auto& move : command.moves()) {
+            if (!board.apply_move(move)) {
+                dbgln("ChessEngine: ignoring position with illegal move {}", move.to_long_algebraic());
+                return;
+            }
+        }
+        m_board = move(board);
+    }
+
+    /**
+     * @param command 
+     */
+    void Engine::handle_go(UCI::GoCommand const& command)
+    {
+        m_search.stop();
+        wait_for_search();
+
+        auto limits = SearchLimits::from_go_command(command, m_board.turn());
+
+        // re-armed here rather than in the search thread, so a stop right after go isn't lost
+        m_search.clear_stop();
+        m_search_thread = Threading::Thread::construct([this, limits, reply_target = m_reply_target, origin_event_loop = &Core::EventLoop::current()] {
+            auto on_info = [reply_target, origin_event_loop](UCI::InfoCommand const& info) {
+                origin_event_loop->deferred_invoke([reply_target, info] {
+                    if (reply_target->engine)
+                        reply_target->engine->send_command(info);
+                });
+                origin_event_loop->wake();
+            };
+
+            auto result = m_search.run(m_board, limits, move(on_info));
+
+            if (result.best_move.has_value()) {
+                origin_event_loop->deferred_invoke([reply_target, best_move = result.best_move.value()] {
+                    if (reply_target->engine)
+                        reply_target->engine->send_command(UCI::BestMoveCommand(best_move));
+                });
+                origin_event_loop->wake();
+            }
+
+            return (intptr_t) nullptr;
+        }, "Search"sv);
+
+        m_search_thread->start();
+    }
+
+    void Engine::handle_stop()
+    {
+        m_search.stop();
+    }
+
+    /**
+     * @param command 
+     */
+    void Engine::handle_bench(UCI::BenchCommand const& command)
+    {
+        m_search.stop();
+        wait_for_search();
+
+        auto results = Search::benchmark(command.depth(), max(command.max_threads(), 1));
+        auto single_thread_ms = results.is_empty() ? 1 : max(results.first().elapsed_ms, 1);
+
+        for (auto const& result : results) {
+            UCI::InfoCommand info;
+            info.string = String::formatted("threads {} depth {} nodes {} time {} nps {} speedup {:.2}",
+                result.thread_count,
+                result.depth,
+                result.nodes,
+                result.elapsed_ms,
+                result.nodes_per_second(),
+                static_cast<double>(single_thread_ms) / max(result.elapsed_ms, 1));
+            send_command(info);
+        }
+    }
+
+} // namespace Chess
@@ -0,0 +1,72 @@
+/**
+ * @file engine.h
+ * @author Krisna Pranav
+ * @brief engine
+ * @version 6.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ * 
+ */
+
+#pragma once
+
+#include <mods/atomic.h>
+#include <mods/atomicrefcounted.h>
+#include <libchess/chess.h>
+#include <libchess/search.h>
+#include <libchess/transpositiontable.h>
+#include <libchess/uciendpoint.h>
+#include <libthreading/thread.h>
+
+namespace Chess 
+{
+
+    class Engine final : public UCI::Endpoint 
+    {
+        C_OBJECT(Engine)
+    public:
+        /**
+         * @brief Destroy the Engine object
+         * 
+         */
+        virtual ~Engine() override;
+
+        virtual void handle_uci() override;
+        virtual void handle_isready() override;
+        virtual void handle_setoption(UCI::SetOptionCommand const&) override;
+        virtual void handle_position(UCI::PositionCommand const&) override;
+        virtual void handle_go(UCI::GoCommand const&) override;
+        virtual void handle_stop() override;
+        virtual void handle_bench(UCI::BenchCommand const&) override;
+
+    private:
+        /**
+         * @brief Construct a new Engine object
+         * 
+         * @param in 
+         * @param out 
+         */
+        Engine(NonnullRefPtr<Core::IODevice> in, NonnullRefPtr<Core::IODevice> out);
+
+        void wait_for_search();
+
+        /**
+         * @brief what the search thread's replies reach the engine through.
+         *        its refcount is atomic, so the search thread may copy it into
+         *        deferred_invoke() lambdas, and the engine clears it on the
+         *        main thread before going away so late replies are dropped.
+         */
+        struct ReplyTarget final : public AtomicRefCounted<ReplyTarget>
+        {
+            Engine* engine { nullptr };
+        }; // struct ReplyTarget final : public AtomicRefCounted<ReplyTarget>
+
+        NonnullRefPtr<ReplyTarget> m_reply_target;
+        Board m_board;
+        TranspositionTable m_table;
+        Search m_search;
+        RefPtr<Threading::Thread> m_search_thread;
+    }; // class Engine final : public UCI::Endpoint
+
+} // namespace Chess
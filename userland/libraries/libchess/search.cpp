@@ -0,0 +1,761 @@
+/**
+ * @file search.cpp
+ * @author Krisna Pranav
+ * @brief search
+ * @version 6.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ * 
+ */
+
+#include <mods/builtinwrappers.h>
+#include <mods/ownptr.h>
+#include <libchess/search.h>
+#include <libcore/elapsedtimer.h>
+#include <libthreading/thread.h>
+
+namespace Chess 
+{
+
+    namespace 
+    {
+
+        constexpr int piece_values[] = { 100, 320, 330, 500, 900, 0 };
+
+        constexpr int centralization[64] = {
+            -20, -10, -10, -10, -10, -10, -10, -20,
+            -10, 0, 0, 0, 0, 0, 0, -10,
+            -10, 0, 5, 10, 10, 5, 0, -10,
+            -10, 5, 10, 20, 20, 10, 5, -10,
+            -10, 5, 10, 20, 20, 10, 5, -10,
+            -10, 0, 5, 10, 10, 5, 0, -10,
+            -10, 0, 0, 0, 0, 0, 0, -10,
+            -20, -10, -10, -10, -10, -10, -10, -20,
+        };
+
+        /**
+         * @param board 
+         * @param color 
+         * @return int 
+         */
+        int evaluate_side(Board const& board, Color color)
+        {
+            int score = 0;
+
+            for (auto type : { Type::Pawn, Type::Knight, Type::Bishop, Type::Rook, Type::Queen }) {
+                auto pieces = board.pieces(color, type);
+                score += popcount(pieces) * piece_values[to_underlying(type)];
+
+                while (pieces) {
+                    auto square = Bitboards::pop_lowest_square(pieces);
+                    if (type == Type::Pawn) {
+                        int advance = (color == Color::White) ? (square / 8) - 1 : 6 - (square / 8);
+                        score += advance * 5;
+                    } else if (type != Type::Rook) {
+                        score += centralization[square];
+                    }
+                }
+            }
+
+            return score;
+        }
+
+        /**
+         * @param board 
+         * @return int 
+         */
+        int evaluate(Board const& board)
+        {
+            auto us = board.turn();
+            return evaluate_side(board, us) - evaluate_side(board, opposing_color(us));
+        }
+
+        /**
+         * @param score 
+         * @param ply 
+         * @return int 
+         */
+        int score_to_table(int score, int ply)
+        {
+            if (score > Search::mate_score - Search::max_ply)
+                return score + ply;
+            if (score < -Search::mate_score + Search::max_ply)
+                return score - ply;
+            return score;
+        }
+
+        /**
+         * @param score 
+         * @param ply 
+         * @return int 
+         */
+        int score_from_table(int score, int ply)
+        {
+            if (score > Search::mate_score - Search::max_ply)
+                return score - ply;
+            if (score < -Search::mate_score + Search::max_ply)
+                return score + ply;
+            return score;
+        }
+
+    } // namespace
+
+    class Search::Worker 
+    {
+    public:
+        /**
+         * @brief Construct a new Worker object 
+         * 
+         * @param search 
+         * @param board 
+         * @param limits 
+         * @param index 
+         */
+        Worker(Search& search, Board const& board, SearchLimits const& limits, size_t index)
+            : m_search(search)
+            , m_board(board)
+            , m_limits(limits)
+            , m_index(index)
+        {
+        }
+
+        /**
+         * @return u64 
+         */
+        u64 nodes() const
+        {
+            return Mods::atomic_load(&m_nodes, Mods::memory_order_relaxed);
+        }
+
+        /**
+         * @brief iterative deepening driver; helpers start at staggered depths so 
+         *        threads spread out over the tree instead of duplicating work.
+         * 
+         * @param on_info 
+         */
+        void iterate(Function<void(UCI::InfoCommand const&)> const& on_info)
+        {
+            m_timer.start();
+            compute_deadlines();
+
+            int max_depth = m_limits.depth.value_or(Search::max_ply - 1);
+            int first_depth = 1 + static_cast<int>(m_index % 2);
+
+            for (int depth = first_depth; depth <= max_depth; ++depth) {
+                m_root_best_move.clear();
+                m_selective_depth = 0;
+
+                int score = search(depth, -Search::infinity, Search::infinity, 0, true);
+
+                if (m_search.is_stopped() && m_completed_depth > 0)
+                    break;
+
+                if (m_root_best_move.has_value()) {
+                    m_result.best_move = m_root_best_move;
+                    m_result.score = score;
+                }
+                m_completed_depth = depth;
+                m_result.depth = depth;
+
+                if (!is_main_thread())
+                    continue;
+
+                if (on_info)
+                    on_info(make_info(depth, score));
+
+                if (m_soft_deadline.has_value() && m_timer.elapsed() >= m_soft_deadline.value())
+                    break;
+
+                if (m_search.is_stopped())
+                    break;
+            }
+
+            if (is_main_thread())
+                m_search.stop();
+
+            m_result.nodes = nodes();
+            m_result.elapsed_ms = m_timer.elapsed();
+        }
+
+        /**
+         * @return SearchResult const& 
+         */
+        SearchResult const& result() const
+        {
+            return m_result;
+        }
+
+    private:
+        /**
+         * @return true 
+         * @return false 
+         */
+        bool is_main_thread() const
+        {
+            return m_index == 0;
+        }
+
+        void compute_deadlines()
+        {
+            static constexpr int move_overhead_ms = 30;
+
+            if (m_limits.infinite)
+                return;
+
+            if (m_limits.movetime.has_value()) {
+                auto budget = max(m_limits.movetime.value() - move_overhead_ms, 1);
+                m_soft_deadline = budget;
+                m_hard_deadline = budget;
+                return;
+            }
+
+            if (!m_limits.time_left.has_value())
+                return;
+
+            auto time_left = m_limits.time_left.value();
+            auto increment = m_limits.increment.value_or(0);
+            auto moves_to_go = max(m_limits.movestogo.value_or(30), 1);
+
+            auto soft = time_left / moves_to_go + increment * 3 / 4;
+            auto hard = min(soft * 4, time_left / 2);
+
+            m_soft_deadline = max(min(soft, time_left - move_overhead_ms), 1);
+            m_hard_deadline = max(hard - move_overhead_ms, 1);
+        }
+
+        void check_limits()
+        {
+            if (!is_main_thread())
+                return;
+
+            if (m_hard_deadline.has_value() && m_timer.elapsed() >= m_hard_deadline.value())
+                m_search.stop();
+
+            if (m_limits.nodes.has_value() && m_search.total_nodes() >= m_limits.nodes.value())
+                m_search.stop();
+        }
+
+        /**
+         * @param move 
+         * @return true 
+         * @return false 
+         */
+        bool is_capture(Move const& move) const
+        {
+            auto target = m_board.get_piece(move.to);
+            if (target.color != Color::None && target.type != Type::None)
+                return true;
+
+            return m_board.get_piece(move.from).type == Type::Pawn && move.from.file != move.to.file;
+        }
+
+        /**
+         * @param move 
+         * @param tt_move 
+         * @param ply 
+         * @return int 
+         */
+        int score_move(Move const& move, u16 tt_move, int ply) const
+        {
+            if (tt_move != 0 && encode_move(move) == tt_move)
+                return 1 << 30;
+
+            auto attacker = m_board.get_piece(move.from).type;
+
+            if (is_capture(move)) {
+                auto victim = m_board.get_piece(move.to).type;
+                int victim_value = victim == Type::None ? piece_values[0] : piece_values[to_underlying(victim)];
+                return (1 << 28) + victim_value * 16 - piece_values[to_underlying(attacker)] / 16;
+            }
+
+            if (move.promote_to == Type::Queen)
+                return 1 << 27;
+
+            if (ply < Search::max_ply) {
+                if (m_killers[ply][0] == encode_move(move))
+                    return (1 << 26) + 1;
+                if (m_killers[ply][1] == encode_move(move))
+                    return 1 << 26;
+            }
+
+            return m_history[to_underlying(m_board.turn())][move.from.index()][move.to.index()];
+        }
+
+        /**
+         * @brief orders moves in place by descending heuristic score. 
+         * 
+         * @param moves 
+         * @param tt_move 
+         * @param ply 
+         */
+        void order_moves(Vector<Move, 256>& moves, u16 tt_move, int ply) const
+        {
+            Vector<int, 256> scores;
+            for (auto const& move : moves)
+                scores.unchecked_append(score_move(move, tt_move, ply));
+
+            for (size_t i = 1; i < moves.size(); ++i) {
+                auto move = moves[i];
+                auto score = scores[i];
+                size_t j = i;
+                while (j > 0 && scores[j - 1] < score) {
+                    moves[j] = moves[j - 1];
+                    scores[j] = scores[j - 1];
+                    --j;
+                }
+                moves[j] = move;
+                scores[j] = score;
+            }
+        }
+
+        /**
+         * @param ply 
+         * @return true 
+         * @return false 
+         */
+        bool is_repetition(int ply) const
+        {
+            auto key = m_key_stack.last();
+            for (ssize_t i = static_cast<ssize_t>(m_key_stack.size()) - 3; i >= 0; i -= 2) {
+                if (m_key_stack[i] == key)
+                    return true;
+            }
+
+            return ply > 0 && m_board.has_position_occurred(key);
+        }
+
+        /**
+         * @param move 
+         * @return Board::UndoState 
+         */
+        Board::UndoState play(Move const& move)
+        {
+            auto undo = m_board.make_move(move);
+            m_key_stack.append(m_board.zobrist_key());
+            return undo;
+        }
+
+        /**
+         * @param undo 
+         */
+        void take_back(Board::UndoState const& undo)
+        {
+            m_key_stack.take_last();
+            m_board.unmake_move(undo);
+        }
+
+        /**
+         * @param alpha 
+         * @param beta 
+         * @param ply 
+         * @return int 
+         */
+        int quiescence(int alpha, int beta, int ply)
+        {
+            count_node();
+            m_selective_depth = max(m_selective_depth, ply);
+
+            if (m_search.is_stopped())
+                return 0;
+
+            int stand_pat = evaluate(m_board);
+            if (stand_pat >= beta || ply >= Search::max_ply - 1)
+                return stand_pat;
+            alpha = max(alpha, stand_pat);
+
+            Vector<Move, 256> moves;
+            m_board.generate_legal_moves(moves);
+
+            size_t tactical_count = 0;
+            for (size_t i = 0; i < moves.size(); ++i) {
+                if (is_capture(moves[i]) || moves[i].promote_to == Type::Queen)
+                    moves[tactical_count++] = moves[i];
+            }
+            moves.shrink(tactical_count);
+            order_moves(moves, 0, Search::max_ply);
+
+            for (auto const& move : moves) {
+                auto undo = play(move);
+                int score = -quiescence(-beta, -alpha, ply + 1);
+                take_back(undo);
+
+                if (m_search.is_stopped())
+                    return 0;
+
+                if (score >= beta)
+                    return score;
+                alpha = max(alpha, score);
+            }
+
+            return alpha;
+        }
+
+        /**
+         * @param depth 
+         * @param alpha 
+         * @param beta 
+         * @param ply 
+         * @param is_pv 
+         * @return int 
+         */
+        int search(int depth, int alpha, int beta, int ply, bool is_pv)
+        {
+            if (ply == 0) {
+                m_key_stack.clear();
+                m_key_stack.append(m_board.zobrist_key());
+            } else if (is_repetition(ply)) {
+                return 0;
+            }
+
+            if (ply >= Search::max_ply - 1)
+                return evaluate(m_board);
+
+            auto us = m_board.turn();
+            bool in_check = m_board.in_check(us);
+            if (in_check)
+                ++depth;
+
+            if (depth <= 0)
+                return quiescence(alpha, beta, ply);
+
+            count_node();
+            if (m_search.is_stopped())
+                return 0;
+
+            auto key = m_key_stack.last();
+            u16 tt_move = 0;
+            if (auto entry = m_search.m_table.probe(key); entry.has_value()) {
+                tt_move = entry->move;
+                int tt_score = score_from_table(entry->score, ply);
+                if (!is_pv && ply > 0 && entry->depth >= depth) {
+                    if (entry->bound == TranspositionTable::Bound::Exact)
+                        return tt_score;
+                    if (entry->bound == TranspositionTable::Bound::Lower && tt_score >= beta)
+                        return tt_score;
+                    if (entry->bound == TranspositionTable::Bound::Upper && tt_score <= alpha)
+                        return tt_score;
+                }
+            }
+
+            Vector<Move, 256> moves;
+            m_board.generate_legal_moves(moves);
+
+            if (moves.is_empty())
+                return in_check ? -Search::mate_score + ply : 0;
+
+            order_moves(moves, tt_move, ply);
+
+            int original_alpha = alpha;
+            int best_score = -Search::infinity;
+            Optional<Move> best_move;
+
+            for (size_t i = 0; i < moves.size(); ++i) {
+                auto const& move = moves[i];
+                bool quiet = !is_capture(move) && move.promote_to == Type::None;
+
+                auto undo = play(move);
+                int score;
+                if (i == 0) {
+                    score = -search(depth - 1, -beta, -alpha, ply + 1, is_pv);
+                } else {
+                    score = -search(depth - 1, -alpha - 1, -alpha, ply + 1, false);
+                    if (score > alpha && score < beta)
+                        score = -search(depth - 1, -beta, -alpha, ply + 1, true);
+                }
+                take_back(undo);
+
+                if (m_search.is_stopped())
+                    return 0;
+
+                if (score <= best_score)
+                    continue;
+
+                best_score = score;
+                best_move = move;
+
+                if (score <= alpha)
+                    continue;
+
+                alpha = score;
+                if (ply == 0)
+                    m_root_best_move = move;
+
+                if (alpha < beta)
+                    continue;
+
+                if (quiet) {
+                    auto encoded = encode_move(move);
+                    if (m_killers[ply][0] != encoded) {
+                        m_killers[ply][1] = m_killers[ply][0];
+                        m_killers[ply][0] = encoded;
+                    }
+                    auto& history = m_history[to_underlying(us)][move.from.index()][move.to.index()];
+                    history = min(history + depth * depth, 1 << 20);
+                }
+                break;
+            }
+
+            TranspositionTable::Entry entry;
+            entry.move = best_move.has_value() ? encode_move(best_move.value()) : 0;
+            entry.score = static_cast<i16>(score_to_table(best_score, ply));
+            entry.depth = static_cast<i8>(depth);
+            if (best_score >= beta)
+                entry.bound = TranspositionTable::Bound::Lower;
+            else if (best_score > original_alpha)
+                entry.bound = TranspositionTable::Bound::Exact;
+            else
+                entry.bound = TranspositionTable::Bound::Upper;
+            m_search.m_table.store(key, entry);
+
+            return best_score;
+        }
+
+        void count_node()
+        {
+            Mods::atomic_store(&m_nodes, m_nodes + 1, Mods::memory_order_relaxed);
+            if ((m_nodes & 2047) == 0)
+                check_limits();
+        }
+
+        /**
+         * @param depth 
+         * @return Vector<Move> 
+         */
+        Vector<Move> principal_variation(int depth)
+        {
+            Vector<Move> pv;
+            Vector<Board::UndoState> undo_stack;
+            Vector<u64> seen;
+
+            while (static_cast<int>(pv.size()) < depth) {
+                auto key = m_board.zobrist_key();
+                if (seen.contains_slow(key))
+                    break;
+                seen.append(key);
+
+                auto entry = m_search.m_table.probe(key);
+                if (!entry.has_value())
+                    break;
+
+                auto move = decode_move(entry->move);
+                if (!move.has_value())
+                    break;
+
+                Vector<Move, 256> moves;
+                m_board.generate_legal_moves(moves);
+                if (!moves.contains_slow(move.value()))
+                    break;
+
+                pv.append(move.value());
+                undo_stack.append(m_board.make_move(move.value()));
+            }
+
+            if (pv.is_empty() && m_result.best_move.has_value())
+                pv.append(m_result.best_move.value());
+
+            while (!undo_stack.is_empty())
+                m_board.unmake_move(undo_stack.take_last());
+
+            return pv;
+        }
+
+        /**
+         * @param depth 
+         * @param score 
+         * @return UCI::InfoCommand 
+         */
+        UCI::InfoCommand make_info(int depth, int score)
+        {
+            UCI::InfoCommand info;
+            auto elapsed = m_timer.elapsed();
+            auto nodes = m_search.total_nodes();
+
+            info.depth = depth;
+            info.seldepth = m_selective_depth;
+            info.time = elapsed;
+            info.nodes = static_cast<int>(nodes);
+            info.nps = static_cast<int>(nodes * 1000 / static_cast<u64>(max(elapsed, 1)));
+            info.hashfull = m_search.m_table.hashfull();
+
+            if (score > Search::mate_score - Search::max_ply)
+                info.score_mate = (Search::mate_score - score + 1) / 2;
+            else if (score < -Search::mate_score + Search::max_ply)
+                info.score_mate = -(Search::mate_score + score) / 2;
+            else
+                info.score_cp = score;
+
+            info.pv = principal_variation(depth);
+            return info;
+        }
+
+        Search& m_search;
+        Board m_board;
+        SearchLimits m_limits;
+        size_t m_index { 0 };
+
+        Core::ElapsedTimer m_timer { true };
+        Optional<int> m_soft_deadline;
+        Optional<int> m_hard_deadline;
+
+        u64 m_nodes { 0 };
+        int m_selective_depth { 0 };
+        int m_completed_depth { 0 };
+        Optional<Move> m_root_best_move;
+        SearchResult m_result;
+
+        Vector<u64> m_key_stack;
+        u16 m_killers[Search::max_ply][2] {};
+        int m_history[2][64][64] {};
+    }; // class Search::Worker
+
+    /**
+     * @param command 
+     * @param side_to_move 
+     * @return SearchLimits 
+     */
+    SearchLimits SearchLimits::from_go_command(UCI::GoCommand const& command, Color side_to_move)
+    {
+        SearchLimits limits;
+        limits.depth = command.depth;
+        if (command.nodes.has_value())
+            limits.nodes = static_cast<u64>(command.nodes.value());
+        limits.movetime = command.movetime;
+        limits.movestogo = command.movestogo;
+        limits.infinite = command.infinite || command.ponder;
+
+        if (side_to_move == Color::White) {
+            limits.time_left = command.wtime;
+            limits.increment = command.winc;
+        } else {
+            limits.time_left = command.btime;
+            limits.increment = command.binc;
+        }
+
+        if (command.mate.has_value() && !limits.depth.has_value())
+            limits.depth = command.mate.value() * 2;
+
+        return limits;
+    }
+
+    /**
+     * @brief Construct a new Search::Search object 
+     * 
+     * @param table 
+     */
+    Search::Search(TranspositionTable& table)
+        : m_table(table)
+    {
+    }
+
+    /**
+     * @brief Destroy the Search::Search object 
+     * 
+     */
+    Search::~Search()
+    {
+        VERIFY(m_workers.is_empty());
+    }
+
+    /**
+     * @return u64 
+     */
+    u64 Search::total_nodes() const
+    {
+        u64 nodes = 0;
+        for (auto* worker : m_workers)
+            nodes += worker->nodes();
+        return nodes;
+    }
+
+    /**
+     * @param board 
+     * @param limits 
+     * @param on_info 
+     * @return SearchResult 
+     */
+    SearchResult Search::run(Board const& board, SearchLimits const& limits, Function<void(UCI::InfoCommand const&)> on_info)
+    {
+        m_table.new_search();
+
+        Vector<NonnullOwnPtr<Worker>> workers;
+        for (size_t i = 0; i < m_thread_count; ++i)
+            workers.append(make<Worker>(*this, board, limits, i));
+
+        for (auto& worker : workers)
+            m_workers.append(worker.ptr());
+
+        Vector<NonnullRefPtr<Threading::Thread>> helpers;
+        for (size_t i = 1; i < workers.size(); ++i) {
+            auto helper = Threading::Thread::construct([&worker = *workers[i]] {
+                worker.iterate({});
+                return (intptr_t) nullptr;
+            }, "Search helper"sv);
+            helper->start();
+            helpers.append(move(helper));
+        }
+
+        workers[0]->iterate(on_info);
+
+        for (auto& helper : helpers)
+            (void)helper->join();
+
+        auto result = workers[0]->result();
+        result.nodes = total_nodes();
+
+        m_workers.clear();
+
+        if (!result.best_move.has_value()) {
+            Vector<Move, 256> moves;
+            board.generate_legal_moves(moves);
+            if (!moves.is_empty())
+                result.best_move = moves.first();
+        }
+
+        return result;
+    }
+
+    /**
+     * @param depth 
+     * @param max_threads 
+     * @return Vector<SearchBenchmarkResult> 
+     */
+    Vector<SearchBenchmarkResult> Search::benchmark(int depth, size_t max_threads)
+    {
+        static constexpr StringView opening_lines[] = {
+            ""sv,
+            "e2e4 e7e5 g1f3 b8c6 f1b5 a7a6"sv,
+            "d2d4 g8f6 c2c4 e7e6 b1c3 f8b4"sv,
+            "e2e4 c7c5 g1f3 d7d6 d2d4 c5d4 f3d4 g8f6 b1c3 a7a6"sv,
+        };
+
+        Vector<SearchBenchmarkResult> results;
+
+        for (size_t thread_count = 1; thread_count <= max_threads; ++thread_count) {
+            TranspositionTable table { 64 };
+            Search search { table };
+            search.set_thread_count(thread_count);
+
+            SearchLimits limits;
+            limits.depth = depth;
+
+            SearchBenchmarkResult bench { thread_count, depth, 0, 0 };
+            for (auto line : opening_lines) {
+                Board board;
+                for (auto move : line.split_view(' '))
+                    board.apply_move(Move(move));
+
+                table.clear();
+                search.clear_stop();
+                auto result = search.run(board, limits);
+                bench.nodes += result.nodes;
+                bench.elapsed_ms += result.elapsed_ms;
+            }
+
+            results.append(bench);
+        }
+
+        return results;
+    }
+
+} // namespace Chess
@@ -0,0 +1,166 @@
+/**
+ * @file search.h
+ * @author Krisna Pranav
+ * @brief search
+ * @version 6.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ * 
+ */
+
+#pragma once
+
+#include <mods/atomic.h>
+#include <mods/function.h>
+#include <mods/noncopyable.h>
+#include <mods/optional.h>
+#include <mods/vector.h>
+#include <libchess/chess.h>
+#include <libchess/transpositiontable.h>
+#include <libchess/ucicommand.h>
+
+namespace Chess 
+{
+
+    struct SearchLimits {
+        Optional<int> depth;
+        Optional<u64> nodes;
+        Optional<int> movetime;
+        Optional<int> time_left;
+        Optional<int> increment;
+        Optional<int> movestogo;
+        bool infinite { false };
+
+        /**
+         * @param command 
+         * @param side_to_move 
+         * @return SearchLimits 
+         */
+        static SearchLimits from_go_command(UCI::GoCommand const& command, Color side_to_move);
+    }; // struct SearchLimits
+
+    struct SearchResult {
+        Optional<Move> best_move;
+        int score { 0 };
+        int depth { 0 };
+        u64 nodes { 0 };
+        int elapsed_ms { 0 };
+    }; // struct SearchResult
+
+    struct SearchBenchmarkResult {
+        size_t thread_count { 0 };
+        int depth { 0 };
+        u64 nodes { 0 };
+        int elapsed_ms { 0 };
+
+        /**
+         * @return u64 
+         */
+        u64 nodes_per_second() const 
+        { 
+            return nodes * 1000 / max(elapsed_ms, 1); 
+        }
+    }; // struct SearchBenchmarkResult
+
+    class Search 
+    {
+        MOD_MAKE_NONCOPYABLE(Search);
+        MOD_MAKE_NONMOVABLE(Search);
+
+    public:
+        static constexpr int max_ply = 128;
+        static constexpr int mate_score = 32000;
+        static constexpr int infinity = 32500;
+
+        /**
+         * @brief Construct a new Search object
+         * 
+         * @param table 
+         */
+        explicit Search(TranspositionTable& table);
+
+        /**
+         * @brief Destroy the Search object
+         * 
+         */
+        ~Search();
+
+        /**
+         * @param thread_count 
+         */
+        void set_thread_count(size_t thread_count) 
+        { 
+            m_thread_count = max<size_t>(thread_count, 1); 
+        }
+
+        /**
+         * @return size_t 
+         */
+        size_t thread_count() const 
+        { 
+            return m_thread_count; 
+        }
+
+        /**
+         * @brief runs an iterative-deepening search until a limit is hit or stop() is called.
+         *        Helper threads (Lazy SMP) share the transposition table; only the calling
+         *        thread reports progress through on_info. A search that was stopped
+         *        returns at once until clear_stop() is called.
+         * 
+         * @param board 
+         * @param limits 
+         * @param on_info 
+         * @return SearchResult 
+         */
+        SearchResult run(Board const& board, SearchLimits const& limits, Function<void(UCI::InfoCommand const&)> on_info = {});
+
+        void stop() 
+        { 
+            m_stopped.store(true, Mods::memory_order_relaxed); 
+        }
+
+        /**
+         * @brief re-arms a stopped search. run() leaves the flag alone, so call
+         *        this before starting the thread that runs it: a stop() that
+         *        arrives in between then still ends the search.
+         */
+        void clear_stop() 
+        { 
+            m_stopped.store(false, Mods::memory_order_relaxed); 
+        }
+
+        /**
+         * @return true 
+         * @return false 
+         */
+        bool is_stopped() const 
+        { 
+            return m_stopped.load(Mods::memory_order_relaxed); 
+        }
+
+        /**
+         * @brief fixed-depth searches over a set of positions at 1..max_threads threads.
+         * 
+         * @param depth 
+         * @param max_threads 
+         * @return Vector<SearchBenchmarkResult> 
+         */
+        static Vector<SearchBenchmarkResult> benchmark(int depth, size_t max_threads);
+
+    private:
+        class Worker;
+        friend class Worker;
+
+        /**
+         * @return u64 
+         */
+        u64 total_nodes() const;
+
+        TranspositionTable& m_table;
+        size_t m_thread_count { 1 };
+        Atomic<bool> m_stopped { false };
+        Vector<Worker*> m_workers;
+    }; // class Search
+
+} // namespace Chess
@@ -0,0 +1,174 @@
+/**
+ * @file transpositiontable.cpp
+ * @author Krisna Pranav
+ * @brief transposition table
+ * @version 6.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ * 
+ */
+
+#include <mods/atomic.h>
+#include <libchess/transpositiontable.h>
+
+namespace Chess 
+{
+
+    /**
+     * @param move 
+     * @return u16 
+     */
+    u16 encode_move(Move const& move)
+    {
+        return static_cast<u16>(move.from.index() | (move.to.index() << 6) | (to_underlying(move.promote_to) << 12));
+    }
+
+    /**
+     * @param encoded 
+     * @return Optional<Move> 
+     */
+    Optional<Move> decode_move(u16 encoded)
+    {
+        if (encoded == 0)
+            return {};
+
+        return Move {
+            Square::from_index(encoded & 0x3f),
+            Square::from_index((encoded >> 6) & 0x3f),
+            static_cast<Type>((encoded >> 12) & 0x7),
+        };
+    }
+
+    namespace 
+    {
+
+        /**
+         * @param entry 
+         * @param generation 
+         * @return u64 
+         */
+        u64 pack(TranspositionTable::Entry const& entry, u8 generation)
+        {
+            return static_cast<u64>(entry.move)
+                | (static_cast<u64>(static_cast<u16>(entry.score)) << 16)
+                | (static_cast<u64>(static_cast<u8>(entry.depth)) << 32)
+                | (static_cast<u64>(to_underlying(entry.bound)) << 40)
+                | (static_cast<u64>(generation) << 48);
+        }
+
+        /**
+         * @param payload 
+         * @return TranspositionTable::Entry 
+         */
+        TranspositionTable::Entry unpack(u64 payload)
+        {
+            return {
+                static_cast<u16>(payload),
+                static_cast<i16>(static_cast<u16>(payload >> 16)),
+                static_cast<i8>(static_cast<u8>(payload >> 32)),
+                static_cast<TranspositionTable::Bound>((payload >> 40) & 0x3),
+            };
+        }
+
+        /**
+         * @param payload 
+         * @return u8 
+         */
+        u8 generation_of(u64 payload)
+        {
+            return static_cast<u8>(payload >> 48);
+        }
+
+    } // namespace
+
+    /**
+     * @brief Construct a new TranspositionTable::TranspositionTable object
+     * 
+     * @param megabytes 
+     */
+    TranspositionTable::TranspositionTable(size_t megabytes)
+    {
+        resize(megabytes);
+    }
+
+    /**
+     * @param megabytes 
+     */
+    void TranspositionTable::resize(size_t megabytes)
+    {
+        size_t slot_count = 1;
+        while (slot_count * 2 * sizeof(Slot) <= max<size_t>(megabytes, 1) * MiB)
+            slot_count *= 2;
+
+        m_slots.clear();
+        m_slots.resize(slot_count);
+    }
+
+    void TranspositionTable::clear()
+    {
+        for (auto& slot : m_slots)
+            slot = {};
+        m_generation = 0;
+    }
+
+    /**
+     * @param key 
+     * @return Optional<TranspositionTable::Entry> 
+     */
+    Optional<TranspositionTable::Entry> TranspositionTable::probe(u64 key) const
+    {
+        auto& slot = const_cast<Slot&>(slot_for(key));
+        auto payload = Mods::atomic_load(&slot.payload, Mods::memory_order_relaxed);
+        auto checksum = Mods::atomic_load(&slot.checksum, Mods::memory_order_relaxed);
+
+        if ((checksum ^ payload) != key || payload == 0)
+            return {};
+
+        return unpack(payload);
+    }
+
+    /**
+     * @param key 
+     * @param entry 
+     */
+    void TranspositionTable::store(u64 key, Entry const& entry)
+    {
+        auto& slot = slot_for(key);
+        auto old_payload = Mods::atomic_load(&slot.payload, Mods::memory_order_relaxed);
+        auto old_checksum = Mods::atomic_load(&slot.checksum, Mods::memory_order_relaxed);
+        bool same_position = (old_checksum ^ old_payload) == key;
+
+        if (old_payload != 0 && generation_of(old_payload) == m_generation) {
+            auto old_entry = unpack(old_payload);
+            if (entry.bound != Bound::Exact && entry.depth + 2 < old_entry.depth)
+                return;
+        }
+
+        auto new_entry = entry;
+        if (same_position && new_entry.move == 0)
+            new_entry.move = unpack(old_payload).move;
+
+        auto payload = pack(new_entry, m_generation);
+        Mods::atomic_store(&slot.checksum, key ^ payload, Mods::memory_order_relaxed);
+        Mods::atomic_store(&slot.payload, payload, Mods::memory_order_relaxed);
+    }
+
+    /**
+     * @return int 
+     */
+    int TranspositionTable::hashfull() const
+    {
+        size_t sample = min<size_t>(1000, m_slots.size());
+        int used = 0;
+
+        for (size_t i = 0; i < sample; ++i) {
+            auto payload = m_slots[i].payload;
+            if (payload != 0 && generation_of(payload) == m_generation)
+                ++used;
+        }
+
+        return static_cast<int>(used * 1000 / sample);
+    }
+
+} // namespace Chess
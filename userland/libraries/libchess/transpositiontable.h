@@ -0,0 +1,124 @@
+/**
+ * @file transpositiontable.h
+ * @author Krisna Pranav
+ * @brief transposition table
+ * @version 6.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ * 
+ */
+
+#pragma once
+
+#include <mods/noncopyable.h>
+#include <mods/optional.h>
+#include <mods/vector.h>
+#include <libchess/chess.h>
+
+namespace Chess 
+{
+
+    /**
+     * @param move 
+     * @return u16 
+     */
+    u16 encode_move(Move const& move);
+
+    /**
+     * @param encoded 
+     * @return Optional<Move> 
+     */
+    Optional<Move> decode_move(u16 encoded);
+
+    class TranspositionTable 
+    {
+        MOD_MAKE_NONCOPYABLE(TranspositionTable);
+        MOD_MAKE_NONMOVABLE(TranspositionTable);
+
+    public:
+        enum class Bound : u8 
+        {
+            None,
+            Exact,
+            Lower,
+            Upper,
+        }; // enum class Bound : u8
+
+        struct Entry {
+            u16 move { 0 };
+            i16 score { 0 };
+            i8 depth { 0 };
+            Bound bound { Bound::None };
+        }; // struct Entry
+
+        /**
+         * @brief Construct a new TranspositionTable object
+         * 
+         * @param megabytes 
+         */
+        explicit TranspositionTable(size_t megabytes = 16);
+
+        /**
+         * @param megabytes 
+         */
+        void resize(size_t megabytes);
+
+        void clear();
+
+        /**
+         * @brief ages out entries from previous searches without clearing them.
+         * 
+         */
+        void new_search() 
+        { 
+            m_generation = (m_generation + 1) & generation_mask; 
+        }
+
+        /**
+         * @brief lock-free probe; torn writes from other threads are rejected
+         *        because each slot stores its key xor-ed with its payload.
+         * 
+         * @param key 
+         * @return Optional<Entry> 
+         */
+        Optional<Entry> probe(u64 key) const;
+
+        /**
+         * @param key 
+         * @param entry 
+         */
+        void store(u64 key, Entry const& entry);
+
+        /**
+         * @return int 
+         */
+        int hashfull() const;
+
+    private:
+        struct Slot {
+            u64 checksum { 0 };
+            u64 payload { 0 };
+        }; // struct Slot
+
+        static constexpr u8 generation_mask = 0x3f;
+
+        /**
+         * @param key 
+         * @return Slot& 
+         */
+        Slot& slot_for(u64 key) 
+        { 
+            return m_slots[key & (m_slots.size() - 1)]; 
+        }
+
+        Slot const& slot_for(u64 key) const 
+        { 
+            return m_slots[key & (m_slots.size() - 1)]; 
+        }
+
+        Vector<Slot> m_slots;
+        u8 m_generation { 0 };
+    }; // class TranspositionTable
+
+} // namespace Chess
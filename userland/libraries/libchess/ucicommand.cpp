@@ -149,17 +149,28 @@ namespace Chess::UCI
     PositionCommand PositionCommand::from_string(StringView command)
     {
         auto tokens = command.split_view(' ');
-        VERIFY(tokens.size() >= 3);
+        VERIFY(tokens.size() >= 2);
         VERIFY(tokens[0] == "position");
-        VERIFY(tokens[2] == "moves");
+        VERIFY(tokens[1] == "startpos" || tokens[1] == "fen");
 
+        // "position fen" is followed by the FEN's own space-separated fields
+        size_t i = 2;
         Optional<String> fen;
-        if (tokens[1] != "startpos")
-            fen = tokens[1];
+        if (tokens[1] == "fen") {
+            StringBuilder builder;
+            for (; i < tokens.size() && tokens[i] != "moves"; ++i) {
+                if (!builder.is_empty())
+                    builder.append(' ');
+                builder.append(tokens[i]);
+            }
+            fen = builder.to_string();
+        }
 
         Vector<Move> moves;
-        for (size_t i = 3; i < tokens.size(); ++i) {
-            moves.append(Move(tokens[i]));
+        if (i < tokens.size()) {
+            VERIFY(tokens[i] == "moves");
+            for (++i; i < tokens.size(); ++i)
+                moves.append(Move(tokens[i]));
         }
         return PositionCommand(fen, moves);
     }
@@ -172,7 +183,9 @@ namespace Chess::UCI
         StringBuilder builder;
         builder.append("position ");
         if (fen().has_value()) {
+            builder.append("fen ");
             builder.append(fen().value());
+            builder.append(' ');
         } else {
             builder.append("startpos ");
         }
@@ -407,9 +420,55 @@ namespace Chess::UCI
      * @param command 
      * @return InfoCommand 
      */
-    InfoCommand InfoCommand::from_string([[maybe_unused]] StringView command)
+    InfoCommand InfoCommand::from_string(StringView command)
     {
-        VERIFY_NOT_REACHED();
+        auto tokens = command.split_view(' ');
+        VERIFY(tokens[0] == "info");
+
+        InfoCommand info;
+        for (size_t i = 1; i < tokens.size(); ++i) {
+            auto next_int = [&]() -> int {
+                VERIFY(++i < tokens.size());
+                return tokens[i].to_int().value();
+            };
+
+            if (tokens[i] == "depth") {
+                info.depth = next_int();
+            } else if (tokens[i] == "seldepth") {
+                info.seldepth = next_int();
+            } else if (tokens[i] == "time") {
+                info.time = next_int();
+            } else if (tokens[i] == "nodes") {
+                info.nodes = next_int();
+            } else if (tokens[i] == "nps") {
+                info.nps = next_int();
+            } else if (tokens[i] == "hashfull") {
+                info.hashfull = next_int();
+            } else if (tokens[i] == "currmovenumber") {
+                info.currmove_number = next_int();
+            } else if (tokens[i] == "currmove") {
+                VERIFY(++i < tokens.size());
+                info.currmove = Move(tokens[i]);
+            } else if (tokens[i] == "score") {
+                VERIFY(++i < tokens.size());
+                if (tokens[i] == "cp")
+                    info.score_cp = next_int();
+                else if (tokens[i] == "mate")
+                    info.score_mate = next_int();
+            } else if (tokens[i] == "pv") {
+                Vector<Move> pv;
+                while (i + 1 < tokens.size())
+                    pv.append(Move(tokens[++i]));
+                info.pv = move(pv);
+            } else if (tokens[i] == "string") {
+                auto offset = command.find("string "sv);
+                VERIFY(offset.has_value());
+                info.string = command.substring_view(offset.value() + 7);
+                break;
+            }
+        }
+
+        return info;
     }
 
     /**
@@ -417,8 +476,72 @@ namespace Chess::UCI
      */
     String InfoCommand::to_string() const
     {
-        VERIFY_NOT_REACHED();
-        return "info";
+        StringBuilder builder;
+        builder.append("info");
+
+        if (depth.has_value())
+            builder.appendff(" depth {}", depth.value());
+        if (seldepth.has_value())
+            builder.appendff(" seldepth {}", seldepth.value());
+        if (score_mate.has_value())
+            builder.appendff(" score mate {}", score_mate.value());
+        else if (score_cp.has_value())
+            builder.appendff(" score cp {}", score_cp.value());
+        if (nodes.has_value())
+            builder.appendff(" nodes {}", nodes.value());
+        if (nps.has_value())
+            builder.appendff(" nps {}", nps.value());
+        if (hashfull.has_value())
+            builder.appendff(" hashfull {}", hashfull.value());
+        if (time.has_value())
+            builder.appendff(" time {}", time.value());
+        if (currmove.has_value())
+            builder.appendff(" currmove {}", currmove.value().to_long_algebraic());
+        if (currmove_number.has_value())
+            builder.appendff(" currmovenumber {}", currmove_number.value());
+
+        if (pv.has_value() && !pv.value().is_empty()) {
+            builder.append(" pv");
+            for (auto& move : pv.value()) {
+                builder.append(' ');
+                builder.append(move.to_long_algebraic());
+            }
+        }
+
+        if (string.has_value()) {
+            builder.append(" string ");
+            builder.append(string.value());
+        }
+
+        builder.append('\n');
+        return builder.build();
+    }
+
+    /**
+     * @param command 
+     * @return BenchCommand 
+     */
+    BenchCommand BenchCommand::from_string(StringView command)
+    {
+        auto tokens = command.split_view(' ');
+        VERIFY(tokens[0] == "bench");
+
+        int depth = 8;
+        int max_threads = 1;
+        if (tokens.size() >= 2)
+            depth = tokens[1].to_int().value_or(depth);
+        if (tokens.size() >= 3)
+            max_threads = tokens[2].to_int().value_or(max_threads);
+
+        return BenchCommand(depth, max_threads);
+    }
+
+    /**
+     * @return String 
+     */
+    String BenchCommand::to_string() const
+    {
+        return String::formatted("bench {} {}\n", depth(), max_threads());
     }
 
 } // namespace Chess::UCI
@@ -43,6 +43,7 @@ namespace Chess::UCI
             Registration,
             Info,
             Option,
+            Bench,
         }; // enum class Type 
 
         /**
@@ -437,7 +438,7 @@ namespace Chess::UCI
          * 
          */
         explicit InfoCommand()
-            : Command(Command::Type::BestMove)
+            : Command(Command::Type::Info)
         {
         }
 
@@ -453,6 +454,8 @@ namespace Chess::UCI
         Optional<int> seldepth;
         Optional<int> time;
         Optional<int> nodes;
+        Optional<int> nps;
+        Optional<int> hashfull;
         Optional<Vector<Chess::Move>> pv;
         
         Optional<int> score_cp;
@@ -461,6 +464,52 @@ namespace Chess::UCI
         Optional<Chess::Move> currmove;
         Optional<int> currmove_number;
 
+        Optional<String> string;
     }; // class InfoCommand : public Command 
 
+    class BenchCommand : public Command 
+    {
+    public:
+        /**
+         * @brief Construct a new Bench Command object
+         * 
+         * @param depth 
+         * @param max_threads 
+         */
+        explicit BenchCommand(int depth, int max_threads)
+            : Command(Command::Type::Bench)
+            , m_depth(depth)
+            , m_max_threads(max_threads)
+        {
+        }
+
+        /**
+         * @param command 
+         * @return BenchCommand 
+         */
+        static BenchCommand from_string(StringView command);
+
+        virtual String to_string() const override;
+
+        /**
+         * @return int 
+         */
+        int depth() const 
+        { 
+            return m_depth; 
+        }
+
+        /**
+         * @return int 
+         */
+        int max_threads() const 
+        { 
+            return m_max_threads; 
+        }
+
+    private:
+        int m_depth { 8 };
+        int m_max_threads { 1 };
+    }; // class BenchCommand : public Command 
+
 } // namespace Chess::UCI
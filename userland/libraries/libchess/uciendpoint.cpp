@@ -52,7 +52,7 @@ namespace Chess::UCI
         case Command::Type::Debug:
             return handle_debug(static_cast<DebugCommand const&>(event));
         case Command::Type::IsReady:
-            return handle_uci();
+            return handle_isready();
         case Command::Type::SetOption:
             return handle_setoption(static_cast<SetOptionCommand const&>(event));
         case Command::Type::Position:
@@ -71,6 +71,8 @@ namespace Chess::UCI
             return handle_bestmove(static_cast<BestMoveCommand const&>(event));
         case Command::Type::Info:
             return handle_info(static_cast<InfoCommand const&>(event));
+        case Command::Type::Bench:
+            return handle_bench(static_cast<BenchCommand const&>(event));
         default:
             break;
         }
@@ -118,6 +120,8 @@ namespace Chess::UCI
             return make<BestMoveCommand>(BestMoveCommand::from_string(line));
         } else if (line.starts_with("info")) {
             return make<InfoCommand>(InfoCommand::from_string(line));
+        } else if (line.starts_with("bench")) {
+            return make<BenchCommand>(BenchCommand::from_string(line));
         }
 
         dbgln("command line: {}", line);
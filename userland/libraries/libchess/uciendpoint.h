@@ -41,6 +41,7 @@ namespace Chess::UCI
         virtual void handle_readyok() { }
         virtual void handle_bestmove(BestMoveCommand const&) { }
         virtual void handle_info(InfoCommand const&) { }
+        virtual void handle_bench(BenchCommand const&) { }
 
         void send_command(Command const&);
 
@@ -9,13 +9,18 @@
  * 
  */
 
+#include <mods/binarysearch.h>
 #include <mods/bytereader.h>
 #include <mods/hashtable.h>
 #include <mods/jsonobject.h>
 #include <mods/jsonvalue.h>
 #include <mods/lexicalpath.h>
+#include <mods/memorystream.h>
+#include <mods/quicksort.h>
+#include <mods/scopeguard.h>
 #include <libcompress/gzip.h>
 #include <libcore/file.h>
+#include <libcore/system.h>
 #include <libcoredump/reader.h>
 #include <signal_numbers.h>
 #include <string.h>
@@ -39,23 +44,12 @@ namespace Coredump
             return Mods::adopt_own_if_nonnull(new (nothrow) Reader(file_or_error.release_value()));
         }
 
-        auto decompressed_data = decompress_coredump(file_or_error.value()->bytes());
+        auto decompressed_file_or_error = decompress_coredump(file_or_error.value()->bytes(), LexicalPath::dirname(path));
 
-        if (!decompressed_data.has_value())
-            return {};
-
-        return adopt_own_if_nonnull(new (nothrow) Reader(decompressed_data.release_value()));
-    }
+        if (decompressed_file_or_error.is_error())
+            return Mods::adopt_own_if_nonnull(new (nothrow) Reader(file_or_error.release_value()));
 
-    /**
-     * @brief Construct a new Reader::Reader object
-     * 
-     * @param buffer 
-     */
-    Reader::Reader(ByteBuffer buffer)
-        : Reader(buffer.bytes())
-    {
-        m_coredump_buffer = move(buffer);
+        return adopt_own_if_nonnull(new (nothrow) Reader(decompressed_file_or_error.release_value()));
     }
 
     /**
@@ -89,25 +83,72 @@ namespace Coredump
             return IterationDecision::Continue;
         });
         VERIFY(m_notes_segment_index != -1);
+
+        build_memory_region_index();
+    }
+
+    void Reader::build_memory_region_index()
+    {
+        for_each_memory_region_info([this](auto const& region_info) {
+            m_memory_regions.append(region_info);
+            return IterationDecision::Continue;
+        });
+
+        quick_sort(m_memory_regions, [](auto const& a, auto const& b) {
+            return a.region_start < b.region_start;
+        });
     }
 
     /**
      * @param raw_coredump 
-     * @return Optional<ByteBuffer> 
+     * @param spill_directory 
+     * @return ErrorOr<NonnullRefPtr<Core::MappedFile>> 
      */
-    Optional<ByteBuffer> Reader::decompress_coredump(ReadonlyBytes raw_coredump)
+    ErrorOr<NonnullRefPtr<Core::MappedFile>> Reader::decompress_coredump(ReadonlyBytes raw_coredump, StringView spill_directory)
     {
-        auto decompressed_coredump = Compress::GzipDecompressor::decompress_all(raw_coredump);
-
-        if (decompressed_coredump.has_value())
-            return decompressed_coredump;
-
-        auto bytebuffer = ByteBuffer::copy(raw_coredump);
+        String spill_template;
+        Vector<char> spill_path;
+        auto create_spill_file = [&](StringView directory) -> ErrorOr<int> {
+            spill_template = String::formatted("{}/.coredump.XXXXXX", directory);
+            spill_path.clear();
+            TRY(spill_path.try_append(spill_template.characters(), spill_template.length() + 1));
+            return Core::System::mkstemp(spill_path.span());
+        };
+
+        // a reader without write access to the coredump directory still gets /tmp
+        auto fd_or_error = create_spill_file(spill_directory);
+        if (fd_or_error.is_error())
+            fd_or_error = create_spill_file("/tmp"sv);
+        auto fd = TRY(fd_or_error);
+
+        ArmedScopeGuard fd_close_guard = [fd] {
+            close(fd);
+        };
+
+        StringView spill_name { spill_path.data(), spill_template.length() };
+        TRY(Core::System::unlink(spill_name));
+
+        InputMemoryStream memory_stream { raw_coredump };
+        Compress::GzipDecompressor gzip_stream { memory_stream };
+
+        static constexpr size_t chunk_size = 64 * KiB;
+        auto chunk = TRY(ByteBuffer::create_uninitialized(chunk_size));
+
+        while (!gzip_stream.has_any_error() && !gzip_stream.unreliable_eof()) {
+            auto nread = gzip_stream.read(chunk.bytes());
+            auto remaining = chunk.bytes().trim(nread);
+
+            while (!remaining.is_empty()) {
+                auto nwritten = TRY(Core::System::write(fd, remaining));
+                remaining = remaining.slice(nwritten);
+            }
+        }
 
-        if (bytebuffer.is_error())
-            return {};
+        if (gzip_stream.handle_any_error())
+            return Error::from_string_literal("Coredump: failed to decompress coredump");
 
-        return bytebuffer.release_value();
+        fd_close_guard.disarm();
+        return Core::MappedFile::map_from_fd_and_close(fd, spill_name);
     }
 
     /**
@@ -250,15 +291,18 @@ namespace Coredump
      */
     Optional<MemoryRegionInfo> Reader::region_containing(FlatPtr address) const
     {
-        Optional<MemoryRegionInfo> ret;
-        for_each_memory_region_info([&ret, address](auto const& region_info) {
-            if (region_info.region_start <= address && region_info.region_end >= address) {
-                ret = region_info;
-                return IterationDecision::Break;
-            }
-            return IterationDecision::Continue;
+        auto const* region = binary_search(m_memory_regions, address, nullptr, [](FlatPtr address, MemoryRegionInfo const& region_info) {
+            if (address < region_info.region_start)
+                return -1;
+            if (address > region_info.region_end)
+                return 1;
+            return 0;
         });
-        return ret;
+
+        if (!region)
+            return {};
+
+        return *region;
     }
 
     /**
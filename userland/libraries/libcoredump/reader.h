@@ -15,6 +15,7 @@
 #include <mods/hashmap.h>
 #include <mods/noncopyable.h>
 #include <mods/ownptr.h>
+#include <mods/vector.h>
 #include <libcore/mappedfile.h>
 #include <libelf/core.h>
 #include <libelf/image.h>
@@ -158,10 +159,20 @@ namespace Coredump
 
     private:
         explicit Reader(ReadonlyBytes);
-        explicit Reader(ByteBuffer);
         explicit Reader(NonnullRefPtr<Core::MappedFile>);
 
-        static Optional<ByteBuffer> decompress_coredump(ReadonlyBytes);
+        /**
+         * @brief streams a gzip coredump into an unlinked spill file and maps it,
+         *        so the decompressed image is backed by the page cache rather than the heap.
+         *        the spill file goes in spill_directory, next to the coredump itself, so a
+         *        large core fills the same persistent disk instead of a RAM-backed /tmp.
+         * 
+         * @param spill_directory 
+         * @return ErrorOr<NonnullRefPtr<Core::MappedFile>> 
+         */
+        static ErrorOr<NonnullRefPtr<Core::MappedFile>> decompress_coredump(ReadonlyBytes, StringView spill_directory);
+
+        void build_memory_region_index();
 
         class NotesEntryIterator 
         {
@@ -195,10 +206,10 @@ namespace Coredump
 
         RefPtr<Core::MappedFile> m_mapped_file;
 
-        ByteBuffer m_coredump_buffer;
-
         ReadonlyBytes m_coredump_bytes;
 
+        Vector<MemoryRegionInfo> m_memory_regions;
+
         ELF::Image m_coredump_image;
         ssize_t m_notes_segment_index { -1 };
     }; // class Reader
@@ -108,6 +108,20 @@ namespace Cpp
             m_parent = &parent; 
         }
 
+        /**
+         * @brief move the node by whole lines, for a node that is reused
+         *        after lines were added or removed above it.
+         * 
+         * @param delta 
+         */
+        void shift_lines(ssize_t delta)
+        {
+            if (m_start.has_value())
+                m_start->line += delta;
+            if (m_end.has_value())
+                m_end->line += delta;
+        }
+
         /**
          * @return NonnullRefPtrVector<Declaration> 
          */
@@ -0,0 +1,193 @@
+/**
+ * @file incrementalparser.cpp
+ * @author Krisna Pranav
+ * @brief incremental parser
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libcpp/incrementalparser.h>
+
+namespace Cpp
+{
+
+    // a reused declaration keeps the text it was parsed from alive. after
+    // this many versions it is parsed again so that old texts can go.
+    static constexpr u64 max_source_generations = 8;
+
+    /**
+     * @param filename
+     */
+    IncrementalParser::IncrementalParser(String const& filename)
+        : m_filename(filename)
+        , m_text(String::empty())
+    {
+        parse({}, {});
+    }
+
+    /**
+     * @param text
+     */
+    void IncrementalParser::set_text(String text)
+    {
+        auto edit = TextEdit::between(m_text, text);
+        apply_edit(move(text), edit);
+    }
+
+    /**
+     * @param text
+     * @param edit
+     */
+    void IncrementalParser::apply_edit(String text, TextEdit const& edit)
+    {
+        Lexer lexer(text);
+        lexer.set_ignore_whitespace(true);
+        auto relexed = lexer.relex(m_text, m_parser->tokens(), edit);
+
+        m_statistics = {};
+        m_statistics.relexed_tokens = relexed.relexed_count;
+        m_statistics.reused_tokens = relexed.tokens.size() - relexed.relexed_count;
+
+        ++m_generation;
+        auto reusable = find_reusable_declarations(relexed);
+
+        // the previous tokens point into the previous text until the parser
+        // holding them is replaced.
+        [[maybe_unused]] auto previous_text = move(m_text);
+        m_text = move(text);
+        parse(move(relexed.tokens), move(reusable));
+    }
+
+    /**
+     * @param tokens
+     * @param first
+     * @param count
+     * @return u64
+     */
+    u64 IncrementalParser::fingerprint(Vector<Token> const& tokens, size_t first, size_t count)
+    {
+        u64 hash = 0xcbf29ce484222325ull;
+        auto mix = [&](u8 byte) {
+            hash = (hash ^ byte) * 0x100000001b3ull;
+        };
+
+        for (size_t i = first; i < first + count; ++i) {
+            auto text = tokens[i].text();
+            mix(static_cast<u8>(tokens[i].type()));
+            for (size_t j = 0; j < text.length(); ++j)
+                mix(text[j]);
+            mix(0);
+        }
+
+        return hash;
+    }
+
+    /**
+     * @param relexed
+     * @return HashMap<size_t, IncrementalParser::Reuse>
+     */
+    HashMap<size_t, IncrementalParser::Reuse> IncrementalParser::find_reusable_declarations(RelexResult const& relexed) const
+    {
+        HashMap<size_t, Reuse> reusable;
+
+        auto const& previous_tokens = m_parser->tokens();
+        auto const& tokens = relexed.tokens;
+        size_t suffix_start = relexed.first_relexed_index + relexed.relexed_count;
+
+        for (size_t i = 0; i < m_declarations.size(); ++i) {
+            auto const& cached = m_declarations[i];
+            if (m_generation - cached.generation >= max_source_generations)
+                continue;
+
+            size_t first = cached.parsed.first_token_index;
+            size_t count = cached.parsed.token_count;
+
+            size_t new_first;
+            if (first + count <= relexed.first_relexed_index)
+                new_first = first;
+            else if (first >= relexed.previous_resume_index)
+                new_first = first - relexed.previous_resume_index + suffix_start;
+            else
+                continue;
+
+            if (count == 0 || new_first + count > tokens.size())
+                continue;
+
+            if (fingerprint(tokens, new_first, count) != cached.fingerprint)
+                continue;
+
+            // node ends are taken from the start of the token that follows,
+            // so that token has to have moved the same way.
+            bool has_next = first + count < previous_tokens.size();
+            if (has_next != (new_first + count < tokens.size()))
+                continue;
+
+            ssize_t line_delta = (ssize_t)tokens[new_first].start().line - (ssize_t)previous_tokens[first].start().line;
+            auto moved_by_lines = [&](Position before, Position after) {
+                return before.column == after.column && (ssize_t)after.line - (ssize_t)before.line == line_delta;
+            };
+
+            bool is_line_shift = true;
+            for (size_t k = 0; k < count + (has_next ? 1 : 0) && is_line_shift; ++k) {
+                auto const& before = previous_tokens[first + k];
+                auto const& after = tokens[new_first + k];
+                is_line_shift = moved_by_lines(before.start(), after.start()) && moved_by_lines(before.end(), after.end());
+            }
+
+            if (is_line_shift)
+                reusable.set(new_first, { i, line_delta });
+        }
+
+        return reusable;
+    }
+
+    /**
+     * @param tokens
+     * @param reusable
+     */
+    void IncrementalParser::parse(Vector<Token> tokens, HashMap<size_t, Reuse> reusable)
+    {
+        auto parser = make<Parser>(move(tokens), m_filename);
+
+        HashMap<Declaration const*, size_t> reused_from;
+        parser->reusable_declaration_callback = [&](size_t token_index) -> Optional<Parser::TopLevelDeclaration> {
+            auto reuse = reusable.get(token_index);
+            if (!reuse.has_value())
+                return {};
+
+            auto& cached = m_declarations[reuse->cached_index];
+            if (reuse->line_delta != 0) {
+                for (auto& node : cached.parsed.nodes)
+                    node.shift_lines(reuse->line_delta);
+            }
+
+            reused_from.set(cached.parsed.declaration.ptr(), reuse->cached_index);
+            return cached.parsed;
+        };
+
+        parser->parse();
+        parser->reusable_declaration_callback = nullptr;
+
+        Vector<CachedDeclaration> declarations;
+        declarations.ensure_capacity(parser->top_level_declarations().size());
+
+        for (auto const& parsed : parser->top_level_declarations()) {
+            if (auto cached_index = reused_from.get(parsed.declaration.ptr()); cached_index.has_value()) {
+                auto& cached = m_declarations[*cached_index];
+                declarations.append({ parsed, cached.fingerprint, cached.source, cached.generation });
+                m_statistics.reused_declarations++;
+                continue;
+            }
+
+            declarations.append({ parsed, fingerprint(parser->tokens(), parsed.first_token_index, parsed.token_count), m_text, m_generation });
+            m_statistics.parsed_declarations++;
+        }
+
+        m_declarations = move(declarations);
+        m_parser = move(parser);
+    }
+
+} // namespace Cpp
@@ -0,0 +1,141 @@
+/**
+ * @file incrementalparser.h
+ * @author Krisna Pranav
+ * @brief incremental parser
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include <mods/hashmap.h>
+#include <mods/noncopyable.h>
+#include <mods/ownptr.h>
+#include <mods/string.h>
+#include <libcpp/lexer.h>
+#include <libcpp/parser.h>
+
+namespace Cpp
+{
+
+    /**
+     * @brief keeps a file lexed and parsed across edits. after an edit only
+     *        the edited range is lexed again, and top-level declarations
+     *        whose tokens are unchanged are taken over from the previous
+     *        parse instead of being parsed again.
+     */
+    class IncrementalParser
+    {
+        MOD_MAKE_NONCOPYABLE(IncrementalParser);
+
+    public:
+        /**
+         * @param filename
+         */
+        explicit IncrementalParser(String const& filename);
+
+        /**
+         * @brief set a new version of the text; the edit is found by
+         *        comparing it with the previous one.
+         *
+         * @param text
+         */
+        void set_text(String text);
+
+        /**
+         * @brief set a new version of the text when the edit is known.
+         *
+         * @param text
+         * @param edit
+         */
+        void apply_edit(String text, TextEdit const& edit);
+
+        /**
+         * @return Parser const&
+         */
+        Parser const& parser() const
+        {
+            return *m_parser;
+        }
+
+        /**
+         * @return RefPtr<TranslationUnit const>
+         */
+        RefPtr<TranslationUnit const> root_node() const
+        {
+            return m_parser->root_node();
+        }
+
+        /**
+         * @return Vector<Token> const&
+         */
+        Vector<Token> const& tokens() const
+        {
+            return m_parser->tokens();
+        }
+
+        struct Statistics {
+            size_t relexed_tokens { 0 };
+            size_t reused_tokens { 0 };
+            size_t parsed_declarations { 0 };
+            size_t reused_declarations { 0 };
+        }; // struct Statistics
+
+        /**
+         * @return Statistics const& what the last update had to redo
+         */
+        Statistics const& statistics() const
+        {
+            return m_statistics;
+        }
+
+    private:
+        /**
+         * @brief a declaration from an earlier parse. its nodes keep views
+         *        into the text they were parsed from, so that text is kept.
+         */
+        struct CachedDeclaration {
+            Parser::TopLevelDeclaration parsed;
+            u64 fingerprint { 0 };
+            String source;
+            u64 generation { 0 };
+        }; // struct CachedDeclaration
+
+        struct Reuse {
+            size_t cached_index { 0 };
+            ssize_t line_delta { 0 };
+        }; // struct Reuse
+
+        /**
+         * @param tokens
+         * @param first
+         * @param count
+         * @return u64
+         */
+        static u64 fingerprint(Vector<Token> const& tokens, size_t first, size_t count);
+
+        /**
+         * @param relexed
+         * @return HashMap<size_t, Reuse> the cached declarations to reuse, by
+         *         the index of their first token in the relexed tokens
+         */
+        HashMap<size_t, Reuse> find_reusable_declarations(RelexResult const& relexed) const;
+
+        /**
+         * @param tokens
+         * @param reusable
+         */
+        void parse(Vector<Token> tokens, HashMap<size_t, Reuse> reusable);
+
+        String m_filename;
+        String m_text;
+        OwnPtr<Parser> m_parser;
+        Vector<CachedDeclaration> m_declarations;
+        u64 m_generation { 0 };
+        Statistics m_statistics;
+    }; // class IncrementalParser
+
+} // namespace Cpp
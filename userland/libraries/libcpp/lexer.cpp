@@ -371,7 +371,7 @@ namespace Cpp
             return 0;
         };
 
-        while (m_index < m_input.length()) {
+        while (m_index < m_input.length() && !m_stop_requested) {
             auto ch = peek();
             if (is_ascii_space(ch)) {
                 begin_token();
@@ -860,4 +860,164 @@ namespace Cpp
         return tokens;
     }
 
+    /**
+     * @param previous 
+     * @param current 
+     * @return TextEdit 
+     */
+    TextEdit TextEdit::between(StringView previous, StringView current)
+    {
+        size_t shorter = min(previous.length(), current.length());
+
+        size_t prefix = 0;
+        while (prefix < shorter && previous[prefix] == current[prefix])
+            ++prefix;
+
+        size_t suffix = 0;
+        while (suffix < shorter - prefix && previous[previous.length() - suffix - 1] == current[current.length() - suffix - 1])
+            ++suffix;
+
+        return { prefix, previous.length() - prefix - suffix, current.length() - prefix - suffix };
+    }
+
+    /**
+     * @brief every iteration of lex_impl() depends only on the text from
+     *        where it starts, so lexing can restart or stop at any token that
+     *        begins one. the pieces of strings and include statements are
+     *        emitted in the middle of an iteration.
+     *
+     * @param token 
+     * @return true 
+     * @return false 
+     */
+    static bool starts_lexer_iteration(Token const& token)
+    {
+        switch (token.type()) {
+        case Token::Type::Whitespace:
+        case Token::Type::IncludePath:
+        case Token::Type::DoubleQuotedString:
+        case Token::Type::SingleQuotedString:
+        case Token::Type::RawString:
+        case Token::Type::EscapeSequence:
+            return false;
+        default:
+            return true;
+        }
+    }
+
+    /**
+     * @param input 
+     * @param token 
+     * @return size_t 
+     */
+    static size_t offset_of(StringView input, Token const& token)
+    {
+        return token.text().characters_without_null_termination() - input.characters_without_null_termination();
+    }
+
+    // how far past the end of a token lex_impl() may peek.
+    static constexpr size_t lexer_lookahead = 16;
+
+    /**
+     * @param previous_input 
+     * @param previous_tokens 
+     * @param edit 
+     * @return RelexResult 
+     */
+    RelexResult Lexer::relex(StringView previous_input, Vector<Token> const& previous_tokens, TextEdit const& edit)
+    {
+        RelexResult result;
+        size_t count = previous_tokens.size();
+
+        // the tokens that could not have seen the edit, even peeking ahead.
+        size_t low = 0;
+        size_t high = count;
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            auto& token = previous_tokens[middle];
+            if (offset_of(previous_input, token) + token.text().length() + lexer_lookahead <= edit.offset)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        size_t restart = low;
+        while (restart > 0 && (restart == count || !starts_lexer_iteration(previous_tokens[restart])))
+            --restart;
+
+        if (restart > 0) {
+            m_index = offset_of(previous_input, previous_tokens[restart]);
+            m_position = previous_tokens[restart].start();
+            m_previous_position = m_position;
+        }
+
+        result.tokens.ensure_capacity(count);
+        for (size_t i = 0; i < restart; ++i) {
+            auto const& token = previous_tokens[i];
+            result.tokens.append(Token(token.type(), token.start(), token.end(), m_input.substring_view(offset_of(previous_input, token), token.text().length())));
+        }
+        result.first_relexed_index = restart;
+
+        size_t previous_edit_end = edit.offset + edit.removed_length;
+        size_t edit_end = edit.offset + edit.inserted_length;
+
+        size_t candidate = low;
+        while (candidate < count && offset_of(previous_input, previous_tokens[candidate]) < previous_edit_end)
+            ++candidate;
+
+        Optional<size_t> resume_index;
+        Position resume_position;
+
+        m_stop_requested = false;
+        lex_impl([&](Token token) {
+            if (resume_index.has_value())
+                return;
+
+            size_t offset = offset_of(m_input, token);
+            if (offset >= edit_end && starts_lexer_iteration(token)) {
+                size_t previous_offset = offset - edit_end + previous_edit_end;
+                while (candidate < count && offset_of(previous_input, previous_tokens[candidate]) < previous_offset)
+                    ++candidate;
+
+                if (candidate < count && offset_of(previous_input, previous_tokens[candidate]) == previous_offset && starts_lexer_iteration(previous_tokens[candidate])) {
+                    resume_index = candidate;
+                    resume_position = token.start();
+                    m_stop_requested = true;
+                    return;
+                }
+            }
+
+            result.tokens.append(move(token));
+        });
+        m_stop_requested = false;
+
+        result.relexed_count = result.tokens.size() - restart;
+        result.previous_resume_index = resume_index.value_or(count);
+
+        if (!resume_index.has_value())
+            return result;
+
+        // from here the text is the same, so are the tokens; only where they
+        // are has moved, and columns only on the line lexing stopped on.
+        auto const& resume_token = previous_tokens[*resume_index];
+        size_t resume_line = resume_token.start().line;
+        ssize_t line_delta = (ssize_t)resume_position.line - (ssize_t)resume_line;
+        ssize_t column_delta = (ssize_t)resume_position.column - (ssize_t)resume_token.start().column;
+
+        auto move_position = [&](Position position) {
+            if (position.line == resume_line)
+                position.column += column_delta;
+            position.line += line_delta;
+            return position;
+        };
+
+        for (size_t i = *resume_index; i < count; ++i) {
+            auto const& token = previous_tokens[i];
+            size_t offset = offset_of(previous_input, token) - previous_edit_end + edit_end;
+            result.tokens.append(Token(token.type(), move_position(token.start()), move_position(token.end()), m_input.substring_view(offset, token.text().length())));
+        }
+
+        return result;
+    }
+
 } // namespace Cpp
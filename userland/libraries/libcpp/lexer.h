@@ -18,6 +18,38 @@
 namespace Cpp 
 {
 
+    /**
+     * @brief a contiguous replacement: removed_length bytes at offset gave
+     *        way to inserted_length new ones.
+     */
+    struct TextEdit {
+        size_t offset { 0 };
+        size_t removed_length { 0 };
+        size_t inserted_length { 0 };
+
+        /**
+         * @brief the smallest edit that turns one text into the other, from
+         *        their common prefix and suffix.
+         *
+         * @param previous
+         * @param current
+         * @return TextEdit
+         */
+        static TextEdit between(StringView previous, StringView current);
+    }; // struct TextEdit
+
+    /**
+     * @brief tokens [0, first_relexed_index) are the previous ones, the next
+     *        relexed_count are new, and the rest are the previous tokens from
+     *        previous_resume_index on, moved to where they now are.
+     */
+    struct RelexResult {
+        Vector<Token> tokens;
+        size_t first_relexed_index { 0 };
+        size_t relexed_count { 0 };
+        size_t previous_resume_index { 0 };
+    }; // struct RelexResult
+
     class Lexer 
     {
     public:
@@ -32,6 +64,20 @@ namespace Cpp
          * @return Vector<Token> 
          */
         Vector<Token> lex();
+
+        /**
+         * @brief lex the input, which is previous_input after an edit, by
+         *        lexing only from shortly before the edit until the tokens
+         *        line up with the previous ones again. previous_tokens must
+         *        come from lexing previous_input with the same options.
+         *
+         * @param previous_input 
+         * @param previous_tokens 
+         * @param edit 
+         * @return RelexResult 
+         */
+        RelexResult relex(StringView previous_input, Vector<Token> const& previous_tokens, TextEdit const& edit);
+
         template<typename Callback>
         void lex_iterable(Callback);
 
@@ -58,6 +104,7 @@ namespace Cpp
 
         StringView m_input;
         size_t m_index { 0 };
+        bool m_stop_requested { false };
         Position m_previous_position { 0, 0 };
         Position m_position { 0, 0 };
 
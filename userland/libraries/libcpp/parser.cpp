@@ -93,11 +93,39 @@ namespace Cpp
                 continue;
             }
 
-            auto declaration = match_declaration_in_translation_unit();
-            if (declaration.has_value()) {
-                return parse_declaration(parent, declaration.value());
+            bool is_top_level = reusable_declaration_callback && &parent == m_root_node.ptr();
+            size_t first_token_index = m_state.token_index;
+
+            if (is_top_level) {
+                if (auto reused = reusable_declaration_callback(first_token_index); reused.has_value()) {
+                    reused->declaration->set_parent(parent);
+                    m_nodes.extend(reused->nodes);
+                    m_state.token_index += reused->token_count;
+                    reused->first_token_index = first_token_index;
+                    auto declaration = reused->declaration;
+                    m_top_level_declarations.append(reused.release_value());
+                    return declaration;
+                }
             }
-            return {};
+
+            size_t first_node_index = m_nodes.size();
+            size_t error_count = m_errors.size();
+
+            auto declaration_type = match_declaration_in_translation_unit();
+            if (!declaration_type.has_value())
+                return {};
+
+            auto declaration = parse_declaration(parent, declaration_type.value());
+
+            if (is_top_level && m_errors.size() == error_count) {
+                NonnullRefPtrVector<ASTNode> nodes;
+                nodes.ensure_capacity(m_nodes.size() - first_node_index);
+                for (size_t i = first_node_index; i < m_nodes.size(); ++i)
+                    nodes.append(m_nodes.ptr_at(i));
+                m_top_level_declarations.append({ first_token_index, m_state.token_index - first_token_index, declaration, move(nodes) });
+            }
+
+            return declaration;
         }
         return {};
     }
@@ -117,6 +117,34 @@ namespace Cpp
          */
         Vector<Token> tokens_in_range(Position start, Position end) const;
 
+        /**
+         * @brief a top-level declaration with the tokens it was parsed from
+         *        and every node under it, so that a later parse of the same
+         *        file can take it over if those tokens have not changed.
+         */
+        struct TopLevelDeclaration {
+            size_t first_token_index { 0 };
+            size_t token_count { 0 };
+            NonnullRefPtr<Declaration> declaration;
+            NonnullRefPtrVector<ASTNode> nodes;
+        }; // struct TopLevelDeclaration
+
+        /**
+         * @brief asked at the start of every top-level declaration for one to
+         *        reuse instead of parsing. while it is set, the parser keeps
+         *        the declarations it parses without errors in
+         *        top_level_declarations().
+         */
+        Function<Optional<TopLevelDeclaration>(size_t token_index)> reusable_declaration_callback { nullptr };
+
+        /**
+         * @return Vector<TopLevelDeclaration> const& 
+         */
+        Vector<TopLevelDeclaration> const& top_level_declarations() const 
+        { 
+            return m_top_level_declarations; 
+        }
+
     private:
         enum class DeclarationType {
             Function,
@@ -530,6 +558,7 @@ namespace Cpp
         RefPtr<TranslationUnit> m_root_node;
         Vector<String> m_errors;
         NonnullRefPtrVector<ASTNode> m_nodes;
+        Vector<TopLevelDeclaration> m_top_level_declarations;
     }; // class Parser final
 
 } // namespace Cpp
@@ -133,6 +133,14 @@ namespace Cpp
     void Preprocessor::handle_include_statement(StringView include_path)
     {
         m_included_paths.append(include_path);
+        if (m_header_cache) {
+            if (auto const* definitions = m_header_cache->definitions_in_header(include_path)) {
+                for (auto& def : *definitions)
+                    m_definitions.set(def.key, def.value);
+            }
+            return;
+        }
+
         if (definitions_in_header_callback) {
             for (auto& def : definitions_in_header_callback(include_path))
                 m_definitions.set(def.key, def.value);
@@ -453,4 +461,71 @@ namespace Cpp
         return processed_value.to_string();
     }
 
+    /**
+     * @param read_header 
+     */
+    PreprocessedHeaderCache::PreprocessedHeaderCache(Function<Optional<String>(StringView)> read_header)
+        : m_read_header(move(read_header))
+    {
+    }
+
+    /**
+     * @param include_path 
+     * @return Preprocessor::Definitions const* 
+     */
+    Preprocessor::Definitions const* PreprocessedHeaderCache::definitions_in_header(StringView include_path)
+    {
+        if (auto it = m_headers.find(include_path); it != m_headers.end()) {
+            ++m_hit_count;
+            return &it->value->definitions;
+        }
+
+        if (m_headers_in_progress.contains(include_path))
+            return nullptr;
+
+        auto text = m_read_header(include_path);
+        if (!text.has_value())
+            return nullptr;
+
+        ++m_miss_count;
+
+        String path = include_path;
+        m_headers_in_progress.set(path);
+
+        Preprocessor preprocessor(path, *text);
+        preprocessor.set_ignore_unsupported_keywords(true);
+        preprocessor.set_ignore_invalid_statements(true);
+        preprocessor.set_header_cache(this);
+        preprocessor.process_and_lex();
+
+        m_headers_in_progress.remove(path);
+
+        auto header = make<Header>();
+        header->definitions = preprocessor.definitions();
+        for (auto included_path : preprocessor.included_paths())
+            header->included_paths.append(included_path);
+
+        auto* definitions = &header->definitions;
+        m_headers.set(path, move(header));
+        return definitions;
+    }
+
+    /**
+     * @param include_path 
+     */
+    void PreprocessedHeaderCache::invalidate(StringView include_path)
+    {
+        if (!m_headers.remove(include_path))
+            return;
+
+        Vector<String> dependents;
+        for (auto& it : m_headers) {
+            if (it.value->included_paths.contains_slow(include_path))
+                dependents.append(it.key);
+        }
+
+        for (auto& dependent : dependents)
+            invalidate(dependent);
+    }
+
 }; // namespace Cpp
@@ -14,6 +14,9 @@
 #include <mods/flystring.h>
 #include <mods/function.h>
 #include <mods/hashmap.h>
+#include <mods/hashtable.h>
+#include <mods/noncopyable.h>
+#include <mods/nonnullownptr.h>
 #include <mods/optional.h>
 #include <mods/string.h>
 #include <mods/stringview.h>
@@ -23,6 +26,8 @@
 namespace Cpp 
 {
 
+    class PreprocessedHeaderCache;
+
     class Preprocessor 
     {
     public:
@@ -112,6 +117,17 @@ namespace Cpp
 
         Function<Definitions(StringView)> definitions_in_header_callback { nullptr };
 
+        /**
+         * @brief take the definitions of included headers from a cache shared
+         *        between translation units instead of definitions_in_header_callback.
+         * 
+         * @param cache 
+         */
+        void set_header_cache(PreprocessedHeaderCache* cache) 
+        { 
+            m_header_cache = cache; 
+        }
+
         /**
          * @return Vector<Token> const& 
          */
@@ -196,6 +212,7 @@ namespace Cpp
         State m_state { State::Normal };
 
         Vector<StringView> m_included_paths;
+        PreprocessedHeaderCache* m_header_cache { nullptr };
 
         struct Options {
             bool ignore_unsupported_keywords { false };
@@ -204,4 +221,65 @@ namespace Cpp
         } m_options;
     }; // class Preprocessor 
 
+    /**
+     * @brief the definitions every header leaves behind, preprocessed once and
+     *        shared by all the translation units that include it, directly or
+     *        through other headers.
+     */
+    class PreprocessedHeaderCache 
+    {
+        MOD_MAKE_NONCOPYABLE(PreprocessedHeaderCache);
+
+    public:
+        /**
+         * @brief Construct a new PreprocessedHeaderCache object
+         * 
+         * @param read_header the text of an include path, or nothing if it
+         *        cannot be found
+         */
+        explicit PreprocessedHeaderCache(Function<Optional<String>(StringView)> read_header);
+
+        /**
+         * @param include_path 
+         * @return Preprocessor::Definitions const* nullptr if the header cannot
+         *         be read or includes itself
+         */
+        Preprocessor::Definitions const* definitions_in_header(StringView include_path);
+
+        /**
+         * @brief forget a header that changed, and every header including it.
+         * 
+         * @param include_path 
+         */
+        void invalidate(StringView include_path);
+
+        /**
+         * @return size_t 
+         */
+        size_t hit_count() const 
+        { 
+            return m_hit_count; 
+        }
+
+        /**
+         * @return size_t 
+         */
+        size_t miss_count() const 
+        { 
+            return m_miss_count; 
+        }
+
+    private:
+        struct Header {
+            Preprocessor::Definitions definitions;
+            Vector<String> included_paths;
+        }; // struct Header
+
+        Function<Optional<String>(StringView)> m_read_header;
+        HashMap<String, NonnullOwnPtr<Header>> m_headers;
+        HashTable<String> m_headers_in_progress;
+        size_t m_hit_count { 0 };
+        size_t m_miss_count { 0 };
+    }; // class PreprocessedHeaderCache 
+
 } // namespace Cpp
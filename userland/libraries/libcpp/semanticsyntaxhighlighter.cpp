@@ -11,7 +11,6 @@
 
 #include "semanticsyntaxhighlighter.h"
 #include "lexer.h"
-#include <libdiff/generator.h>
 #include <libgui/autocompleteprovider.h>
 #include <libgfx/palette.h>
 
@@ -28,52 +27,48 @@ namespace Cpp
         auto text = m_client->get_text();
         {
             Threading::MutexLocker locker(m_lock);
-            Cpp::Lexer lexer(text);
-            lexer.set_ignore_whitespace(true);
-            auto current_tokens = lexer.lex();
+            auto relexed = relex_saved_tokens(text);
 
-            StringBuilder current_tokens_as_lines;
-            StringBuilder previous_tokens_as_lines;
+            // tokens before and after the relexed range are the saved ones,
+            // moved, so they keep their semantic types.
+            size_t suffix_start = relexed.first_relexed_index + relexed.relexed_count;
+            new_tokens_info.ensure_capacity(relexed.tokens.size());
 
-            for (auto& token : current_tokens)
-                current_tokens_as_lines.appendff("{}\n", token.type_as_string());
+            for (size_t i = 0; i < relexed.tokens.size(); ++i) {
+                auto& token = relexed.tokens[i];
+                auto type = GUI::AutocompleteProvider::TokenInfo::SemanticType::Unknown;
 
-            for (Cpp::Token const& token : m_saved_tokens)
-                previous_tokens_as_lines.appendff("{}\n", token.type_as_string());
+                Optional<size_t> previous_index;
+                if (i < relexed.first_relexed_index)
+                    previous_index = i;
+                else if (i >= suffix_start)
+                    previous_index = i - suffix_start + relexed.previous_resume_index;
 
-            auto previous = previous_tokens_as_lines.build();
-            auto current = current_tokens_as_lines.build();
-            auto diff_hunks = Diff::from_text(previous.view(), current.view());
+                if (previous_index.has_value() && *previous_index < m_tokens_info.size())
+                    type = m_tokens_info[*previous_index].type;
 
-            for (auto& token : current_tokens) {
-                new_tokens_info.append(GUI::AutocompleteProvider::TokenInfo { GUI::AutocompleteProvider::TokenInfo::SemanticType::Unknown,
+                new_tokens_info.append(GUI::AutocompleteProvider::TokenInfo { type,
                     token.start().line, token.start().column, token.end().line, token.end().column });
             }
-            size_t previous_token_index = 0;
-            size_t current_token_index = 0;
-            for (auto const& hunk : diff_hunks) {
-                for (; previous_token_index < hunk.original_start_line; ++previous_token_index) {
-                    new_tokens_info[current_token_index].type = m_tokens_info[previous_token_index].type;
-                    ++current_token_index;
-                }
-                for (size_t i = 0; i < hunk.added_lines.size(); ++i) {
-                    ++current_token_index;
-                }
-                for (size_t i = 0; i < hunk.removed_lines.size(); ++i) {
-                    ++previous_token_index;
-                }
-            }
-            while (current_token_index < new_tokens_info.size() && previous_token_index < m_tokens_info.size()) {
-                new_tokens_info[current_token_index].type = m_tokens_info[previous_token_index].type;
-
-                ++previous_token_index;
-                ++current_token_index;
-            }
         }
 
         update_spans(new_tokens_info, palette);
     }
 
+    /**
+     * @brief lex the text by lexing again only what changed since the saved
+     *        tokens. the result points into text.
+     * 
+     * @param text 
+     * @return RelexResult 
+     */
+    RelexResult SemanticSyntaxHighlighter::relex_saved_tokens(String const& text) const
+    {
+        Cpp::Lexer lexer(text);
+        lexer.set_ignore_whitespace(true);
+        return lexer.relex(m_saved_tokens_text, m_saved_tokens, TextEdit::between(m_saved_tokens_text, text));
+    }
+
     /**
      * @param palette 
      * @param type 
@@ -155,10 +150,9 @@ namespace Cpp
             Threading::MutexLocker locker(m_lock);
             m_tokens_info = move(tokens_info);
 
-            m_saved_tokens_text = m_client->get_text();
-            Cpp::Lexer lexer(m_saved_tokens_text);
-            lexer.set_ignore_whitespace(true);
-            m_saved_tokens = lexer.lex();
+            auto text = m_client->get_text();
+            m_saved_tokens = relex_saved_tokens(text).tokens;
+            m_saved_tokens_text = move(text);
         }
     }
 
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "lexer.h"
 #include "syntaxhighlighter.h"
 #include "token.h"
 #include <libgui/autocompleteprovider.h>
@@ -87,6 +88,12 @@ namespace Cpp
     private:
         void update_spans(Vector<GUI::AutocompleteProvider::TokenInfo> const&, Gfx::Palette const&);
 
+        /**
+         * @param text 
+         * @return RelexResult 
+         */
+        RelexResult relex_saved_tokens(String const& text) const;
+
         Cpp::SyntaxHighlighter m_simple_syntax_highlighter;
         Vector<GUI::AutocompleteProvider::TokenInfo> m_tokens_info;
         String m_saved_tokens_text;
@@ -11,73 +11,386 @@
 
 
 #include "generator.h"
+#include <mods/hashmap.h>
 
 namespace Diff 
 {
 
+    namespace 
+    {
+
+        class LineDiffer 
+        {
+        public:
+            /**
+             * @brief Construct a new LineDiffer object
+             * 
+             * @param old_ids 
+             * @param new_ids 
+             */
+            LineDiffer(Vector<u32> const& old_ids, Vector<u32> const& new_ids)
+                : m_old(old_ids)
+                , m_new(new_ids)
+            {
+                m_removed.resize(m_old.size());
+                m_added.resize(m_new.size());
+            }
+
+            /**
+             * @param algorithm 
+             */
+            void run(Algorithm algorithm)
+            {
+                if (algorithm == Algorithm::Patience)
+                    compare_patience(0, m_old.size(), 0, m_new.size());
+                else
+                    compare_myers(0, m_old.size(), 0, m_new.size());
+            }
+
+            /**
+             * @return Vector<bool> const& 
+             */
+            Vector<bool> const& removed() const 
+            { 
+                return m_removed; 
+            }
+
+            /**
+             * @return Vector<bool> const& 
+             */
+            Vector<bool> const& added() const 
+            { 
+                return m_added; 
+            }
+
+        private:
+            /**
+             * @param old_start 
+             * @param old_end 
+             * @param new_start 
+             * @param new_end 
+             * @return true 
+             * @return false 
+             */
+            bool trim_common_affixes(size_t& old_start, size_t& old_end, size_t& new_start, size_t& new_end)
+            {
+                while (old_start < old_end && new_start < new_end && m_old[old_start] == m_new[new_start]) {
+                    ++old_start;
+                    ++new_start;
+                }
+
+                while (old_start < old_end && new_start < new_end && m_old[old_end - 1] == m_new[new_end - 1]) {
+                    --old_end;
+                    --new_end;
+                }
+
+                if (old_start == old_end) {
+                    for (size_t j = new_start; j < new_end; ++j)
+                        m_added[j] = true;
+                    return true;
+                }
+
+                if (new_start == new_end) {
+                    for (size_t i = old_start; i < old_end; ++i)
+                        m_removed[i] = true;
+                    return true;
+                }
+
+                return false;
+            }
+
+            /**
+             * @param old_start 
+             * @param old_end 
+             * @param new_start 
+             * @param new_end 
+             */
+            void compare_myers(size_t old_start, size_t old_end, size_t new_start, size_t new_end)
+            {
+                if (trim_common_affixes(old_start, old_end, new_start, new_end))
+                    return;
+
+                auto split = find_middle_snake(old_start, old_end, new_start, new_end);
+                if (!split.has_value()) {
+                    for (size_t i = old_start; i < old_end; ++i)
+                        m_removed[i] = true;
+                    for (size_t j = new_start; j < new_end; ++j)
+                        m_added[j] = true;
+                    return;
+                }
+
+                compare_myers(old_start, split->old_index, new_start, split->new_index);
+                compare_myers(split->old_index, old_end, split->new_index, new_end);
+            }
+
+            struct Split {
+                size_t old_index;
+                size_t new_index;
+            }; // struct Split
+
+            /**
+             * @brief bidirectional search for the middle snake of the
+             *        shortest edit script, using O(N + M) scratch space.
+             * 
+             * @param old_start 
+             * @param old_end 
+             * @param new_start 
+             * @param new_end 
+             * @return Optional<Split> 
+             */
+            Optional<Split> find_middle_snake(size_t old_start, size_t old_end, size_t new_start, size_t new_end)
+            {
+                auto const n = static_cast<ssize_t>(old_end - old_start);
+                auto const m = static_cast<ssize_t>(new_end - new_start);
+                auto const max_d = (n + m + 1) / 2;
+                auto const v_offset = max_d;
+                auto const v_length = 2 * max_d + 2;
+
+                m_forward.resize(v_length);
+                m_backward.resize(v_length);
+                
+                for (ssize_t i = 0; i < v_length; ++i) {
+                    m_forward[i] = -1;
+                    m_backward[i] = -1;
+                }
+
+                m_forward[v_offset + 1] = 0;
+                m_backward[v_offset + 1] = 0;
+
+                auto const* a = m_old.data() + old_start;
+                auto const* b = m_new.data() + new_start;
+
+                auto const delta = n - m;
+                bool const front = (delta % 2) != 0;
+
+                ssize_t k1_start = 0;
+                ssize_t k1_end = 0;
+                ssize_t k2_start = 0;
+                ssize_t k2_end = 0;
+
+                for (ssize_t d = 0; d < max_d; ++d) {
+                    for (ssize_t k1 = -d + k1_start; k1 <= d - k1_end; k1 += 2) {
+                        auto k1_offset = v_offset + k1;
+                        ssize_t x1;
+                        if (k1 == -d || (k1 != d && m_forward[k1_offset - 1] < m_forward[k1_offset + 1]))
+                            x1 = m_forward[k1_offset + 1];
+                        else
+                            x1 = m_forward[k1_offset - 1] + 1;
+                        auto y1 = x1 - k1;
+
+                        while (x1 < n && y1 < m && a[x1] == b[y1]) {
+                            ++x1;
+                            ++y1;
+                        }
+
+                        m_forward[k1_offset] = x1;
+
+                        if (x1 > n) {
+                            k1_end += 2;
+                        } else if (y1 > m) {
+                            k1_start += 2;
+                        } else if (front) {
+                            auto k2_offset = v_offset + delta - k1;
+                            if (k2_offset >= 0 && k2_offset < v_length && m_backward[k2_offset] != -1) {
+                                auto x2 = n - m_backward[k2_offset];
+                                if (x1 >= x2)
+                                    return Split { old_start + x1, new_start + y1 };
+                            }
+                        }
+                    }
+
+                    for (ssize_t k2 = -d + k2_start; k2 <= d - k2_end; k2 += 2) {
+                        auto k2_offset = v_offset + k2;
+                        ssize_t x2;
+                        if (k2 == -d || (k2 != d && m_backward[k2_offset - 1] < m_backward[k2_offset + 1]))
+                            x2 = m_backward[k2_offset + 1];
+                        else
+                            x2 = m_backward[k2_offset - 1] + 1;
+                        auto y2 = x2 - k2;
+
+                        while (x2 < n && y2 < m && a[n - x2 - 1] == b[m - y2 - 1]) {
+                            ++x2;
+                            ++y2;
+                        }
+
+                        m_backward[k2_offset] = x2;
+
+                        if (x2 > n) {
+                            k2_end += 2;
+                        } else if (y2 > m) {
+                            k2_start += 2;
+                        } else if (!front) {
+                            auto k1_offset = v_offset + delta - k2;
+                            if (k1_offset >= 0 && k1_offset < v_length && m_forward[k1_offset] != -1) {
+                                auto x1 = m_forward[k1_offset];
+                                auto y1 = v_offset + x1 - k1_offset;
+                                if (x1 >= n - x2)
+                                    return Split { old_start + x1, new_start + y1 };
+                            }
+                        }
+                    }
+                }
+
+                return {};
+            }
+
+            /**
+             * @brief anchors the diff on lines that occur exactly once on both sides,
+             *        falling back to Myers between anchors.
+             * 
+             * @param old_start 
+             * @param old_end 
+             * @param new_start 
+             * @param new_end 
+             */
+            void compare_patience(size_t old_start, size_t old_end, size_t new_start, size_t new_end)
+            {
+                if (trim_common_affixes(old_start, old_end, new_start, new_end))
+                    return;
+
+                struct Occurrence {
+                    size_t old_count { 0 };
+                    size_t new_count { 0 };
+                    size_t old_index { 0 };
+                    size_t new_index { 0 };
+                }; // struct Occurrence
+
+                HashMap<u32, Occurrence> occurrences;
+                for (size_t i = old_start; i < old_end; ++i) {
+                    auto& occurrence = occurrences.ensure(m_old[i]);
+                    ++occurrence.old_count;
+                    occurrence.old_index = i;
+                }
+                for (size_t j = new_start; j < new_end; ++j) {
+                    auto it = occurrences.find(m_new[j]);
+                    if (it == occurrences.end())
+                        continue;
+                    ++it->value.new_count;
+                    it->value.new_index = j;
+                }
+
+                Vector<Split> candidates;
+                for (size_t i = old_start; i < old_end; ++i) {
+                    auto const& occurrence = occurrences.find(m_old[i])->value;
+                    if (occurrence.old_count == 1 && occurrence.new_count == 1)
+                        candidates.append({ i, occurrence.new_index });
+                }
+
+                auto anchors = longest_increasing_subsequence(candidates);
+                if (anchors.is_empty()) {
+                    compare_myers(old_start, old_end, new_start, new_end);
+                    return;
+                }
+
+                size_t old_cursor = old_start;
+                size_t new_cursor = new_start;
+                for (auto const& anchor : anchors) {
+                    compare_patience(old_cursor, anchor.old_index, new_cursor, anchor.new_index);
+                    old_cursor = anchor.old_index + 1;
+                    new_cursor = anchor.new_index + 1;
+                }
+                compare_patience(old_cursor, old_end, new_cursor, new_end);
+            }
+
+            /**
+             * @param candidates 
+             * @return Vector<Split> 
+             */
+            static Vector<Split> longest_increasing_subsequence(Vector<Split> const& candidates)
+            {
+                Vector<size_t> pile_tops;
+                Vector<ssize_t> predecessors;
+                predecessors.resize(candidates.size());
+
+                for (size_t index = 0; index < candidates.size(); ++index) {
+                    auto new_index = candidates[index].new_index;
+
+                    size_t low = 0;
+                    size_t high = pile_tops.size();
+                    while (low < high) {
+                        auto middle = low + (high - low) / 2;
+                        if (candidates[pile_tops[middle]].new_index < new_index)
+                            low = middle + 1;
+                        else
+                            high = middle;
+                    }
+
+                    predecessors[index] = low > 0 ? static_cast<ssize_t>(pile_tops[low - 1]) : -1;
+                    if (low == pile_tops.size())
+                        pile_tops.append(index);
+                    else
+                        pile_tops[low] = index;
+                }
+
+                Vector<Split> result;
+                if (pile_tops.is_empty())
+                    return result;
+
+                result.resize(pile_tops.size());
+                auto cursor = static_cast<ssize_t>(pile_tops.last());
+                for (size_t i = pile_tops.size(); i > 0; --i) {
+                    result[i - 1] = candidates[cursor];
+                    cursor = predecessors[cursor];
+                }
+
+                return result;
+            }
+
+            Vector<u32> const& m_old;
+            Vector<u32> const& m_new;
+            Vector<bool> m_removed;
+            Vector<bool> m_added;
+            Vector<ssize_t> m_forward;
+            Vector<ssize_t> m_backward;
+        }; // class LineDiffer
+
+    } // namespace
+
     /**
      * @param old_text 
      * @param new_text 
+     * @param algorithm 
      * @return Vector<Hunk> 
      */
-    Vector<Hunk> from_text(StringView old_text, StringView new_text)
+    Vector<Hunk> from_text(StringView old_text, StringView new_text, Algorithm algorithm)
     {
         auto old_lines = old_text.lines();
         auto new_lines = new_text.lines();
 
-        enum class Direction {
-            Down,     
-            Right,    
-            Diagonal, 
-        }; // enum class Direction
+        HashMap<StringView, u32> line_ids;
+        auto intern_lines = [&line_ids](Vector<StringView> const& lines) {
+            Vector<u32> ids;
+            ids.ensure_capacity(lines.size());
+            for (auto const& line : lines) {
+                auto next_id = static_cast<u32>(line_ids.size());
+                ids.unchecked_append(line_ids.ensure(line, [next_id] { return next_id; }));
+            }
+            return ids;
+        };
 
-        struct Cell {
-            size_t length;
-            Direction direction;
-        }; // struct Cell
+        auto old_ids = intern_lines(old_lines);
+        auto new_ids = intern_lines(new_lines);
 
-        auto dp_matrix = Vector<Cell>();
-        dp_matrix.resize((old_lines.size() + 1) * (new_lines.size() + 1));
+        LineDiffer differ(old_ids, new_ids);
+        differ.run(algorithm);
 
-        auto dp = [&dp_matrix, width = old_lines.size() + 1](size_t i, size_t j) -> Cell& {
-            return dp_matrix[i + width * j];
-        };
-
-        for (size_t i = 0; i <= old_lines.size(); ++i)
-            dp(i, new_lines.size()) = { 0, Direction::Right };
-
-        for (size_t j = 0; j <= new_lines.size(); ++j)
-            dp(old_lines.size(), 0) = { 0, Direction::Down };
-
-        for (int i = old_lines.size() - 1; i >= 0; --i) {
-            for (int j = new_lines.size() - 1; j >= 0; --j) {
-                if (old_lines[i] == new_lines[j]) {
-                    dp(i, j) = { dp(i + 1, j + 1).length + 1, Direction::Diagonal };
-                } else {
-                    auto down = dp(i, j + 1).length;
-                    auto right = dp(i + 1, j).length;
-                    if (down > right)
-                        dp(i, j) = { down, Direction::Down };
-                    else
-                        dp(i, j) = { right, Direction::Right };
-                }
-            }
-        }
+        auto const& removed = differ.removed();
+        auto const& added = differ.added();
 
         Vector<Hunk> hunks;
         Hunk cur_hunk;
         bool in_hunk = false;
 
-        auto update_hunk = [&](size_t i, size_t j, Direction direction) {
-            if (!in_hunk) {
-                in_hunk = true;
-                cur_hunk = { i, j, {}, {} };
-            }
-            if (direction == Direction::Down) {
-                cur_hunk.added_lines.append(new_lines[j]);
-            } else if (direction == Direction::Right) {
-                cur_hunk.removed_lines.append(old_lines[i]);
-            }
+        auto begin_hunk = [&](size_t i, size_t j) {
+            if (in_hunk)
+                return;
+            in_hunk = true;
+            cur_hunk = {
+                old_lines.is_empty() ? 0 : min(i, old_lines.size() - 1),
+                new_lines.is_empty() ? 0 : min(j, new_lines.size() - 1),
+                {},
+                {},
+            };
         };
 
         auto flush_hunk = [&]() {
@@ -94,14 +407,15 @@ namespace Diff
         size_t i = 0;
         size_t j = 0;
 
-        while (i < old_lines.size() && j < new_lines.size()) {
-            auto& cell = dp(i, j);
-            if (cell.direction == Direction::Down) {
-                update_hunk(i, j, cell.direction);
-                ++j;
-            } else if (cell.direction == Direction::Right) {
-                update_hunk(i, j, cell.direction);
+        while (i < old_lines.size() || j < new_lines.size()) {
+            if (i < old_lines.size() && removed[i]) {
+                begin_hunk(i, j);
+                cur_hunk.removed_lines.append(old_lines[i]);
                 ++i;
+            } else if (j < new_lines.size() && added[j]) {
+                begin_hunk(i, j);
+                cur_hunk.added_lines.append(new_lines[j]);
+                ++j;
             } else {
                 ++i;
                 ++j;
@@ -109,19 +423,9 @@ namespace Diff
             }
         }
 
-        while (i < old_lines.size()) {
-            update_hunk(i, new_lines.is_empty() ? 0 : new_lines.size() - 1, Direction::Right); // Remove a line
-            ++i;
-        }
-        while (j < new_lines.size()) {
-            update_hunk(old_lines.is_empty() ? 0 : old_lines.size() - 1, j, Direction::Down); // Add a line
-            ++j;
-        }
-
         flush_hunk();
 
         return hunks;
     }
 
 } // namespace Diff
- 
\ No newline at end of file
@@ -16,11 +16,17 @@
 namespace Diff 
 {
 
+    enum class Algorithm {
+        Myers,
+        Patience,
+    }; // enum class Algorithm
+
     /**
      * @param old_text 
      * @param new_text 
+     * @param algorithm 
      * @return Vector<Hunk> 
      */
-    Vector<Hunk> from_text(StringView old_text, StringView new_text);
+    Vector<Hunk> from_text(StringView old_text, StringView new_text, Algorithm algorithm = Algorithm::Myers);
 
 } // namespace Diff
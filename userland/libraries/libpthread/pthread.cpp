@@ -22,6 +22,7 @@
 #include <mods/stdlibextra.h>
 #include <pranaos.h>
 #include <pthread.h>
+#include <sched.h>
 #include <signal.h>
 #include <stdio.h>
 #include <string.h>
@@ -701,6 +702,7 @@ extern "C"
     }
 
     constexpr static pid_t spinlock_unlock_sentinel = 0;
+    constexpr static u32 spinlock_max_backoff = 1024;
     
     /**
      * @param lock 
@@ -734,15 +736,30 @@ extern "C"
     int pthread_spin_lock(pthread_spinlock_t* lock)
     {
         const auto desired = gettid();
+        u32 backoff = 1;
+
         while(true)
         {
-            auto current = Mods::atomic_load(&lock->m_lock);
+            auto current = Mods::atomic_load(&lock->m_lock, Mods::MemoryOrder::memory_order_relaxed);
 
             if(current == desired)
                 return EDEADLK;
 
-            if(Mods::atomic_compare_exchange_strong(&lock->m_lock, current, desired, Mods::MemoryOrder::memory_order_acquire))
-                break;
+            if(current == spinlock_unlock_sentinel) {
+                if(Mods::atomic_compare_exchange_strong(&lock->m_lock, current, desired, Mods::MemoryOrder::memory_order_acquire))
+                    break;
+                continue;
+            }
+
+            for(u32 i = 0; i < backoff; ++i)
+                __pthread_relax();
+
+            // once backing off stops helping, the owner is probably not
+            // running; give it the cpu.
+            if(backoff < spinlock_max_backoff)
+                backoff *= 2;
+            else
+                sched_yield();
         }
 
         return 0;
@@ -11,6 +11,7 @@
 
 #include <mods/string.h>
 #include <mods/string_builder.h>
+#include <mods/utf8view.h>
 #include <libtextcodec/decoder.h>
 
 namespace TextCodec {
@@ -20,6 +21,7 @@ namespace TextCodec {
         Latin1Decoder s_latin1_decoder;
         UTF8Decoder s_utf8_decoder;
         UTF16BEDecoder s_utf16be_decoder;
+        UTF16LEDecoder s_utf16le_decoder;
         Latin2Decoder s_latin2_decoder;
         HebrewDecoder s_hebrew_decoder;
         CyrillicDecoder s_cyrillic_decoder;
@@ -44,6 +46,8 @@ namespace TextCodec {
                 return &s_utf8_decoder;
             if (encoding.value().equals_ignoring_case("utf-16be"))
                 return &s_utf16be_decoder;
+            if (encoding.value().equals_ignoring_case("utf-16le"))
+                return &s_utf16le_decoder;
             if (encoding.value().equals_ignoring_case("iso-8859-2"))
                 return &s_latin2_decoder;
             if (encoding.value().equals_ignoring_case("windows-1255"))
@@ -183,7 +187,7 @@ namespace TextCodec {
         case 0xFE: 
             return bytes[1] == 0xFF ? &s_utf16be_decoder : nullptr;
         case 0xFF: 
-            TODO();
+            return bytes[1] == 0xFE ? &s_utf16le_decoder : nullptr;
         }
 
         return nullptr;
@@ -215,7 +219,15 @@ namespace TextCodec {
     String Decoder::to_utf8(StringView input)
     {
         StringBuilder builder(input.length());
-        process(input, [&builder](u32 c) { builder.append_code_point(c); });
+        u8 buffer[4096];
+
+        auto remaining = input.bytes();
+        while (!remaining.is_empty()) {
+            auto result = decode_to_utf8(remaining, { buffer, sizeof(buffer) });
+            builder.append(StringView { reinterpret_cast<char const*>(buffer), result.produced });
+            remaining = remaining.slice(result.consumed);
+        }
+
         return builder.to_string();
     }
 
@@ -230,6 +242,17 @@ namespace TextCodec {
         }
     }
 
+    /**
+     * @param input 
+     * @param output 
+     * @param input_is_complete 
+     * @return TranscodeResult 
+     */
+    TranscodeResult UTF8Decoder::decode_to_utf8(ReadonlyBytes input, Bytes output, bool input_is_complete)
+    {
+        return transcode_utf8_to_utf8(input, output, input_is_complete);
+    }
+
     /**
      * @param input 
      * @return String 
@@ -245,17 +268,56 @@ namespace TextCodec {
         return bomless_input;
     }
 
+    namespace 
+    {
+        /**
+         * @param input 
+         * @param endianness 
+         * @param on_code_point 
+         */
+        void process_utf16(StringView input, Utf16Endianness endianness, Function<void(u32)>& on_code_point)
+        {
+            auto read_unit = [&](size_t i) -> u16 {
+                u8 first = input[i];
+                u8 second = input[i + 1];
+                return endianness == Utf16Endianness::Big ? (first << 8) | second : first | (second << 8);
+            };
+
+            size_t utf16_length = input.length() - (input.length() % 2);
+            for (size_t i = 0; i < utf16_length; i += 2) {
+                u32 code_point = read_unit(i);
+
+                if (code_point >= 0xD800 && code_point <= 0xDBFF && i + 2 < utf16_length) {
+                    u16 low = read_unit(i + 2);
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                        i += 2;
+                    }
+                }
+
+                on_code_point(code_point);
+            }
+        }
+    } // anonymous namespace
+
     /**
      * @param input 
      * @param on_code_point 
      */
     void UTF16BEDecoder::process(StringView input, Function<void(u32)> on_code_point)
     {
-        size_t utf16_length = input.length() - (input.length() % 2);
-        for (size_t i = 0; i < utf16_length; i += 2) {
-            u16 code_point = (input[i] << 8) | input[i + 1];
-            on_code_point(code_point);
-        }
+        process_utf16(input, Utf16Endianness::Big, on_code_point);
+    }
+
+    /**
+     * @param input 
+     * @param output 
+     * @param input_is_complete 
+     * @return TranscodeResult 
+     */
+    TranscodeResult UTF16BEDecoder::decode_to_utf8(ReadonlyBytes input, Bytes output, bool input_is_complete)
+    {
+        return transcode_utf16_to_utf8(input, output, Utf16Endianness::Big, input_is_complete);
     }
     
     /**
@@ -270,31 +332,72 @@ namespace TextCodec {
             bomless_input = input.substring_view(2);
         }
 
-        StringBuilder builder(bomless_input.length() / 2);
+        return Decoder::to_utf8(bomless_input);
+    }
 
-        process(bomless_input, [&builder](u32 c) { builder.append_code_point(c); });
-        return builder.to_string();
+    /**
+     * @param input 
+     * @param on_code_point 
+     */
+    void UTF16LEDecoder::process(StringView input, Function<void(u32)> on_code_point)
+    {
+        process_utf16(input, Utf16Endianness::Little, on_code_point);
+    }
+
+    /**
+     * @param input 
+     * @param output 
+     * @param input_is_complete 
+     * @return TranscodeResult 
+     */
+    TranscodeResult UTF16LEDecoder::decode_to_utf8(ReadonlyBytes input, Bytes output, bool input_is_complete)
+    {
+        return transcode_utf16_to_utf8(input, output, Utf16Endianness::Little, input_is_complete);
+    }
+
+    /**
+     * @param input 
+     * @return String 
+     */
+    String UTF16LEDecoder::to_utf8(StringView input)
+    {
+        auto bomless_input = input;
+
+        if (auto bytes = input.bytes(); bytes.size() >= 2 && bytes[0] == 0xFF && bytes[1] == 0xFE) {
+            bomless_input = input.substring_view(2);
+        }
+
+        return Decoder::to_utf8(bomless_input);
     }
 
     /**
      * @param input 
      * @param on_code_point 
      */
-    void Latin1Decoder::process(StringView input, Function<void(u32)> on_code_point)
+    void SingleByteDecoder::process(StringView input, Function<void(u32)> on_code_point)
     {
-        for (size_t i = 0; i < input.length(); ++i) {
-            u8 ch = input[i];
-            on_code_point(ch);
+        for (u8 ch : input) {
+            on_code_point(m_table.code_point(ch));
         }
     }
 
+    /**
+     * @param input 
+     * @param output 
+     * @return TranscodeResult 
+     */
+    TranscodeResult SingleByteDecoder::decode_to_utf8(ReadonlyBytes input, Bytes output, bool)
+    {
+        return transcode_single_byte_to_utf8(input, output, m_table);
+    }
+
     namespace 
     {
         /**
          * @param in 
          * @return u32 
          */
-        u32 convert_latin2_to_utf8(u8 in)
+        constexpr u32 convert_latin2_to_utf8(u8 in)
         {
             switch (in) {
 
@@ -370,26 +473,26 @@ namespace TextCodec {
                 return in;
             }
         }
-    } // anonymous namespace
 
-    /**
-     * @param input 
-     * @param on_code_point 
-     */
-    void Latin2Decoder::process(StringView input, Function<void(u32)> on_code_point)
-    {
-        for (auto c : input) {
-            on_code_point(convert_latin2_to_utf8(c));
+        /**
+         * @tparam Callback 
+         * @param callback 
+         * @return Array<u32, 128> 
+         */
+        template<typename Callback>
+        constexpr Array<u32, 128> high_half_table(Callback callback)
+        {
+            Array<u32, 128> table {};
+            for (size_t i = 0; i < 128; ++i)
+                table[i] = callback(0x80 + i);
+            return table;
         }
-    }
 
-    /**
-     * @param input 
-     * @param on_code_point 
-     */
-    void HebrewDecoder::process(StringView input, Function<void(u32)> on_code_point)
-    {
-        static constexpr Array<u32, 128> translation_table = {
+        constexpr auto s_latin1_table = high_half_table([](u8 ch) -> u32 { return ch; });
+
+        constexpr auto s_latin2_table = high_half_table(convert_latin2_to_utf8);
+
+        constexpr Array<u32, 128> s_hebrew_table = {
             0x20AC, 0xFFFD, 0x201A, 0x192, 0x201E, 0x2026, 0x2020, 0x2021, 0x2C6, 0x2030, 0xFFFD, 0x2039, 0xFFFD, 0xFFFD, 0xFFFD, 0xFFFD,
             0xFFFD, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014, 0x2DC, 0x2122, 0xFFFD, 0x203A, 0xFFFD, 0xFFFD, 0xFFFD, 0xFFFD,
             0xA0, 0xA1, 0xA2, 0xA3, 0x20AA, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xD7, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF,
@@ -400,22 +503,7 @@ namespace TextCodec {
             0x5E0, 0x5E1, 0x5E2, 0x5E3, 0x5E4, 0x5E5, 0x5E6, 0x5E7, 0x5E8, 0x5E9, 0x5EA, 0xFFFD, 0xFFFD, 0x200E, 0x200F, 0xFFFD
         };
 
-        for (unsigned char ch : input) {
-            if (ch < 0x80) { 
-                on_code_point(ch);
-            } else {
-                on_code_point(translation_table[ch - 0x80]);
-            }
-        }
-    }
-
-    /**
-     * @param input 
-     * @param on_code_point 
-     */
-    void CyrillicDecoder::process(StringView input, Function<void(u32)> on_code_point)
-    {
-        static constexpr Array<u32, 128> translation_table = {
+        constexpr Array<u32, 128> s_cyrillic_table = {
             0x402, 0x403, 0x201A, 0x453, 0x201E, 0x2026, 0x2020, 0x2021, 0x20AC, 0x2030, 0x409, 0x2039, 0x40A, 0x40C, 0x40B, 0x40F,
             0x452, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014, 0xFFFD, 0x2122, 0x459, 0x203A, 0x45A, 0x45C, 0x45B, 0x45F,
             0xA0, 0x40E, 0x45E, 0x408, 0xA4, 0x490, 0xA6, 0xA7, 0x401, 0xA9, 0x404, 0xAB, 0xAC, 0xAD, 0xAE, 0x407,
@@ -426,22 +514,7 @@ namespace TextCodec {
             0x440, 0x441, 0x442, 0x443, 0x444, 0x445, 0x446, 0x447, 0x448, 0x449, 0x44A, 0x44B, 0x44C, 0x44D, 0x44E, 0x44F
         };
 
-        for (unsigned char ch : input) {
-            if (ch < 0x80) { 
-                on_code_point(ch);
-            } else {
-                on_code_point(translation_table[ch - 0x80]);
-            }
-        }
-    }
-
-    /**
-     * @param input 
-     * @param on_code_point 
-     */
-    void Koi8RDecoder::process(StringView input, Function<void(u32)> on_code_point)
-    {
-        static constexpr Array<u32, 128> translation_table = {
+        constexpr Array<u32, 128> s_koi8r_table = {
             0x2500,0x2502,0x250c,0x2510,0x2514,0x2518,0x251c,0x2524,0x252c,0x2534,0x253c,0x2580,0x2584,0x2588,0x258c,0x2590,
             0x2591,0x2592,0x2593,0x2320,0x25a0,0x2219,0x221a,0x2248,0x2264,0x2265,0xA0,0x2321,0xb0,0xb2,0xb7,0xf7,
             0x2550,0x2551,0x2552,0xd191,0x2553,0x2554,0x2555,0x2556,0x2557,0x2558,0x2559,0x255a,0x255b,0x255c,0x255d,0x255e,
@@ -451,23 +524,8 @@ namespace TextCodec {
             0x42e,0x410,0x441,0x426,0x414,0x415,0x424,0x413,0x425,0x418,0x419,0x41a,0x41b,0x41c,0x41d,0x41e,
             0x41f,0x42f,0x420,0x421,0x422,0x423,0x416,0x412,0x42c,0x42b,0x417,0x428,0x42d,0x429,0x427,0x42a,
         };
-     
-        for (unsigned char ch : input) {
-            if (ch < 0x80) { 
-                on_code_point(ch);
-            } else {
-                on_code_point(translation_table[ch - 0x80]);
-            }
-        }
-    }
 
-    /**
-     * @param input 
-     * @param on_code_point 
-     */
-    void Latin9Decoder::process(StringView input, Function<void(u32)> on_code_point)
-    {
-        auto convert_latin9_to_utf8 = [](u8 ch) -> u32 {
+        constexpr auto s_latin9_table = high_half_table([](u8 ch) -> u32 {
             switch (ch) {
             case 0xA4:
                 return 0x20AC;
@@ -488,20 +546,9 @@ namespace TextCodec {
             default:
                 return ch;
             }
-        };
+        });
 
-        for (auto ch : input) {
-            on_code_point(convert_latin9_to_utf8(ch));
-        }
-    }
-
-    /**
-     * @param input 
-     * @param on_code_point 
-     */
-    void TurkishDecoder::process(StringView input, Function<void(u32)> on_code_point)
-    {
-        auto convert_turkish_to_utf8 = [](u8 ch) -> u32 {
+        constexpr auto s_turkish_table = high_half_table([](u8 ch) -> u32 {
             switch (ch) {
             case 0xD0:
                 return 0x11E;
@@ -518,29 +565,51 @@ namespace TextCodec {
             default:
                 return ch;
             }
-        };
+        });
 
-        for (auto ch : input) {
-            on_code_point(convert_turkish_to_utf8(ch));
-        }
+        constexpr auto s_x_user_defined_table = high_half_table([](u8 ch) -> u32 {
+            return 0xF780 + ch - 0x80;
+        });
+    } // anonymous namespace
+
+    Latin1Decoder::Latin1Decoder()
+        : SingleByteDecoder(s_latin1_table)
+    {
     }
 
-    /**
-     * @param input 
-     * @param on_code_point 
-     */
-    void XUserDefinedDecoder::process(StringView input, Function<void(u32)> on_code_point)
+    Latin2Decoder::Latin2Decoder()
+        : SingleByteDecoder(s_latin2_table)
     {
-        auto convert_x_user_defined_to_utf8 = [](u8 ch) -> u32 {
-            if (ch <= 0x7f)
-                return ch;
+    }
 
-            return 0xF780 + ch - 0x80;
-        };
+    HebrewDecoder::HebrewDecoder()
+        : SingleByteDecoder(s_hebrew_table)
+    {
+    }
 
-        for (auto ch : input) {
-            on_code_point(convert_x_user_defined_to_utf8(ch));
-        }
+    CyrillicDecoder::CyrillicDecoder()
+        : SingleByteDecoder(s_cyrillic_table)
+    {
+    }
+
+    Koi8RDecoder::Koi8RDecoder()
+        : SingleByteDecoder(s_koi8r_table)
+    {
+    }
+
+    Latin9Decoder::Latin9Decoder()
+        : SingleByteDecoder(s_latin9_table)
+    {
+    }
+
+    TurkishDecoder::TurkishDecoder()
+        : SingleByteDecoder(s_turkish_table)
+    {
+    }
+
+    XUserDefinedDecoder::XUserDefinedDecoder()
+        : SingleByteDecoder(s_x_user_defined_table)
+    {
     }
 
 }
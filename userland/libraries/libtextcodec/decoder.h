@@ -13,6 +13,7 @@
 
 #include <mods/forward.h>
 #include <mods/function.h>
+#include <libtextcodec/transcoding.h>
 
 namespace TextCodec 
 {
@@ -25,6 +26,19 @@ namespace TextCodec
          */
         virtual void process(StringView, Function<void(u32)> on_code_point) = 0;
 
+        /**
+         * @brief decodes straight into a caller's buffer as UTF-8, without a
+         *        call per code point. call again from input[consumed] until
+         *        all input is consumed; feeding a stream in pieces, pass
+         *        input_is_complete = false for all but the last one.
+         *
+         * @param input 
+         * @param output 
+         * @param input_is_complete 
+         * @return TranscodeResult 
+         */
+        virtual TranscodeResult decode_to_utf8(ReadonlyBytes input, Bytes output, bool input_is_complete = true) = 0;
+
         /**
          * @return String 
          */
@@ -46,6 +60,14 @@ namespace TextCodec
          */
         virtual void process(StringView, Function<void(u32)> on_code_point) override;
 
+        /**
+         * @param input 
+         * @param output 
+         * @param input_is_complete 
+         * @return TranscodeResult 
+         */
+        virtual TranscodeResult decode_to_utf8(ReadonlyBytes input, Bytes output, bool input_is_complete = true) override;
+
         /**
          * @return String 
          */
@@ -60,83 +82,121 @@ namespace TextCodec
          */
         virtual void process(StringView, Function<void(u32)> on_code_point) override;
 
+        /**
+         * @param input 
+         * @param output 
+         * @param input_is_complete 
+         * @return TranscodeResult 
+         */
+        virtual TranscodeResult decode_to_utf8(ReadonlyBytes input, Bytes output, bool input_is_complete = true) override;
+
         /**
          * @return String 
          */
         virtual String to_utf8(StringView) override;
     }; // class UTF16BEDecoder final : public Decoder 
 
-    class Latin1Decoder final : public Decoder 
+    class UTF16LEDecoder final : public Decoder 
     {
     public:
         /**
          * @param on_code_point 
          */
         virtual void process(StringView, Function<void(u32)> on_code_point) override;
-    }; // class Latin1Decoder final : public Decoder 
 
-    class Latin2Decoder final : public Decoder 
-    {
-    public:
         /**
-         * @param on_code_point 
+         * @param input 
+         * @param output 
+         * @param input_is_complete 
+         * @return TranscodeResult 
          */
-        virtual void process(StringView, Function<void(u32)> on_code_point) override;
-    }; // class Latin2Decoder final : public Decoder 
+        virtual TranscodeResult decode_to_utf8(ReadonlyBytes input, Bytes output, bool input_is_complete = true) override;
 
-    class HebrewDecoder final : public Decoder 
-    {
-    public:
         /**
-         * @param on_code_point 
+         * @return String 
          */
-        virtual void process(StringView, Function<void(u32)> on_code_point) override;
-    }; // class HebrewDecoder final : public Decoder 
+        virtual String to_utf8(StringView) override;
+    }; // class UTF16LEDecoder final : public Decoder 
 
-    class CyrillicDecoder final : public Decoder 
+    /**
+     * @brief the ASCII-compatible single-byte encodings, which differ only
+     *        in what their high half maps to.
+     */
+    class SingleByteDecoder : public Decoder 
     {
     public:
         /**
          * @param on_code_point 
          */
         virtual void process(StringView, Function<void(u32)> on_code_point) override;
-    }; // class CyrillicDecoder final : public Decoder 
 
-    class Koi8RDecoder final : public Decoder 
-    {
-    public:
         /**
-         * @param on_code_point 
+         * @param input 
+         * @param output 
+         * @return TranscodeResult 
          */
-        virtual void process(StringView, Function<void(u32)> on_code_point) override;
-    }; // class Koi8RDecoder final : public Decoder 
+        virtual TranscodeResult decode_to_utf8(ReadonlyBytes input, Bytes output, bool = true) override;
 
-    class Latin9Decoder final : public Decoder 
-    {
-    public:
+    protected:
         /**
-         * @param on_code_point 
+         * @param high_half code points for bytes 0x80 to 0xFF
          */
-        virtual void process(StringView, Function<void(u32)> on_code_point) override;
-    }; // class Latin9Decoder final : public Decoder 
+        explicit SingleByteDecoder(Array<u32, 128> const& high_half)
+            : m_table(high_half)
+        {
+        }
+
+    private:
+        SingleByteTable m_table;
+    }; // class SingleByteDecoder : public Decoder 
 
-    class TurkishDecoder final : public Decoder 
+    class Latin1Decoder final : public SingleByteDecoder 
     {
     public:
-        /**
-         * @param on_code_point 
-         */
-        virtual void process(StringView, Function<void(u32)> on_code_point) override;
-    }; // class TurkishDecoder final : public Decoder 
+        Latin1Decoder();
+    }; // class Latin1Decoder final : public SingleByteDecoder 
 
-    class XUserDefinedDecoder final : public Decoder 
+    class Latin2Decoder final : public SingleByteDecoder 
     {
     public:
-        /**
-         * @param on_code_point 
-         */
-        virtual void process(StringView, Function<void(u32)> on_code_point) override;
-    }; // class XUserDefinedDecoder final : public Decoder 
+        Latin2Decoder();
+    }; // class Latin2Decoder final : public SingleByteDecoder 
+
+    class HebrewDecoder final : public SingleByteDecoder 
+    {
+    public:
+        HebrewDecoder();
+    }; // class HebrewDecoder final : public SingleByteDecoder 
+
+    class CyrillicDecoder final : public SingleByteDecoder 
+    {
+    public:
+        CyrillicDecoder();
+    }; // class CyrillicDecoder final : public SingleByteDecoder 
+
+    class Koi8RDecoder final : public SingleByteDecoder 
+    {
+    public:
+        Koi8RDecoder();
+    }; // class Koi8RDecoder final : public SingleByteDecoder 
+
+    class Latin9Decoder final : public SingleByteDecoder 
+    {
+    public:
+        Latin9Decoder();
+    }; // class Latin9Decoder final : public SingleByteDecoder 
+
+    class TurkishDecoder final : public SingleByteDecoder 
+    {
+    public:
+        TurkishDecoder();
+    }; // class TurkishDecoder final : public SingleByteDecoder 
+
+    class XUserDefinedDecoder final : public SingleByteDecoder 
+    {
+    public:
+        XUserDefinedDecoder();
+    }; // class XUserDefinedDecoder final : public SingleByteDecoder 
 
     /**
      * @param encoding 
@@ -0,0 +1,429 @@
+/**
+ * @file transcoding.cpp
+ * @author Krisna Pranav
+ * @brief Transcoding
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <mods/charactertypes.h>
+#include <mods/simd.h>
+#include <mods/stdlibextra.h>
+#include <mods/utf8view.h>
+#include <libtextcodec/transcoding.h>
+#include <string.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace TextCodec
+{
+
+    namespace
+    {
+        using namespace Mods::SIMD;
+
+        using u16x8_unaligned = u16 __attribute__((vector_size(16), aligned(1), may_alias));
+        using u8x8_unaligned = u8 __attribute__((vector_size(8), aligned(1), may_alias));
+        using u64_unaligned = u64 __attribute__((aligned(1), may_alias));
+
+        constexpr u32 replacement_character = 0xFFFD;
+
+        enum class Utf8Sequence
+        {
+            Valid,
+            Invalid,
+            Truncated,
+        }; // enum class Utf8Sequence
+
+        /**
+         * @param code_point
+         * @return size_t
+         */
+        ALWAYS_INLINE size_t utf8_length(u32 code_point)
+        {
+            if (code_point < 0x80)
+                return 1;
+            if (code_point < 0x800)
+                return 2;
+            if (code_point < 0x10000)
+                return 3;
+            return 4;
+        }
+
+        /**
+         * @param output
+         * @param code_point
+         * @param length
+         */
+        ALWAYS_INLINE void write_utf8(u8* output, u32 code_point, size_t length)
+        {
+            switch (length) {
+            case 1:
+                output[0] = code_point;
+                break;
+            case 2:
+                output[0] = 0xC0 | (code_point >> 6);
+                output[1] = 0x80 | (code_point & 0x3F);
+                break;
+            case 3:
+                output[0] = 0xE0 | (code_point >> 12);
+                output[1] = 0x80 | ((code_point >> 6) & 0x3F);
+                output[2] = 0x80 | (code_point & 0x3F);
+                break;
+            default:
+                output[0] = 0xF0 | (code_point >> 18);
+                output[1] = 0x80 | ((code_point >> 12) & 0x3F);
+                output[2] = 0x80 | ((code_point >> 6) & 0x3F);
+                output[3] = 0x80 | (code_point & 0x3F);
+                break;
+            }
+        }
+
+        /**
+         * @param input
+         * @param endianness
+         * @return u16
+         */
+        ALWAYS_INLINE u16 read_utf16(u8 const* input, Utf16Endianness endianness)
+        {
+            if (endianness == Utf16Endianness::Big)
+                return (input[0] << 8) | input[1];
+            return input[0] | (input[1] << 8);
+        }
+
+        /**
+         * @param output
+         * @param unit
+         * @param endianness
+         */
+        ALWAYS_INLINE void write_utf16(u8* output, u16 unit, Utf16Endianness endianness)
+        {
+            if (endianness == Utf16Endianness::Big) {
+                output[0] = unit >> 8;
+                output[1] = unit;
+            } else {
+                output[0] = unit;
+                output[1] = unit >> 8;
+            }
+        }
+
+        /**
+         * @brief decodes one sequence by the same rules as validate_utf8(),
+         *        so that the two agree on where valid text ends.
+         *
+         * @param input
+         * @param length
+         * @param code_point
+         * @param sequence_length
+         * @return Utf8Sequence
+         */
+        Utf8Sequence decode_utf8(u8 const* input, size_t length, u32& code_point, size_t& sequence_length)
+        {
+            u8 lead = input[0];
+
+            if (lead < 0x80) {
+                code_point = lead;
+                sequence_length = 1;
+                return Utf8Sequence::Valid;
+            }
+
+            if ((lead & 0xE0) == 0xC0) {
+                code_point = lead & 0x1F;
+                sequence_length = 2;
+            } else if ((lead & 0xF0) == 0xE0) {
+                code_point = lead & 0x0F;
+                sequence_length = 3;
+            } else if ((lead & 0xF8) == 0xF0) {
+                code_point = lead & 0x07;
+                sequence_length = 4;
+            } else {
+                return Utf8Sequence::Invalid;
+            }
+
+            size_t available = min(length, sequence_length);
+            for (size_t i = 1; i < available; ++i) {
+                if ((input[i] & 0xC0) != 0x80)
+                    return Utf8Sequence::Invalid;
+                code_point = (code_point << 6) | (input[i] & 0x3F);
+            }
+
+            if (available < sequence_length)
+                return Utf8Sequence::Truncated;
+
+            return is_unicode(code_point) ? Utf8Sequence::Valid : Utf8Sequence::Invalid;
+        }
+    } // namespace
+
+    /**
+     * @param high_half
+     */
+    SingleByteTable::SingleByteTable(Array<u32, 128> const& high_half)
+        : m_high_half(high_half)
+    {
+        for (size_t i = 0; i < 128; ++i) {
+            u32 code_point = high_half[i];
+            size_t length = utf8_length(code_point);
+            VERIFY(length <= 3);
+
+            u8 bytes[4] = {};
+            write_utf8(bytes, code_point, length);
+            m_packed_utf8[i] = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (length << 24);
+        }
+    }
+
+    /**
+     * @brief ASCII runs are found a vector at a time and copied with
+     *        memcpy; the bytes between them are table lookups.
+     *
+     * @param input
+     * @param output
+     * @param table
+     * @return TranscodeResult
+     */
+    TranscodeResult transcode_single_byte_to_utf8(ReadonlyBytes input, Bytes output, SingleByteTable const& table)
+    {
+        u8 const* in = input.data();
+        u8 const* in_end = in + input.size();
+        u8* out = output.data();
+        u8* out_end = out + output.size();
+
+        while (in < in_end) {
+            size_t run = ascii_prefix_length(in, min<size_t>(in_end - in, out_end - out));
+            memcpy(out, in, run);
+            in += run;
+            out += run;
+
+            if (in == in_end || out == out_end)
+                break;
+
+            bool output_full = false;
+            while (in < in_end && *in >= 0x80) {
+                u32 packed = table.packed_utf8(*in);
+                size_t length = packed >> 24;
+                if ((size_t)(out_end - out) < length) {
+                    output_full = true;
+                    break;
+                }
+
+                out[0] = packed;
+                if (length > 1)
+                    out[1] = packed >> 8;
+                if (length > 2)
+                    out[2] = packed >> 16;
+
+                out += length;
+                ++in;
+            }
+
+            if (output_full)
+                break;
+        }
+
+        return { (size_t)(in - input.data()), (size_t)(out - output.data()) };
+    }
+
+    /**
+     * @brief runs of ASCII code units are narrowed eight at a time.
+     *
+     * @param input
+     * @param output
+     * @param endianness
+     * @param input_is_complete
+     * @return TranscodeResult
+     */
+    TranscodeResult transcode_utf16_to_utf8(ReadonlyBytes input, Bytes output, Utf16Endianness endianness, bool input_is_complete)
+    {
+        u8 const* in = input.data();
+        u8 const* in_end = in + input.size();
+        u8* out = output.data();
+        u8* out_end = out + output.size();
+
+        while (in_end - in >= 2) {
+            u32 code_point = read_utf16(in, endianness);
+
+            if (code_point < 0x80) {
+                while (in_end - in >= 16 && out_end - out >= 8) {
+                    u16x8 units = *reinterpret_cast<u16x8_unaligned const*>(in);
+                    if (endianness == Utf16Endianness::Big)
+                        units = (units << 8) | (units >> 8);
+
+                    auto non_ascii = (u64x2)(units & 0xFF80);
+                    if (non_ascii[0] | non_ascii[1])
+                        break;
+
+                    *reinterpret_cast<u8x8_unaligned*>(out) = __builtin_convertvector(units, u8x8);
+                    in += 16;
+                    out += 8;
+                }
+
+                if (in_end - in < 2)
+                    break;
+                code_point = read_utf16(in, endianness);
+            }
+
+            size_t consumed = 2;
+            if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+                if (in_end - in < 4) {
+                    if (!input_is_complete)
+                        break;
+                    code_point = replacement_character;
+                } else if (u16 low = read_utf16(in + 2, endianness); low >= 0xDC00 && low <= 0xDFFF) {
+                    code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                    consumed = 4;
+                } else {
+                    code_point = replacement_character;
+                }
+            } else if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+                code_point = replacement_character;
+            }
+
+            size_t length = utf8_length(code_point);
+            if ((size_t)(out_end - out) < length)
+                break;
+
+            write_utf8(out, code_point, length);
+            out += length;
+            in += consumed;
+        }
+
+        if (in_end - in == 1 && input_is_complete && out_end - out >= 3) {
+            write_utf8(out, replacement_character, 3);
+            out += 3;
+            in++;
+        }
+
+        return { (size_t)(in - input.data()), (size_t)(out - output.data()) };
+    }
+
+    /**
+     * @brief runs of ASCII are widened eight bytes at a time.
+     *
+     * @param input
+     * @param output
+     * @param endianness
+     * @param input_is_complete
+     * @return TranscodeResult
+     */
+    TranscodeResult transcode_utf8_to_utf16(ReadonlyBytes input, Bytes output, Utf16Endianness endianness, bool input_is_complete)
+    {
+        u8 const* in = input.data();
+        u8 const* in_end = in + input.size();
+        u8* out = output.data();
+        u8* out_end = out + output.size();
+
+        while (in < in_end) {
+            if (*in < 0x80) {
+                while (in_end - in >= 8 && out_end - out >= 16) {
+                    if (*reinterpret_cast<u64_unaligned const*>(in) & 0x8080808080808080ull)
+                        break;
+
+                    auto units = __builtin_convertvector(*reinterpret_cast<u8x8_unaligned const*>(in), u16x8);
+                    if (endianness == Utf16Endianness::Big)
+                        units = (units << 8) | (units >> 8);
+
+                    *reinterpret_cast<u16x8_unaligned*>(out) = units;
+                    in += 8;
+                    out += 16;
+                }
+
+                if (in == in_end)
+                    break;
+
+                if (*in < 0x80) {
+                    if (out_end - out < 2)
+                        break;
+                    write_utf16(out, *in, endianness);
+                    in++;
+                    out += 2;
+                    continue;
+                }
+            }
+
+            u32 code_point = 0;
+            size_t length = 1;
+            auto sequence = decode_utf8(in, in_end - in, code_point, length);
+
+            if (sequence == Utf8Sequence::Truncated && !input_is_complete)
+                break;
+
+            if (sequence != Utf8Sequence::Valid) {
+                length = sequence == Utf8Sequence::Truncated ? in_end - in : 1;
+                code_point = replacement_character;
+            } else if (code_point >= 0xD800 && code_point <= 0xDFFF) {
+                code_point = replacement_character;
+            }
+
+            size_t needed = code_point >= 0x10000 ? 4 : 2;
+            if ((size_t)(out_end - out) < needed)
+                break;
+
+            if (code_point >= 0x10000) {
+                code_point -= 0x10000;
+                write_utf16(out, 0xD800 | (code_point >> 10), endianness);
+                write_utf16(out + 2, 0xDC00 | (code_point & 0x3FF), endianness);
+            } else {
+                write_utf16(out, code_point, endianness);
+            }
+
+            in += length;
+            out += needed;
+        }
+
+        return { (size_t)(in - input.data()), (size_t)(out - output.data()) };
+    }
+
+    /**
+     * @brief validates a window as large as the output at a time with
+     *        validate_utf8() and copies the valid prefix in one go.
+     *
+     * @param input
+     * @param output
+     * @param input_is_complete
+     * @return TranscodeResult
+     */
+    TranscodeResult transcode_utf8_to_utf8(ReadonlyBytes input, Bytes output, bool input_is_complete)
+    {
+        size_t in = 0;
+        size_t out = 0;
+
+        while (in < input.size()) {
+            size_t window = min(input.size() - in, output.size() - out);
+            size_t valid = 0;
+            validate_utf8(input.data() + in, window, valid);
+
+            memcpy(output.data() + out, input.data() + in, valid);
+            in += valid;
+            out += valid;
+
+            if (valid == window)
+                break;
+
+            u32 code_point = 0;
+            size_t length = 1;
+            auto sequence = decode_utf8(input.data() + in, input.size() - in, code_point, length);
+
+            // valid, but cut off by the window: the output is full
+            if (sequence == Utf8Sequence::Valid)
+                break;
+
+            if (sequence == Utf8Sequence::Truncated && !input_is_complete)
+                break;
+
+            if (output.size() - out < 3)
+                break;
+
+            write_utf8(output.data() + out, replacement_character, 3);
+            out += 3;
+            in += sequence == Utf8Sequence::Truncated ? input.size() - in : 1;
+        }
+
+        return { in, out };
+    }
+
+} // namespace TextCodec
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,117 @@
+/**
+ * @file transcoding.h
+ * @author Krisna Pranav
+ * @brief Transcoding
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include <mods/array.h>
+#include <mods/span.h>
+#include <mods/types.h>
+
+namespace TextCodec
+{
+
+    /**
+     * @brief how far a bulk conversion got. it stops early, on a character
+     *        boundary, when the output is full, or when the input ends inside
+     *        a character that more input could still complete; the caller
+     *        resumes from input[consumed].
+     */
+    struct TranscodeResult
+    {
+        size_t consumed { 0 };
+        size_t produced { 0 };
+    }; // struct TranscodeResult
+
+    enum class Utf16Endianness
+    {
+        Big,
+        Little,
+    }; // enum class Utf16Endianness
+
+    /**
+     * @brief an ASCII-compatible single-byte encoding: bytes below 0x80 are
+     *        themselves, the high half maps through a table. the UTF-8 form
+     *        of every high byte is precomputed, so decoding is a lookup.
+     */
+    class SingleByteTable
+    {
+    public:
+        /**
+         * @param high_half code points for bytes 0x80 to 0xFF
+         */
+        explicit SingleByteTable(Array<u32, 128> const& high_half);
+
+        /**
+         * @param byte
+         * @return u32
+         */
+        u32 code_point(u8 byte) const
+        {
+            return byte < 0x80 ? byte : m_high_half[byte - 0x80];
+        }
+
+        /**
+         * @param byte a byte of 0x80 or above
+         * @return u32 up to three UTF-8 bytes, lowest first, with the byte
+         *         count in the top eight bits
+         */
+        u32 packed_utf8(u8 byte) const
+        {
+            return m_packed_utf8[byte - 0x80];
+        }
+
+    private:
+        Array<u32, 128> const& m_high_half;
+        Array<u32, 128> m_packed_utf8;
+    }; // class SingleByteTable
+
+    /**
+     * @param input
+     * @param output
+     * @param table
+     * @return TranscodeResult
+     */
+    TranscodeResult transcode_single_byte_to_utf8(ReadonlyBytes input, Bytes output, SingleByteTable const& table);
+
+    /**
+     * @brief unpaired surrogates become U+FFFD.
+     *
+     * @param input
+     * @param output
+     * @param endianness
+     * @param input_is_complete false if more input may follow, so a final
+     *        odd byte or high surrogate is left unconsumed
+     * @return TranscodeResult
+     */
+    TranscodeResult transcode_utf16_to_utf8(ReadonlyBytes input, Bytes output, Utf16Endianness endianness, bool input_is_complete = true);
+
+    /**
+     * @brief invalid sequences become U+FFFD.
+     *
+     * @param input
+     * @param output
+     * @param endianness
+     * @param input_is_complete
+     * @return TranscodeResult
+     */
+    TranscodeResult transcode_utf8_to_utf16(ReadonlyBytes input, Bytes output, Utf16Endianness endianness, bool input_is_complete = true);
+
+    /**
+     * @brief copies valid UTF-8 and replaces invalid sequences with U+FFFD.
+     *
+     * @param input
+     * @param output
+     * @param input_is_complete
+     * @return TranscodeResult
+     */
+    TranscodeResult transcode_utf8_to_utf8(ReadonlyBytes input, Bytes output, bool input_is_complete = true);
+
+} // namespace TextCodec
@@ -11,14 +11,14 @@
 
 #pragma once
 
+#include <mods/atomic.h>
 #include <mods/function.h>
 #include <mods/nonnullrefptr.h>
 #include <mods/optional.h>
-#include <mods/queue.h>
 #include <libcore/event.h>
 #include <libcore/eventloop.h>
 #include <libcore/object.h>
-#include <libthreading/thread.h>
+#include <libthreading/threadpool.h>
 
 namespace Threading 
 {
@@ -40,9 +40,12 @@ namespace Threading
          */
         BackgroundActionBase() { }
 
-        static void enqueue_work(Function<void()>);
-
-        static Thread& background_thread();
+        /**
+         * @param work
+         * @param priority
+         * @return NonnullRefPtr<Task>
+         */
+        static NonnullRefPtr<Task> enqueue_work(Function<void()> work, TaskPriority priority);
     };
 
     /**
@@ -54,14 +57,23 @@ namespace Threading
         C_OBJECT(BackgroundAction);
 
     public:
+        /**
+         * @brief a cancelled action that has not started never runs and
+         *        never calls on_complete; a running one can poll
+         *        is_cancelled() to stop early.
+         */
         void cancel()
         {
-            m_cancelled = true;
+            m_cancelled.store(true, Mods::MemoryOrder::memory_order_relaxed);
+            if (m_task && m_task->cancel()) {
+                m_task = nullptr;
+                unref();
+            }
         }
 
         bool is_cancelled() const
         {
-            return m_cancelled;
+            return m_cancelled.load(Mods::MemoryOrder::memory_order_relaxed);
         }
 
         virtual ~BackgroundAction() { }
@@ -72,29 +84,36 @@ namespace Threading
          * 
          * @param action 
          * @param on_complete 
+         * @param priority
          */
-        BackgroundAction(Function<Result(BackgroundAction&)> action, Function<void(Result)> on_complete)
-            : Core::Object(&background_thread())
+        BackgroundAction(Function<Result(BackgroundAction&)> action, Function<void(Result)> on_complete, TaskPriority priority = TaskPriority::Normal)
+            : Core::Object(nullptr)
             , m_action(move(action))
             , m_on_complete(move(on_complete))
         {
-            enqueue_work([this, origin_event_loop = &Core::EventLoop::current()] {
-                m_result = m_action(*this);
-                if (m_on_complete) {
-                    origin_event_loop->deferred_invoke([this] {
+            // the pool holds this reference until the origin event loop has
+            // seen the result. it is only ever dropped on the origin thread,
+            // since Core::Object's ref count is not atomic.
+            ref();
+
+            m_task = enqueue_work([this, origin_event_loop = &Core::EventLoop::current()] {
+                if (!is_cancelled())
+                    m_result = m_action(*this);
+                origin_event_loop->deferred_invoke([this] {
+                    m_task = nullptr;
+                    if (m_on_complete && m_result.has_value() && !is_cancelled())
                         m_on_complete(m_result.release_value());
-                        remove_from_parent();
-                    });
-                    origin_event_loop->wake();
-                } else {
-                    this->remove_from_parent();
-                }
-            });
+                    unref();
+                });
+                origin_event_loop->wake();
+            },
+                priority);
         }
 
-        bool m_cancelled { false };
+        Atomic<bool> m_cancelled { false };
         Function<Result(BackgroundAction&)> m_action;
         Function<void(Result)> m_on_complete;
         Optional<Result> m_result;
+        RefPtr<Task> m_task;
     }; // class BackgroundAction final : public Core::Object
 } // namespace Threading
@@ -0,0 +1,299 @@
+/**
+ * @file threadpool.cpp
+ * @author Krisna Pranav
+ * @brief Thread Pool
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <mods/array.h>
+#include <mods/string.h>
+#include <libthreading/threadpool.h>
+#include <sched.h>
+#include <unistd.h>
+
+namespace Threading
+{
+    /**
+     * @brief a growable ring of tasks. the owning worker pushes and pops at
+     *        the back, thieves take from the front, so a thief gets the
+     *        oldest and usually biggest piece of work.
+     */
+    class TaskDeque
+    {
+    public:
+        bool is_empty() const
+        {
+            return m_size == 0;
+        }
+
+        /**
+         * @param task
+         */
+        void push_back(NonnullRefPtr<Task> task)
+        {
+            if (m_size == m_slots.size())
+                grow();
+            m_slots[(m_head + m_size) & (m_slots.size() - 1)] = move(task);
+            m_size++;
+        }
+
+        /**
+         * @return RefPtr<Task>
+         */
+        RefPtr<Task> pop_back()
+        {
+            if (is_empty())
+                return nullptr;
+            m_size--;
+            return move(m_slots[(m_head + m_size) & (m_slots.size() - 1)]);
+        }
+
+        /**
+         * @return RefPtr<Task>
+         */
+        RefPtr<Task> pop_front()
+        {
+            if (is_empty())
+                return nullptr;
+            auto task = move(m_slots[m_head]);
+            m_head = (m_head + 1) & (m_slots.size() - 1);
+            m_size--;
+            return task;
+        }
+
+    private:
+        void grow()
+        {
+            Vector<RefPtr<Task>> slots;
+            slots.resize(max<size_t>(16, m_slots.size() * 2));
+            for (size_t i = 0; i < m_size; i++)
+                slots[i] = move(m_slots[(m_head + i) & (m_slots.size() - 1)]);
+            m_slots = move(slots);
+            m_head = 0;
+        }
+
+        Vector<RefPtr<Task>> m_slots;
+        size_t m_head { 0 };
+        size_t m_size { 0 };
+    }; // class TaskDeque
+
+    struct ThreadPool::Worker
+    {
+        Mutex mutex;
+        Array<TaskDeque, task_priority_count> deques;
+        RefPtr<Thread> thread;
+        pthread_t tid { 0 };
+    }; // struct ThreadPool::Worker
+
+    static thread_local ThreadPool* s_current_pool;
+    static thread_local size_t s_current_worker;
+
+    void Task::run()
+    {
+        auto expected = State::Queued;
+        if (m_state.compare_exchange_strong(expected, State::Running, Mods::MemoryOrder::memory_order_acq_rel)) {
+            m_function();
+            m_state.store(State::Finished, Mods::MemoryOrder::memory_order_release);
+        }
+        m_function = nullptr;
+    }
+
+    /**
+     * @return ThreadPool&
+     */
+    ThreadPool& ThreadPool::the()
+    {
+        static ThreadPool* s_the = new ThreadPool;
+        return *s_the;
+    }
+
+    /**
+     * @param worker_count
+     */
+    ThreadPool::ThreadPool(size_t worker_count)
+    {
+        if (worker_count == 0) {
+            auto online = sysconf(_SC_NPROCESSORS_ONLN);
+            worker_count = online > 0 ? online : 1;
+        }
+
+        for (size_t i = 0; i < worker_count; i++)
+            m_workers.append(make<Worker>());
+
+        for (size_t i = 0; i < worker_count; i++) {
+            auto& worker = *m_workers[i];
+            worker.thread = Thread::construct([this, i] { return worker_loop(i); }, String::formatted("Pool worker {}", i));
+            worker.thread->start();
+            worker.tid = worker.thread->tid();
+        }
+    }
+
+    /**
+     * @brief lets the workers drain what is queued, then joins them.
+     */
+    ThreadPool::~ThreadPool()
+    {
+        m_stopping.store(true);
+        {
+            MutexLocker locker(m_sleep_mutex);
+            m_sleep_condition.broadcast();
+        }
+
+        for (auto& worker : m_workers)
+            pthread_join(worker->tid, nullptr);
+    }
+
+    /**
+     * @param function
+     * @param priority
+     * @return NonnullRefPtr<Task>
+     */
+    NonnullRefPtr<Task> ThreadPool::submit(Function<void()> function, TaskPriority priority)
+    {
+        auto task = adopt_ref(*new Task(move(function), priority));
+
+        size_t index = s_current_pool == this
+            ? s_current_worker
+            : m_next_worker.fetch_add(1, Mods::MemoryOrder::memory_order_relaxed) % m_workers.size();
+
+        // counted before it is visible so take_task() never takes the count
+        // below zero. pairs with the check in worker_loop(): either a worker
+        // about to sleep sees the new count, or we see it sleeping and wake it.
+        m_queued_count.fetch_add(1);
+
+        auto& worker = *m_workers[index];
+        {
+            MutexLocker locker(worker.mutex);
+            worker.deques[static_cast<size_t>(priority)].push_back(task);
+        }
+
+        if (m_sleeping_count.load() > 0) {
+            MutexLocker locker(m_sleep_mutex);
+            m_sleep_condition.signal();
+        }
+
+        return task;
+    }
+
+    /**
+     * @param preferred_worker
+     * @return RefPtr<Task>
+     */
+    RefPtr<Task> ThreadPool::take_task(size_t preferred_worker)
+    {
+        if (m_queued_count.load(Mods::MemoryOrder::memory_order_relaxed) == 0)
+            return nullptr;
+
+        bool is_own = s_current_pool == this && s_current_worker == preferred_worker;
+        size_t count = m_workers.size();
+
+        for (size_t priority = 0; priority < task_priority_count; priority++) {
+            for (size_t i = 0; i < count; i++) {
+                auto& worker = *m_workers[(preferred_worker + i) % count];
+
+                RefPtr<Task> task;
+                {
+                    MutexLocker locker(worker.mutex);
+                    auto& deque = worker.deques[priority];
+                    task = (is_own && i == 0) ? deque.pop_back() : deque.pop_front();
+                }
+
+                if (task) {
+                    m_queued_count.fetch_sub(1, Mods::MemoryOrder::memory_order_relaxed);
+                    return task;
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @return true
+     * @return false
+     */
+    bool ThreadPool::run_pending_task()
+    {
+        size_t start = s_current_pool == this
+            ? s_current_worker
+            : m_next_worker.load(Mods::MemoryOrder::memory_order_relaxed) % m_workers.size();
+
+        auto task = take_task(start);
+        if (!task)
+            return false;
+
+        task->run();
+        return true;
+    }
+
+    /**
+     * @param worker_index
+     * @return intptr_t
+     */
+    intptr_t ThreadPool::worker_loop(size_t worker_index)
+    {
+        s_current_pool = this;
+        s_current_worker = worker_index;
+
+        for (;;) {
+            if (auto task = take_task(worker_index)) {
+                task->run();
+                continue;
+            }
+
+            MutexLocker locker(m_sleep_mutex);
+            m_sleeping_count.fetch_add(1);
+
+            if (m_queued_count.load() == 0) {
+                if (m_stopping.load()) {
+                    m_sleeping_count.fetch_sub(1);
+                    break;
+                }
+                m_sleep_condition.wait();
+            }
+
+            m_sleeping_count.fetch_sub(1);
+        }
+
+        s_current_pool = nullptr;
+        return 0;
+    }
+
+    /**
+     * @param function
+     */
+    void TaskGroup::spawn(Function<void()> function)
+    {
+        m_pending.fetch_add(1, Mods::MemoryOrder::memory_order_relaxed);
+        m_tasks.append(m_pool.submit([this, function = move(function)] {
+            function();
+            m_pending.fetch_sub(1, Mods::MemoryOrder::memory_order_release);
+        },
+            m_priority));
+    }
+
+    void TaskGroup::cancel()
+    {
+        for (auto& task : m_tasks) {
+            if (task->cancel())
+                m_pending.fetch_sub(1, Mods::MemoryOrder::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief helps the pool until every subtask has run or been cancelled,
+     *        so nested groups on worker threads cannot starve the pool.
+     */
+    void TaskGroup::wait()
+    {
+        while (m_pending.load(Mods::MemoryOrder::memory_order_acquire) > 0) {
+            if (!m_pool.run_pending_task())
+                sched_yield();
+        }
+        m_tasks.clear();
+    }
+} // namespace Threading
@@ -0,0 +1,209 @@
+/**
+ * @file threadpool.h
+ * @author Krisna Pranav
+ * @brief Thread Pool
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include <mods/atomic.h>
+#include <mods/atomicrefcounted.h>
+#include <mods/function.h>
+#include <mods/noncopyable.h>
+#include <mods/nonnullownptr.h>
+#include <mods/nonnullrefptr.h>
+#include <mods/vector.h>
+#include <libthreading/conditionvariable.h>
+#include <libthreading/mutex.h>
+#include <libthreading/thread.h>
+
+namespace Threading
+{
+    enum class TaskPriority : u8
+    {
+        High = 0,
+        Normal,
+        Low,
+    }; // enum class TaskPriority
+
+    static constexpr size_t task_priority_count = 3;
+
+    class Task final : public AtomicRefCounted<Task>
+    {
+        friend class ThreadPool;
+
+    public:
+        enum class State : u8
+        {
+            Queued,
+            Running,
+            Finished,
+            Cancelled,
+        }; // enum class State
+
+        /**
+         * @brief stop the task from ever running. too late once a worker
+         *        has picked it up.
+         *
+         * @return true if the task was still queued
+         */
+        bool cancel()
+        {
+            auto expected = State::Queued;
+            return m_state.compare_exchange_strong(expected, State::Cancelled, Mods::MemoryOrder::memory_order_acq_rel);
+        }
+
+        State state() const
+        {
+            return m_state.load(Mods::MemoryOrder::memory_order_acquire);
+        }
+
+        bool is_cancelled() const
+        {
+            return state() == State::Cancelled;
+        }
+
+        TaskPriority priority() const
+        {
+            return m_priority;
+        }
+
+    private:
+        /**
+         * @param function
+         * @param priority
+         */
+        Task(Function<void()> function, TaskPriority priority)
+            : m_function(move(function))
+            , m_priority(priority)
+        {
+        }
+
+        /**
+         * @brief run the task unless it was cancelled; drops the function
+         *        either way so its captures die with it.
+         */
+        void run();
+
+        Function<void()> m_function;
+        TaskPriority m_priority;
+        Atomic<State> m_state { State::Queued };
+    }; // class Task
+
+    /**
+     * @brief a fixed set of workers, one per cpu by default, each with its
+     *        own deque per priority. a worker pops its own deques LIFO for
+     *        cache warmth and, when they run dry, steals FIFO from the others,
+     *        always looking at higher priorities first.
+     */
+    class ThreadPool
+    {
+        MOD_MAKE_NONCOPYABLE(ThreadPool);
+        MOD_MAKE_NONMOVABLE(ThreadPool);
+
+    public:
+        static ThreadPool& the();
+
+        /**
+         * @param worker_count zero means one worker per online cpu
+         */
+        explicit ThreadPool(size_t worker_count = 0);
+        ~ThreadPool();
+
+        size_t worker_count() const
+        {
+            return m_workers.size();
+        }
+
+        /**
+         * @brief queue a task. submissions from a worker of this pool go to
+         *        its own deque, other threads spread theirs round robin.
+         *
+         * @param function
+         * @param priority
+         * @return NonnullRefPtr<Task>
+         */
+        NonnullRefPtr<Task> submit(Function<void()> function, TaskPriority priority = TaskPriority::Normal);
+
+        /**
+         * @brief run one queued task on the calling thread, so that a thread
+         *        waiting for subtasks helps instead of sleeping.
+         *
+         * @return true if there was a task to take
+         */
+        bool run_pending_task();
+
+    private:
+        struct Worker;
+
+        /**
+         * @param preferred_worker
+         * @return RefPtr<Task>
+         */
+        RefPtr<Task> take_task(size_t preferred_worker);
+
+        /**
+         * @param worker_index
+         * @return intptr_t
+         */
+        intptr_t worker_loop(size_t worker_index);
+
+        Vector<NonnullOwnPtr<Worker>> m_workers;
+        Atomic<size_t> m_next_worker { 0 };
+        Atomic<size_t> m_queued_count { 0 };
+        Atomic<bool> m_stopping { false };
+
+        Mutex m_sleep_mutex;
+        ConditionVariable m_sleep_condition { m_sleep_mutex };
+        Atomic<size_t> m_sleeping_count { 0 };
+    }; // class ThreadPool
+
+    /**
+     * @brief fork/join on top of a pool. spawn() the subtasks, then wait();
+     *        the waiting thread runs queued tasks until the group is done.
+     */
+    class TaskGroup
+    {
+        MOD_MAKE_NONCOPYABLE(TaskGroup);
+        MOD_MAKE_NONMOVABLE(TaskGroup);
+
+    public:
+        /**
+         * @param pool
+         * @param priority
+         */
+        explicit TaskGroup(ThreadPool& pool = ThreadPool::the(), TaskPriority priority = TaskPriority::Normal)
+            : m_pool(pool)
+            , m_priority(priority)
+        {
+        }
+
+        ~TaskGroup()
+        {
+            wait();
+        }
+
+        /**
+         * @param function
+         */
+        void spawn(Function<void()> function);
+
+        /**
+         * @brief cancel every subtask that has not started yet.
+         */
+        void cancel();
+
+        void wait();
+
+    private:
+        ThreadPool& m_pool;
+        TaskPriority m_priority;
+        Vector<NonnullRefPtr<Task>> m_tasks;
+        Atomic<size_t> m_pending { 0 };
+    }; // class TaskGroup
+} // namespace Threading
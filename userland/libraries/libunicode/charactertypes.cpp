@@ -11,6 +11,7 @@
 
 #include <mods/charactertypes.h>
 #include <mods/platform.h>
+#include <mods/simd.h>
 #include <mods/string_builder.h>
 #include <mods/types.h>
 #include <mods/utf16view.h>
@@ -55,171 +56,288 @@ namespace Unicode
         return {}; 
     }
 
-    #if ENABLE_UNICODE_DATA
-
-    /**
-     * @param string 
-     * @param index 
-     * @return true 
-     * @return false 
-     */
-    static bool is_after_uppercase_i(Utf8View const& string, size_t index)
+    namespace
     {
-        auto preceding_view = string.substring_view(0, index);
-        bool found_uppercase_i = false;
-
-        for (auto code_point : preceding_view) {
-            if (code_point == 'I') {
-                found_uppercase_i = true;
-                continue;
-            }
+        enum class CaseMapping
+        {
+            Lowercase,
+            Uppercase,
+        }; // enum class CaseMapping
+
+        /**
+         * @brief case-maps ASCII sixteen bytes at a time: bytes in the source
+         *        letter range get their 0x20 bit flipped.
+         *
+         * @tparam mapping
+         * @param builder
+         * @param data
+         * @param length
+         */
+        template<CaseMapping mapping>
+        void append_ascii_case_mapped(StringBuilder& builder, u8 const* data, size_t length)
+        {
+            using u8x16_unaligned = u8 __attribute__((vector_size(16), aligned(1), may_alias));
+            constexpr u8 first_letter = mapping == CaseMapping::Lowercase ? 'A' : 'a';
+
+            char buffer[256];
+
+            while (length > 0) {
+                size_t chunk = min(length, sizeof(buffer));
+                size_t i = 0;
+
+                for (; i + 16 <= chunk; i += 16) {
+                    Mods::SIMD::u8x16 bytes = *reinterpret_cast<u8x16_unaligned const*>(data + i);
+                    Mods::SIMD::u8x16 offsets = bytes - first_letter;
+                    auto is_letter = (Mods::SIMD::u8x16)(offsets < 26);
+                    *reinterpret_cast<u8x16_unaligned*>(buffer + i) = bytes ^ (is_letter & 0x20);
+                }
 
-            u32 combining_class = canonical_combining_class(code_point);
+                for (; i < chunk; ++i)
+                    buffer[i] = mapping == CaseMapping::Lowercase ? to_ascii_lowercase(data[i]) : to_ascii_uppercase(data[i]);
 
-            if (combining_class == 0)
-                found_uppercase_i = false;
-            else if (combining_class == 230)
-                found_uppercase_i = false;
+                builder.append(buffer, chunk);
+                data += chunk;
+                length -= chunk;
+            }
         }
+    } // namespace
 
-        return found_uppercase_i;
-    }
+    #if ENABLE_UNICODE_DATA
 
-    /**
-     * @param string 
-     * @param index 
-     * @return true 
-     * @return false 
-     */
-    static bool is_after_soft_dotted_code_point(Utf8View const& string, size_t index)
+    namespace
     {
-        auto preceding_view = string.substring_view(0, index);
-        bool found_soft_dotted_code_point = false;
-
-        for (auto code_point : preceding_view) {
-            if (code_point_has_property(code_point, Property::Soft_Dotted)) {
-                found_soft_dotted_code_point = true;
-                continue;
+        /**
+         * @brief what the special casing conditions need to know about the
+         *        text before the current code point, carried forward as the
+         *        text is mapped instead of being rescanned for every code point.
+         */
+        struct CaseMappingContext
+        {
+            bool after_uppercase_i { false };
+            bool after_soft_dotted { false };
+            bool after_cased_letter { false };
+
+            /**
+             * @param code_point
+             */
+            void update(u32 code_point)
+            {
+                u32 combining_class = canonical_combining_class(code_point);
+                bool ends_combining_sequence = combining_class == 0 || combining_class == 230;
+
+                if (code_point == 'I')
+                    after_uppercase_i = true;
+                else if (ends_combining_sequence)
+                    after_uppercase_i = false;
+
+                if (code_point_has_property(code_point, Property::Soft_Dotted))
+                    after_soft_dotted = true;
+                else if (ends_combining_sequence)
+                    after_soft_dotted = false;
+
+                bool is_cased = code_point_has_property(code_point, Property::Cased);
+                bool is_case_ignorable = code_point_has_property(code_point, Property::Case_Ignorable);
+
+                if (is_cased && !is_case_ignorable)
+                    after_cased_letter = true;
+                else if (!is_case_ignorable)
+                    after_cased_letter = false;
             }
 
-            u32 combining_class = canonical_combining_class(code_point);
+            /**
+             * @brief every ASCII code point has combining class 0, so after a
+             *        run only its tail matters.
+             *
+             * @param run
+             */
+            void update_after_ascii_run(ReadonlyBytes run)
+            {
+                if (run.is_empty())
+                    return;
 
-            if (combining_class == 0)
-                found_soft_dotted_code_point = false;
-            else if (combining_class == 230)
-                found_soft_dotted_code_point = false;
-        }
+                u8 last = run[run.size() - 1];
+                after_uppercase_i = last == 'I';
+                after_soft_dotted = code_point_has_property(last, Property::Soft_Dotted);
 
-        return found_soft_dotted_code_point;
-    }
+                for (size_t i = run.size(); i > 0; --i) {
+                    u8 code_point = run[i - 1];
+                    if (code_point_has_property(code_point, Property::Case_Ignorable))
+                        continue;
 
-    /**
-     * @param string 
-     * @param index 
-     * @param byte_length 
-     * @return true 
-     * @return false 
-     */
-    static bool is_final_code_point(Utf8View const& string, size_t index, size_t byte_length)
-    {
-        auto preceding_view = string.substring_view(0, index);
-        auto following_view = ((index + byte_length) < string.byte_length())
-            ? string.substring_view(index + byte_length)
-            : Utf8View {};
+                    after_cased_letter = code_point_has_property(code_point, Property::Cased);
+                    break;
+                }
+            }
+        }; // struct CaseMappingContext
 
-        size_t cased_letter_count = 0;
+        /**
+         * @param following
+         * @return true
+         * @return false
+         */
+        bool is_followed_by_cased_letter(Utf8View const& following)
+        {
+            for (auto code_point : following) {
+                if (code_point_has_property(code_point, Property::Case_Ignorable))
+                    continue;
 
-        for (auto code_point : preceding_view) {
-            bool is_cased = code_point_has_property(code_point, Property::Cased);
-            bool is_case_ignorable = code_point_has_property(code_point, Property::Case_Ignorable);
+                return code_point_has_property(code_point, Property::Cased);
+            }
 
-            if (is_cased && !is_case_ignorable)
-                ++cased_letter_count;
-            else if (!is_case_ignorable)
-                cased_letter_count = 0;
+            return false;
         }
 
-        if (cased_letter_count == 0)
-            return false;
+        /**
+         * @param following
+         * @return true
+         * @return false
+         */
+        bool is_followed_by_combining_class_above(Utf8View const& following)
+        {
+            for (auto code_point : following) {
+                u32 combining_class = canonical_combining_class(code_point);
+
+                if (combining_class == 0)
+                    return false;
+                if (combining_class == 230)
+                    return true;
+            }
 
-        for (auto code_point : following_view) {
-            bool is_cased = code_point_has_property(code_point, Property::Cased);
-            bool is_case_ignorable = code_point_has_property(code_point, Property::Case_Ignorable);
+            return false;
+        }
 
-            if (is_case_ignorable)
-                continue;
-            if (is_cased)
-                return false;
+        /**
+         * @param following
+         * @return true
+         * @return false
+         */
+        bool is_followed_by_combining_dot_above(Utf8View const& following)
+        {
+            for (auto code_point : following) {
+                if (code_point == 0x307)
+                    return true;
+
+                u32 combining_class = canonical_combining_class(code_point);
+
+                if (combining_class == 0)
+                    return false;
+                if (combining_class == 230)
+                    return false;
+            }
 
-            break;
+            return false;
         }
 
-        return true;
-    }
+        /**
+         * @brief the preceding text is summarized by context; only the
+         *        conditions about what follows look ahead, and they stop at
+         *        the end of the combining sequence or the next letter.
+         *
+         * @param code_point
+         * @param locale
+         * @param context
+         * @param following
+         * @return SpecialCasing const*
+         */
+        SpecialCasing const* find_matching_special_case(u32 code_point, Locale locale, CaseMappingContext const& context, Utf8View const& following)
+        {
+            auto special_casings = special_case_mapping(code_point);
+
+            for (auto const* special_casing : special_casings) {
+                if (special_casing->locale != Locale::None && special_casing->locale != locale)
+                    continue;
+
+                switch (special_casing->condition) {
+                case Condition::None:
+                    return special_casing;
 
-    /**
-     * @param string 
-     * @param index 
-     * @param byte_length 
-     * @return true 
-     * @return false 
-     */
-    static bool is_followed_by_combining_class_above(Utf8View const& string, size_t index, size_t byte_length)
-    {
-        auto following_view = ((index + byte_length) < string.byte_length())
-            ? string.substring_view(index + byte_length)
-            : Utf8View {};
+                case Condition::AfterI:
+                    if (context.after_uppercase_i)
+                        return special_casing;
+                    break;
+
+                case Condition::AfterSoftDotted:
+                    if (context.after_soft_dotted)
+                        return special_casing;
+                    break;
+
+                case Condition::FinalSigma:
+                    if (context.after_cased_letter && !is_followed_by_cased_letter(following))
+                        return special_casing;
+                    break;
+
+                case Condition::MoreAbove:
+                    if (is_followed_by_combining_class_above(following))
+                        return special_casing;
+                    break;
+
+                case Condition::NotBeforeDot:
+                    if (!is_followed_by_combining_dot_above(following))
+                        return special_casing;
+                    break;
+                }
+            }
 
-        for (auto code_point : following_view) {
-            u32 combining_class = canonical_combining_class(code_point);
+            return nullptr;
+        }
 
-            if (combining_class == 0)
-                return false;
-            if (combining_class == 230)
-                return true;
+        /**
+         * @brief whether any ASCII code point has a special casing in the
+         *        locale (Turkish and Lithuanian 'i' do), which rules out the
+         *        ASCII fast path.
+         *
+         * @param locale
+         * @return true
+         * @return false
+         */
+        bool has_ascii_special_casing(Locale locale)
+        {
+            for (u32 code_point = 0; code_point < 0x80; ++code_point) {
+                for (auto const* special_casing : special_case_mapping(code_point)) {
+                    if (special_casing->locale == Locale::None || special_casing->locale == locale)
+                        return true;
+                }
+            }
+
+            return false;
         }
+    } // namespace
 
-        return false;
-    }
+    #endif
 
     /**
-     * @param string 
-     * @param index 
-     * @param byte_length 
-     * @return true 
-     * @return false 
+     * @param code_point
+     * 
      */
-    static bool is_followed_by_combining_dot_above(Utf8View const& string, size_t index, size_t byte_length)
+    u32 __attribute__((weak)) to_unicode_lowercase(u32 code_point)
     {
-        auto following_view = ((index + byte_length) < string.byte_length())
-            ? string.substring_view(index + byte_length)
-            : Utf8View {};
-
-        for (auto code_point : following_view) {
-            if (code_point == 0x307)
-                return true;
-
-            u32 combining_class = canonical_combining_class(code_point);
-
-            if (combining_class == 0)
-                return false;
-            if (combining_class == 230)
-                return false;
-        }
+        return to_ascii_lowercase(code_point);
+    }
 
-        return false;
+    /**
+     * @param code_point
+     * 
+     */
+    u32 __attribute__((weak)) to_unicode_uppercase(u32 code_point)
+    {
+        return to_ascii_uppercase(code_point);
     }
 
     /**
-     * @param code_point 
-     * @param string 
-     * @param locale 
-     * @param index 
-     * @param byte_length 
-     * @return SpecialCasing const* 
+     * @brief maps the whole string in one pass. ASCII runs take the vector
+     *        path whenever the locale leaves ASCII alone.
+     *
+     * @tparam mapping
+     * @param builder
+     * @param string
+     * @param locale
      */
-    static SpecialCasing const* find_matching_special_case(u32 code_point, Utf8View const& string, Optional<StringView> locale, size_t index, size_t byte_length)
+    template<CaseMapping mapping>
+    static void append_case_mapped(StringBuilder& builder, StringView string, [[maybe_unused]] Optional<StringView> locale)
     {
+        auto bytes = string.bytes();
+
+    #if ENABLE_UNICODE_DATA
         auto requested_locale = Locale::None;
 
         if (locale.has_value()) {
@@ -227,64 +345,81 @@ namespace Unicode
                 requested_locale = *maybe_locale;
         }
 
-        auto special_casings = special_case_mapping(code_point);
-
-        for (auto const* special_casing : special_casings) {
-            if (special_casing->locale != Locale::None && special_casing->locale != requested_locale)
-                continue;
-
-            switch (special_casing->condition) {
-            case Condition::None:
-                return special_casing;
-
-            case Condition::AfterI:
-                if (is_after_uppercase_i(string, index))
-                    return special_casing;
-                break;
+        bool use_ascii_fast_path;
+        if (requested_locale == Locale::None) {
+            static bool const s_default_locale_has_ascii_special_casing = has_ascii_special_casing(Locale::None);
+            use_ascii_fast_path = !s_default_locale_has_ascii_special_casing;
+        } else {
+            use_ascii_fast_path = !has_ascii_special_casing(requested_locale);
+        }
 
-            case Condition::AfterSoftDotted:
-                if (is_after_soft_dotted_code_point(string, index))
-                    return special_casing;
-                break;
+        CaseMappingContext context;
+        size_t index = 0;
 
-            case Condition::FinalSigma:
-                if (is_final_code_point(string, index, byte_length))
-                    return special_casing;
-                break;
+        while (index < bytes.size()) {
+            if (use_ascii_fast_path && bytes[index] < 0x80) {
+                size_t run = ascii_prefix_length(bytes.data() + index, bytes.size() - index);
+                append_ascii_case_mapped<mapping>(builder, bytes.data() + index, run);
+                context.update_after_ascii_run(bytes.slice(index, run));
+                index += run;
+                continue;
+            }
 
-            case Condition::MoreAbove:
-                if (is_followed_by_combining_class_above(string, index, byte_length))
-                    return special_casing;
-                break;
+            Utf8View remaining { string.substring_view(index) };
+            auto it = remaining.begin();
+            u32 code_point = *it;
+            size_t byte_length = it.underlying_code_point_length_in_bytes();
+            Utf8View following { string.substring_view(index + byte_length) };
 
-            case Condition::NotBeforeDot:
-                if (!is_followed_by_combining_dot_above(string, index, byte_length))
-                    return special_casing;
-                break;
+            auto const* special_casing = find_matching_special_case(code_point, requested_locale, context, following);
+            if (!special_casing) {
+                builder.append_code_point(mapping == CaseMapping::Lowercase ? to_unicode_lowercase(code_point) : to_unicode_uppercase(code_point));
+            } else if constexpr (mapping == CaseMapping::Lowercase) {
+                for (size_t i = 0; i < special_casing->lowercase_mapping_size; ++i)
+                    builder.append_code_point(special_casing->lowercase_mapping[i]);
+            } else {
+                for (size_t i = 0; i < special_casing->uppercase_mapping_size; ++i)
+                    builder.append_code_point(special_casing->uppercase_mapping[i]);
             }
+
+            context.update(code_point);
+            index += byte_length;
         }
+    #else
+        size_t index = 0;
 
-        return nullptr;
-    }
+        while (index < bytes.size()) {
+            size_t run = ascii_prefix_length(bytes.data() + index, bytes.size() - index);
+            append_ascii_case_mapped<mapping>(builder, bytes.data() + index, run);
+            index += run;
 
+            size_t other = index;
+            while (other < bytes.size() && bytes[other] >= 0x80)
+                ++other;
+            builder.append(reinterpret_cast<char const*>(bytes.data() + index), other - index);
+            index = other;
+        }
     #endif
+    }
 
     /**
-     * @param code_point
-     * 
+     * @param builder 
+     * @param string 
+     * @param locale 
      */
-    u32 __attribute__((weak)) to_unicode_lowercase(u32 code_point)
+    void append_unicode_lowercase_full(StringBuilder& builder, StringView string, Optional<StringView> locale)
     {
-        return to_ascii_lowercase(code_point);
+        append_case_mapped<CaseMapping::Lowercase>(builder, string, locale);
     }
 
     /**
-     * @param code_point
-     * 
+     * @param builder 
+     * @param string 
+     * @param locale 
      */
-    u32 __attribute__((weak)) to_unicode_uppercase(u32 code_point)
+    void append_unicode_uppercase_full(StringBuilder& builder, StringView string, Optional<StringView> locale)
     {
-        return to_ascii_uppercase(code_point);
+        append_case_mapped<CaseMapping::Uppercase>(builder, string, locale);
     }
 
     /**
@@ -292,33 +427,11 @@ namespace Unicode
      * @param locale 
      * @return String 
      */
-    String to_unicode_lowercase_full(StringView string, [[maybe_unused]] Optional<StringView> locale)
+    String to_unicode_lowercase_full(StringView string, Optional<StringView> locale)
     {
-    #if ENABLE_UNICODE_DATA
-        Utf8View view { string };
-        StringBuilder builder;
-
-        size_t index = 0;
-        size_t byte_length = 0;
-
-        for (auto it = view.begin(); it != view.end(); ++it, index += byte_length) {
-            u32 code_point = *it;
-            byte_length = it.underlying_code_point_length_in_bytes();
-
-            auto const* special_casing = find_matching_special_case(code_point, view, locale, index, byte_length);
-            if (!special_casing) {
-                builder.append_code_point(to_unicode_lowercase(code_point));
-                continue;
-            }
-
-            for (size_t i = 0; i < special_casing->lowercase_mapping_size; ++i)
-                builder.append_code_point(special_casing->lowercase_mapping[i]);
-        }
-
+        StringBuilder builder(string.length());
+        append_unicode_lowercase_full(builder, string, locale);
         return builder.build();
-    #else
-        return string.to_lowercase_string();
-    #endif
     }
 
     /**
@@ -326,33 +439,11 @@ namespace Unicode
      * @param locale 
      * @return String 
      */
-    String to_unicode_uppercase_full(StringView string, [[maybe_unused]] Optional<StringView> locale)
+    String to_unicode_uppercase_full(StringView string, Optional<StringView> locale)
     {
-    #if ENABLE_UNICODE_DATA
-        Utf8View view { string };
-        StringBuilder builder;
-
-        size_t index = 0;
-        size_t byte_length = 0;
-
-        for (auto it = view.begin(); it != view.end(); ++it, index += byte_length) {
-            u32 code_point = *it;
-            byte_length = it.underlying_code_point_length_in_bytes();
-
-            auto const* special_casing = find_matching_special_case(code_point, view, locale, index, byte_length);
-            if (!special_casing) {
-                builder.append_code_point(to_unicode_uppercase(code_point));
-                continue;
-            }
-
-            for (size_t i = 0; i < special_casing->uppercase_mapping_size; ++i)
-                builder.append_code_point(special_casing->uppercase_mapping[i]);
-        }
-
+        StringBuilder builder(string.length());
+        append_unicode_uppercase_full(builder, string, locale);
         return builder.build();
-    #else
-        return string.to_uppercase_string();
-    #endif
     }
 
     Optional<GeneralCategory> __attribute__((weak)) general_category_from_string(StringView) 
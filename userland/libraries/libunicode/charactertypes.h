@@ -82,12 +82,25 @@ namespace Unicode
      */
     String to_unicode_lowercase_full(StringView, Optional<StringView> locale = {});
 
+    /**
+     * @brief like to_unicode_lowercase_full(), but appends to a builder the
+     *        caller can clear and reuse across strings.
+     *
+     * @param locale 
+     */
+    void append_unicode_lowercase_full(StringBuilder&, StringView, Optional<StringView> locale = {});
+
     /**
      * @param locale 
      * @return String 
      */
     String to_unicode_uppercase_full(StringView, Optional<StringView> locale = {});
 
+    /**
+     * @param locale 
+     */
+    void append_unicode_uppercase_full(StringBuilder&, StringView, Optional<StringView> locale = {});
+
     Optional<GeneralCategory> general_category_from_string(StringView);
 
     /**
@@ -0,0 +1,124 @@
+/**
+ * @file basicblockcache.cpp
+ * @author Krisna Pranav
+ * @brief basic block cache
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#include <libx86/basicblockcache.h>
+
+namespace X86
+{
+
+    /**
+     * @brief one bit for each page of the 32-bit guest address space.
+     */
+    BasicBlockCache::BasicBlockCache()
+        : m_code_pages(MUST(Bitmap::create(((u64)NumericLimits<u32>::max() + 1) / page_size, false)))
+    {
+    }
+
+    /**
+     * @param block
+     * @return DecodedBlock const&
+     */
+    DecodedBlock const& BasicBlockCache::add_block(NonnullOwnPtr<DecodedBlock> block)
+    {
+        u32 start = block->start();
+        if (m_blocks.contains(start))
+            retire_block(start);
+
+        u32 first_page = start / page_size;
+        u32 last_page = first_page;
+        if (!block->is_empty())
+            last_page = (block->end() - 1) / page_size;
+
+        for (u32 page = first_page;; ++page) {
+            auto it = m_blocks_by_page.find(page);
+            if (it == m_blocks_by_page.end())
+                m_blocks_by_page.set(page, Vector<u32> { start });
+            else
+                (*it).value.append(start);
+            m_code_pages.set(page, true);
+
+            if (page == last_page)
+                break;
+        }
+
+        auto& result = *block;
+        m_blocks.set(start, move(block));
+        return result;
+    }
+
+    /**
+     * @brief takes the block out of the map and out of the list of every
+     *        page it spans, and keeps it alive until the next lookup.
+     *
+     * @param start
+     */
+    void BasicBlockCache::retire_block(u32 start)
+    {
+        auto it = m_blocks.find(start);
+        if (it == m_blocks.end())
+            return;
+
+        auto block = move((*it).value);
+        m_blocks.remove(start);
+
+        u32 first_page = start / page_size;
+        u32 last_page = block->is_empty() ? first_page : (block->end() - 1) / page_size;
+
+        for (u32 page = first_page;; ++page) {
+            auto page_it = m_blocks_by_page.find(page);
+            if (page_it != m_blocks_by_page.end()) {
+                auto& starts = (*page_it).value;
+                starts.remove_first_matching([&](u32 block_start) { return block_start == start; });
+                if (starts.is_empty()) {
+                    m_blocks_by_page.remove(page);
+                    m_code_pages.set(page, false);
+                }
+            }
+
+            if (page == last_page)
+                break;
+        }
+
+        ++m_statistics.invalidated_blocks;
+        m_retired_blocks.append(move(block));
+    }
+
+    /**
+     * @param first_page
+     * @param last_page
+     */
+    void BasicBlockCache::invalidate_pages(u32 first_page, u32 last_page)
+    {
+        for (u32 page = first_page;; ++page) {
+            auto it = m_blocks_by_page.find(page);
+            if (it != m_blocks_by_page.end()) {
+                auto starts = (*it).value;
+                for (auto start : starts)
+                    retire_block(start);
+            }
+
+            if (page == last_page)
+                break;
+        }
+    }
+
+    void BasicBlockCache::clear()
+    {
+        for (auto& entry : m_blocks)
+            m_retired_blocks.append(move(entry.value));
+
+        m_statistics.invalidated_blocks += m_blocks.size();
+        m_blocks.clear();
+        m_blocks_by_page.clear();
+        m_code_pages.fill(false);
+    }
+
+} // namespace X86
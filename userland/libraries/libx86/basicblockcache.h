@@ -0,0 +1,275 @@
+/**
+ * @file basicblockcache.h
+ * @author Krisna Pranav
+ * @brief basic block cache
+ * @version 6.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2021-2025 pranaOS Developers, Krisna Pranav
+ *
+ */
+
+#pragma once
+
+#include <mods/bitmap.h>
+#include <mods/flathashmap.h>
+#include <mods/nonnullownptr.h>
+#include <mods/numericlimits.h>
+#include <mods/try.h>
+#include <mods/vector.h>
+#include <libx86/instruction.h>
+
+namespace X86
+{
+
+    /**
+     * @brief an instruction decoded once, with its handler looked up once.
+     */
+    struct DecodedInstruction
+    {
+        Instruction instruction;
+        InstructionHandler handler { nullptr };
+        u32 address { 0 };
+        u32 next_address { 0 };
+    }; // struct DecodedInstruction
+
+    /**
+     * @brief a straight run of instructions that ends with the first one
+     *        that may transfer control, or at max_instructions_per_block.
+     *        instructions that fail to decode are left out; a block that
+     *        starts with one is empty.
+     */
+    class DecodedBlock
+    {
+    public:
+        /**
+         * @param start
+         * @param o32
+         * @param a32
+         */
+        DecodedBlock(u32 start, bool o32, bool a32)
+            : m_start(start)
+            , m_o32(o32)
+            , m_a32(a32)
+        {
+        }
+
+        u32 start() const
+        {
+            return m_start;
+        }
+
+        /**
+         * @return u32 the address after the last instruction
+         */
+        u32 end() const
+        {
+            return m_instructions.is_empty() ? m_start : m_instructions.last().next_address;
+        }
+
+        bool o32() const
+        {
+            return m_o32;
+        }
+
+        bool a32() const
+        {
+            return m_a32;
+        }
+
+        bool is_empty() const
+        {
+            return m_instructions.is_empty();
+        }
+
+        Vector<DecodedInstruction> const& instructions() const
+        {
+            return m_instructions;
+        }
+
+    private:
+        friend class BasicBlockCache;
+
+        u32 m_start { 0 };
+        bool m_o32 { false };
+        bool m_a32 { false };
+        Vector<DecodedInstruction> m_instructions;
+    }; // class DecodedBlock
+
+    /**
+     * @brief pre-decoded basic blocks keyed by guest address. the owner
+     *        reports every guest write through did_write(), which drops the
+     *        blocks on any page written to; writes to pages without code
+     *        cost one bit test.
+     *
+     *        a block invalidated while it is running stays alive until the
+     *        next find() or decode(), so execute() can finish the instruction
+     *        it is in and stop there.
+     */
+    class BasicBlockCache
+    {
+    public:
+        static constexpr size_t page_size = 4096;
+        static constexpr size_t max_instructions_per_block = 64;
+
+        struct Statistics
+        {
+            size_t hits { 0 };
+            size_t misses { 0 };
+            size_t invalidated_blocks { 0 };
+        }; // struct Statistics
+
+        /**
+         * @brief Construct a new Basic Block Cache object
+         *
+         */
+        BasicBlockCache();
+
+        /**
+         * @param address
+         * @param o32
+         * @param a32
+         * @return DecodedBlock const* nullptr if there is no block decoded
+         *         at address in this operand and address size
+         */
+        DecodedBlock const* find(u32 address, bool o32, bool a32)
+        {
+            if (!m_retired_blocks.is_empty())
+                m_retired_blocks.clear();
+
+            auto it = m_blocks.find(address);
+            if (it == m_blocks.end() || (*it).value->o32() != o32 || (*it).value->a32() != a32) {
+                ++m_statistics.misses;
+                return nullptr;
+            }
+
+            ++m_statistics.hits;
+            return (*it).value.ptr();
+        }
+
+        /**
+         * @brief decodes and caches the block at address, replacing any
+         *        block already there.
+         *
+         * @tparam InstructionStreamType
+         * @param address
+         * @param stream positioned at address
+         * @param o32
+         * @param a32
+         * @return DecodedBlock const&
+         */
+        template<typename InstructionStreamType>
+        DecodedBlock const& decode(u32 address, InstructionStreamType& stream, bool o32, bool a32)
+        {
+            if (!m_retired_blocks.is_empty())
+                m_retired_blocks.clear();
+
+            auto block = make<DecodedBlock>(address, o32, a32);
+            u32 next_address = address;
+
+            while (block->m_instructions.size() < max_instructions_per_block && stream.can_read()) {
+                auto instruction = Instruction::from_stream(stream, o32, a32);
+                if (!instruction.is_valid())
+                    break;
+
+                u32 instruction_address = next_address;
+                next_address += instruction.length();
+                bool ends_block = instruction.ends_basic_block();
+                block->m_instructions.append({ instruction, instruction.handler(), instruction_address, next_address });
+
+                if (ends_block)
+                    break;
+            }
+
+            return add_block(move(block));
+        }
+
+        /**
+         * @param address
+         * @param size
+         */
+        ALWAYS_INLINE void did_write(u32 address, size_t size)
+        {
+            u32 first_page = address / page_size;
+            u32 last_page = min<u64>((u64)address + max<size_t>(size, 1) - 1, NumericLimits<u32>::max()) / page_size;
+            if (first_page == last_page) {
+                if (!m_code_pages.get(first_page))
+                    return;
+            } else if (m_code_pages.count_in_range(first_page, (size_t)last_page - first_page + 1, true) == 0) {
+                // a wide write can cover code on a page between its first and last
+                return;
+            }
+
+            invalidate_pages(first_page, last_page);
+        }
+
+        /**
+         * @brief runs a block on an interpreter that keeps its instruction
+         *        pointer in eip(). set_eip() is called with the address after
+         *        each instruction before its handler runs, as decoding from
+         *        the guest stream would have left it. the block is left early
+         *        when a handler jumps elsewhere or writes over cached code.
+         *
+         * @tparam CPU
+         * @param cpu
+         * @param block
+         * @return true if every instruction in the block ran
+         */
+        template<typename CPU>
+        ALWAYS_INLINE bool execute(CPU& cpu, DecodedBlock const& block)
+        {
+            auto invalidated_blocks = m_statistics.invalidated_blocks;
+            auto& instructions = block.instructions();
+
+            for (size_t i = 0; i < instructions.size(); ++i) {
+                auto& decoded = instructions[i];
+                cpu.set_eip(decoded.next_address);
+                (cpu.*decoded.handler)(decoded.instruction);
+
+                if (i + 1 == instructions.size())
+                    return true;
+                if (cpu.eip() != decoded.next_address || m_statistics.invalidated_blocks != invalidated_blocks)
+                    return false;
+            }
+
+            return false;
+        }
+
+        void clear();
+
+        size_t block_count() const
+        {
+            return m_blocks.size();
+        }
+
+        Statistics const& statistics() const
+        {
+            return m_statistics;
+        }
+
+    private:
+        /**
+         * @param block
+         * @return DecodedBlock const&
+         */
+        DecodedBlock const& add_block(NonnullOwnPtr<DecodedBlock>);
+
+        /**
+         * @param first_page
+         * @param last_page
+         */
+        void invalidate_pages(u32 first_page, u32 last_page);
+
+        /**
+         * @param start
+         */
+        void retire_block(u32 start);
+
+        FlatHashMap<u32, NonnullOwnPtr<DecodedBlock>> m_blocks;
+        FlatHashMap<u32, Vector<u32>> m_blocks_by_page;
+        Bitmap m_code_pages;
+        Vector<NonnullOwnPtr<DecodedBlock>> m_retired_blocks;
+        Statistics m_statistics;
+    }; // class BasicBlockCache
+
+} // namespace X86
@@ -19,20 +19,12 @@
 
 namespace X86 
 {
-    InstructionDescriptor s_table16[256];
-    InstructionDescriptor s_table32[256];
-    InstructionDescriptor s_0f_table16[256];
-    InstructionDescriptor s_0f_table32[256];
-    InstructionDescriptor s_sse_table_np[256];
-    InstructionDescriptor s_sse_table_66[256];
-    InstructionDescriptor s_sse_table_f3[256];
-
     /**
      * @param op 
      * @return true 
      * @return false 
      */
-    static bool opcode_has_register_index(u8 op)
+    static constexpr bool opcode_has_register_index(u8 op)
     {
         if (op >= 0x40 && op <= 0x5F)
             return true;
@@ -44,458 +36,550 @@ namespace X86
     }
 
     /**
-     * @param table 
-     * @param op 
-     * @param mnemonic 
-     * @param format 
-     * @param handler 
-     * @param lock_prefix_allowed 
+     * @brief fills in an OpcodeTables. everything it does is constexpr, so
+     *        the tables are constant-initialized rather than built by a
+     *        static constructor at program start.
      */
-    static void build(InstructionDescriptor* table, u8 op, const char* mnemonic, InstructionFormat format, InstructionHandler handler, IsLockPrefixAllowed lock_prefix_allowed)
+    class OpcodeTableBuilder
     {
-        InstructionDescriptor& d = table[op];
-
-        d.handler = handler;
-        d.mnemonic = mnemonic;
-        d.format = format;
-        d.lock_prefix_allowed = lock_prefix_allowed;
+    public:
+        /**
+         * @param tables
+         */
+        constexpr explicit OpcodeTableBuilder(OpcodeTables& tables)
+            : m_tables(tables)
+        {
+        }
 
-        if ((format > __BeginFormatsWithRMByte && format < __EndFormatsWithRMByte) || format == MultibyteWithSlash)
-            d.has_rm = true;
-        else
-            d.opcode_has_register_index = opcode_has_register_index(op);
+        constexpr void build_all();
+
+    private:
+        /**
+         * @brief slash tables are carved out of the fixed pool in
+         *        OpcodeTables, since constant evaluation cannot keep heap
+         *        allocations.
+         *
+         * @return InstructionDescriptor*
+         */
+        constexpr InstructionDescriptor* allocate_slashes()
+        {
+            VERIFY(m_tables.slash_descriptor_count + 8 <= max_slash_descriptors);
+            auto* slashes = &m_tables.slash_descriptors[m_tables.slash_descriptor_count];
+            m_tables.slash_descriptor_count += 8;
+            return slashes;
+        }
 
-        switch (format) {
-        case OP_RM8_imm8:
-        case OP_RM16_imm8:
-        case OP_RM32_imm8:
-        case OP_reg16_RM16_imm8:
-        case OP_reg32_RM32_imm8:
-        case OP_AL_imm8:
-        case OP_imm8:
-        case OP_reg8_imm8:
-        case OP_AX_imm8:
-        case OP_EAX_imm8:
-        case OP_short_imm8:
-        case OP_imm8_AL:
-        case OP_imm8_AX:
-        case OP_imm8_EAX:
-        case OP_RM16_reg16_imm8:
-        case OP_RM32_reg32_imm8:
-        case OP_mm1_imm8:
-        case OP_mm1_mm2m64_imm8:
-        case OP_reg_mm1_imm8:
-        case OP_mm1_r32m16_imm8:
-        case OP_xmm1_xmm2m32_imm8:
-        case OP_xmm1_xmm2m128_imm8:
-        case OP_reg_xmm1_imm8:
-        case OP_xmm1_r32m16_imm8:
-            d.imm1_bytes = 1;
-            break;
-        case OP_reg16_RM16_imm16:
-        case OP_AX_imm16:
-        case OP_imm16:
-        case OP_relimm16:
-        case OP_reg16_imm16:
-        case OP_RM16_imm16:
-            d.imm1_bytes = 2;
-            break;
-        case OP_RM32_imm32:
-        case OP_reg32_RM32_imm32:
-        case OP_reg32_imm32:
-        case OP_EAX_imm32:
-        case OP_imm32:
-        case OP_relimm32:
-            d.imm1_bytes = 4;
-            break;
-        case OP_imm16_imm8:
-            d.imm1_bytes = 2;
-            d.imm2_bytes = 1;
-            break;
-        case OP_imm16_imm16:
-            d.imm1_bytes = 2;
-            d.imm2_bytes = 2;
-            break;
-        case OP_imm16_imm32:
-            d.imm1_bytes = 2;
-            d.imm2_bytes = 4;
-            break;
-        case OP_moff8_AL:
-        case OP_moff16_AX:
-        case OP_moff32_EAX:
-        case OP_AL_moff8:
-        case OP_AX_moff16:
-        case OP_EAX_moff32:
-        case OP_NEAR_imm:
-            d.imm1_bytes = CurrentAddressSize;
-            break;
-        case InvalidFormat:
-        case MultibyteWithSlash:
-        case InstructionPrefix:
-        case __BeginFormatsWithRMByte:
-        case OP_RM16_reg16:
-        case OP_reg8_RM8:
-        case OP_reg16_RM16:
-        case OP_RM16_seg:
-        case OP_RM32_seg:
-        case OP_RM8:
-        case OP_RM16:
-        case OP_RM32:
-        case OP_FPU:
-        case OP_FPU_reg:
-        case OP_FPU_mem:
-        case OP_FPU_AX16:
-        case OP_FPU_RM16:
-        case OP_FPU_RM32:
-        case OP_FPU_RM64:
-        case OP_FPU_M80:
-        case OP_RM8_reg8:
-        case OP_RM32_reg32:
-        case OP_reg32_RM32:
-        case OP_reg16_mem16:
-        case OP_reg32_mem32:
-        case OP_seg_RM16:
-        case OP_seg_RM32:
-        case OP_RM8_1:
-        case OP_RM16_1:
-        case OP_RM32_1:
-        case OP_FAR_mem16:
-        case OP_FAR_mem32:
-        case OP_RM8_CL:
-        case OP_RM16_CL:
-        case OP_RM32_CL:
-        case OP_reg32_CR:
-        case OP_CR_reg32:
-        case OP_reg16_RM8:
-        case OP_reg32_RM8:
-        case OP_mm1_rm32:
-        case OP_rm32_mm2:
-        case OP_mm1_mm2m64:
-        case OP_mm1_mm2m32:
-        case OP_mm1m64_mm2:
-        case OP_reg_mm1:
-        case __SSE:
-        case OP_xmm1_xmm2m32:
-        case OP_xmm1_xmm2m64:
-        case OP_xmm1_xmm2m128:
-        case OP_xmm1m32_xmm2:
-        case OP_xmm1m64_xmm2:
-        case OP_xmm1m128_xmm2:
-        case OP_reg_xmm1:
-        case OP_xmm1_rm32:
-        case OP_xmm1_m64:
-        case OP_m64_xmm2:
-        case OP_rm8_xmm2m32:
-        case OP_xmm1_mm2m64:
-        case OP_mm1m64_xmm2:
-        case OP_mm1_xmm2m64:
-        case OP_r32_xmm2m32:
-        case __EndFormatsWithRMByte:
-        case OP_CS:
-        case OP_DS:
-        case OP_ES:
-        case OP_SS:
-        case OP_FS:
-        case OP_GS:
-        case OP:
-        case OP_reg16:
-        case OP_AX_reg16:
-        case OP_EAX_reg32:
-        case OP_3:
-        case OP_AL_DX:
-        case OP_AX_DX:
-        case OP_EAX_DX:
-        case OP_DX_AL:
-        case OP_DX_AX:
-        case OP_DX_EAX:
-        case OP_reg8_CL:
-        case OP_reg32:
-        case OP_reg32_RM16:
-        case OP_reg32_DR:
-        case OP_DR_reg32:
-        case OP_RM16_reg16_CL:
-        case OP_RM32_reg32_CL:
-            break;
+        /**
+         * @brief whether a /digit descriptor has a table by rm of its own.
+         *        this is tracked on the side, since comparing an address in
+         *        the pool with null is not a constant expression when
+         *        building with -fsanitize=null.
+         *
+         * @param d a descriptor in the slash pool
+         * @return bool&
+         */
+        constexpr bool& has_rm_table(InstructionDescriptor const& d)
+        {
+            return m_has_rm_table[&d - m_tables.slash_descriptors];
         }
-    }
 
-    /**
-     * @param table 
-     * @param op 
-     * @param slash 
-     * @param mnemonic 
-     * @param format 
-     * @param handler 
-     * @param lock_prefix_allowed 
-     */
-    static void build_slash(InstructionDescriptor* table, u8 op, u8 slash, const char* mnemonic, InstructionFormat format, InstructionHandler handler, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
-    {
-        InstructionDescriptor& d = table[op];
-        VERIFY(d.handler == nullptr);
-        d.format = MultibyteWithSlash;
-        d.has_rm = true;
-        if (!d.slashes)
-            d.slashes = new InstructionDescriptor[8];
-
-        build(d.slashes, slash, mnemonic, format, handler, lock_prefix_allowed);
-    }
+        /**
+         * @brief marks the instructions that may transfer control, so
+         *        that a decoded basic block ends right after them.
+         */
+        constexpr void mark_block_terminators()
+        {
+            for (u8 op : { 0x9A, 0xC2, 0xC3, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF, 0xE0, 0xE1, 0xE2, 0xE3, 0xE8, 0xE9, 0xEA, 0xEB, 0xF4 }) {
+                m_tables.table16[op].ends_basic_block = true;
+                m_tables.table32[op].ends_basic_block = true;
+            }
 
-    /**
-     * @param table 
-     * @param op 
-     * @param slash 
-     * @param rm 
-     * @param mnemonic 
-     * @param format 
-     * @param handler 
-     */
-    static void build_slash_rm(InstructionDescriptor* table, u8 op, u8 slash, u8 rm, const char* mnemonic, InstructionFormat format, InstructionHandler handler)
-    {
-        VERIFY((rm & 0xc0) == 0xc0);
-        VERIFY(((rm >> 3) & 7) == slash);
-
-        InstructionDescriptor& d0 = table[op];
-        VERIFY(d0.format == MultibyteWithSlash);
-        InstructionDescriptor& d = d0.slashes[slash];
-
-        if (!d.slashes) {
-            d.slashes = new InstructionDescriptor[8];
-            for (int i = 0; i < 8; ++i) {
-                d.slashes[i] = d;
-                d.slashes[i].slashes = nullptr;
+            for (u8 op = 0x70; op <= 0x7F; ++op) {
+                m_tables.table16[op].ends_basic_block = true;
+                m_tables.table32[op].ends_basic_block = true;
+            }
+
+            for (u8 op = 0x80; op <= 0x8F; ++op) {
+                m_tables.table_0f16[op].ends_basic_block = true;
+                m_tables.table_0f32[op].ends_basic_block = true;
+            }
+
+            for (u8 op : { 0x05, 0x0B, 0x34, 0x35 }) {
+                m_tables.table_0f16[op].ends_basic_block = true;
+                m_tables.table_0f32[op].ends_basic_block = true;
+            }
+
+            // CALL, CALLF, JMP and JMPF through a register or memory
+            for (auto* table : { m_tables.table16, m_tables.table32 }) {
+                for (u8 slash = 2; slash <= 5; ++slash) {
+                    auto& d = table[0xFF].slashes[slash];
+                    d.ends_basic_block = true;
+                    if (has_rm_table(d)) {
+                        for (size_t rm = 0; rm < 8; ++rm)
+                            d.slashes[rm].ends_basic_block = true;
+                    }
+                }
             }
         }
 
-        build(d.slashes, rm & 7, mnemonic, format, handler, LockPrefixNotAllowed);
-    }
+        /**
+         * @param table 
+         * @param op 
+         * @param mnemonic 
+         * @param format 
+         * @param handler 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build(InstructionDescriptor* table, u8 op, const char* mnemonic, InstructionFormat format, InstructionHandler handler, IsLockPrefixAllowed lock_prefix_allowed)
+        {
+            InstructionDescriptor& d = table[op];
+
+            d.handler = handler;
+            d.mnemonic = mnemonic;
+            d.format = format;
+            d.lock_prefix_allowed = lock_prefix_allowed;
+
+            if ((format > __BeginFormatsWithRMByte && format < __EndFormatsWithRMByte) || format == MultibyteWithSlash)
+                d.has_rm = true;
+            else
+                d.opcode_has_register_index = opcode_has_register_index(op);
+
+            switch (format) {
+            case OP_RM8_imm8:
+            case OP_RM16_imm8:
+            case OP_RM32_imm8:
+            case OP_reg16_RM16_imm8:
+            case OP_reg32_RM32_imm8:
+            case OP_AL_imm8:
+            case OP_imm8:
+            case OP_reg8_imm8:
+            case OP_AX_imm8:
+            case OP_EAX_imm8:
+            case OP_short_imm8:
+            case OP_imm8_AL:
+            case OP_imm8_AX:
+            case OP_imm8_EAX:
+            case OP_RM16_reg16_imm8:
+            case OP_RM32_reg32_imm8:
+            case OP_mm1_imm8:
+            case OP_mm1_mm2m64_imm8:
+            case OP_reg_mm1_imm8:
+            case OP_mm1_r32m16_imm8:
+            case OP_xmm1_xmm2m32_imm8:
+            case OP_xmm1_xmm2m128_imm8:
+            case OP_reg_xmm1_imm8:
+            case OP_xmm1_r32m16_imm8:
+                d.imm1_bytes = 1;
+                break;
+            case OP_reg16_RM16_imm16:
+            case OP_AX_imm16:
+            case OP_imm16:
+            case OP_relimm16:
+            case OP_reg16_imm16:
+            case OP_RM16_imm16:
+                d.imm1_bytes = 2;
+                break;
+            case OP_RM32_imm32:
+            case OP_reg32_RM32_imm32:
+            case OP_reg32_imm32:
+            case OP_EAX_imm32:
+            case OP_imm32:
+            case OP_relimm32:
+                d.imm1_bytes = 4;
+                break;
+            case OP_imm16_imm8:
+                d.imm1_bytes = 2;
+                d.imm2_bytes = 1;
+                break;
+            case OP_imm16_imm16:
+                d.imm1_bytes = 2;
+                d.imm2_bytes = 2;
+                break;
+            case OP_imm16_imm32:
+                d.imm1_bytes = 2;
+                d.imm2_bytes = 4;
+                break;
+            case OP_moff8_AL:
+            case OP_moff16_AX:
+            case OP_moff32_EAX:
+            case OP_AL_moff8:
+            case OP_AX_moff16:
+            case OP_EAX_moff32:
+            case OP_NEAR_imm:
+                d.imm1_bytes = CurrentAddressSize;
+                break;
+            case InvalidFormat:
+            case MultibyteWithSlash:
+            case InstructionPrefix:
+            case __BeginFormatsWithRMByte:
+            case OP_RM16_reg16:
+            case OP_reg8_RM8:
+            case OP_reg16_RM16:
+            case OP_RM16_seg:
+            case OP_RM32_seg:
+            case OP_RM8:
+            case OP_RM16:
+            case OP_RM32:
+            case OP_FPU:
+            case OP_FPU_reg:
+            case OP_FPU_mem:
+            case OP_FPU_AX16:
+            case OP_FPU_RM16:
+            case OP_FPU_RM32:
+            case OP_FPU_RM64:
+            case OP_FPU_M80:
+            case OP_RM8_reg8:
+            case OP_RM32_reg32:
+            case OP_reg32_RM32:
+            case OP_reg16_mem16:
+            case OP_reg32_mem32:
+            case OP_seg_RM16:
+            case OP_seg_RM32:
+            case OP_RM8_1:
+            case OP_RM16_1:
+            case OP_RM32_1:
+            case OP_FAR_mem16:
+            case OP_FAR_mem32:
+            case OP_RM8_CL:
+            case OP_RM16_CL:
+            case OP_RM32_CL:
+            case OP_reg32_CR:
+            case OP_CR_reg32:
+            case OP_reg16_RM8:
+            case OP_reg32_RM8:
+            case OP_mm1_rm32:
+            case OP_rm32_mm2:
+            case OP_mm1_mm2m64:
+            case OP_mm1_mm2m32:
+            case OP_mm1m64_mm2:
+            case OP_reg_mm1:
+            case __SSE:
+            case OP_xmm1_xmm2m32:
+            case OP_xmm1_xmm2m64:
+            case OP_xmm1_xmm2m128:
+            case OP_xmm1m32_xmm2:
+            case OP_xmm1m64_xmm2:
+            case OP_xmm1m128_xmm2:
+            case OP_reg_xmm1:
+            case OP_xmm1_rm32:
+            case OP_xmm1_m64:
+            case OP_m64_xmm2:
+            case OP_rm8_xmm2m32:
+            case OP_xmm1_mm2m64:
+            case OP_mm1m64_xmm2:
+            case OP_mm1_xmm2m64:
+            case OP_r32_xmm2m32:
+            case __EndFormatsWithRMByte:
+            case OP_CS:
+            case OP_DS:
+            case OP_ES:
+            case OP_SS:
+            case OP_FS:
+            case OP_GS:
+            case OP:
+            case OP_reg16:
+            case OP_AX_reg16:
+            case OP_EAX_reg32:
+            case OP_3:
+            case OP_AL_DX:
+            case OP_AX_DX:
+            case OP_EAX_DX:
+            case OP_DX_AL:
+            case OP_DX_AX:
+            case OP_DX_EAX:
+            case OP_reg8_CL:
+            case OP_reg32:
+            case OP_reg32_RM16:
+            case OP_reg32_DR:
+            case OP_DR_reg32:
+            case OP_RM16_reg16_CL:
+            case OP_RM32_reg32_CL:
+                break;
+            }
+        }
 
-    /**
-     * @param op 
-     * @param mnemonic 
-     * @param format 
-     * @param impl 
-     * @param lock_prefix_allowed 
-     */
-    static void build_0f(u8 op, const char* mnemonic, InstructionFormat format, InstructionHandler impl, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
-    {
-        build(s_0f_table16, op, mnemonic, format, impl, lock_prefix_allowed);
-        build(s_0f_table32, op, mnemonic, format, impl, lock_prefix_allowed);
-    }
+        /**
+         * @param table 
+         * @param op 
+         * @param slash 
+         * @param mnemonic 
+         * @param format 
+         * @param handler 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build_slash(InstructionDescriptor* table, u8 op, u8 slash, const char* mnemonic, InstructionFormat format, InstructionHandler handler, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+        {
+            InstructionDescriptor& d = table[op];
+            VERIFY(d.handler == nullptr);
+            if (d.format != MultibyteWithSlash)
+                d.slashes = allocate_slashes();
+            d.format = MultibyteWithSlash;
+            d.has_rm = true;
 
-    /**
-     * @param op 
-     * @param mnemonic 
-     * @param format 
-     * @param impl 
-     * @param lock_prefix_allowed 
-     */
-    static void build(u8 op, const char* mnemonic, InstructionFormat format, InstructionHandler impl, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
-    {
-        build(s_table16, op, mnemonic, format, impl, lock_prefix_allowed);
-        build(s_table32, op, mnemonic, format, impl, lock_prefix_allowed);
-    }
+            build(d.slashes, slash, mnemonic, format, handler, lock_prefix_allowed);
+        }
 
-    /**
-     * @param op 
-     * @param mnemonic 
-     * @param format16 
-     * @param impl16 
-     * @param format32 
-     * @param impl32 
-     * @param lock_prefix_allowed 
-     */
-    static void build(u8 op, const char* mnemonic, InstructionFormat format16, InstructionHandler impl16, InstructionFormat format32, InstructionHandler impl32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
-    {
-        build(s_table16, op, mnemonic, format16, impl16, lock_prefix_allowed);
-        build(s_table32, op, mnemonic, format32, impl32, lock_prefix_allowed);
-    }
+        /**
+         * @param table 
+         * @param op 
+         * @param slash 
+         * @param rm 
+         * @param mnemonic 
+         * @param format 
+         * @param handler 
+         */
+        constexpr void build_slash_rm(InstructionDescriptor* table, u8 op, u8 slash, u8 rm, const char* mnemonic, InstructionFormat format, InstructionHandler handler)
+        {
+            VERIFY((rm & 0xc0) == 0xc0);
+            VERIFY(((rm >> 3) & 7) == slash);
+
+            InstructionDescriptor& d0 = table[op];
+            VERIFY(d0.format == MultibyteWithSlash);
+            InstructionDescriptor& d = d0.slashes[slash];
+
+            if (!has_rm_table(d)) {
+                has_rm_table(d) = true;
+                d.slashes = allocate_slashes();
+                for (int i = 0; i < 8; ++i) {
+                    d.slashes[i] = d;
+                    d.slashes[i].slashes = nullptr;
+                }
+            }
 
-    /**
-     * @param op 
-     * @param mnemonic 
-     * @param format16 
-     * @param impl16 
-     * @param format32 
-     * @param impl32 
-     * @param lock_prefix_allowed 
-     */
-    static void build_0f(u8 op, const char* mnemonic, InstructionFormat format16, InstructionHandler impl16, InstructionFormat format32, InstructionHandler impl32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
-    {
-        build(s_0f_table16, op, mnemonic, format16, impl16, lock_prefix_allowed);
-        build(s_0f_table32, op, mnemonic, format32, impl32, lock_prefix_allowed);
-    }
+            build(d.slashes, rm & 7, mnemonic, format, handler, LockPrefixNotAllowed);
+        }
 
-    /**
-     * @param op 
-     * @param mnemonic16 
-     * @param format16 
-     * @param impl16 
-     * @param mnemonic32 
-     * @param format32 
-     * @param impl32 
-     * @param lock_prefix_allowed 
-     */
-    static void build(u8 op, const char* mnemonic16, InstructionFormat format16, InstructionHandler impl16, const char* mnemonic32, InstructionFormat format32, InstructionHandler impl32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
-    {
-        build(s_table16, op, mnemonic16, format16, impl16, lock_prefix_allowed);
-        build(s_table32, op, mnemonic32, format32, impl32, lock_prefix_allowed);
-    }   
+        /**
+         * @param op 
+         * @param mnemonic 
+         * @param format 
+         * @param impl 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build_0f(u8 op, const char* mnemonic, InstructionFormat format, InstructionHandler impl, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+        {
+            build(m_tables.table_0f16, op, mnemonic, format, impl, lock_prefix_allowed);
+            build(m_tables.table_0f32, op, mnemonic, format, impl, lock_prefix_allowed);
+        }
 
-    /**
-     * @param op 
-     * @param mnemonic16 
-     * @param format16 
-     * @param impl16 
-     * @param mnemonic32 
-     * @param format32 
-     * @param impl32 
-     * @param lock_prefix_allowed 
-     */
-    static void build_0f(u8 op, const char* mnemonic16, InstructionFormat format16, InstructionHandler impl16, const char* mnemonic32, InstructionFormat format32, InstructionHandler impl32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
-    {
-        build(s_0f_table16, op, mnemonic16, format16, impl16, lock_prefix_allowed);
-        build(s_0f_table32, op, mnemonic32, format32, impl32, lock_prefix_allowed);
-    }
+        /**
+         * @param op 
+         * @param mnemonic 
+         * @param format 
+         * @param impl 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build(u8 op, const char* mnemonic, InstructionFormat format, InstructionHandler impl, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+        {
+            build(m_tables.table16, op, mnemonic, format, impl, lock_prefix_allowed);
+            build(m_tables.table32, op, mnemonic, format, impl, lock_prefix_allowed);
+        }
 
-    /**
-     * @param op 
-     * @param slash 
-     * @param mnemonic 
-     * @param format 
-     * @param impl 
-     * @param lock_prefix_allowed 
-     */
-    static void build_slash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format, InstructionHandler impl, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
-    {
-        build_slash(s_table16, op, slash, mnemonic, format, impl, lock_prefix_allowed);
-        build_slash(s_table32, op, slash, mnemonic, format, impl, lock_prefix_allowed);
-    }
+        /**
+         * @param op 
+         * @param mnemonic 
+         * @param format16 
+         * @param impl16 
+         * @param format32 
+         * @param impl32 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build(u8 op, const char* mnemonic, InstructionFormat format16, InstructionHandler impl16, InstructionFormat format32, InstructionHandler impl32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+        {
+            build(m_tables.table16, op, mnemonic, format16, impl16, lock_prefix_allowed);
+            build(m_tables.table32, op, mnemonic, format32, impl32, lock_prefix_allowed);
+        }
 
-    /**
-     * @param op 
-     * @param slash 
-     * @param mnemonic 
-     * @param format16 
-     * @param impl16 
-     * @param format32 
-     * @param impl32 
-     * @param lock_prefix_allowed 
-     */
-    static void build_slash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format16, InstructionHandler impl16, InstructionFormat format32, InstructionHandler impl32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
-    {
-        build_slash(s_table16, op, slash, mnemonic, format16, impl16, lock_prefix_allowed);
-        build_slash(s_table32, op, slash, mnemonic, format32, impl32, lock_prefix_allowed);
-    }
+        /**
+         * @param op 
+         * @param mnemonic 
+         * @param format16 
+         * @param impl16 
+         * @param format32 
+         * @param impl32 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build_0f(u8 op, const char* mnemonic, InstructionFormat format16, InstructionHandler impl16, InstructionFormat format32, InstructionHandler impl32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+        {
+            build(m_tables.table_0f16, op, mnemonic, format16, impl16, lock_prefix_allowed);
+            build(m_tables.table_0f32, op, mnemonic, format32, impl32, lock_prefix_allowed);
+        }
 
-    /**
-     * @param op 
-     * @param slash 
-     * @param mnemonic 
-     * @param format16 
-     * @param impl16 
-     * @param format32 
-     * @param impl32 
-     * @param lock_prefix_allowed 
-     */
-    static void build_0f_slash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format16, InstructionHandler impl16, InstructionFormat format32, InstructionHandler impl32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
-    {
-        build_slash(s_0f_table16, op, slash, mnemonic, format16, impl16, lock_prefix_allowed);
-        build_slash(s_0f_table32, op, slash, mnemonic, format32, impl32, lock_prefix_allowed);
-    }
+        /**
+         * @param op 
+         * @param mnemonic16 
+         * @param format16 
+         * @param impl16 
+         * @param mnemonic32 
+         * @param format32 
+         * @param impl32 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build(u8 op, const char* mnemonic16, InstructionFormat format16, InstructionHandler impl16, const char* mnemonic32, InstructionFormat format32, InstructionHandler impl32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+        {
+            build(m_tables.table16, op, mnemonic16, format16, impl16, lock_prefix_allowed);
+            build(m_tables.table32, op, mnemonic32, format32, impl32, lock_prefix_allowed);
+        }   
+
+        /**
+         * @param op 
+         * @param mnemonic16 
+         * @param format16 
+         * @param impl16 
+         * @param mnemonic32 
+         * @param format32 
+         * @param impl32 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build_0f(u8 op, const char* mnemonic16, InstructionFormat format16, InstructionHandler impl16, const char* mnemonic32, InstructionFormat format32, InstructionHandler impl32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+        {
+            build(m_tables.table_0f16, op, mnemonic16, format16, impl16, lock_prefix_allowed);
+            build(m_tables.table_0f32, op, mnemonic32, format32, impl32, lock_prefix_allowed);
+        }
 
-    /**
-     * @param op 
-     * @param slash 
-     * @param mnemonic 
-     * @param format 
-     * @param impl 
-     * @param lock_prefix_allowed 
-     */
-    static void build_0f_slash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format, InstructionHandler impl, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
-    {
-        build_slash(s_0f_table16, op, slash, mnemonic, format, impl, lock_prefix_allowed);
-        build_slash(s_0f_table32, op, slash, mnemonic, format, impl, lock_prefix_allowed);
-    }
+        /**
+         * @param op 
+         * @param slash 
+         * @param mnemonic 
+         * @param format 
+         * @param impl 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build_slash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format, InstructionHandler impl, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+        {
+            build_slash(m_tables.table16, op, slash, mnemonic, format, impl, lock_prefix_allowed);
+            build_slash(m_tables.table32, op, slash, mnemonic, format, impl, lock_prefix_allowed);
+        }
 
-    /**
-     * @param op 
-     * @param slash 
-     * @param rm 
-     * @param mnemonic 
-     * @param format 
-     * @param impl 
-     */
-    static void build_slash_rm(u8 op, u8 slash, u8 rm, const char* mnemonic, InstructionFormat format, InstructionHandler impl)
-    {
-        build_slash_rm(s_table16, op, slash, rm, mnemonic, format, impl);
-        build_slash_rm(s_table32, op, slash, rm, mnemonic, format, impl);
-    }
+        /**
+         * @param op 
+         * @param slash 
+         * @param mnemonic 
+         * @param format16 
+         * @param impl16 
+         * @param format32 
+         * @param impl32 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build_slash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format16, InstructionHandler impl16, InstructionFormat format32, InstructionHandler impl32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+        {
+            build_slash(m_tables.table16, op, slash, mnemonic, format16, impl16, lock_prefix_allowed);
+            build_slash(m_tables.table32, op, slash, mnemonic, format32, impl32, lock_prefix_allowed);
+        }
 
-    /**
-     * @param op 
-     * @param slash 
-     * @param mnemonic 
-     * @param format 
-     * @param impl 
-     */
-    static void build_slash_reg(u8 op, u8 slash, const char* mnemonic, InstructionFormat format, InstructionHandler impl)
-    {
-        for (int i = 0; i < 8; ++i)
-            build_slash_rm(op, slash, 0xc0 | (slash << 3) | i, mnemonic, format, impl);
-    }
+        /**
+         * @param op 
+         * @param slash 
+         * @param mnemonic 
+         * @param format16 
+         * @param impl16 
+         * @param format32 
+         * @param impl32 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build_0f_slash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format16, InstructionHandler impl16, InstructionFormat format32, InstructionHandler impl32, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+        {
+            build_slash(m_tables.table_0f16, op, slash, mnemonic, format16, impl16, lock_prefix_allowed);
+            build_slash(m_tables.table_0f32, op, slash, mnemonic, format32, impl32, lock_prefix_allowed);
+        }
 
-    /**
-     * @param op 
-     * @param mnemonic 
-     * @param format 
-     * @param impl 
-     * @param lock_prefix_allowed 
-     */
-    static void build_sse_np(u8 op, const char* mnemonic, InstructionFormat format, InstructionHandler impl, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
-    {
-        if (s_0f_table32[op].format == InvalidFormat) {
-            build_0f(op, mnemonic, format, impl, lock_prefix_allowed);
-            build(s_sse_table_np, op, mnemonic, format, impl, lock_prefix_allowed);
-            return;
+        /**
+         * @param op 
+         * @param slash 
+         * @param mnemonic 
+         * @param format 
+         * @param impl 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build_0f_slash(u8 op, u8 slash, const char* mnemonic, InstructionFormat format, InstructionHandler impl, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+        {
+            build_slash(m_tables.table_0f16, op, slash, mnemonic, format, impl, lock_prefix_allowed);
+            build_slash(m_tables.table_0f32, op, slash, mnemonic, format, impl, lock_prefix_allowed);
         }
-        if (s_0f_table32[op].format != __SSE)
-            build_0f(op, "__SSE_temp", __SSE, nullptr, lock_prefix_allowed);
 
-        VERIFY(s_0f_table32[op].format == __SSE);
-        build(s_sse_table_np, op, mnemonic, format, impl, lock_prefix_allowed);
-    }
+        /**
+         * @param op 
+         * @param slash 
+         * @param rm 
+         * @param mnemonic 
+         * @param format 
+         * @param impl 
+         */
+        constexpr void build_slash_rm(u8 op, u8 slash, u8 rm, const char* mnemonic, InstructionFormat format, InstructionHandler impl)
+        {
+            build_slash_rm(m_tables.table16, op, slash, rm, mnemonic, format, impl);
+            build_slash_rm(m_tables.table32, op, slash, rm, mnemonic, format, impl);
+        }
 
-    /**
-     * @param op 
-     * @param mnemonic 
-     * @param format 
-     * @param impl 
-     * @param lock_prefix_allowed 
-     */
-    static void build_sse_66(u8 op, const char* mnemonic, InstructionFormat format, InstructionHandler impl, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
-    {
-        if (s_0f_table32[op].format != __SSE)
-            build_0f(op, "__SSE_temp", __SSE, nullptr, lock_prefix_allowed);
-        VERIFY(s_0f_table32[op].format == __SSE);
-        build(s_sse_table_66, op, mnemonic, format, impl, lock_prefix_allowed);
-    }
+        /**
+         * @param op 
+         * @param slash 
+         * @param mnemonic 
+         * @param format 
+         * @param impl 
+         */
+        constexpr void build_slash_reg(u8 op, u8 slash, const char* mnemonic, InstructionFormat format, InstructionHandler impl)
+        {
+            for (int i = 0; i < 8; ++i)
+                build_slash_rm(op, slash, 0xc0 | (slash << 3) | i, mnemonic, format, impl);
+        }
 
-    /**
-     * @param op 
-     * @param mnemonic 
-     * @param format 
-     * @param impl 
-     * @param lock_prefix_allowed 
-     */
-    static void build_sse_f3(u8 op, const char* mnemonic, InstructionFormat format, InstructionHandler impl, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
-    {
-        if (s_0f_table32[op].format != __SSE)
-            build_0f(op, "__SSE_temp", __SSE, nullptr, lock_prefix_allowed);
-        VERIFY(s_0f_table32[op].format == __SSE);
-        build(s_sse_table_f3, op, mnemonic, format, impl, lock_prefix_allowed);
-    }
+        /**
+         * @param op 
+         * @param mnemonic 
+         * @param format 
+         * @param impl 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build_sse_np(u8 op, const char* mnemonic, InstructionFormat format, InstructionHandler impl, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+        {
+            if (m_tables.table_0f32[op].format == InvalidFormat) {
+                build_0f(op, mnemonic, format, impl, lock_prefix_allowed);
+                build(m_tables.sse_table_np, op, mnemonic, format, impl, lock_prefix_allowed);
+                return;
+            }
+            if (m_tables.table_0f32[op].format != __SSE)
+                build_0f(op, "__SSE_temp", __SSE, nullptr, lock_prefix_allowed);
+
+            VERIFY(m_tables.table_0f32[op].format == __SSE);
+            build(m_tables.sse_table_np, op, mnemonic, format, impl, lock_prefix_allowed);
+        }
+
+        /**
+         * @param op 
+         * @param mnemonic 
+         * @param format 
+         * @param impl 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build_sse_66(u8 op, const char* mnemonic, InstructionFormat format, InstructionHandler impl, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+        {
+            if (m_tables.table_0f32[op].format != __SSE)
+                build_0f(op, "__SSE_temp", __SSE, nullptr, lock_prefix_allowed);
+            VERIFY(m_tables.table_0f32[op].format == __SSE);
+            build(m_tables.sse_table_66, op, mnemonic, format, impl, lock_prefix_allowed);
+        }
 
-    [[gnu::constructor]] static void build_opcode_tables()
+        /**
+         * @param op 
+         * @param mnemonic 
+         * @param format 
+         * @param impl 
+         * @param lock_prefix_allowed 
+         */
+        constexpr void build_sse_f3(u8 op, const char* mnemonic, InstructionFormat format, InstructionHandler impl, IsLockPrefixAllowed lock_prefix_allowed = LockPrefixNotAllowed)
+        {
+            if (m_tables.table_0f32[op].format != __SSE)
+                build_0f(op, "__SSE_temp", __SSE, nullptr, lock_prefix_allowed);
+            VERIFY(m_tables.table_0f32[op].format == __SSE);
+            build(m_tables.sse_table_f3, op, mnemonic, format, impl, lock_prefix_allowed);
+        }
+
+        OpcodeTables& m_tables;
+        bool m_has_rm_table[max_slash_descriptors] {};
+    }; // class OpcodeTableBuilder
+
+    constexpr void OpcodeTableBuilder::build_all()
     {
         build(0x00, "ADD", OP_RM8_reg8, &Interpreter::ADD_RM8_reg8, LockPrefixAllowed);
         build(0x01, "ADD", OP_RM16_reg16, &Interpreter::ADD_RM16_reg16, OP_RM32_reg32, &Interpreter::ADD_RM32_reg32, LockPrefixAllowed);
@@ -1216,8 +1300,17 @@ namespace X86
         build_0f(0xFD, "PADDW", OP_mm1_mm2m64, &Interpreter::PADDW_mm1_mm2m64);
         build_0f(0xFE, "PADDD", OP_mm1_mm2m64, &Interpreter::PADDD_mm1_mm2m64);
         build_0f(0xFF, "UD0", OP, &Interpreter::UD0);
+
+        mark_block_terminators();
     }
 
+    constexpr OpcodeTables::OpcodeTables()
+    {
+        OpcodeTableBuilder(*this).build_all();
+    }
+
+    constinit OpcodeTables s_opcode_tables;
+
     static const char* register_name(RegisterIndex8);
     static const char* register_name(RegisterIndex16);
     static const char* register_name(RegisterIndex32);
@@ -245,15 +245,34 @@ namespace X86
         }
 
         IsLockPrefixAllowed lock_prefix_allowed { LockPrefixNotAllowed };
+
+        bool ends_basic_block { false };
     }; // struct InstructionDescriptor 
 
-    extern InstructionDescriptor s_table16[256];
-    extern InstructionDescriptor s_table32[256];
-    extern InstructionDescriptor s_0f_table16[256];
-    extern InstructionDescriptor s_0f_table32[256];
-    extern InstructionDescriptor s_sse_table_np[256];
-    extern InstructionDescriptor s_sse_table_66[256];
-    extern InstructionDescriptor s_sse_table_f3[256];
+    static constexpr size_t max_slash_descriptors = 8 * 128;
+
+    /**
+     * @brief every decoder table, with the /digit and /digit+rm sub-tables
+     *        in one fixed pool. the constructor is constexpr, so the whole
+     *        thing is constant-initialized data in the image.
+     */
+    struct OpcodeTables 
+    {
+        constexpr OpcodeTables();
+
+        InstructionDescriptor table16[256];
+        InstructionDescriptor table32[256];
+        InstructionDescriptor table_0f16[256];
+        InstructionDescriptor table_0f32[256];
+        InstructionDescriptor sse_table_np[256];
+        InstructionDescriptor sse_table_66[256];
+        InstructionDescriptor sse_table_f3[256];
+
+        InstructionDescriptor slash_descriptors[max_slash_descriptors];
+        size_t slash_descriptor_count { 0 };
+    }; // struct OpcodeTables
+
+    extern OpcodeTables s_opcode_tables;
 
     struct Prefix 
     {
@@ -784,6 +803,15 @@ namespace X86
             return m_descriptor; 
         }
 
+        /**
+         * @return true if this instruction may transfer control, so a
+         *         decoded basic block ends with it
+         */
+        bool ends_basic_block() const 
+        { 
+            return m_descriptor->ends_basic_block; 
+        }
+
         unsigned length() const;
 
         String mnemonic() const;
@@ -1386,19 +1414,19 @@ namespace X86
 
         if (m_op == 0x0f) {
             m_sub_op = stream.read8();
-            m_descriptor = m_o32 ? &s_0f_table32[m_sub_op] : &s_0f_table16[m_sub_op];
+            m_descriptor = m_o32 ? &s_opcode_tables.table_0f32[m_sub_op] : &s_opcode_tables.table_0f16[m_sub_op];
         } else {
-            m_descriptor = m_o32 ? &s_table32[m_op] : &s_table16[m_op];
+            m_descriptor = m_o32 ? &s_opcode_tables.table32[m_op] : &s_opcode_tables.table16[m_op];
         }
 
         if (m_descriptor->format == __SSE) {
             if (m_rep_prefix == 0xF3) {
-                m_descriptor = &s_sse_table_f3[m_sub_op];
+                m_descriptor = &s_opcode_tables.sse_table_f3[m_sub_op];
             } else if (m_has_operand_size_override_prefix) {
                 m_o32 = true;
-                m_descriptor = &s_sse_table_66[m_sub_op];
+                m_descriptor = &s_opcode_tables.sse_table_66[m_sub_op];
             } else {
-                m_descriptor = &s_sse_table_np[m_sub_op];
+                m_descriptor = &s_opcode_tables.sse_table_np[m_sub_op];
             }
         }
 